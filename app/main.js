@@ -1,5 +1,5 @@
 const { app, BrowserWindow, ipcMain, dialog } = require('electron');
-const { execFile } = require('child_process');
+const { execFile, spawn } = require('child_process');
 const path = require('path');
 const fs = require('fs');
 
@@ -17,21 +17,113 @@ function createWindow() {
 
 app.whenReady().then(createWindow);
 
-ipcMain.handle('run-typing-tutor', async (event, args) => {
+const backendPath = path.join(__dirname, '../build/typingtutor.exe');
+const backendCwd = path.join(__dirname, '../build');
+
+// The in-process backend, when `npm run build-native` has built it. It runs
+// the same C code as the executable without a pipe round trip per call, on
+// a worker thread so the main process stays responsive.
+let nativeBackend = null;
+try {
+  nativeBackend = require('./native/build/Release/typingtutor.node');
+  nativeBackend.open(backendCwd);
+} catch (error) {
+  nativeBackend = null;
+}
+
+// One resident `typingtutor --serve` process answers every request, so the
+// corpus and leaderboard are parsed once instead of on every IPC call.
+let backend = null;
+let backendBuffer = Buffer.alloc(0);
+const pendingRequests = [];
+
+function startBackend() {
+  const child = spawn(backendPath, ['--serve'], { cwd: backendCwd });
+  child.stdout.on('data', (chunk) => {
+    backendBuffer = Buffer.concat([backendBuffer, chunk]);
+    drainBackendReplies();
+  });
+  child.stdin.on('error', () => {});
+  child.on('error', () => stopBackend(child));
+  child.on('exit', () => stopBackend(child));
+  backend = child;
+  backendBuffer = Buffer.alloc(0);
+}
+
+function stopBackend(child) {
+  if (backend !== child) return;
+  backend = null;
+  // Queries still waiting on the dead process are retried one-shot. A
+  // submission may already have been recorded, so it is never sent twice.
+  while (pendingRequests.length > 0) {
+    const request = pendingRequests.shift();
+    if (isQuery(request.args)) {
+      runOnce(request.args).then(request.resolve);
+    } else {
+      request.resolve('ERROR: The backend stopped before answering; the attempt may not have been saved');
+    }
+  }
+}
+
+function isQuery(args) {
+  return /^--(get|list)-/.test(String(args[0]));
+}
+
+function drainBackendReplies() {
+  for (;;) {
+    const newline = backendBuffer.indexOf(0x0a);
+    if (newline < 0) return;
+    const [status, length] = backendBuffer.subarray(0, newline).toString().split(' ').map(Number);
+    if (backendBuffer.length < newline + 1 + length) return;
+    const body = backendBuffer.subarray(newline + 1, newline + 1 + length).toString('utf8');
+    backendBuffer = backendBuffer.subarray(newline + 1 + length);
+    const request = pendingRequests.shift();
+    if (request) request.resolve(status === 0 ? body : `ERROR: ${body}`);
+  }
+}
+
+function runOnce(args) {
   return new Promise((resolve) => {
-    execFile(
-      path.join(__dirname, '../build/typingtutor.exe'),
-      args,
-      { cwd: path.join(__dirname, '../build') },
-      (error, stdout, stderr) => {
-        if (error) {
-          resolve(`ERROR: ${stderr || error.message}`);  // ✅ Graceful error
-        } else {
-          resolve(stdout);
-        }
+    execFile(backendPath, args, { cwd: backendCwd }, (error, stdout, stderr) => {
+      if (error) {
+        resolve(`ERROR: ${stderr || error.message}`);  // ✅ Graceful error
+      } else {
+        resolve(stdout);
       }
-    );
+    });
+  });
+}
+
+async function runBackend(args) {
+  if (nativeBackend) {
+    const { status, output } = await nativeBackend.run(args.map(String));
+    return status === 0 ? output : `ERROR: ${output}`;
+  }
+  if (!backend) startBackend();
+  return new Promise((resolve) => {
+    const payload = Buffer.concat(args.map((arg) => Buffer.from(`${arg}\0`, 'utf8')));
+    pendingRequests.push({ args, resolve });
+    backend.stdin.write(`${payload.length}\n`);
+    backend.stdin.write(payload);
   });
+}
+
+ipcMain.handle('run-typing-tutor', async (event, args) => runBackend(args));
+
+// One page of a leaderboard as { total, entries: [{ rank, username, cpm, wpm,
+// accuracy }] }: typed rows from the addon, or the same fields read from the
+// --serve process's --format json records.
+ipcMain.handle('get-leaderboard', async (event, difficulty, limit = 10) => {
+  if (nativeBackend) return nativeBackend.leaderboard(String(difficulty), 0, limit);
+  const reply = await runBackend(['--format', 'json', '--get-leaderboard', difficulty, '--limit', String(limit)]);
+  if (reply.startsWith('ERROR:')) throw new Error(reply.replace('ERROR:', '').trim());
+  const [header, ...entries] = reply.split('\n').filter(line => line !== '').map(line => JSON.parse(line));
+  return { total: header ? header.total : 0, entries };
+});
+
+app.on('will-quit', () => {
+  if (backend) backend.stdin.end();
+  if (nativeBackend) nativeBackend.close();
 });
 
 // IPC for exporting stats
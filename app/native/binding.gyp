@@ -0,0 +1,34 @@
+{
+  "targets": [
+    {
+      "target_name": "typingtutor",
+      "sources": [
+        "typingtutor_addon.c",
+        "../../libtypingtutor.c",
+        "../../backend.c",
+        "../../backend_corpus.c",
+        "../../backend_scoring.c",
+        "../../backend_leaderboard.c",
+        "../../backend_profiles.c",
+        "../../scoring.c",
+        "../../corpus.c",
+        "../../leaderboard_store.c",
+        "../../leaderboard_journal.c",
+        "../../keystroke_log.c",
+        "../../thread_pool.c",
+        "../../file_lock.c",
+        "../../profile_store.c",
+        "../../progress_store.c",
+        "../../score_sketch.c"
+      ],
+      "include_dirs": ["../.."],
+      "defines": ["TYPINGTUTOR_BUILDING_LIBRARY"],
+      "conditions": [
+        ["OS!='win'", {
+          "cflags": ["-O2", "-fvisibility=hidden", "-pthread"],
+          "libraries": ["-lm", "-pthread"]
+        }]
+      ]
+    }
+  ]
+}
@@ -0,0 +1,422 @@
+// N-API addon for Electron's main process: libtypingtutor in-process, so an
+// IPC call no longer goes through the --serve pipe. Built by binding.gyp
+// (npm run build-native); main.js falls back to the pipe without it.
+//
+//   open(dataDirectory)
+//   run([args...])                      -> promise of { status, output }, as one --serve
+//                                          request; runs off the main thread, one at a time
+//   leaderboard(difficulty, offset, limit)
+//                                       -> promise of { total, entries: [{ rank, username,
+//                                            cpm, wpm, accuracy }] }, queued like run()
+//   profile(username)                   -> promise of { username, attempts, bestCpm, avgCpm,
+//                                            bestAccuracy, avgAccuracy }, queued like run()
+//   profiles(offset, limit)             -> promise of { total, profiles: [...] }, queued
+//                                          like run()
+//   score(paragraph, typed, caseInsensitive, seconds)
+//                                       -> { cpm, wpm, accuracy, wrongChars, substitutions,
+//                                            insertions, deletions, paragraphLength }
+//   paragraph(difficulty[, username])   -> string, or null
+//   close()                             once the request in progress is done; queued
+//                                          ones are rejected
+//
+// score() and paragraph() are quick and run inline, so they throw while a
+// queued request is in progress rather than overlap it on the handle.
+
+#include <stdlib.h>
+#include <string.h>
+#include <node_api.h>
+
+#include "libtypingtutor.h"
+
+#define ADDON_MAX_ARGS 16
+#define ADDON_MAX_ROWS 1000
+
+// One backend per process, as for the executable
+static TypingTutor *tutor;
+
+typedef enum {
+    REQUEST_RUN,
+    REQUEST_LEADERBOARD,
+    REQUEST_PROFILE,
+    REQUEST_PROFILES
+} RequestKind;
+
+// A run() or typed query call. The handle is not thread-safe, so only the
+// head of the queue is on the thread pool; each one starts the next as it
+// completes.
+typedef struct RunRequest {
+    napi_async_work work;
+    napi_deferred deferred;
+    RequestKind kind;
+    uint32_t argc;
+    char *args[ADDON_MAX_ARGS];     // the command, or the difficulty or username
+    uint64_t offset;
+    size_t limit;
+    void *rows;                     // TypingTutorLeaderboardEntry or TypingTutorProfile
+    int64_t count;                  // rows written, or the status of run()/profile()
+    uint64_t total;
+    struct RunRequest *next;
+} RunRequest;
+
+static RunRequest *runQueue, *runQueueTail;
+static int closeRequested;
+
+static napi_value throwError(napi_env env, const char *message) {
+    napi_throw_error(env, NULL, message);
+    return NULL;
+}
+
+// A JavaScript string as a malloc'd UTF-8 string, or NULL if it is not one
+static char *copyString(napi_env env, napi_value value) {
+    size_t length;
+    if (napi_get_value_string_utf8(env, value, NULL, 0, &length) != napi_ok) return NULL;
+    char *text = malloc(length + 1);
+    if (text) napi_get_value_string_utf8(env, value, text, length + 1, &length);
+    return text;
+}
+
+static int isNullish(napi_env env, napi_value value) {
+    napi_valuetype type;
+    napi_typeof(env, value, &type);
+    return type == napi_undefined || type == napi_null;
+}
+
+static void setNumber(napi_env env, napi_value object, const char *name, double number) {
+    napi_value value;
+    napi_create_double(env, number, &value);
+    napi_set_named_property(env, object, name, value);
+}
+
+static napi_value openTutor(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    if (tutor) return NULL;
+    char *directory = argc >= 1 && !isNullish(env, argv[0]) ? copyString(env, argv[0]) : NULL;
+    tutor = typingTutorOpen(directory);
+    free(directory);
+    if (!tutor) return throwError(env, "Could not open the typing tutor data directory");
+    return NULL;
+}
+
+static void freeRunRequest(napi_env env, RunRequest *request) {
+    napi_delete_async_work(env, request->work);
+    for (uint32_t i = 0; i < request->argc; i++) free(request->args[i]);
+    free(request->rows);
+    free(request);
+}
+
+static void rejectRun(napi_env env, RunRequest *request, const char *message) {
+    napi_value text, error;
+    napi_create_string_utf8(env, message, NAPI_AUTO_LENGTH, &text);
+    napi_create_error(env, NULL, text, &error);
+    napi_reject_deferred(env, request->deferred, error);
+}
+
+static void closeNow(napi_env env) {
+    // Requests behind the one that just finished never reached the pool
+    while (runQueue) {
+        RunRequest *request = runQueue;
+        runQueue = request->next;
+        rejectRun(env, request, "The typing tutor was closed");
+        freeRunRequest(env, request);
+    }
+    runQueueTail = NULL;
+    typingTutorClose(tutor);
+    tutor = NULL;
+    closeRequested = 0;
+}
+
+static napi_value closeTutor(napi_env env, napi_callback_info info) {
+    (void)info;
+    if (runQueue) {
+        closeRequested = 1;
+    } else {
+        closeNow(env);
+    }
+    return NULL;
+}
+
+// On a thread-pool thread, with the handle to itself
+static void executeRun(napi_env env, void *data) {
+    RunRequest *request = data;
+    (void)env;
+    switch (request->kind) {
+    case REQUEST_RUN:
+        request->count = typingTutorRun(tutor, (int)request->argc, (const char *const *)request->args);
+        break;
+    case REQUEST_LEADERBOARD:
+        request->count = typingTutorLeaderboard(tutor, request->args[0], request->offset, request->rows,
+                                                request->limit, &request->total);
+        break;
+    case REQUEST_PROFILE:
+        request->count = typingTutorProfile(tutor, request->args[0], request->rows);
+        break;
+    case REQUEST_PROFILES:
+        request->count = typingTutorProfiles(tutor, request->offset, request->rows, request->limit, &request->total);
+        break;
+    }
+}
+
+static void setString(napi_env env, napi_value object, const char *name, const char *text) {
+    napi_value value;
+    napi_create_string_utf8(env, text, NAPI_AUTO_LENGTH, &value);
+    napi_set_named_property(env, object, name, value);
+}
+
+static napi_value profileObject(napi_env env, const TypingTutorProfile *profile) {
+    napi_value result;
+    napi_create_object(env, &result);
+    setString(env, result, "username", profile->username);
+    setNumber(env, result, "attempts", (double)profile->attempts);
+    setNumber(env, result, "bestCpm", profile->bestCpm);
+    setNumber(env, result, "avgCpm", profile->avgCpm);
+    setNumber(env, result, "bestAccuracy", profile->bestAccuracy);
+    setNumber(env, result, "avgAccuracy", profile->avgAccuracy);
+    return result;
+}
+
+// { total, <name>: [rows...] } for a leaderboard or profile page
+static napi_value pageObject(napi_env env, const RunRequest *request, const char *name) {
+    napi_value result, rows;
+    napi_create_object(env, &result);
+    setNumber(env, result, "total", (double)request->total);
+    napi_create_array_with_length(env, (size_t)request->count, &rows);
+    for (int64_t i = 0; i < request->count; i++) {
+        napi_value row;
+        if (request->kind == REQUEST_PROFILES) {
+            row = profileObject(env, (const TypingTutorProfile *)request->rows + i);
+        } else {
+            const TypingTutorLeaderboardEntry *entry = (const TypingTutorLeaderboardEntry *)request->rows + i;
+            napi_create_object(env, &row);
+            setNumber(env, row, "rank", (double)entry->rank);
+            setString(env, row, "username", entry->username);
+            setNumber(env, row, "cpm", entry->cpm);
+            setNumber(env, row, "wpm", entry->wpm);
+            setNumber(env, row, "accuracy", entry->accuracy);
+        }
+        napi_set_element(env, rows, (uint32_t)i, row);
+    }
+    napi_set_named_property(env, result, name, rows);
+    return result;
+}
+
+// Back on the main thread: settle the promise, then start the next request
+static void completeRun(napi_env env, napi_status status, void *data) {
+    RunRequest *request = data;
+    if (status != napi_ok) {
+        rejectRun(env, request, "The request was cancelled");
+    } else if (request->kind != REQUEST_RUN && request->count < 0) {
+        rejectRun(env, request, request->kind == REQUEST_LEADERBOARD ? "Could not read the leaderboard"
+                                                                     : "Could not read the profile store");
+    } else {
+        napi_value result, value;
+        size_t length;
+        const char *output;
+        switch (request->kind) {
+        case REQUEST_RUN:
+            output = typingTutorOutput(tutor, &length);
+            napi_create_object(env, &result);
+            setNumber(env, result, "status", (double)request->count);
+            napi_create_string_utf8(env, output, length, &value);
+            napi_set_named_property(env, result, "output", value);
+            break;
+        case REQUEST_PROFILE:
+            result = profileObject(env, request->rows);
+            break;
+        case REQUEST_LEADERBOARD:
+            result = pageObject(env, request, "entries");
+            break;
+        case REQUEST_PROFILES:
+        default:
+            result = pageObject(env, request, "profiles");
+            break;
+        }
+        napi_resolve_deferred(env, request->deferred, result);
+    }
+    runQueue = request->next;
+    if (!runQueue) runQueueTail = NULL;
+    freeRunRequest(env, request);
+
+    if (closeRequested) {
+        closeNow(env);
+    } else if (runQueue) {
+        napi_queue_async_work(env, runQueue->work);
+    }
+}
+
+// Put a filled-in request on the queue and return its promise. On error the
+// request is freed and a JavaScript exception is pending.
+static napi_value queueRequest(napi_env env, RunRequest *request, const char *error) {
+    napi_value name, promise;
+    napi_create_string_utf8(env, "typingTutorRun", NAPI_AUTO_LENGTH, &name);
+    if (!error && request->kind != REQUEST_RUN && request->limit > 0 && !request->rows) error = "Out of memory";
+    if (!error && napi_create_async_work(env, NULL, name, executeRun, completeRun, request, &request->work) != napi_ok) {
+        error = "Could not start the request";
+    }
+    if (error) {
+        for (uint32_t i = 0; i < request->argc; i++) free(request->args[i]);
+        free(request->rows);
+        free(request);
+        return throwError(env, error);
+    }
+    napi_create_promise(env, &request->deferred, &promise);
+
+    if (runQueueTail) {
+        runQueueTail->next = request;
+    } else {
+        runQueue = request;
+        napi_queue_async_work(env, request->work);
+    }
+    runQueueTail = request;
+    return promise;
+}
+
+static napi_value runCommand(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    if (!tutor || closeRequested) return throwError(env, "open() has not been called");
+    uint32_t count = 0;
+    if (argc < 1 || napi_get_array_length(env, argv[0], &count) != napi_ok) {
+        return throwError(env, "run() takes an array of strings");
+    }
+    if (count > ADDON_MAX_ARGS) return throwError(env, "Too many arguments");
+
+    RunRequest *request = calloc(1, sizeof(RunRequest));
+    if (!request) return throwError(env, "Out of memory");
+    request->kind = REQUEST_RUN;
+    for (; request->argc < count; request->argc++) {
+        napi_value element;
+        napi_get_element(env, argv[0], request->argc, &element);
+        if (!(request->args[request->argc] = copyString(env, element))) break;
+    }
+    return queueRequest(env, request, request->argc != count ? "run() takes an array of strings" : NULL);
+}
+
+// An optional non-negative count argument, or fallback
+static double countArgument(napi_env env, size_t argc, napi_value *argv, size_t index, double fallback) {
+    double value;
+    if (index >= argc || isNullish(env, argv[index]) || napi_get_value_double(env, argv[index], &value) != napi_ok ||
+        value < 0) {
+        return fallback;
+    }
+    return value;
+}
+
+static napi_value leaderboardPage(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    if (!tutor || closeRequested) return throwError(env, "open() has not been called");
+    RunRequest *request = calloc(1, sizeof(RunRequest));
+    if (!request) return throwError(env, "Out of memory");
+    request->kind = REQUEST_LEADERBOARD;
+    request->offset = (uint64_t)countArgument(env, argc, argv, 1, 0);
+    request->limit = (size_t)countArgument(env, argc, argv, 2, 10);
+    if (request->limit > ADDON_MAX_ROWS) request->limit = ADDON_MAX_ROWS;
+    request->rows = calloc(request->limit, sizeof(TypingTutorLeaderboardEntry));
+    if (argc >= 1 && (request->args[0] = copyString(env, argv[0]))) request->argc = 1;
+    return queueRequest(env, request, request->argc != 1 ? "leaderboard() takes a difficulty" : NULL);
+}
+
+static napi_value userProfile(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    if (!tutor || closeRequested) return throwError(env, "open() has not been called");
+    RunRequest *request = calloc(1, sizeof(RunRequest));
+    if (!request) return throwError(env, "Out of memory");
+    request->kind = REQUEST_PROFILE;
+    request->limit = 1;
+    request->rows = calloc(1, sizeof(TypingTutorProfile));
+    if (argc >= 1 && (request->args[0] = copyString(env, argv[0]))) request->argc = 1;
+    return queueRequest(env, request, request->argc != 1 ? "profile() takes a username" : NULL);
+}
+
+static napi_value profilePage(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    if (!tutor || closeRequested) return throwError(env, "open() has not been called");
+    RunRequest *request = calloc(1, sizeof(RunRequest));
+    if (!request) return throwError(env, "Out of memory");
+    request->kind = REQUEST_PROFILES;
+    request->offset = (uint64_t)countArgument(env, argc, argv, 0, 0);
+    request->limit = (size_t)countArgument(env, argc, argv, 1, 100);
+    if (request->limit > ADDON_MAX_ROWS) request->limit = ADDON_MAX_ROWS;
+    request->rows = calloc(request->limit, sizeof(TypingTutorProfile));
+    return queueRequest(env, request, NULL);
+}
+
+static napi_value scoreTyping(napi_env env, napi_callback_info info) {
+    size_t argc = 4;
+    napi_value argv[4];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    if (!tutor) return throwError(env, "open() has not been called");
+    if (runQueue) return throwError(env, "A run() is still in progress");
+    if (argc < 4) return throwError(env, "score() takes paragraph, typed, caseInsensitive, seconds");
+    char *paragraph = copyString(env, argv[0]);
+    char *typed = copyString(env, argv[1]);
+    bool caseInsensitive = false;
+    double seconds = 0;
+    napi_coerce_to_bool(env, argv[2], &argv[2]);
+    napi_get_value_bool(env, argv[2], &caseInsensitive);
+    napi_get_value_double(env, argv[3], &seconds);
+
+    TypingTutorStats stats;
+    int status = paragraph && typed ? typingTutorScore(tutor, paragraph, typed, caseInsensitive, seconds, &stats) : -1;
+    free(paragraph);
+    free(typed);
+    if (status != 0) return throwError(env, "score() needs a non-empty paragraph and the typed text");
+
+    napi_value result;
+    napi_create_object(env, &result);
+    setNumber(env, result, "cpm", stats.cpm);
+    setNumber(env, result, "wpm", stats.wpm);
+    setNumber(env, result, "accuracy", stats.accuracy);
+    setNumber(env, result, "wrongChars", stats.wrongChars);
+    setNumber(env, result, "substitutions", stats.substitutions);
+    setNumber(env, result, "insertions", stats.insertions);
+    setNumber(env, result, "deletions", stats.deletions);
+    setNumber(env, result, "paragraphLength", (double)stats.paragraphLength);
+    return result;
+}
+
+static napi_value nextParagraph(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+    if (!tutor) return throwError(env, "open() has not been called");
+    if (runQueue) return throwError(env, "A run() is still in progress");
+    char *difficulty = argc >= 1 ? copyString(env, argv[0]) : NULL;
+    char *username = argc >= 2 && !isNullish(env, argv[1]) ? copyString(env, argv[1]) : NULL;
+    const char *text = difficulty ? typingTutorParagraph(tutor, difficulty, username) : NULL;
+    free(difficulty);
+    free(username);
+
+    napi_value result;
+    if (text) {
+        napi_create_string_utf8(env, text, NAPI_AUTO_LENGTH, &result);
+    } else {
+        napi_get_null(env, &result);
+    }
+    return result;
+}
+
+static napi_value initAddon(napi_env env, napi_value exports) {
+    napi_property_descriptor methods[] = {
+        {"open", NULL, openTutor, NULL, NULL, NULL, napi_default, NULL},
+        {"close", NULL, closeTutor, NULL, NULL, NULL, napi_default, NULL},
+        {"run", NULL, runCommand, NULL, NULL, NULL, napi_default, NULL},
+        {"score", NULL, scoreTyping, NULL, NULL, NULL, napi_default, NULL},
+        {"paragraph", NULL, nextParagraph, NULL, NULL, NULL, napi_default, NULL},
+        {"leaderboard", NULL, leaderboardPage, NULL, NULL, NULL, napi_default, NULL},
+        {"profile", NULL, userProfile, NULL, NULL, NULL, napi_default, NULL},
+        {"profiles", NULL, profilePage, NULL, NULL, NULL, napi_default, NULL},
+    };
+    napi_define_properties(env, exports, sizeof(methods) / sizeof(methods[0]), methods);
+    return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, initAddon)
@@ -1,31 +1,36 @@
 // Simple progress tracking
 let progressData = [];
 
-// Load progress from file (replace with actual file reading)
-function loadProgress() {
-    // TODO: Read from build/progress.txt
-    // Format: wpm,accuracy,date (one line per test)
-    // Example implementation:
-    /*
-    const fs = require('fs');
+// Load the last 30 days from the backend's per-user progress history, one
+// point per day. The page is opened as progress.html?user=<name>.
+async function loadProgress() {
+    const { ipcRenderer } = require('electron');
+    const user = new URLSearchParams(window.location.search).get('user') || 'default';
+    const pad = (n) => String(n).padStart(2, '0');
+    const day = (date) => `${date.getFullYear()}-${pad(date.getMonth() + 1)}-${pad(date.getDate())}`;
+    const to = new Date();
+    const from = new Date(to.getTime() - 29 * 24 * 60 * 60 * 1000);
+
+    progressData = [];
     try {
-        const data = fs.readFileSync('../build/progress.txt', 'utf8');
-        const lines = data.trim().split('\n');
-        progressData = lines.map(line => {
-            const [wpm, accuracy, date] = line.split(',');
-            return {
-                wpm: parseInt(wpm),
-                accuracy: parseInt(accuracy),
-                date: date,
-                timestamp: new Date(date).getTime()
-            };
-        });
+        const result = await ipcRenderer.invoke('run-typing-tutor', ['--format', 'json', '--get-progress', user,
+            day(from), day(to), 'daily', '--fields', 'period,avgWpm,avgAccuracy']);
+        if (!result.startsWith('ERROR')) {
+            // A header record, then one record per day
+            progressData = result.trim().split('\n').slice(1).map(line => {
+                const { period, avgWpm, avgAccuracy } = JSON.parse(line);
+                return {
+                    wpm: Math.round(avgWpm),
+                    accuracy: Math.round(avgAccuracy),
+                    date: period,
+                    timestamp: new Date(period).getTime()
+                };
+            });
+        }
     } catch (error) {
-        console.log('No progress file found or error reading file');
-        progressData = [];
+        console.log('Could not load progress history');
     }
-    */
-    
+
     updateStats();
     drawGraph();
 }
@@ -459,7 +459,10 @@ window.runTypingTutor = async function(isRestart = false) {
         if (useCustom && customText.length > 0) {
             currentParagraph = customText;
         } else {
-            const result = await ipcRenderer.invoke('run-typing-tutor', ['--get-paragraph', selectedDifficulty]);
+            // With a user, paragraphs come from their no-repeat shuffle
+            const paragraphArgs = ['--format', 'json', '--get-paragraph', selectedDifficulty];
+            if (currentUser) paragraphArgs.push(currentUser);
+            const result = await ipcRenderer.invoke('run-typing-tutor', paragraphArgs);
 
             // ✅ Handle file read failure from backend
             if (result.startsWith("ERROR:")) {
@@ -467,8 +470,8 @@ window.runTypingTutor = async function(isRestart = false) {
                 return;
             }
 
-            const match = result.match(/Random Paragraph:\s*([\s\S]*)/);
-            currentParagraph = match ? match[1].trim() : '';
+            const [record] = parseRecords(result);
+            currentParagraph = record ? record.paragraph.trim() : '';
 
             if (!currentParagraph) {
                 showToast("Paragraph could not be loaded", true); // fallback toast and quit
@@ -520,6 +523,7 @@ window.submitTyping = async function(isTimedEnd = false) {
     const caseInsensitive = document.getElementById('caseSensitive')?.checked ? 0 : 1;
 
     const args = [
+        '--format', 'json',
         currentUser,
         selectedDifficulty,
         caseInsensitive.toString(),
@@ -532,10 +536,25 @@ window.submitTyping = async function(isTimedEnd = false) {
 
     try {
         const result = await ipcRenderer.invoke('run-typing-tutor', args);
-        const statsMatch = result.match(/Typing Stats:\n([\s\S]*)/);
+
+        // The final numbers are the backend's, the same as every other front end shows
+        const [scored] = parseRecords(result);
+        if (scored) {
+            if (realtimeTyping.updateInterval) {
+                clearInterval(realtimeTyping.updateInterval);
+                realtimeTyping.updateInterval = null;
+            }
+            realtimeTyping.stats.cpm = scored.cpm;
+            realtimeTyping.stats.wpm = scored.wpm;
+            realtimeTyping.stats.accuracy = scored.accuracy;
+            const speed = document.getElementById('speed-stat');
+            const accuracy = document.getElementById('accuracy-stat');
+            if (speed) speed.textContent = `${scored.cpm.toFixed(2)} CPM (${scored.wpm.toFixed(2)} WPM)`;
+            if (accuracy) accuracy.textContent = `${scored.accuracy.toFixed(2)}%`;
+        }
 
         // Optionally display via stats dashboard
-        // displayFinalStats(statsMatch ? statsMatch[1].trim() : result);
+        // displayFinalStats(scored);
 
         document.getElementById('exportBtn').disabled = false;
         showLeaderboard(); // ✅ Grid layout will now update
@@ -655,37 +674,25 @@ window.returnToMainMenu = function() {
     checkStartConditions();
 };
 
+// Records of a --format json reply, one JSON object per line
+function parseRecords(result) {
+  if (result.startsWith('ERROR:')) throw new Error(result.replace('ERROR:', '').trim());
+  return result.split('\n').filter(line => line !== '').map(line => JSON.parse(line));
+}
+
+// The top ten of a difficulty's leaderboard
+async function leaderboardRows(difficulty) {
+  const { entries } = await ipcRenderer.invoke('get-leaderboard', difficulty, 10);
+  return entries.map(({ username, cpm, wpm, accuracy }) => ({ name: username, cpm, wpm, accuracy, difficulty }));
+}
+
 // Show leaderboard
 async function showLeaderboard(difficulty = 'Easy') {
   const entries = document.getElementById('leaderboard-entries');
   entries.innerHTML = '';
 
   try {
-    const result = await ipcRenderer.invoke('run-typing-tutor', ['--get-leaderboard', difficulty]);
-    console.log('Raw output from C program:', JSON.stringify(result));
-
-    // Parse the table-formatted output
-    const lines = result.trim().split('\n')
-      .filter(line => line.trim() !== '' && line.includes('|')) // Keep lines with table data
-      .filter(line => !line.includes('Rank') && !line.includes('---')) // Skip header and separator
-      .map(line => {
-        // Extract fields using regex to handle multiple spaces and pipes
-        const match = line.match(/\|\s*(\d+)\s*\|\s*(\w+)\s*\|\s*(\d+\.\d+)\s*\|\s*(\d+\.\d+)\s*\|\s*(\d+\.\d+)\s*\|/);
-        if (!match) {
-          console.warn(`Invalid line format: ${line}`);
-          return null;
-        }
-        const [, rank, name, cpm, wpm, accuracy] = match;
-        const parsedCpm = parseFloat(cpm);
-        const parsedWpm = parseFloat(wpm);
-        const parsedAccuracy = parseFloat(accuracy);
-        if (isNaN(parsedCpm) || isNaN(parsedWpm) || isNaN(parsedAccuracy)) {
-          console.warn(`Invalid numeric values in line: ${line}`);
-          return null;
-        }
-        return { name, cpm: parsedCpm, wpm: parsedWpm, accuracy: parsedAccuracy, difficulty };
-      })
-      .filter(entry => entry !== null);
+    const lines = await leaderboardRows(difficulty);
 
     const uniqueScores = lines.reduce((acc, current) => {
       const existing = acc.find(item => item.name === current.name);
@@ -700,7 +707,7 @@ async function showLeaderboard(difficulty = 'Easy') {
     uniqueScores.sort((a, b) => b.cpm - a.cpm);
 
     if (uniqueScores.length === 0) {
-      entries.innerHTML = `<div class="error-message">No valid leaderboard entries for ${difficulty}. Raw output: <pre>${result || 'Empty output'}</pre></div>`;
+      entries.innerHTML = `<div class="error-message">No valid leaderboard entries for ${difficulty}.</div>`;
       return;
     }
 
@@ -720,7 +727,7 @@ async function showLeaderboard(difficulty = 'Easy') {
     });
   } catch (error) {
     console.error('Error loading leaderboard:', error);
-    entries.innerHTML = `<div class="error-message">Error loading leaderboard data: ${error.message}. Raw output: <pre>${result || 'No output received'}</pre></div>`;
+    entries.innerHTML = `<div class="error-message">Error loading leaderboard data: ${error.message}.</div>`;
   }
 }
 
@@ -765,35 +772,11 @@ async function showFullLeaderboard(difficulty = 'Easy') {
     }
 
     try {
-        const result = await ipcRenderer.invoke('run-typing-tutor', ['--get-leaderboard', difficulty]);
-        console.log('Raw output from C program:', JSON.stringify(result));
-        if (!result) throw new Error('No leaderboard data received');
+        const lines = await leaderboardRows(difficulty);
 
         const entries = document.getElementById('full-leaderboard-entries');
         entries.innerHTML = '';
 
-        const lines = result.trim().split('\n')
-            .filter(line => line.trim() !== '' && line.includes('|')) // Keep lines with table data
-            .filter(line => !line.includes('Rank') && !line.includes('---')) // Skip header and separator
-            .map(line => {
-                // Extract fields using regex to handle table format
-                const match = line.match(/\|\s*(\d+)\s*\|\s*(\w+)\s*\|\s*(\d+\.\d+)\s*\|\s*(\d+\.\d+)\s*\|\s*(\d+\.\d+)\s*\|/);
-                if (!match) {
-                    console.warn(`Invalid line format: ${line}`);
-                    return null;
-                }
-                const [, rank, name, cpm, wpm, accuracy] = match;
-                const parsedCpm = parseFloat(cpm);
-                const parsedWpm = parseFloat(wpm);
-                const parsedAccuracy = parseFloat(accuracy);
-                if (isNaN(parsedCpm) || isNaN(parsedWpm) || isNaN(parsedAccuracy)) {
-                    console.warn(`Invalid numeric values in line: ${line}`);
-                    return null;
-                }
-                return { name, cpm: parsedCpm, wpm: parsedWpm, accuracy: parsedAccuracy, difficulty };
-            })
-            .filter(entry => entry !== null);
-
         const uniqueScores = lines.reduce((acc, current) => {
             const existing = acc.find(item => item.name === current.name);
             if (!existing || existing.cpm < current.cpm) {
@@ -807,7 +790,7 @@ async function showFullLeaderboard(difficulty = 'Easy') {
         uniqueScores.sort((a, b) => b.cpm - a.cpm);
 
         if (uniqueScores.length === 0) {
-            entries.innerHTML = `<div class="error-message">No valid leaderboard entries for ${difficulty}. Raw output: <pre>${result || 'Empty output'}</pre></div>`;
+            entries.innerHTML = `<div class="error-message">No valid leaderboard entries for ${difficulty}.</div>`;
             return;
         }
 
@@ -830,7 +813,7 @@ async function showFullLeaderboard(difficulty = 'Easy') {
     } catch (error) {
         console.error('Error loading full leaderboard:', error);
         const entries = document.getElementById('full-leaderboard-entries');
-        entries.innerHTML = `<div class="error-message">Error loading leaderboard data: ${error.message}. Raw output: <pre>${result || 'No output received'}</pre></div>`;
+        entries.innerHTML = `<div class="error-message">Error loading leaderboard data: ${error.message}.</div>`;
         modal.style.display = 'block';
     }
 }
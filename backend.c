@@ -0,0 +1,444 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <errno.h>
+
+#include "backend.h"
+
+// Write-behind commit for processAttempts(). Each store takes the whole batch
+// under one lock and, unless durability is none, one sync; the leaderboard
+// journal makes its own group commit.
+void commitPendingAttempts(void *context, const void *items, size_t count, WriteBehindDurability durability) {
+    BackendState *state = context;
+    const PendingAttempt *attempts = items;
+    int sync = durability != WRITE_BEHIND_NONE;
+
+    ProfileStore *profiles = getProfileStore(state);
+    if (profiles && lockProfileStore(profiles, 1) == 0) {
+        for (size_t i = 0; i < count; i++) {
+            UserProfile profile = {0};
+            strncpy(profile.username, attempts[i].username, sizeof(profile.username) - 1);
+            ProfileRecord *record = claimProfileRecord(profiles, profile.username);
+            if (!record) {
+                fprintf(stderr, "Error saving user profile for '%s'\n", profile.username);
+                continue;
+            }
+            copyProfileRecord(&profile, record);
+            recordProfileAttempt(&profile, &attempts[i].stats);
+            storeProfileRecord(record, &profile);
+            if (attempts[i].hasKeystrokes) addRecordKeystrokes(profiles, record, &attempts[i].keystrokes);
+        }
+        if (sync && syncProfileStore(profiles) != 0) fprintf(stderr, "Error syncing %s\n", PROFILE_STORE_PATH);
+        unlockProfileStore(profiles);
+    } else {
+        fprintf(stderr, "Error saving user profiles\n");
+    }
+
+    // Consecutive attempts of one user share one lookup of their history
+    ProgressSample samples[max_pending_attempts];
+    ProgressStore *progress = getProgressStore(state);
+    for (size_t i = 0, run; i < count; i += run) {
+        for (run = 0; i + run < count && strcmp(attempts[i + run].username, attempts[i].username) == 0; run++) {
+            fillProgressSample(&samples[run], attempts[i + run].difficulty, &attempts[i + run].stats);
+        }
+        if (!progress || appendProgressSamples(progress, attempts[i].username, samples, run) != 0) {
+            fprintf(stderr, "Error saving progress for '%s'\n", attempts[i].username);
+        }
+    }
+    if (progress && sync && syncProgressStore(progress) != 0) fprintf(stderr, "Error syncing %s\n", PROGRESS_STORE_PATH);
+
+    ScoreSketch (*sketches)[SCORE_SKETCH_METRICS] = calloc(SCORE_SKETCH_DIFFICULTIES, sizeof(*sketches));
+    ScoreSketchStore *sketchStore = getScoreSketchStore(state);
+    if (sketches && sketchStore) {
+        for (size_t i = 0; i < count; i++) {
+            ScoreSketch *row = sketches[progressDifficulty(attempts[i].difficulty)];
+            addToScoreSketch(&row[SCORE_SKETCH_CPM], SCORE_SKETCH_CPM, attempts[i].stats.typingSpeed);
+            addToScoreSketch(&row[SCORE_SKETCH_WPM], SCORE_SKETCH_WPM, attempts[i].stats.wordsPerMinute);
+            addToScoreSketch(&row[SCORE_SKETCH_ACCURACY], SCORE_SKETCH_ACCURACY, attempts[i].stats.accuracy);
+        }
+        if (mergeScoreSketches(sketchStore, (const ScoreSketch (*)[SCORE_SKETCH_METRICS])sketches) != 0 ||
+            (sync && syncScoreSketchStore(sketchStore) != 0)) {
+            fprintf(stderr, "Error saving score distribution\n");
+        }
+    }
+    free(sketches);
+
+    LeaderboardEntry entries[max_pending_attempts];
+    for (size_t i = 0; i < count; i++) {
+        memset(&entries[i], 0, sizeof(entries[i]));
+        strncpy(entries[i].username, attempts[i].username, sizeof(entries[i].username) - 1);
+        strncpy(entries[i].difficulty, attempts[i].difficulty, sizeof(entries[i].difficulty) - 1);
+        entries[i].typingSpeed = attempts[i].stats.typingSpeed;
+        entries[i].wordsPerMinute = attempts[i].stats.wordsPerMinute;
+        entries[i].accuracy = attempts[i].stats.accuracy;
+    }
+    refreshLeaderboard(state);
+    if (!state->journalOpen || commitLeaderboardEntries(&state->journal, entries, count) != 0) {
+        fprintf(stderr, "Error saving %zu leaderboard entries\n", count);
+    }
+
+    compactLeaderboardIfNeeded(state);
+}
+
+// Room for length more bytes and the terminating NUL
+static void reserveReply(ReplyBuffer *reply, size_t length) {
+    if (reply->length + length + 1 > reply->capacity) {
+        size_t capacity = reply->capacity ? reply->capacity : 256;
+        while (capacity < reply->length + length + 1) capacity *= 2;
+        reply->data = realloc(reply->data, capacity);
+        CHECK_FILE_OP(reply->data, "Memory allocation error for reply buffer");
+        reply->capacity = capacity;
+    }
+}
+
+void replyPrintf(ReplyBuffer *reply, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    va_list copy;
+    va_copy(copy, args);
+    int needed = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    if (needed < 0) {
+        va_end(args);
+        return;
+    }
+
+    reserveReply(reply, needed);
+    vsnprintf(reply->data + reply->length, needed + 1, format, args);
+    reply->length += needed;
+    va_end(args);
+}
+
+void freeReplyBuffer(ReplyBuffer *reply) {
+    free(reply->data);
+    reply->data = NULL;
+    reply->length = reply->capacity = 0;
+}
+
+void replyAppend(ReplyBuffer *reply, const void *data, size_t length) {
+    reserveReply(reply, length);
+    memcpy(reply->data + reply->length, data, length);
+    reply->length += length;
+    reply->data[reply->length] = '\0';
+}
+
+// Little-endian, whatever the host
+static void replyAppendInteger(ReplyBuffer *reply, uint64_t value, int bytes) {
+    unsigned char encoded[8];
+    for (int i = 0; i < bytes; i++) encoded[i] = (unsigned char)(value >> (8 * i));
+    replyAppend(reply, encoded, bytes);
+}
+
+const QueryOptions textQueryOptions = {OUTPUT_TEXT, 0, SIZE_MAX, ""};
+
+// Takes --format text|json|binary, --offset N, --limit N and --fields a,b,...
+// out of argv. They may lead any command, and may also follow a --command,
+// but never sit among a submission's positional arguments, which carry
+// whatever the user typed.
+int parseQueryOptions(int *argc, char *argv[], QueryOptions *options, ReplyBuffer *reply) {
+    *options = textQueryOptions;
+    int kept = 1, anywhere = 0;
+    for (int i = 1; i < *argc; i++) {
+        const char *name = argv[i];
+        int isOption = strcmp(name, "--format") == 0 || strcmp(name, "--offset") == 0 ||
+                       strcmp(name, "--limit") == 0 || strcmp(name, "--fields") == 0;
+        if (!isOption || !(kept == 1 || anywhere)) {
+            if (kept == 1) anywhere = strncmp(name, "--", 2) == 0;
+            argv[kept++] = argv[i];
+            continue;
+        }
+        if (i + 1 >= *argc) {
+            replyPrintf(reply, "Error: %s needs a value\n", name);
+            return 1;
+        }
+        const char *value = argv[++i];
+        if (strcmp(name, "--format") == 0) {
+            if (strcmp(value, "text") == 0) {
+                options->format = OUTPUT_TEXT;
+            } else if (strcmp(value, "json") == 0) {
+                options->format = OUTPUT_JSON;
+            } else if (strcmp(value, "binary") == 0) {
+                options->format = OUTPUT_BINARY;
+            } else {
+                replyPrintf(reply, "Error: --format must be text, json or binary\n");
+                return 1;
+            }
+        } else if (strcmp(name, "--fields") == 0) {
+            if (strlen(value) + 3 > sizeof(options->fields)) {
+                replyPrintf(reply, "Error: Too many --fields\n");
+                return 1;
+            }
+            snprintf(options->fields, sizeof(options->fields), ",%s,", value);
+        } else {
+            char *end;
+            errno = 0;
+            unsigned long long number = strtoull(value, &end, 10);
+            if (end == value || *end != '\0' || value[0] == '-' || errno == ERANGE || number > SIZE_MAX) {
+                replyPrintf(reply, "Error: %s must be a non-negative whole number\n", name);
+                return 1;
+            }
+            if (strcmp(name, "--offset") == 0) {
+                options->offset = (size_t)number;
+            } else {
+                options->limit = (size_t)number;
+            }
+        }
+    }
+    argv[kept] = NULL;
+    *argc = kept;
+    return 0;
+}
+
+// Where a page of a total-row list ends, given where it starts
+size_t pageEnd(const QueryOptions *options, size_t total) {
+    if (options->offset >= total) return options->offset;
+    return total - options->offset > options->limit ? options->offset + options->limit : total;
+}
+
+// A record's fields go to the reply as they are added. A JSON record is one
+// line; a binary record is its length (4 bytes) and then, per field, the
+// name's length (1 byte), the name, a type byte and the value: 'f' a double,
+// 'i' a signed integer (8 bytes each), 's' a length (4 bytes) and UTF-8.
+// Header records (selectable 0) keep every field whatever --fields says.
+void beginRecord(OutputRecord *record, const QueryOptions *options, ReplyBuffer *reply, int selectable) {
+    record->options = options;
+    record->reply = reply;
+    record->start = reply->length;
+    record->fieldCount = 0;
+    record->selectable = selectable;
+    if (options->format == OUTPUT_BINARY) {
+        replyAppendInteger(reply, 0, 4);
+    } else {
+        replyAppend(reply, "{", 1);
+    }
+}
+
+void endRecord(OutputRecord *record) {
+    ReplyBuffer *reply = record->reply;
+    if (record->options->format == OUTPUT_BINARY) {
+        uint64_t length = reply->length - record->start - 4;
+        for (int i = 0; i < 4; i++) reply->data[record->start + i] = (char)(length >> (8 * i));
+    } else {
+        replyAppend(reply, "}\n", 2);
+    }
+}
+
+// Starts a field, or returns 0 when --fields leaves it out
+static int beginField(OutputRecord *record, const char *name, char type) {
+    const char *fields = record->options->fields;
+    size_t nameLength = strlen(name);
+    if (record->selectable && fields[0]) {
+        const char *match = fields;
+        while ((match = strstr(match, name)) && !(match[-1] == ',' && match[nameLength] == ',')) match++;
+        if (!match) return 0;
+    }
+    ReplyBuffer *reply = record->reply;
+    if (record->options->format == OUTPUT_BINARY) {
+        replyAppendInteger(reply, nameLength, 1);
+        replyAppend(reply, name, nameLength);
+        replyAppend(reply, &type, 1);
+    } else {
+        replyPrintf(reply, "%s\"%s\":", record->fieldCount ? "," : "", name);
+    }
+    record->fieldCount++;
+    return 1;
+}
+
+void recordString(OutputRecord *record, const char *name, const char *value) {
+    if (!beginField(record, name, 's')) return;
+    ReplyBuffer *reply = record->reply;
+    size_t length = strlen(value);
+    if (record->options->format == OUTPUT_BINARY) {
+        replyAppendInteger(reply, length, 4);
+        replyAppend(reply, value, length);
+        return;
+    }
+    replyAppend(reply, "\"", 1);
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)value[i];
+        if (c == '"' || c == '\\') {
+            replyPrintf(reply, "\\%c", c);
+        } else if (c == '\n') {
+            replyAppend(reply, "\\n", 2);
+        } else if (c < 32) {
+            replyPrintf(reply, "\\u%04x", c);
+        } else {
+            replyAppend(reply, &value[i], 1);
+        }
+    }
+    replyAppend(reply, "\"", 1);
+}
+
+// JSON carries the decimals the text output shows; binary the full double
+void recordDecimal(OutputRecord *record, const char *name, double value, int decimals) {
+    if (!beginField(record, name, 'f')) return;
+    if (record->options->format == OUTPUT_BINARY) {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        replyAppendInteger(record->reply, bits, 8);
+    } else if (isfinite(value)) {
+        replyPrintf(record->reply, "%.*f", decimals, value);
+    } else {
+        replyAppend(record->reply, "null", 4);
+    }
+}
+
+void recordNumber(OutputRecord *record, const char *name, double value) {
+    recordDecimal(record, name, value, 2);
+}
+
+void recordInteger(OutputRecord *record, const char *name, long long value) {
+    if (!beginField(record, name, 'i')) return;
+    if (record->options->format == OUTPUT_BINARY) {
+        replyAppendInteger(record->reply, (uint64_t)value, 8);
+    } else {
+        replyPrintf(record->reply, "%lld", value);
+    }
+}
+
+// Open every data file inside directory rather than the working directory.
+// Call before the first command; -1 if the name is too long.
+int setDataDirectory(BackendState *state, const char *directory) {
+    size_t length = directory ? strlen(directory) : 0;
+    int separated = length == 0 || directory[length - 1] == '/' || directory[length - 1] == '\\';
+    if (length + !separated >= sizeof(state->dataDirectory)) {
+        fprintf(stderr, "Error: Path too long: %s\n", directory);
+        return -1;
+    }
+    snprintf(state->dataDirectory, sizeof(state->dataDirectory), "%s%s", length ? directory : "", separated ? "" : "/");
+    return 0;
+}
+
+// A data file name inside the data directory; absolute names are left alone
+const char *dataPath(const BackendState *state, const char *name, char path[max_data_path]) {
+    int absolute = name[0] == '/' || name[0] == '\\' || (name[0] && name[1] == ':');
+    snprintf(path, max_data_path, "%s%s", absolute ? "" : state->dataDirectory, name);
+    return path;
+}
+
+ScoreSketchStore *getScoreSketchStore(BackendState *state) {
+    char path[max_data_path];
+    if (!state->sketchesOpen) {
+        state->sketchesOpen = openScoreSketchStore(&state->sketches, dataPath(state, SCORE_SKETCH_PATH, path)) == 0;
+    }
+    return state->sketchesOpen ? &state->sketches : NULL;
+}
+
+ProgressStore *getProgressStore(BackendState *state) {
+    char path[max_data_path];
+    if (!state->progressOpen) {
+        state->progressOpen = openProgressStore(&state->progress, dataPath(state, PROGRESS_STORE_PATH, path)) == 0;
+    }
+    return state->progressOpen ? &state->progress : NULL;
+}
+
+ProfileStore *getProfileStore(BackendState *state) {
+    char path[max_data_path];
+    if (!state->profilesOpen) {
+        state->profilesOpen = openProfileStore(&state->profiles, dataPath(state, PROFILE_STORE_PATH, path)) == 0;
+    }
+    return state->profilesOpen ? &state->profiles : NULL;
+}
+
+void freeBackendState(BackendState *state) {
+    for (int i = 0; i < state->sectionCount; i++) {
+        freeParagraphCache(&state->sections[i].cache);
+    }
+    state->sectionCount = 0;
+    if (state->compiledOpen) {
+        closeCompiledCorpus(&state->compiled);
+        state->compiledOpen = 0;
+    }
+    if (state->profilesOpen) {
+        closeProfileStore(&state->profiles);
+        state->profilesOpen = 0;
+    }
+    if (state->sketchesOpen) {
+        closeScoreSketchStore(&state->sketches);
+        state->sketchesOpen = 0;
+    }
+    if (state->progressOpen) {
+        closeProgressStore(&state->progress);
+        state->progressOpen = 0;
+    }
+    if (state->leaderboardLoaded) {
+        freeLeaderboardStore(&state->leaderboard);
+        state->leaderboardLoaded = 0;
+    }
+    if (state->journalOpen) {
+        closeLeaderboardJournal(&state->journal);
+        state->journalOpen = 0;
+    }
+}
+
+// argv as left by parseQueryOptions()
+int dispatchQuery(BackendState *state, int argc, char *argv[], const QueryOptions *options, ReplyBuffer *reply) {
+    if ((argc == 3 || argc == 4) && strcmp(argv[1], "--get-paragraph") == 0) {
+        return handleGetParagraph(state, argv[2], argc == 4 ? argv[3] : NULL, options, reply);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--get-drill") == 0) {
+        if (argc != 4 && argc != 5) {
+            replyPrintf(reply, "Usage: %s --get-drill <difficulty> <gram,gram,...> [count]\n", argv[0]);
+            return 1;
+        }
+        return handleGetDrill(state, argc, argv, options, reply);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--get-leaderboard") == 0) {
+        return handleGetLeaderboard(state, argc, argv, options, reply);
+    }
+    if (argc == 2 && strcmp(argv[1], "--list-profiles") == 0) {
+        return handleListProfiles(state, options, reply);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--get-progress") == 0) {
+        if (argc != 5 && argc != 6) {
+            replyPrintf(reply, "Usage: %s --get-progress <username> <from> <to> [attempts|daily|weekly]\n", argv[0]);
+            return 1;
+        }
+        return handleGetProgress(state, argc, argv, options, reply);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--get-percentiles") == 0) {
+        if (argc != 3 && argc != 6) {
+            replyPrintf(reply, "Usage: %s --get-percentiles <difficulty> [cpm wpm accuracy]\n", argv[0]);
+            return 1;
+        }
+        return handleGetPercentiles(state, argc, argv, options, reply);
+    }
+    if (argc >= 2 && argc <= 4 && strcmp(argv[1], "--compile-corpus") == 0) {
+        return handleCompileCorpus(state, argc, argv, reply);
+    }
+    if (argc == 3 && strcmp(argv[1], "--score-batch") == 0 && strcmp(argv[2], "-") != 0) {
+        char path[max_data_path];
+        FILE *in = fopen(dataPath(state, argv[2], path), "r");
+        if (!in) {
+            replyPrintf(reply, "Error: Could not open %s\n", argv[2]);
+            return 1;
+        }
+        int status = handleScoreBatch(state, in, reply);
+        fclose(in);
+        return status;
+    }
+    if (argc >= 2 && strcmp(argv[1], "--score-stream") == 0) {
+        if (argc != 8 || strcmp(argv[7], "-") == 0) {
+            replyPrintf(reply, "Usage: %s --score-stream <username> <difficulty> <caseInsensitive> <elapsedTime> <paragraphFile> <inputFile>\n", argv[0]);
+            return 1;
+        }
+        char path[max_data_path];
+        FILE *in = fopen(dataPath(state, argv[7], path), "rb");
+        if (!in) {
+            replyPrintf(reply, "Error: Could not open %s\n", argv[7]);
+            return 1;
+        }
+        int status = handleScoreStream(state, argv, in, options, reply);
+        fclose(in);
+        return status;
+    }
+    return handleSubmission(state, argc, argv, options, reply);
+}
+
+int dispatchCommand(BackendState *state, int argc, char *argv[], ReplyBuffer *reply) {
+    QueryOptions options;
+    if (parseQueryOptions(&argc, argv, &options, reply) != 0) return 1;
+    return dispatchQuery(state, argc, argv, &options, reply);
+}
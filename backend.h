@@ -0,0 +1,260 @@
+#ifndef BACKEND_H
+#define BACKEND_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "corpus.h"
+#include "keystroke_log.h"
+#include "leaderboard_journal.h"
+#include "leaderboard_store.h"
+#include "profile_store.h"
+#include "progress_store.h"
+#include "score_sketch.h"
+#include "scoring.h"
+#include "write_behind.h"
+
+// The backend shared by typingtutor.exe, libtypingtutor and the benchmarks:
+//
+//   backend_corpus.c       paragraphs.txt/paragraphs.bin sections, shuffles, drills
+//   backend_scoring.c      typing stats, submissions, --score-batch, --score-stream
+//   backend_leaderboard.c  the in-memory leaderboard over the journal, and its queries
+//   backend_profiles.c     profiles, keystroke timing, progress history, percentiles
+//   backend.c              replies, --format records, the stores and command dispatch
+//
+// Data files are opened inside the state's data directory, which is the
+// working directory unless setDataDirectory() names another one.
+
+#define max_corpus_sections 8
+#define max_serve_args 16
+#define journal_compact_bytes (64 * 1024)
+#define max_batch_chunk 4096
+#define stream_chunk_size (64 * 1024)
+#define max_drill_matches 20
+#define max_pending_attempts 16
+#define leaderboard_page_size 10
+#define max_data_path 320
+
+#define EASY_SPEED 5
+#define EASY_MEDIUM_SPEED 8
+#define MEDIUM_HARD_SPEED 12
+#define HARD_SPEED 12
+#define HARD_MAX_SPEED 16
+
+#define CHECK_FILE_OP(f, msg) do { if (!(f)) { perror(msg); exit(EXIT_FAILURE); } } while (0)
+
+
+typedef struct {
+    char username[50];
+    double bestSpeed;
+    double bestAccuracy;
+    double totalSpeed;
+    double totalAccuracy;
+    int totalAttempts;
+} UserProfile;
+
+typedef struct {
+    int easy;
+    int medium;
+    int hard;
+} Difficulty;
+
+typedef struct {
+    double typingSpeed;   
+    double wordsPerMinute; 
+    double accuracy;
+    int wrongChars;
+    size_t paragraphLength;
+    int caseInsensitive;
+} TypingStats;
+
+// The text of one load of paragraphs, every paragraph NUL-terminated back to
+// back. Counted, so that a --listen session can finish typing one after a
+// reload has replaced the cache it came from.
+typedef struct {
+    char *text;
+    size_t length;
+    size_t capacity;
+    int references;
+} ParagraphArena;
+
+// A paragraph as its place in the arena; its index in the cache is its id
+typedef struct {
+    size_t offset;
+    size_t length;
+} ParagraphView;
+
+typedef struct {
+    ParagraphArena *arena;
+    ParagraphView *views;
+    int count;
+} ParagraphCache;
+
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+} ReplyBuffer;
+
+typedef enum {
+    OUTPUT_TEXT,
+    OUTPUT_JSON,                    // one compact JSON object per line
+    OUTPUT_BINARY                   // length-prefixed records of typed fields
+} OutputFormat;
+
+// --format, --offset, --limit and --fields, taken out of a command's
+// arguments before it is dispatched
+typedef struct {
+    OutputFormat format;
+    size_t offset;                  // rows of a list to skip
+    size_t limit;                   // SIZE_MAX when not given
+    char fields[256];               // ",cpm,wpm," or empty for every field
+} QueryOptions;
+
+// One record of --format json or binary output, built in place in the reply
+typedef struct {
+    const QueryOptions *options;
+    ReplyBuffer *reply;
+    size_t start;
+    int fieldCount;
+    int selectable;                 // whether --fields applies
+} OutputRecord;
+
+typedef struct {
+    char difficulty[20];
+    ParagraphCache cache;
+    time_t loadedMtime;
+} CorpusSection;
+
+// Everything a command needs between requests. One-shot invocations fill it
+// lazily and throw it away; --serve keeps it for the life of the process.
+typedef struct {
+    CorpusSection sections[max_corpus_sections];
+    int sectionCount;
+    CompiledCorpus compiled;
+    int compiledOpen;
+    time_t compiledMtime;
+    CompiledCorpus embedded;
+    LeaderboardStore leaderboard;
+    int leaderboardLoaded;
+    LeaderboardJournal journal;
+    int journalOpen;
+    ProfileStore profiles;
+    int profilesOpen;
+    ScoreSketchStore sketches;
+    int sketchesOpen;
+    ProgressStore progress;
+    int progressOpen;
+    char dataDirectory[200];        // "" or a prefix ending in a separator
+} BackendState;
+
+
+// One finished interactive attempt, waiting for the write-behind thread
+typedef struct {
+    char username[50];              // sanitized profile name
+    char difficulty[20];
+    TypingStats stats;
+    int hasKeystrokes;
+    KeystrokeSummary keystrokes;
+} PendingAttempt;
+
+extern const QueryOptions textQueryOptions;
+
+// backend_corpus.c
+long readTextLine(FILE *in, char **buf, size_t *capacity);
+void loadParagraphs(FILE *file, ParagraphCache *cache);
+void loadEmbeddedParagraphs(ParagraphCache *cache);
+void loadParagraphsForDifficulty(FILE *file, ParagraphCache *cache, const char *difficultyLevel);
+void freeParagraphCache(ParagraphCache *cache);
+void releaseParagraphArena(ParagraphArena *arena);
+const char *paragraphText(const ParagraphCache *cache, int id);
+int randomParagraphId(const ParagraphCache *cache);
+int shuffledParagraphId(BackendState *state, const ParagraphCache *cache, const char *username, const char *section);
+char *getRandomParagraph(ParagraphCache *cache);
+char *getShuffledParagraph(BackendState *state, ParagraphCache *cache, const char *username, const char *section);
+unsigned long randomIndex(unsigned long count);
+ParagraphCache *getCorpusSection(BackendState *state, const char *difficultyLevel);
+CompiledCorpus *getCompiledCorpus(BackendState *state);
+int handleGetParagraph(BackendState *state, const char *difficultyLevel, const char *username,
+                       const QueryOptions *options, ReplyBuffer *reply);
+int handleGetDrill(BackendState *state, int argc, char *argv[], const QueryOptions *options, ReplyBuffer *reply);
+int handleCompileCorpus(BackendState *state, int argc, char *argv[], ReplyBuffer *reply);
+
+// backend_scoring.c
+void printTypingStats(double elapsedTime, const char *input, const char *correctText, Difficulty difficulty, TypingStats *stats);
+void computeTypingStats(ScoreWorkspace *workspace, double elapsedTime, const char *input, const char *correctText, TypingStats *stats);
+void fillTypingStats(double elapsedTime, size_t distance, size_t inputLength, size_t paragraphLength, TypingStats *stats);
+int levenshtein(const char *s1, const char *s2, int caseInsensitive);
+void formatEditBreakdown(ReplyBuffer *reply, const EditScript *script, int withScript);
+Difficulty difficultyForLevel(const char *difficultyLevel);
+void formatSubmission(ReplyBuffer *reply, const char *difficultyLevel, const TypingStats *stats,
+                      const EditScript *edits);
+void formatPercentile(BackendState *state, const char *difficultyLevel, const TypingStats *stats,
+                      ReplyBuffer *reply);
+void recordSubmission(BackendState *state, const char *username, const char *difficultyLevel,
+                      TypingStats *stats, const EditScript *edits, const QueryOptions *options, ReplyBuffer *reply);
+int handleSubmission(BackendState *state, int argc, char *argv[], const QueryOptions *options, ReplyBuffer *reply);
+int handleScoreBatch(BackendState *state, FILE *in, ReplyBuffer *reply);
+int handleScoreStream(BackendState *state, char *argv[], FILE *in, const QueryOptions *options, ReplyBuffer *reply);
+
+// backend_leaderboard.c
+void updateLeaderboard(BackendState *state, UserProfile *profile, TypingStats *currentAttempt, const char *difficulty);
+void formatLeaderboard(ReplyBuffer *reply, const LeaderboardStore *store, const char *difficulty, size_t offset,
+                       size_t count);
+void displayLeaderboard(BackendState *state, const char *difficulty);
+void refreshLeaderboard(BackendState *state);
+void compactLeaderboardIfNeeded(BackendState *state);
+int handleGetLeaderboard(BackendState *state, int argc, char *argv[], const QueryOptions *options,
+                         ReplyBuffer *reply);
+
+// backend_profiles.c
+void sanitizeUsername(char *username, size_t size);
+void profileName(const char *username, char *name, size_t size);
+void loadUserProfile(BackendState *state, UserProfile *profile);
+void readUserProfile(BackendState *state, UserProfile *profile);
+void updateUserProfile(BackendState *state, UserProfile *profile, TypingStats *currentAttempt);
+void recordProfileAttempt(UserProfile *profile, const TypingStats *currentAttempt);
+ProfileRecord *claimProfileRecord(ProfileStore *store, const char *username);
+void copyProfileRecord(UserProfile *profile, const ProfileRecord *record);
+void storeProfileRecord(ProfileRecord *record, const UserProfile *profile);
+void addRecordKeystrokes(const ProfileStore *store, ProfileRecord *record, const KeystrokeSummary *summary);
+uint64_t nextShuffledIndex(BackendState *state, const char *username, const char *section, uint64_t count);
+void saveKeystrokeSummary(BackendState *state, const char *username, const KeystrokeSummary *summary);
+void recordProgress(BackendState *state, const char *username, const char *difficultyLevel,
+                    const TypingStats *currentAttempt);
+int progressDifficulty(const char *difficultyLevel);
+void fillProgressSample(ProgressSample *sample, const char *difficultyLevel, const TypingStats *currentAttempt);
+void sketchValues(const TypingStats *currentAttempt, double values[SCORE_SKETCH_METRICS]);
+void recordScoreSketches(BackendState *state, const char *difficultyLevel, const TypingStats *currentAttempt);
+int handleListProfiles(BackendState *state, const QueryOptions *options, ReplyBuffer *reply);
+int handleGetProgress(BackendState *state, int argc, char *argv[], const QueryOptions *options, ReplyBuffer *reply);
+int handleGetPercentiles(BackendState *state, int argc, char *argv[], const QueryOptions *options,
+                         ReplyBuffer *reply);
+
+// backend.c
+void replyPrintf(ReplyBuffer *reply, const char *format, ...);
+void freeReplyBuffer(ReplyBuffer *reply);
+void replyAppend(ReplyBuffer *reply, const void *data, size_t length);
+int parseQueryOptions(int *argc, char *argv[], QueryOptions *options, ReplyBuffer *reply);
+size_t pageEnd(const QueryOptions *options, size_t total);
+void beginRecord(OutputRecord *record, const QueryOptions *options, ReplyBuffer *reply, int selectable);
+void endRecord(OutputRecord *record);
+void recordString(OutputRecord *record, const char *name, const char *value);
+void recordDecimal(OutputRecord *record, const char *name, double value, int decimals);
+void recordNumber(OutputRecord *record, const char *name, double value);
+void recordInteger(OutputRecord *record, const char *name, long long value);
+int setDataDirectory(BackendState *state, const char *directory);
+const char *dataPath(const BackendState *state, const char *name, char path[max_data_path]);
+ProfileStore *getProfileStore(BackendState *state);
+ScoreSketchStore *getScoreSketchStore(BackendState *state);
+ProgressStore *getProgressStore(BackendState *state);
+void freeBackendState(BackendState *state);
+// Write-behind commit of PendingAttempts; context is the BackendState
+void commitPendingAttempts(void *context, const void *items, size_t count, WriteBehindDurability durability);
+int dispatchQuery(BackendState *state, int argc, char *argv[], const QueryOptions *options, ReplyBuffer *reply);
+int dispatchCommand(BackendState *state, int argc, char *argv[], ReplyBuffer *reply);
+
+#endif
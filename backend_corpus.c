@@ -0,0 +1,346 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <limits.h>
+#include <sys/stat.h>
+
+#include "backend.h"
+
+// Generated by embed_corpus.c from build/paragraphs.txt
+#include "paragraphs.h"
+
+// Read one line of any length into *buf, growing it as needed; returns its
+// length without the line ending, or -1 at end of input.
+long readTextLine(FILE *in, char **buf, size_t *capacity) {
+    size_t length = 0;
+    int gotData = 0;
+    for (;;) {
+        if (*capacity - length < 2) {
+            *capacity = *capacity ? *capacity * 2 : 512;
+            *buf = realloc(*buf, *capacity);
+            CHECK_FILE_OP(*buf, "Memory allocation error for line buffer");
+        }
+        size_t room = *capacity - length;
+        if (!fgets(*buf + length, room > INT_MAX ? INT_MAX : (int)room, in)) break;
+        gotData = 1;
+        length += strlen(*buf + length);
+        if (length > 0 && (*buf)[length - 1] == '\n') {
+            length--;
+            break;
+        }
+    }
+    if (!gotData) return -1;
+    if (length > 0 && (*buf)[length - 1] == '\r') length--;
+    (*buf)[length] = '\0';
+    return (long)length;
+}
+
+static void initParagraphCache(ParagraphCache *cache) {
+    cache->arena = calloc(1, sizeof(ParagraphArena));
+    CHECK_FILE_OP(cache->arena, "Memory allocation error for paragraph cache");
+    cache->arena->references = 1;
+    cache->views = NULL;
+    cache->count = 0;
+}
+
+// Both arrays grow geometrically, so a corpus of any size loads with a
+// handful of allocations. Views hold offsets, which survive the moves.
+static void addParagraph(ParagraphCache *cache, size_t *viewCapacity, const char *text, size_t length) {
+    ParagraphArena *arena = cache->arena;
+    if (arena->length + length + 1 > arena->capacity) {
+        size_t capacity = arena->capacity ? arena->capacity : 4096;
+        while (capacity < arena->length + length + 1) capacity *= 2;
+        arena->text = realloc(arena->text, capacity);
+        CHECK_FILE_OP(arena->text, "Memory allocation error for paragraph text");
+        arena->capacity = capacity;
+    }
+    if ((size_t)cache->count == *viewCapacity) {
+        *viewCapacity = *viewCapacity ? *viewCapacity * 2 : 64;
+        cache->views = realloc(cache->views, *viewCapacity * sizeof(ParagraphView));
+        CHECK_FILE_OP(cache->views, "Memory allocation error for paragraph cache");
+    }
+    memcpy(arena->text + arena->length, text, length);
+    arena->text[arena->length + length] = '\0';
+    cache->views[cache->count].offset = arena->length;
+    cache->views[cache->count].length = length;
+    cache->count++;
+    arena->length += length + 1;
+}
+
+// The paragraphs under the "#<difficultyLevel>" marker, or of every section
+// when difficultyLevel is NULL; marker lines are never paragraphs
+static void loadParagraphSection(FILE *file, ParagraphCache *cache, const char *difficultyLevel) {
+    char *line = NULL;
+    size_t lineCapacity = 0, viewCapacity = 0;
+    long length;
+    int inSection = difficultyLevel == NULL;
+    char marker[16];
+    if (difficultyLevel) snprintf(marker, sizeof(marker), "#%s", difficultyLevel);
+
+    initParagraphCache(cache);
+    while ((length = readTextLine(file, &line, &lineCapacity)) >= 0) {
+        if (line[0] == '#') {
+            if (difficultyLevel) inSection = (strcasecmp(line, marker) == 0);
+            continue;
+        }
+        if (inSection && length > 0) addParagraph(cache, &viewCapacity, line, (size_t)length);
+    }
+    free(line);
+}
+
+void loadParagraphs(FILE *file, ParagraphCache *cache) {
+    loadParagraphSection(file, cache, NULL);
+}
+
+// Every paragraph compiled into the binary, for when there is no paragraphs.txt
+void loadEmbeddedParagraphs(ParagraphCache *cache) {
+    CompiledCorpus corpus;
+    openEmbeddedCorpus(&corpus, &embedded_corpus);
+    size_t viewCapacity = 0;
+    initParagraphCache(cache);
+    for (uint64_t i = 0; i < corpus.header->paragraphCount; i++) {
+        uint32_t length;
+        const char *para = getCorpusParagraph(&corpus, i, &length);
+        if (para) addParagraph(cache, &viewCapacity, para, length);
+    }
+}
+
+// Load paragraphs for specific difficulty into cache
+void loadParagraphsForDifficulty(FILE *file, ParagraphCache *cache, const char *difficultyLevel)
+{
+    loadParagraphSection(file, cache, difficultyLevel);
+}
+
+void releaseParagraphArena(ParagraphArena *arena) {
+    if (!arena || --arena->references > 0) return;
+    free(arena->text);
+    free(arena);
+}
+
+void freeParagraphCache(ParagraphCache *cache) {
+    releaseParagraphArena(cache->arena);
+    free(cache->views);
+    cache->arena = NULL;
+    cache->views = NULL;
+    cache->count = 0;
+}
+
+const char *paragraphText(const ParagraphCache *cache, int id) {
+    return cache->arena->text + cache->views[id].offset;
+}
+
+int randomParagraphId(const ParagraphCache *cache) {
+    if (cache->count == 0) {
+        fprintf(stderr, "Error: No paragraphs available.\n");
+        exit(EXIT_FAILURE);
+    }
+    return (int)randomIndex(cache->count);
+}
+
+// The next paragraph of this user's no-repeat pass over the cache
+int shuffledParagraphId(BackendState *state, const ParagraphCache *cache, const char *username, const char *section) {
+    if (cache->count == 0) {
+        fprintf(stderr, "Error: No paragraphs available.\n");
+        exit(EXIT_FAILURE);
+    }
+    return (int)nextShuffledIndex(state, username, section, (uint64_t)cache->count);
+}
+
+char *getRandomParagraph(ParagraphCache *cache) {
+    return (char *)paragraphText(cache, randomParagraphId(cache));
+}
+
+char *getShuffledParagraph(BackendState *state, ParagraphCache *cache, const char *username, const char *section) {
+    return (char *)paragraphText(cache, shuffledParagraphId(state, cache, username, section));
+}
+
+// rand() only guarantees 15 bits (RAND_MAX is 32767 on Windows), which is not
+// enough to reach every paragraph of a large corpus
+unsigned long randomIndex(unsigned long count) {
+    unsigned long value = ((unsigned long)rand() << 30) ^ ((unsigned long)rand() << 15) ^ (unsigned long)rand();
+    return value % count;
+}
+
+// Paragraphs for one difficulty, reloaded only when paragraphs.txt changes
+ParagraphCache *getCorpusSection(BackendState *state, const char *difficultyLevel) {
+    struct stat info;
+    char textPath[max_data_path];
+    if (stat(dataPath(state, "paragraphs.txt", textPath), &info) != 0) return NULL;
+
+    CorpusSection *section = NULL;
+    for (int i = 0; i < state->sectionCount; i++) {
+        if (strcasecmp(state->sections[i].difficulty, difficultyLevel) == 0) {
+            section = &state->sections[i];
+            break;
+        }
+    }
+    if (section && section->loadedMtime == info.st_mtime) return &section->cache;
+
+    if (!section) {
+        if (state->sectionCount >= max_corpus_sections) return NULL;
+        section = &state->sections[state->sectionCount++];
+        strncpy(section->difficulty, difficultyLevel, sizeof(section->difficulty) - 1);
+        section->difficulty[sizeof(section->difficulty) - 1] = '\0';
+    } else {
+        freeParagraphCache(&section->cache);
+    }
+
+    FILE *file = fopen(textPath, "r");
+    if (!file) {
+        section->cache.count = 0;
+        return NULL;
+    }
+    loadParagraphsForDifficulty(file, &section->cache, section->difficulty);
+    fclose(file);
+    section->loadedMtime = info.st_mtime;
+    return &section->cache;
+}
+
+// Mapped paragraphs.bin, used only while it is at least as new as paragraphs.txt.
+// With neither file the corpus compiled into the binary is served, so a
+// read-only or empty working directory needs no corpus files at all.
+CompiledCorpus *getCompiledCorpus(BackendState *state) {
+    struct stat binaryInfo, textInfo;
+    char textPath[max_data_path], binaryPath[max_data_path];
+    int haveText = stat(dataPath(state, "paragraphs.txt", textPath), &textInfo) == 0;
+    if (stat(dataPath(state, "paragraphs.bin", binaryPath), &binaryInfo) != 0) {
+        if (haveText) return NULL;
+        openEmbeddedCorpus(&state->embedded, &embedded_corpus);
+        return &state->embedded;
+    }
+    if (haveText && textInfo.st_mtime > binaryInfo.st_mtime) return NULL;
+
+    if (state->compiledOpen && state->compiledMtime == binaryInfo.st_mtime) return &state->compiled;
+    if (state->compiledOpen) {
+        closeCompiledCorpus(&state->compiled);
+        state->compiledOpen = 0;
+    }
+    if (openCompiledCorpus(&state->compiled, binaryPath) != 0) return NULL;
+    state->compiledOpen = 1;
+    state->compiledMtime = binaryInfo.st_mtime;
+    return &state->compiled;
+}
+
+static void replyParagraph(const char *difficultyLevel, const char *para, const QueryOptions *options,
+                           ReplyBuffer *reply) {
+    if (options->format == OUTPUT_TEXT) {
+        replyPrintf(reply, "Random Paragraph:\n%s\n", para);
+        return;
+    }
+    OutputRecord record;
+    beginRecord(&record, options, reply, 1);
+    recordString(&record, "difficulty", difficultyLevel);
+    recordString(&record, "paragraph", para);
+    endRecord(&record);
+}
+
+// With a username the paragraph comes from that user's no-repeat shuffle
+int handleGetParagraph(BackendState *state, const char *difficultyLevel, const char *username,
+                       const QueryOptions *options, ReplyBuffer *reply) {
+    CompiledCorpus *compiled = getCompiledCorpus(state);
+    if (compiled) {
+        const CorpusSectionRecord *section = findCorpusSection(compiled, difficultyLevel);
+        if (!section || section->entryCount == 0) {
+            replyPrintf(reply, "No paragraphs found for difficulty: %s\n", difficultyLevel);
+            return 1;
+        }
+        uint64_t offset = username ? nextShuffledIndex(state, username, difficultyLevel, section->entryCount)
+                                   : randomIndex(section->entryCount);
+        const char *para = getCorpusParagraph(compiled, section->firstEntry + offset, NULL);
+        if (para) {
+            replyParagraph(difficultyLevel, para, options, reply);
+            return 0;
+        }
+    }
+
+    ParagraphCache *cache = getCorpusSection(state, difficultyLevel);
+    if (!cache) {
+        replyPrintf(reply, "Error: Could not open paragraphs.txt\n");
+        return 1;
+    }
+    if (cache->count == 0) {
+        replyPrintf(reply, "No paragraphs found for difficulty: %s\n", difficultyLevel);
+        return 1;
+    }
+    replyParagraph(difficultyLevel,
+                   username ? getShuffledParagraph(state, cache, username, difficultyLevel) : getRandomParagraph(cache),
+                   options, reply);
+    return 0;
+}
+
+// argv: --get-drill <difficulty> <gram,gram,...> [count]
+// The paragraphs richest in the given letter bigrams/trigrams, from the
+// n-gram index in paragraphs.bin
+int handleGetDrill(BackendState *state, int argc, char *argv[], const QueryOptions *options, ReplyBuffer *reply) {
+    const char *difficultyLevel = argv[2];
+    size_t count = argc >= 5 ? (size_t)strtoul(argv[4], NULL, 10) : 1;
+    if (count < 1) count = 1;
+    if (count > max_drill_matches) count = max_drill_matches;
+
+    int gramIds[CORPUS_MAX_QUERY_GRAMS];
+    size_t gramCount = 0;
+    char grams[256];
+    snprintf(grams, sizeof(grams), "%s", argv[3]);
+    for (char *gram = strtok(grams, ","); gram; gram = strtok(NULL, ",")) {
+        int id = corpusGramId(gram);
+        if (id < 0 || gramCount == CORPUS_MAX_QUERY_GRAMS) {
+            replyPrintf(reply, "Error: '%s' is not a two- or three-letter n-gram (at most %d of them)\n", gram,
+                        CORPUS_MAX_QUERY_GRAMS);
+            return 1;
+        }
+        gramIds[gramCount++] = id;
+    }
+    if (gramCount == 0) {
+        replyPrintf(reply, "Error: No n-grams given\n");
+        return 1;
+    }
+
+    CompiledCorpus *compiled = getCompiledCorpus(state);
+    if (!compiled) {
+        replyPrintf(reply, "Error: Drills need an up-to-date paragraphs.bin; run --compile-corpus first\n");
+        return 1;
+    }
+    const CorpusSectionRecord *section = findCorpusSection(compiled, difficultyLevel);
+    if (!section || section->entryCount == 0) {
+        replyPrintf(reply, "No paragraphs found for difficulty: %s\n", difficultyLevel);
+        return 1;
+    }
+    CorpusMatch matches[max_drill_matches];
+    size_t found = findGramRichParagraphs(compiled, section, gramIds, gramCount, matches, count);
+    if (found == 0) {
+        replyPrintf(reply, "No paragraphs contain %s\n", argv[3]);
+        return 1;
+    }
+    for (size_t i = 0; i < found; i++) {
+        const char *para = getCorpusParagraph(compiled, matches[i].paragraph, NULL);
+        if (!para) continue;
+        if (options->format == OUTPUT_TEXT) {
+            replyPrintf(reply, "Drill Paragraph (score %.4f):\n%s\n", matches[i].score, para);
+            continue;
+        }
+        OutputRecord record;
+        beginRecord(&record, options, reply, 1);
+        recordDecimal(&record, "score", matches[i].score, 4);
+        recordString(&record, "paragraph", para);
+        endRecord(&record);
+    }
+    return 0;
+}
+
+int handleCompileCorpus(BackendState *state, int argc, char *argv[], ReplyBuffer *reply) {
+    const char *textPath = (argc >= 3) ? argv[2] : "paragraphs.txt";
+    const char *binaryPath = (argc >= 4) ? argv[3] : "paragraphs.bin";
+    char textFile[max_data_path], binaryFile[max_data_path];
+    uint64_t paragraphCount;
+    uint32_t sectionCount;
+    if (compileCorpus(dataPath(state, textPath, textFile), dataPath(state, binaryPath, binaryFile),
+                      &paragraphCount, &sectionCount) != 0) {
+        replyPrintf(reply, "Error: Could not compile %s\n", textPath);
+        return 1;
+    }
+    replyPrintf(reply, "Compiled %llu paragraphs in %u sections into %s\n",
+                (unsigned long long)paragraphCount, sectionCount, binaryPath);
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/stat.h>
+
+#include "backend.h"
+
+// Generated by embed_corpus.c from build/leaderboard.txt
+#include "leaderboard.h"
+
+void updateLeaderboard(BackendState *state, UserProfile *profile, TypingStats *currentAttempt, const char *difficulty) {
+    LeaderboardEntry newEntry;
+    memset(&newEntry, 0, sizeof(newEntry));
+    strncpy(newEntry.username, profile->username, sizeof(newEntry.username) - 1);
+    newEntry.typingSpeed = currentAttempt->typingSpeed;
+    newEntry.wordsPerMinute = currentAttempt->wordsPerMinute;
+    newEntry.accuracy = currentAttempt->accuracy;
+    strncpy(newEntry.difficulty, difficulty, sizeof(newEntry.difficulty) - 1);
+
+    refreshLeaderboard(state);
+    if (!state->journalOpen || commitLeaderboardEntry(&state->journal, &newEntry) != 0) {
+        fprintf(stderr, "Error saving leaderboard entry for '%s'\n", newEntry.username);
+        return;
+    }
+    refreshLeaderboard(state);
+}
+
+// count entries from rank offset + 1; the walk starts with an O(log n) seek
+void formatLeaderboard(ReplyBuffer *reply, const LeaderboardStore *store, const char *difficulty, size_t offset,
+                       size_t count) {
+    replyPrintf(reply, "\nLeaderboard for %s Difficulty:\n", difficulty);
+    replyPrintf(reply, "-------------------------------------------------------------\n");
+    replyPrintf(reply, "| Rank | Username       | CPM    | WPM    | Accuracy (%%) |\n");
+    replyPrintf(reply, "-------------------------------------------------------------\n");
+
+    size_t rank = offset + 1;
+    for (const LeaderboardNode *node = leaderboardAt(store, difficulty, rank); node && rank <= offset + count;
+         node = leaderboardNext(node), rank++) {
+        replyPrintf(reply, "| %4zu | %-14s | %6.2f | %6.2f | %10.2f |\n",
+                    rank, node->entry.username,
+                    node->entry.typingSpeed, node->entry.wordsPerMinute,
+                    node->entry.accuracy);
+    }
+    if (rank == 1) {
+        replyPrintf(reply, "|      No entries for this difficulty level yet          |\n");
+    }
+    replyPrintf(reply, "-------------------------------------------------------------\n");
+}
+
+void displayLeaderboard(BackendState *state, const char *difficulty) {
+    ReplyBuffer reply = {0};
+    refreshLeaderboard(state);
+    formatLeaderboard(&reply, &state->leaderboard, difficulty, 0, leaderboard_page_size);
+    fwrite(reply.data, 1, reply.length, stdout);
+    freeReplyBuffer(&reply);
+}
+
+// Catch up with the shared snapshot and journal. Without a writable lock file
+// (read-only media) the snapshot is loaded once and never written, and with
+// no snapshot either the embedded seed leaderboard is shown.
+void refreshLeaderboard(BackendState *state) {
+    if (!state->leaderboardLoaded) {
+        initLeaderboardStore(&state->leaderboard);
+        state->leaderboardLoaded = 1;
+        state->journalOpen = openLeaderboardJournal(&state->journal, state->dataDirectory) == 0;
+        struct stat info;
+        char path[max_data_path];
+        if (!state->journalOpen && stat(dataPath(state, LEADERBOARD_SNAPSHOT_PATH, path), &info) == 0) {
+            replayLeaderboardFile(&state->leaderboard, path, 0);
+        } else if (!state->journalOpen) {
+            for (size_t i = 0; i < embedded_leaderboard_count; i++) {
+                recordLeaderboardEntry(&state->leaderboard, &embedded_leaderboard[i]);
+            }
+        }
+    }
+    if (state->journalOpen) refreshLeaderboardView(&state->journal, &state->leaderboard);
+}
+
+// Called once a reply is out, so folding the journal never delays a user
+void compactLeaderboardIfNeeded(BackendState *state) {
+    if (state->journalOpen) compactLeaderboardJournal(&state->journal, journal_compact_bytes);
+}
+
+// Rank of the caller's own entry, found from the scores it was shown
+// (echoed to two decimals, so only entries within rounding of userCPM are
+// candidates); 0 if it is not on the board
+static size_t findUserRank(const LeaderboardStore *store, const char *difficulty, const char *currentUser,
+                           double userCPM, double userWPM, double userAccuracy, const LeaderboardNode **found) {
+    size_t userRank = leaderboardRank(store, difficulty, userCPM + 0.005);
+    const LeaderboardNode *node = leaderboardAt(store, difficulty, userRank);
+    for (; node && node->entry.typingSpeed >= userCPM - 0.005; node = leaderboardNext(node), userRank++) {
+        const LeaderboardEntry *entry = &node->entry;
+        if (strcmp(entry->username, currentUser) == 0 && fabs(entry->wordsPerMinute - userWPM) <= 0.005 &&
+            fabs(entry->accuracy - userAccuracy) <= 0.005) {
+            *found = node;
+            return userRank;
+        }
+    }
+    return 0;
+}
+
+// argv: --get-leaderboard [difficulty [username cpm wpm accuracy]]
+// A page of the board, the top leaderboard_page_size entries unless --offset
+// or --limit say otherwise
+int handleGetLeaderboard(BackendState *state, int argc, char *argv[], const QueryOptions *options,
+                         ReplyBuffer *reply) {
+    const char *difficulty = (argc >= 3) ? argv[2] : "Easy";
+    const char *currentUser = (argc >= 4) ? argv[3] : NULL;
+    double userCPM = (argc >= 5) ? atof(argv[4]) : -1;
+    double userWPM = (argc >= 6) ? atof(argv[5]) : -1;
+    double userAccuracy = (argc >= 7) ? atof(argv[6]) : -1;
+    size_t limit = options->limit == SIZE_MAX ? leaderboard_page_size : options->limit;
+    if (limit > SIZE_MAX - options->offset) limit = SIZE_MAX - options->offset;
+
+    refreshLeaderboard(state);
+    const LeaderboardStore *store = &state->leaderboard;
+    const LeaderboardNode *node = NULL;
+    size_t userRank = 0;
+    if (currentUser && userCPM > 0 && userWPM > 0 && userAccuracy > 0) {
+        userRank = findUserRank(store, difficulty, currentUser, userCPM, userWPM, userAccuracy, &node);
+    }
+    size_t count = leaderboardCount(store, difficulty);
+
+    if (options->format != OUTPUT_TEXT) {
+        OutputRecord record;
+        beginRecord(&record, options, reply, 0);
+        recordString(&record, "difficulty", difficulty);
+        recordInteger(&record, "total", (long long)count);
+        recordInteger(&record, "offset", (long long)options->offset);
+        if (userRank) recordInteger(&record, "userRank", (long long)userRank);
+        endRecord(&record);
+
+        size_t rank = options->offset + 1;
+        for (const LeaderboardNode *row = leaderboardAt(store, difficulty, rank);
+             row && rank <= options->offset + limit; row = leaderboardNext(row), rank++) {
+            beginRecord(&record, options, reply, 1);
+            recordInteger(&record, "rank", (long long)rank);
+            recordString(&record, "username", row->entry.username);
+            recordNumber(&record, "cpm", row->entry.typingSpeed);
+            recordNumber(&record, "wpm", row->entry.wordsPerMinute);
+            recordNumber(&record, "accuracy", row->entry.accuracy);
+            endRecord(&record);
+        }
+        return 0;
+    }
+
+    formatLeaderboard(reply, store, difficulty, options->offset, limit);
+    if (node) {
+        if (userRank <= options->offset || userRank > options->offset + limit) {
+            // Off the page shown, so with the entries just above and below
+            replyPrintf(reply, "\nYour Result:\n");
+            for (size_t rank = userRank - 1; rank <= userRank + 1; rank++) {
+                const LeaderboardNode *row = rank == userRank ? node : leaderboardAt(store, difficulty, rank);
+                if (!row) continue;
+                replyPrintf(reply, "| %4zu | %-14s | %6.2f | %6.2f | %10.2f |\n",
+                            rank,
+                            row->entry.username,
+                            row->entry.typingSpeed,
+                            row->entry.wordsPerMinute,
+                            row->entry.accuracy);
+            }
+        }
+        replyPrintf(reply, "Rank %zu of %zu (top %.2f%%)\n", userRank, count, 100.0 * userRank / count);
+    }
+    return 0;
+}
@@ -0,0 +1,599 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <time.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+#include "backend.h"
+
+void sanitizeUsername(char *username, size_t size) {
+    for (size_t i = 0; i < strlen(username) && i < size - 1; i++) {
+        if (!isalnum(username[i]) && username[i] != '-' && username[i] != '_') {
+            username[i] = '_';
+        }
+    }
+    username[size - 1] = '\0';
+}
+
+void loadUserProfile(BackendState *state, UserProfile *profile) {
+    printf("Enter your username: ");
+    CHECK_FILE_OP(fgets(profile->username, sizeof(profile->username), stdin), "Error reading username");
+    profile->username[strcspn(profile->username, "\n")] = '\0';
+    if (strlen(profile->username) == 0) {
+        strcpy(profile->username, "default");
+    }
+    sanitizeUsername(profile->username, sizeof(profile->username));
+    readUserProfile(state, profile);
+}
+
+void copyProfileRecord(UserProfile *profile, const ProfileRecord *record) {
+    profile->bestSpeed = record->bestSpeed;
+    profile->bestAccuracy = record->bestAccuracy;
+    profile->totalSpeed = record->totalSpeed;
+    profile->totalAccuracy = record->totalAccuracy;
+    profile->totalAttempts = (int)record->totalAttempts;
+}
+
+void storeProfileRecord(ProfileRecord *record, const UserProfile *profile) {
+    record->bestSpeed = profile->bestSpeed;
+    record->bestAccuracy = profile->bestAccuracy;
+    record->totalSpeed = profile->totalSpeed;
+    record->totalAccuracy = profile->totalAccuracy;
+    record->totalAttempts = profile->totalAttempts;
+}
+
+static void legacyProfilePath(const ProfileStore *store, const char *username, char *path, size_t size) {
+    snprintf(path, size, "%s%s_profile.txt", store->directory, username);
+}
+
+// Older builds kept one <username>_profile.txt per user. The first time such
+// a user reaches the store, their totals move into the new record and the
+// file goes away.
+static void importLegacyProfile(const ProfileStore *store, ProfileRecord *record) {
+    char filename[320];
+    legacyProfilePath(store, record->username, filename, sizeof(filename));
+    FILE *f = fopen(filename, "r");
+    if (!f) return;
+    UserProfile legacy = {0};
+    if (fscanf(f, "%lf %lf %lf %lf %d", &legacy.bestSpeed, &legacy.bestAccuracy,
+               &legacy.totalSpeed, &legacy.totalAccuracy, &legacy.totalAttempts) == 5) {
+        storeProfileRecord(record, &legacy);
+        fclose(f);
+        remove(filename);
+        return;
+    }
+    fclose(f);
+}
+
+// Find or add the record for a sanitized name; needs the exclusive lock
+ProfileRecord *claimProfileRecord(ProfileStore *store, const char *username) {
+    ProfileRecord *record = findProfileRecord(store, username, 0);
+    if (record) return record;
+    record = findProfileRecord(store, username, 1);
+    if (record) importLegacyProfile(store, record);
+    return record;
+}
+
+// Fill in the stored totals for profile->username, or zero them for a new user
+void readUserProfile(BackendState *state, UserProfile *profile) {
+    profile->bestSpeed = profile->bestAccuracy = profile->totalSpeed = profile->totalAccuracy = 0;
+    profile->totalAttempts = 0;
+    ProfileStore *store = getProfileStore(state);
+    if (!store || lockProfileStore(store, 0) != 0) return;
+    const ProfileRecord *record = findProfileRecord(store, profile->username, 0);
+    if (record) copyProfileRecord(profile, record);
+    unlockProfileStore(store);
+
+    char filename[320];
+    struct stat info;
+    legacyProfilePath(store, profile->username, filename, sizeof(filename));
+    if (record || stat(filename, &info) != 0 || lockProfileStore(store, 1) != 0) return;
+    record = claimProfileRecord(store, profile->username);
+    if (record) copyProfileRecord(profile, record);
+    unlockProfileStore(store);
+}
+
+// Apply the attempt to the stored totals as one read-modify-write, so
+// concurrent backends never lose each other's attempts. *profile comes back
+// with the new totals.
+void updateUserProfile(BackendState *state, UserProfile *profile, TypingStats *currentAttempt) {
+    ProfileStore *store = getProfileStore(state);
+    if (!store || lockProfileStore(store, 1) != 0) {
+        recordProfileAttempt(profile, currentAttempt);
+        fprintf(stderr, "Error saving user profile for '%s'\n", profile->username);
+        return;
+    }
+    ProfileRecord *record = claimProfileRecord(store, profile->username);
+    if (record) copyProfileRecord(profile, record);
+    recordProfileAttempt(profile, currentAttempt);
+    if (record) {
+        storeProfileRecord(record, profile);
+    } else {
+        fprintf(stderr, "Error saving user profile for '%s'\n", profile->username);
+    }
+    unlockProfileStore(store);
+}
+
+// Older builds kept "<section> <count> <seed> <position>" lines in
+// <username>_shuffle.txt. The first time such a user shuffles, the positions
+// move into their record and the file goes away.
+static void importLegacyShuffle(const ProfileStore *store, ProfileRecord *record) {
+    char filename[320];
+    snprintf(filename, sizeof(filename), "%s%s_shuffle.txt", store->directory, record->username);
+    FILE *f = fopen(filename, "r");
+    if (!f) return;
+    ProfileShuffle *shuffle = record->shuffles;
+    unsigned long long count, seed, position;
+    char section[PROFILE_SECTION_LENGTH];
+    while (shuffle < record->shuffles + PROFILE_SHUFFLE_SECTIONS &&
+           fscanf(f, "%23s %llu %llu %llu", section, &count, &seed, &position) == 4) {
+        snprintf(shuffle->section, sizeof(shuffle->section), "%s", section);
+        shuffle->count = count;
+        shuffle->seed = seed;
+        shuffle->position = position;
+        shuffle++;
+    }
+    fclose(f);
+    remove(filename);
+}
+
+// Each user walks every section in a seeded order, so no paragraph repeats
+// until all of them have been seen. Only the seed and the position are kept,
+// in the user's profiles.db record, and advanced under the store lock so
+// concurrent backends never hand out the same position. A changed paragraph
+// count starts a fresh pass; so does a section that fell out of the record's
+// most recently used slots.
+uint64_t nextShuffledIndex(BackendState *state, const char *username, const char *section, uint64_t count) {
+    char name[50];
+    profileName(username, name, sizeof(name));
+    ProfileStore *store = getProfileStore(state);
+    if (!store || lockProfileStore(store, 1) != 0) {
+        fprintf(stderr, "Error saving shuffle position for '%s'\n", name);
+        return randomIndex(count);
+    }
+    ProfileRecord *record = claimProfileRecord(store, name);
+    if (!record) {
+        unlockProfileStore(store);
+        fprintf(stderr, "Error saving shuffle position for '%s'\n", name);
+        return randomIndex(count);
+    }
+
+    if (record->shuffles[0].section[0] == '\0') importLegacyShuffle(store, record);
+    int slot = PROFILE_SHUFFLE_SECTIONS - 1;
+    for (int i = 0; i < PROFILE_SHUFFLE_SECTIONS; i++) {
+        if (strncasecmp(record->shuffles[i].section, section, PROFILE_SECTION_LENGTH) == 0) {
+            slot = i;
+            break;
+        }
+    }
+    ProfileShuffle shuffle = record->shuffles[slot];
+    if (strncasecmp(shuffle.section, section, PROFILE_SECTION_LENGTH) != 0) {
+        memset(&shuffle, 0, sizeof(shuffle));
+        snprintf(shuffle.section, sizeof(shuffle.section), "%s", section);
+    }
+    if (shuffle.count != count || shuffle.position >= count) {
+        // Stepping the old seed keeps passes started within the same second
+        // (same srand() seed) from repeating the previous order
+        shuffle.count = count;
+        shuffle.seed = (shuffle.seed * 6364136223846793005ull + 1442695040888963407ull) ^
+                       ((uint64_t)rand() << 32) ^ ((uint64_t)rand() << 16) ^ (uint64_t)rand() ^
+                       (uint64_t)time(NULL);
+        shuffle.position = 0;
+    }
+    uint64_t index = shuffledCorpusIndex(shuffle.seed, shuffle.position++, count);
+
+    memmove(&record->shuffles[1], &record->shuffles[0], (size_t)slot * sizeof(ProfileShuffle));
+    record->shuffles[0] = shuffle;
+    unlockProfileStore(store);
+    return index;
+}
+
+void recordProfileAttempt(UserProfile *profile, const TypingStats *currentAttempt) {
+    if (currentAttempt->typingSpeed > profile->bestSpeed)
+        profile->bestSpeed = currentAttempt->typingSpeed;
+    if (currentAttempt->accuracy > profile->bestAccuracy)
+        profile->bestAccuracy = currentAttempt->accuracy;
+
+    profile->totalSpeed += currentAttempt->typingSpeed;
+    profile->totalAccuracy += currentAttempt->accuracy;
+    profile->totalAttempts++;
+}
+
+// Older builds appended one line per real-time attempt to
+// <username>_keystrokes.txt:
+//   <time> <keys> <errors> <backspaces> <durationMs> <medianMs> <p90Ms>
+//   hist <counts...> pauses <n> <ms> bursts <n> <meanLength> <cpm>
+//   keys <n> <code>:<count>:<meanMs>... bigrams <n> ...
+// The first time such a user's timing is saved, those lines are added to
+// the record's totals and the file goes away.
+static void importLegacyKeystrokes(const ProfileStore *store, ProfileRecord *record) {
+    char filename[320];
+    snprintf(filename, sizeof(filename), "%s%s_keystrokes.txt", store->directory, record->username);
+    FILE *f = fopen(filename, "r");
+    if (!f) return;
+    char *line = NULL;
+    size_t capacity = 0;
+    while (readTextLine(f, &line, &capacity) >= 0) {
+        KeystrokeSummary summary;
+        memset(&summary, 0, sizeof(summary));
+        long long timestamp;
+        double durationMs, medianMs, p90Ms, pauseMs;
+        int used;
+        const char *cursor = line;
+        if (sscanf(cursor, "%lld %u %u %u %lf %lf %lf hist%n", &timestamp, &summary.keystrokes, &summary.errors,
+                   &summary.backspaces, &durationMs, &medianMs, &p90Ms, &used) != 7) {
+            continue;
+        }
+        cursor += used;
+        int complete = 1;
+        for (int i = 0; i < KEYSTROKE_HISTOGRAM_BUCKETS && complete; i++) {
+            complete = sscanf(cursor, " %u%n", &summary.intervalHistogram[i], &used) == 1;
+            cursor += complete ? used : 0;
+        }
+        int keyCount = 0;
+        if (!complete || sscanf(cursor, " pauses %u %lf bursts %u %lf %lf keys %d%n", &summary.pauseCount, &pauseMs,
+                                &summary.burstCount, &summary.meanBurstLength, &summary.burstCpm, &keyCount,
+                                &used) != 6) {
+            continue;
+        }
+        cursor += used;
+        for (int i = 0; i < keyCount; i++) {
+            int code;
+            unsigned count;
+            double meanMs;
+            if (sscanf(cursor, " %d:%u:%lf%n", &code, &count, &meanMs, &used) != 3) break;
+            cursor += used;
+            if (code < ' ' || code - ' ' >= KEYSTROKE_PRINTABLE_KEYS) continue;
+            summary.keys[code - ' '].count = count;
+            summary.keys[code - ' '].totalNs = (uint64_t)(meanMs * 1e6 * count);
+        }
+        summary.durationNs = (uint64_t)(durationMs * 1e6);
+        summary.medianIntervalNs = (uint64_t)(medianMs * 1e6);
+        summary.p90IntervalNs = (uint64_t)(p90Ms * 1e6);
+        summary.pauseNs = (uint64_t)(pauseMs * 1e6);
+        addKeystrokeSummary(&record->keystrokes, &summary);
+    }
+    free(line);
+    fclose(f);
+    remove(filename);
+}
+
+void addRecordKeystrokes(const ProfileStore *store, ProfileRecord *record, const KeystrokeSummary *summary) {
+    if (record->keystrokes.attempts == 0) importLegacyKeystrokes(store, record);
+    addKeystrokeSummary(&record->keystrokes, summary);
+}
+
+// Fold the attempt's timing into the totals kept in the user's profile record
+void saveKeystrokeSummary(BackendState *state, const char *username, const KeystrokeSummary *summary) {
+    char name[50];
+    profileName(username, name, sizeof(name));
+    ProfileStore *store = getProfileStore(state);
+    ProfileRecord *record = NULL;
+    if (store && lockProfileStore(store, 1) == 0) {
+        record = claimProfileRecord(store, name);
+        if (record) addRecordKeystrokes(store, record, summary);
+        unlockProfileStore(store);
+    }
+    if (!record) fprintf(stderr, "Error saving keystroke timing for '%s'\n", name);
+}
+
+// The key profiles are stored under: sanitized, "default" when empty
+void profileName(const char *username, char *name, size_t size) {
+    strncpy(name, username, size - 1);
+    name[size - 1] = '\0';
+    if (strlen(name) == 0) strncpy(name, "default", size - 1);
+    sanitizeUsername(name, size);
+}
+
+// Append the attempt to the user's history in progress.db, behind --get-progress
+void recordProgress(BackendState *state, const char *username, const char *difficultyLevel,
+                    const TypingStats *currentAttempt) {
+    char name[50];
+    profileName(username, name, sizeof(name));
+
+    ProgressSample sample;
+    fillProgressSample(&sample, difficultyLevel, currentAttempt);
+
+    ProgressStore *store = getProgressStore(state);
+    if (!store || appendProgressSample(store, name, &sample) != 0) {
+        fprintf(stderr, "Error saving progress for '%s'\n", name);
+    }
+}
+
+void fillProgressSample(ProgressSample *sample, const char *difficultyLevel, const TypingStats *currentAttempt) {
+    memset(sample, 0, sizeof(*sample));
+    sample->timestamp = (int64_t)time(NULL);
+    sample->typingSpeed = (float)currentAttempt->typingSpeed;
+    sample->wordsPerMinute = (float)currentAttempt->wordsPerMinute;
+    sample->accuracy = (float)currentAttempt->accuracy;
+    sample->errors = currentAttempt->wrongChars > 0 ? (uint32_t)currentAttempt->wrongChars : 0;
+    sample->difficulty = (uint8_t)progressDifficulty(difficultyLevel);
+}
+
+int progressDifficulty(const char *difficultyLevel) {
+    if (strcasecmp(difficultyLevel, "Easy") == 0) return PROGRESS_EASY;
+    if (strcasecmp(difficultyLevel, "Medium") == 0) return PROGRESS_MEDIUM;
+    if (strcasecmp(difficultyLevel, "Hard") == 0) return PROGRESS_HARD;
+    return PROGRESS_OTHER;
+}
+
+void sketchValues(const TypingStats *currentAttempt, double values[SCORE_SKETCH_METRICS]) {
+    values[SCORE_SKETCH_CPM] = currentAttempt->typingSpeed;
+    values[SCORE_SKETCH_WPM] = currentAttempt->wordsPerMinute;
+    values[SCORE_SKETCH_ACCURACY] = currentAttempt->accuracy;
+}
+
+// Count the attempt in the per-difficulty distributions behind percentiles
+void recordScoreSketches(BackendState *state, const char *difficultyLevel, const TypingStats *currentAttempt) {
+    double values[SCORE_SKETCH_METRICS];
+    sketchValues(currentAttempt, values);
+    ScoreSketchStore *store = getScoreSketchStore(state);
+    if (!store || recordScoreSample(store, progressDifficulty(difficultyLevel), values) != 0) {
+        fprintf(stderr, "Error saving score distribution\n");
+    }
+}
+
+// Stored profiles (all of them unless --offset or --limit say otherwise) and
+// the totals across all of them, read straight from the record array instead
+// of a scan of the working directory
+int handleListProfiles(BackendState *state, const QueryOptions *options, ReplyBuffer *reply) {
+    ProfileStore *store = getProfileStore(state);
+    if (!store || lockProfileStore(store, 0) != 0) {
+        replyPrintf(reply, "Error: Could not open %s\n", PROFILE_STORE_PATH);
+        return 1;
+    }
+    size_t count = profileRecordCount(store);
+    size_t end = pageEnd(options, count);
+    long long attempts = 0;
+    double totalSpeed = 0, totalAccuracy = 0;
+    // The totals cover every profile whatever the page; summing them is far
+    // cheaper than formatting rows
+    for (size_t i = 0; i < count; i++) {
+        const ProfileRecord *record = profileRecordAt(store, i);
+        attempts += record->totalAttempts;
+        totalSpeed += record->totalSpeed;
+        totalAccuracy += record->totalAccuracy;
+    }
+    double averageSpeed = attempts ? totalSpeed / attempts : 0.0;
+    double averageAccuracy = attempts ? totalAccuracy / attempts : 0.0;
+
+    if (options->format != OUTPUT_TEXT) {
+        OutputRecord row;
+        beginRecord(&row, options, reply, 0);
+        recordInteger(&row, "total", (long long)count);
+        recordInteger(&row, "offset", (long long)options->offset);
+        recordInteger(&row, "attempts", attempts);
+        recordNumber(&row, "avgCpm", averageSpeed);
+        recordNumber(&row, "avgAccuracy", averageAccuracy);
+        endRecord(&row);
+        for (size_t i = options->offset; i < end; i++) {
+            const ProfileRecord *record = profileRecordAt(store, i);
+            double runs = record->totalAttempts > 0 ? (double)record->totalAttempts : 1;
+            beginRecord(&row, options, reply, 1);
+            recordString(&row, "username", record->username);
+            recordInteger(&row, "attempts", record->totalAttempts);
+            recordNumber(&row, "bestCpm", record->bestSpeed);
+            recordNumber(&row, "avgCpm", record->totalSpeed / runs);
+            recordNumber(&row, "bestAccuracy", record->bestAccuracy);
+            recordNumber(&row, "avgAccuracy", record->totalAccuracy / runs);
+            endRecord(&row);
+        }
+        unlockProfileStore(store);
+        return 0;
+    }
+
+    replyPrintf(reply, "\nProfiles (%zu users):\n", count);
+    replyPrintf(reply, "--------------------------------------------------------------------------\n");
+    replyPrintf(reply, "| Username       | Attempts | Best CPM | Avg CPM | Best Acc | Avg Acc  |\n");
+    replyPrintf(reply, "--------------------------------------------------------------------------\n");
+    for (size_t i = options->offset; i < end; i++) {
+        const ProfileRecord *record = profileRecordAt(store, i);
+        double runs = record->totalAttempts > 0 ? (double)record->totalAttempts : 1;
+        replyPrintf(reply, "| %-14s | %8lld | %8.2f | %7.2f | %7.2f%% | %7.2f%% |\n",
+                    record->username, (long long)record->totalAttempts, record->bestSpeed,
+                    record->totalSpeed / runs, record->bestAccuracy, record->totalAccuracy / runs);
+    }
+    unlockProfileStore(store);
+    replyPrintf(reply, "--------------------------------------------------------------------------\n");
+    replyPrintf(reply, "All users: %lld attempts, average CPM %.2f, average accuracy %.2f%%\n", attempts,
+                averageSpeed, averageAccuracy);
+    return 0;
+}
+
+// "YYYY-MM-DD" as local midnight, or the midnight after it for an inclusive
+// end date; "-" leaves that end of the range open
+static int parseProgressDate(const char *text, int endOfDay, int64_t *timestamp) {
+    if (strcmp(text, "-") == 0) {
+        *timestamp = endOfDay ? INT64_MAX : INT64_MIN;
+        return 0;
+    }
+    struct tm date;
+    char extra;
+    memset(&date, 0, sizeof(date));
+    if (sscanf(text, "%d-%d-%d%c", &date.tm_year, &date.tm_mon, &date.tm_mday, &extra) != 3 ||
+        date.tm_mon < 1 || date.tm_mon > 12 || date.tm_mday < 1 || date.tm_mday > 31) return -1;
+    date.tm_year -= 1900;
+    date.tm_mon -= 1;
+    if (endOfDay) date.tm_mday++;
+    date.tm_isdst = -1;
+    time_t when = mktime(&date);
+    if (when == (time_t)-1) return -1;
+    *timestamp = (int64_t)when;
+    return 0;
+}
+
+static void formatProgressTime(char *buffer, size_t size, int64_t timestamp, const char *format) {
+    time_t when = (time_t)timestamp;
+    struct tm *local = localtime(&when);
+    if (!local || strftime(buffer, size, format, local) == 0) snprintf(buffer, size, "%lld", (long long)timestamp);
+}
+
+// The CSV header line, or the header record of structured output
+static void formatProgressHeader(const char *name, const char *resolution, size_t total, const QueryOptions *options,
+                                 ReplyBuffer *reply) {
+    if (options->format == OUTPUT_TEXT) {
+        if (strcmp(resolution, "attempts") == 0) {
+            replyPrintf(reply, "time,cpm,wpm,accuracy,difficulty,errors\n");
+        } else {
+            replyPrintf(reply, "period,attempts,avgCpm,avgWpm,avgAccuracy,bestCpm,bestWpm,errors\n");
+        }
+        return;
+    }
+    OutputRecord record;
+    beginRecord(&record, options, reply, 0);
+    recordString(&record, "username", name);
+    recordString(&record, "resolution", resolution);
+    recordInteger(&record, "total", (long long)total);
+    recordInteger(&record, "offset", (long long)options->offset);
+    endRecord(&record);
+}
+
+// argv: --get-progress <username> <from> <to> [attempts|daily|weekly]
+// Replies with CSV: a column header line, then one row per attempt or per
+// period (or the records of --format json/binary; --offset/--limit pick
+// rows). Rollup ranges only read the precomputed day/week records.
+int handleGetProgress(BackendState *state, int argc, char *argv[], const QueryOptions *options, ReplyBuffer *reply) {
+    static const char *difficultyNames[] = {"Easy", "Medium", "Hard", "Other"};
+    const char *resolution = argc >= 6 ? argv[5] : "attempts";
+    int64_t from, to;
+    if (parseProgressDate(argv[3], 0, &from) != 0 || parseProgressDate(argv[4], 1, &to) != 0) {
+        replyPrintf(reply, "Error: Dates must be YYYY-MM-DD or -\n");
+        return 1;
+    }
+    int rollupsWanted = strcmp(resolution, "attempts") != 0;
+    ProgressPeriod period = strcmp(resolution, "weekly") == 0 ? PROGRESS_WEEKLY : PROGRESS_DAILY;
+    if (rollupsWanted && strcmp(resolution, "daily") != 0 && strcmp(resolution, "weekly") != 0) {
+        replyPrintf(reply, "Error: Resolution must be attempts, daily or weekly\n");
+        return 1;
+    }
+
+    char name[50], when[32];
+    profileName(argv[2], name, sizeof(name));
+    int structured = options->format != OUTPUT_TEXT;
+    OutputRecord record;
+
+    ProgressStore *store = getProgressStore(state);
+    if (!store) {
+        replyPrintf(reply, "Error: Could not open %s\n", PROGRESS_STORE_PATH);
+        return 1;
+    }
+    ProgressRollup *rollups = NULL;
+    ProgressSample *samples = NULL;
+    long count = rollupsWanted ? readProgressRollups(store, name, period, from, to, &rollups)
+                               : readProgressSamples(store, name, from, to, &samples);
+    if (count < 0 && errno == ENOENT) {
+        formatProgressHeader(name, resolution, 0, options, reply);
+        return 0;
+    }
+    size_t end = pageEnd(options, count > 0 ? (size_t)count : 0);
+
+    formatProgressHeader(name, resolution, count > 0 ? (size_t)count : 0, options, reply);
+    for (size_t i = options->offset; rollupsWanted && i < end; i++) {
+        const ProgressRollup *rollup = &rollups[i];
+        formatProgressTime(when, sizeof(when), rollup->periodStart, "%Y-%m-%d");
+        if (!structured) {
+            replyPrintf(reply, "%s,%u,%.2f,%.2f,%.2f,%.2f,%.2f,%u\n", when, rollup->attempts,
+                        rollup->totalSpeed / rollup->attempts, rollup->totalWordsPerMinute / rollup->attempts,
+                        rollup->totalAccuracy / rollup->attempts, rollup->bestSpeed,
+                        rollup->bestWordsPerMinute, rollup->errors);
+            continue;
+        }
+        beginRecord(&record, options, reply, 1);
+        recordString(&record, "period", when);
+        recordInteger(&record, "attempts", rollup->attempts);
+        recordNumber(&record, "avgCpm", rollup->totalSpeed / rollup->attempts);
+        recordNumber(&record, "avgWpm", rollup->totalWordsPerMinute / rollup->attempts);
+        recordNumber(&record, "avgAccuracy", rollup->totalAccuracy / rollup->attempts);
+        recordNumber(&record, "bestCpm", rollup->bestSpeed);
+        recordNumber(&record, "bestWpm", rollup->bestWordsPerMinute);
+        recordInteger(&record, "errors", rollup->errors);
+        endRecord(&record);
+    }
+    for (size_t i = options->offset; !rollupsWanted && i < end; i++) {
+        const ProgressSample *sample = &samples[i];
+        const char *difficulty = difficultyNames[sample->difficulty <= PROGRESS_OTHER ? sample->difficulty : PROGRESS_OTHER];
+        formatProgressTime(when, sizeof(when), sample->timestamp, "%Y-%m-%d %H:%M:%S");
+        if (!structured) {
+            replyPrintf(reply, "%s,%.2f,%.2f,%.2f,%s,%u\n", when, sample->typingSpeed, sample->wordsPerMinute,
+                        sample->accuracy, difficulty, sample->errors);
+            continue;
+        }
+        beginRecord(&record, options, reply, 1);
+        recordString(&record, "time", when);
+        recordInteger(&record, "timestamp", sample->timestamp);
+        recordNumber(&record, "cpm", sample->typingSpeed);
+        recordNumber(&record, "wpm", sample->wordsPerMinute);
+        recordNumber(&record, "accuracy", sample->accuracy);
+        recordString(&record, "difficulty", difficulty);
+        recordInteger(&record, "errors", sample->errors);
+        endRecord(&record);
+    }
+    free(rollups);
+    free(samples);
+    int status = count < 0;
+    if (status) replyPrintf(reply, "Error: Could not read progress for %s\n", name);
+    return status;
+}
+
+// argv: --get-percentiles <difficulty> [cpm wpm accuracy]
+// Quantiles of every attempt recorded at the difficulty, and where the given
+// scores would fall among them
+int handleGetPercentiles(BackendState *state, int argc, char *argv[], const QueryOptions *options,
+                         ReplyBuffer *reply) {
+    static const char *metricNames[] = {"CPM", "WPM", "Accuracy"};
+    static const char *quantileNames[] = {"p10", "p25", "p50", "p75", "p90", "p99"};
+    static const double quantiles[] = {0.10, 0.25, 0.50, 0.75, 0.90, 0.99};
+    int difficulty = progressDifficulty(argv[2]);
+    ScoreSketchStore *store = getScoreSketchStore(state);
+    ScoreSketch *sketch = malloc(sizeof(ScoreSketch));
+    CHECK_FILE_OP(sketch, "Memory allocation error for score sketch");
+
+    int status = 0;
+    OutputRecord record;
+    for (int m = 0; m < SCORE_SKETCH_METRICS; m++) {
+        if (!store || readScoreSketch(store, difficulty, m, sketch) != 0) {
+            replyPrintf(reply, "Error: Could not read score distributions\n");
+            status = 1;
+            break;
+        }
+        if (options->format != OUTPUT_TEXT) {
+            // A header record with the count, then one record per metric
+            if (m == 0) {
+                beginRecord(&record, options, reply, 0);
+                recordString(&record, "difficulty", argv[2]);
+                recordInteger(&record, "attempts", (long long)sketch->count);
+                endRecord(&record);
+            }
+            if (sketch->count == 0) break;
+            beginRecord(&record, options, reply, 1);
+            recordString(&record, "metric", metricNames[m]);
+            for (size_t q = 0; q < sizeof(quantiles) / sizeof(quantiles[0]); q++) {
+                recordNumber(&record, quantileNames[q], scoreSketchQuantile(sketch, m, quantiles[q]));
+            }
+            if (argc == 6) {
+                double value = atof(argv[3 + m]);
+                recordNumber(&record, "value", value);
+                recordDecimal(&record, "beats", 100.0 * scoreSketchShareBelow(sketch, m, value), 1);
+            }
+            endRecord(&record);
+            continue;
+        }
+        if (m == 0) replyPrintf(reply, "Attempts: %llu\n", (unsigned long long)sketch->count);
+        if (sketch->count == 0) break;
+        replyPrintf(reply, "%-9s", metricNames[m]);
+        for (size_t q = 0; q < sizeof(quantiles) / sizeof(quantiles[0]); q++) {
+            replyPrintf(reply, " p%02.0f %.2f", quantiles[q] * 100, scoreSketchQuantile(sketch, m, quantiles[q]));
+        }
+        replyPrintf(reply, "\n");
+        if (argc == 6) {
+            double value = atof(argv[3 + m]);
+            replyPrintf(reply, "  %.2f beats %.1f%% of attempts\n", value,
+                        100.0 * scoreSketchShareBelow(sketch, m, value));
+        }
+    }
+    free(sketch);
+    return status;
+}
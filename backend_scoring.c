@@ -0,0 +1,523 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+
+#include "backend.h"
+#include "thread_pool.h"
+
+// One line of a --score-batch stream; the strings point into the line
+typedef struct {
+    char *line;
+    long lineNumber;
+    const char *username;
+    const char *difficulty;
+    const char *input;
+    const char *paragraph;
+    int caseInsensitive;
+    double elapsedTime;
+    const char *error;          // why the line cannot be scored, or NULL
+    TypingStats stats;
+} BatchAttempt;
+
+// Shared scratch buffers for the bit-parallel scorer; grown once, then reused
+static ScoreWorkspace scoreWorkspace;
+
+static EditScript editScript;
+
+void printTypingStats(double elapsedTime, const char *input, const char *correctText, Difficulty difficulty, TypingStats *stats) {
+    computeTypingStats(&scoreWorkspace, elapsedTime, input, correctText, stats);
+}
+
+// Thread-safe as long as each thread passes its own workspace
+void computeTypingStats(ScoreWorkspace *workspace, double elapsedTime, const char *input, const char *correctText, TypingStats *stats) {
+    size_t inputLength = strlen(input), paragraphLength = strlen(correctText);
+    size_t dist = editDistance(workspace, correctText, paragraphLength, input, inputLength, stats->caseInsensitive);
+    fillTypingStats(elapsedTime, dist, inputLength, paragraphLength, stats);
+}
+
+// The numbers every scoring path reports, from the edit distance and lengths
+void fillTypingStats(double elapsedTime, size_t distance, size_t inputLength, size_t paragraphLength, TypingStats *stats) {
+    double len = (double)paragraphLength;
+    double accuracy = ((len - (double)distance) / len) * 100.0;
+    if (accuracy < 0) accuracy = 0;
+
+    if (elapsedTime < 0.01) elapsedTime = 0.01;
+
+    double cpm = (inputLength / elapsedTime) * 60.0;
+    double wpm = cpm / 5.0;
+
+    stats->typingSpeed = cpm;
+    stats->wordsPerMinute = wpm;
+    stats->accuracy = accuracy;
+    stats->wrongChars = (int)distance;
+    stats->paragraphLength = paragraphLength;
+}
+
+int levenshtein(const char *s1, const char *s2, int caseInsensitive) {
+    return (int)editDistance(&scoreWorkspace, s1, strlen(s1), s2, strlen(s2), caseInsensitive);
+}
+
+static void formatEditChar(ReplyBuffer *reply, unsigned char c) {
+    if (c >= 32 && c < 127 && c != '\'' && c != '\\') {
+        replyPrintf(reply, "'%c'", c);
+    } else {
+        replyPrintf(reply, "'\\x%02x'", c);
+    }
+}
+
+// Which mistakes were made: edit counts, the most frequent key confusions and,
+// with withScript set, every edit as kind+targetPos,typedPos:expected,typed
+// (character codes, 0 where the edit has no character on that side)
+void formatEditBreakdown(ReplyBuffer *reply, const EditScript *script, int withScript) {
+    Confusion confusions[10];
+    size_t count = topConfusions(script, confusions, sizeof(confusions) / sizeof(confusions[0]));
+
+    replyPrintf(reply, "Substitutions: %zu\n", script->substitutions);
+    replyPrintf(reply, "Extra Characters: %zu\n", script->insertions);
+    replyPrintf(reply, "Missed Characters: %zu\n", script->deletions);
+    replyPrintf(reply, "Confusions:");
+    for (size_t i = 0; i < count; i++) {
+        replyPrintf(reply, i ? ", " : " ");
+        formatEditChar(reply, confusions[i].expected);
+        replyPrintf(reply, " typed as ");
+        formatEditChar(reply, confusions[i].typed);
+        replyPrintf(reply, " x%u", (unsigned)confusions[i].count);
+    }
+    replyPrintf(reply, count ? "\n" : " none\n");
+
+    if (!withScript) return;
+    replyPrintf(reply, "Edit Script:");
+    for (size_t i = 0; i < script->count; i++) {
+        const EditOp *op = &script->ops[i];
+        replyPrintf(reply, " %c%zu,%zu:%u,%u", op->kind, op->targetPos, op->typedPos,
+                    (unsigned)op->expected, (unsigned)op->typed);
+    }
+    replyPrintf(reply, "\n");
+}
+
+Difficulty difficultyForLevel(const char *difficultyLevel) {
+    if (strcmp(difficultyLevel, "Easy") == 0)
+        return (Difficulty){EASY_SPEED, EASY_MEDIUM_SPEED, MEDIUM_HARD_SPEED};
+    if (strcmp(difficultyLevel, "Medium") == 0)
+        return (Difficulty){EASY_MEDIUM_SPEED, MEDIUM_HARD_SPEED, HARD_MAX_SPEED};
+    return (Difficulty){MEDIUM_HARD_SPEED, HARD_MAX_SPEED, HARD_SPEED + 4};
+}
+
+static const char *performanceNames[] = {"Excellent", "Good", "Fair", "Needs Improvement"};
+
+static const char *performanceMessages[] = {
+    "Excellent! You passed the Hard threshold.",
+    "Good! You passed the Medium threshold.",
+    "Fair! You passed the Easy threshold.",
+    "Needs Improvement. Try to type faster!",
+};
+
+// Index into performanceNames: the highest threshold of the difficulty passed
+static int performanceLevel(const char *difficultyLevel, const TypingStats *stats) {
+    Difficulty difficulty = difficultyForLevel(difficultyLevel);
+    if (stats->typingSpeed >= difficulty.hard) return 0;
+    if (stats->typingSpeed >= difficulty.medium) return 1;
+    if (stats->typingSpeed >= difficulty.easy) return 2;
+    return 3;
+}
+
+// The stats, edit breakdown and verdict every submission path replies with
+void formatSubmission(ReplyBuffer *reply, const char *difficultyLevel, const TypingStats *stats,
+                      const EditScript *edits) {
+    replyPrintf(reply, "\nTyping Stats:\n");
+    replyPrintf(reply, "CPM: %.2f\n", stats->typingSpeed);
+    replyPrintf(reply, "WPM: %.2f\n", stats->wordsPerMinute);
+    replyPrintf(reply, "Accuracy: %.2f%%\n", stats->accuracy);
+    replyPrintf(reply, "Wrong Characters: %d\n", stats->wrongChars);
+    if (edits) formatEditBreakdown(reply, edits, 1);
+    replyPrintf(reply, "Performance: %s\n", performanceMessages[performanceLevel(difficultyLevel, stats)]);
+}
+
+// Shares of earlier attempts at the same difficulty that were slower and
+// less accurate; 0, or -1 when there are none
+static int attemptPercentile(BackendState *state, const char *difficultyLevel, const TypingStats *stats,
+                             double *fasterThan, double *moreAccurateThan) {
+    ScoreSketchStore *store = getScoreSketchStore(state);
+    int difficulty = progressDifficulty(difficultyLevel);
+    ScoreSketch *speeds = malloc(2 * sizeof(ScoreSketch));
+    int status = -1;
+    if (store && speeds && readScoreSketch(store, difficulty, SCORE_SKETCH_CPM, &speeds[0]) == 0 &&
+        readScoreSketch(store, difficulty, SCORE_SKETCH_ACCURACY, &speeds[1]) == 0 && speeds[0].count > 0) {
+        *fasterThan = scoreSketchShareBelow(&speeds[0], SCORE_SKETCH_CPM, stats->typingSpeed);
+        *moreAccurateThan = scoreSketchShareBelow(&speeds[1], SCORE_SKETCH_ACCURACY, stats->accuracy);
+        status = 0;
+    }
+    free(speeds);
+    return status;
+}
+
+// Where the attempt falls among earlier attempts at the same difficulty
+void formatPercentile(BackendState *state, const char *difficultyLevel, const TypingStats *stats,
+                      ReplyBuffer *reply) {
+    double fasterThan, moreAccurateThan;
+    if (attemptPercentile(state, difficultyLevel, stats, &fasterThan, &moreAccurateThan) == 0) {
+        replyPrintf(reply, "Percentile: faster than %.1f%% of %s attempts, more accurate than %.1f%%\n",
+                    100.0 * fasterThan, difficultyLevel, 100.0 * moreAccurateThan);
+    }
+}
+
+// The same report as one record; percentiles are percentages here too
+static void formatSubmissionRecord(BackendState *state, const char *difficultyLevel, const TypingStats *stats,
+                                   const EditScript *edits, const QueryOptions *options, ReplyBuffer *reply) {
+    OutputRecord record;
+    beginRecord(&record, options, reply, 1);
+    recordString(&record, "difficulty", difficultyLevel);
+    recordNumber(&record, "cpm", stats->typingSpeed);
+    recordNumber(&record, "wpm", stats->wordsPerMinute);
+    recordNumber(&record, "accuracy", stats->accuracy);
+    recordInteger(&record, "wrongChars", stats->wrongChars);
+    recordInteger(&record, "paragraphLength", (long long)stats->paragraphLength);
+    if (edits) {
+        recordInteger(&record, "substitutions", (long long)edits->substitutions);
+        recordInteger(&record, "insertions", (long long)edits->insertions);
+        recordInteger(&record, "deletions", (long long)edits->deletions);
+    }
+    recordString(&record, "performance", performanceNames[performanceLevel(difficultyLevel, stats)]);
+    double fasterThan, moreAccurateThan;
+    if (attemptPercentile(state, difficultyLevel, stats, &fasterThan, &moreAccurateThan) == 0) {
+        recordDecimal(&record, "fasterThan", 100.0 * fasterThan, 1);
+        recordDecimal(&record, "moreAccurateThan", 100.0 * moreAccurateThan, 1);
+    }
+    endRecord(&record);
+}
+
+// Report a scored attempt and put it on the leaderboard and the profile
+void recordSubmission(BackendState *state, const char *username, const char *difficultyLevel,
+                      TypingStats *stats, const EditScript *edits, const QueryOptions *options, ReplyBuffer *reply) {
+    if (options->format != OUTPUT_TEXT) {
+        formatSubmissionRecord(state, difficultyLevel, stats, edits, options, reply);
+    } else {
+        formatSubmission(reply, difficultyLevel, stats, edits);
+        formatPercentile(state, difficultyLevel, stats, reply);
+    }
+
+    UserProfile entrant = {0};
+    strncpy(entrant.username, username, sizeof(entrant.username) - 1);
+    updateLeaderboard(state, &entrant, stats, difficultyLevel);
+
+    UserProfile profile = {0};
+    profileName(username, profile.username, sizeof(profile.username));
+    updateUserProfile(state, &profile, stats);
+    recordProgress(state, username, difficultyLevel, stats);
+    recordScoreSketches(state, difficultyLevel, stats);
+}
+
+int handleSubmission(BackendState *state, int argc, char *argv[], const QueryOptions *options, ReplyBuffer *reply) {
+    if (argc < 7) {
+        replyPrintf(reply, "Usage: %s <username> <difficulty> <caseInsensitive> <elapsedTime> <userInput> <paragraph>\n", argv[0]);
+        return 1;
+    }
+    const char *username = argv[1];
+    const char *difficultyLevel = argv[2];
+    int caseInsensitive = atoi(argv[3]);
+    double elapsedTime = atof(argv[4]);
+    const char *userInput = argv[5];
+    const char *para = argv[6];
+
+    if (options->format == OUTPUT_TEXT) replyPrintf(reply, "Random Paragraph:\n%s\n", para);
+
+    Difficulty difficulty = difficultyForLevel(difficultyLevel);
+    TypingStats stats = {.caseInsensitive = caseInsensitive};
+    printTypingStats(elapsedTime, userInput, para, difficulty, &stats);
+    alignEdits(&editScript, para, strlen(para), userInput, strlen(userInput), caseInsensitive);
+    recordSubmission(state, username, difficultyLevel, &stats, &editScript, options, reply);
+    return 0;
+}
+
+// Split "username<TAB>difficulty<TAB>caseFlag<TAB>seconds<TAB>input<TAB>paragraph"
+static void parseBatchAttempt(BatchAttempt *attempt) {
+    char *fields[6];
+    char *cursor = attempt->line;
+    for (int i = 0; i < 6; i++) {
+        fields[i] = cursor;
+        cursor = (i < 5) ? strchr(cursor, '\t') : NULL;
+        if (i < 5 && !cursor) {
+            attempt->error = "expected 6 tab-separated fields";
+            return;
+        }
+        if (cursor) *cursor++ = '\0';
+    }
+    if (strchr(fields[5], '\t')) {
+        attempt->error = "expected 6 tab-separated fields";
+        return;
+    }
+
+    char *end;
+    attempt->username = fields[0];
+    attempt->difficulty = fields[1];
+    attempt->caseInsensitive = atoi(fields[2]);
+    attempt->elapsedTime = strtod(fields[3], &end);
+    attempt->input = fields[4];
+    attempt->paragraph = fields[5];
+    if (strlen(attempt->username) == 0 || strlen(attempt->difficulty) == 0) {
+        attempt->error = "missing username or difficulty";
+    } else if (strcmp(fields[2], "0") != 0 && strcmp(fields[2], "1") != 0) {
+        attempt->error = "case flag must be 0 or 1";
+    } else if (end == fields[3] || *end != '\0' || !(attempt->elapsedTime > 0)) {
+        attempt->error = "elapsed time must be a positive number of seconds";
+    } else if (strlen(attempt->paragraph) == 0) {
+        attempt->error = "empty paragraph";
+    }
+}
+
+typedef struct {
+    BatchAttempt *attempts;
+    ScoreWorkspace *workspaces;
+} BatchChunk;
+
+// A chunk's progress samples, sorted by user so each user's files are opened
+// and appended to once per chunk
+typedef struct {
+    char username[50];              // sanitized profile name
+    size_t order;                   // position in the chunk, kept within a user
+    ProgressSample sample;
+} BatchProgress;
+
+static int compareBatchProgress(const void *a, const void *b) {
+    const BatchProgress *left = a, *right = b;
+    int byName = strcmp(left->username, right->username);
+    if (byName != 0) return byName;
+    return left->order < right->order ? -1 : left->order > right->order;
+}
+
+static void saveBatchProgress(BackendState *state, BatchProgress *progress, size_t count, ProgressSample *samples) {
+    ProgressStore *store = getProgressStore(state);
+    qsort(progress, count, sizeof(BatchProgress), compareBatchProgress);
+    for (size_t i = 0, run; i < count; i += run) {
+        for (run = 0; i + run < count && strcmp(progress[i + run].username, progress[i].username) == 0; run++) {
+            samples[run] = progress[i + run].sample;
+        }
+        if (!store || appendProgressSamples(store, progress[i].username, samples, run) != 0) {
+            fprintf(stderr, "Error saving progress for '%s'\n", progress[i].username);
+        }
+    }
+}
+
+static void scoreBatchAttempt(void *context, size_t index, int worker) {
+    BatchChunk *chunk = context;
+    BatchAttempt *attempt = &chunk->attempts[index];
+    if (attempt->error) return;
+    attempt->stats.caseInsensitive = attempt->caseInsensitive;
+    computeTypingStats(&chunk->workspaces[worker], attempt->elapsedTime, attempt->input, attempt->paragraph, &attempt->stats);
+}
+
+// Score a stream of attempts on every core. Results come back in input
+// order, one line each; all leaderboard entries go into the journal as one
+// commit, each chunk updates its profiles in place under a single lock and
+// appends each user's progress once.
+int handleScoreBatch(BackendState *state, FILE *in, ReplyBuffer *reply) {
+    int threadCount = hardwareThreadCount();
+    BatchChunk chunk;
+    chunk.attempts = malloc(max_batch_chunk * sizeof(BatchAttempt));
+    chunk.workspaces = malloc(threadCount * sizeof(ScoreWorkspace));
+    BatchProgress *progress = malloc(max_batch_chunk * sizeof(BatchProgress));
+    ProgressSample *samples = malloc(max_batch_chunk * sizeof(ProgressSample));
+    CHECK_FILE_OP(chunk.attempts && chunk.workspaces && progress && samples, "Memory allocation error for batch scoring");
+    for (int i = 0; i < threadCount; i++) initScoreWorkspace(&chunk.workspaces[i]);
+
+    // One chunk's attempts per difficulty and metric, merged into the store at once
+    ScoreSketch (*sketches)[SCORE_SKETCH_METRICS] = malloc(sizeof(ScoreSketch) * SCORE_SKETCH_DIFFICULTIES * SCORE_SKETCH_METRICS);
+    CHECK_FILE_OP(sketches, "Memory allocation error for batch scoring");
+
+    LeaderboardEntry *entries = NULL;
+    size_t entryCount = 0, entryCapacity = 0;
+    long lineNumber = 0, scored = 0, rejected = 0;
+    char *line = NULL;
+    size_t lineCapacity = 0;
+    int done = 0;
+    int status = 0;
+
+    while (!done) {
+        size_t count = 0;
+        long length;
+        while (count < max_batch_chunk && (length = readTextLine(in, &line, &lineCapacity)) >= 0) {
+            lineNumber++;
+            if (length == 0 || line[0] == '#') continue;
+            BatchAttempt *attempt = &chunk.attempts[count++];
+            memset(attempt, 0, sizeof(*attempt));
+            attempt->line = strdup(line);
+            CHECK_FILE_OP(attempt->line, "Memory allocation error for batch line");
+            attempt->lineNumber = lineNumber;
+            parseBatchAttempt(attempt);
+        }
+        done = count < max_batch_chunk;
+
+        parallelFor(count, threadCount, scoreBatchAttempt, &chunk);
+
+        if (entryCount + count > entryCapacity) {
+            entryCapacity = (entryCount + count) * 2;
+            entries = realloc(entries, entryCapacity * sizeof(LeaderboardEntry));
+            CHECK_FILE_OP(entries, "Memory allocation error for batch results");
+        }
+        ProfileStore *profiles = getProfileStore(state);
+        if (profiles && lockProfileStore(profiles, 1) != 0) profiles = NULL;
+        memset(sketches, 0, sizeof(ScoreSketch) * SCORE_SKETCH_DIFFICULTIES * SCORE_SKETCH_METRICS);
+        size_t progressCount = 0;
+        for (size_t i = 0; i < count; i++) {
+            BatchAttempt *attempt = &chunk.attempts[i];
+            if (attempt->error) {
+                replyPrintf(reply, "%ld\terror\t%s\n", attempt->lineNumber, attempt->error);
+                rejected++;
+                free(attempt->line);
+                continue;
+            }
+            replyPrintf(reply, "%ld\t%s\t%s\t%.2f\t%.2f\t%.2f\t%d\n", attempt->lineNumber, attempt->username,
+                        attempt->difficulty, attempt->stats.typingSpeed, attempt->stats.wordsPerMinute,
+                        attempt->stats.accuracy, attempt->stats.wrongChars);
+
+            LeaderboardEntry *entry = &entries[entryCount];
+            memset(entry, 0, sizeof(*entry));
+            strncpy(entry->username, attempt->username, sizeof(entry->username) - 1);
+            strncpy(entry->difficulty, attempt->difficulty, sizeof(entry->difficulty) - 1);
+            entry->typingSpeed = attempt->stats.typingSpeed;
+            entry->wordsPerMinute = attempt->stats.wordsPerMinute;
+            entry->accuracy = attempt->stats.accuracy;
+
+            UserProfile profile = {0};
+            profileName(attempt->username, profile.username, sizeof(profile.username));
+            ProfileRecord *record = profiles ? claimProfileRecord(profiles, profile.username) : NULL;
+            if (record) {
+                copyProfileRecord(&profile, record);
+                recordProfileAttempt(&profile, &attempt->stats);
+                storeProfileRecord(record, &profile);
+            } else if (status == 0) {
+                replyPrintf(reply, "Error: Could not update profile for %s\n", attempt->username);
+                status = 1;
+            }
+            BatchProgress *pending = &progress[progressCount];
+            snprintf(pending->username, sizeof(pending->username), "%s", profile.username);
+            pending->order = progressCount++;
+            fillProgressSample(&pending->sample, attempt->difficulty, &attempt->stats);
+            double values[SCORE_SKETCH_METRICS];
+            sketchValues(&attempt->stats, values);
+            int difficulty = progressDifficulty(attempt->difficulty);
+            for (int m = 0; m < SCORE_SKETCH_METRICS; m++) addToScoreSketch(&sketches[difficulty][m], m, values[m]);
+            entryCount++;
+            scored++;
+            free(attempt->line);
+        }
+        if (profiles) unlockProfileStore(profiles);
+        saveBatchProgress(state, progress, progressCount, samples);
+        ScoreSketchStore *sketchStore = getScoreSketchStore(state);
+        if (!sketchStore || mergeScoreSketches(sketchStore, (const ScoreSketch (*)[SCORE_SKETCH_METRICS])sketches) != 0) {
+            replyPrintf(reply, "Error: Could not save score distributions\n");
+            status = 1;
+        }
+    }
+
+    if (entryCount > 0) {
+        refreshLeaderboard(state);
+        if (!state->journalOpen || commitLeaderboardEntries(&state->journal, entries, entryCount) != 0) {
+            replyPrintf(reply, "Error: Could not save %zu leaderboard entries\n", entryCount);
+            status = 1;
+        } else {
+            refreshLeaderboard(state);
+        }
+    }
+    replyPrintf(reply, "# scored %ld, rejected %ld, threads %d\n", scored, rejected, threadCount);
+
+    for (int i = 0; i < threadCount; i++) freeScoreWorkspace(&chunk.workspaces[i]);
+    free(chunk.workspaces);
+    free(progress);
+    free(samples);
+    free(sketches);
+    free(chunk.attempts);
+    free(entries);
+    free(line);
+    return status;
+}
+
+// Drop one trailing line ending, the way readTextLine does
+static void stripLineEnding(const char *text, size_t *length) {
+    if (*length > 0 && text[*length - 1] == '\n') {
+        (*length)--;
+        if (*length > 0 && text[*length - 1] == '\r') (*length)--;
+    }
+}
+
+static char *readWholeFile(const char *path, size_t *length) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    size_t capacity = stream_chunk_size, got;
+    char *data = malloc(capacity);
+    CHECK_FILE_OP(data, "Memory allocation error for passage");
+    *length = 0;
+    while ((got = fread(data + *length, 1, capacity - *length, f)) > 0) {
+        *length += got;
+        if (*length == capacity) {
+            capacity *= 2;
+            data = realloc(data, capacity);
+            CHECK_FILE_OP(data, "Memory allocation error for passage");
+        }
+    }
+    int failed = ferror(f);
+    fclose(f);
+    if (failed) {
+        free(data);
+        return NULL;
+    }
+    return data;
+}
+
+// Score a multi-page passage, e.g. a book chapter from an endurance test.
+// The typed text is never held: it is read from in a chunk at a time and fed
+// to the stream scorer, which gives the same distance as editDistance.
+// argv: --score-stream <username> <difficulty> <caseInsensitive> <elapsedTime> <paragraphFile> [inputFile]
+int handleScoreStream(BackendState *state, char *argv[], FILE *in, const QueryOptions *options, ReplyBuffer *reply) {
+    const char *username = argv[2];
+    const char *difficultyLevel = argv[3];
+    int caseInsensitive = atoi(argv[4]);
+    double elapsedTime = atof(argv[5]);
+
+    size_t paragraphLength;
+    char path[max_data_path];
+    char *para = readWholeFile(dataPath(state, argv[6], path), &paragraphLength);
+    if (para) stripLineEnding(para, &paragraphLength);
+    if (!para || paragraphLength == 0) {
+        replyPrintf(reply, "Error: Could not read a passage from %s\n", argv[6]);
+        free(para);
+        return 1;
+    }
+    StreamScorer scorer;
+    initStreamScorer(&scorer);
+    beginStreamScore(&scorer, para, paragraphLength, caseInsensitive);
+    free(para);
+
+    // The last two bytes are held back until the next read in case they are
+    // the final line ending
+    char *chunk = malloc(stream_chunk_size + 2);
+    CHECK_FILE_OP(chunk, "Memory allocation error for input chunk");
+    size_t held = 0, got;
+    while ((got = fread(chunk + held, 1, stream_chunk_size, in)) > 0) {
+        size_t total = held + got;
+        held = total < 2 ? total : 2;
+        streamScoreText(&scorer, chunk, total - held);
+        memmove(chunk, chunk + total - held, held);
+    }
+    int failed = ferror(in);
+    stripLineEnding(chunk, &held);
+    streamScoreText(&scorer, chunk, held);
+    free(chunk);
+    if (failed) {
+        replyPrintf(reply, "Error: Could not read the typed input\n");
+        freeStreamScorer(&scorer);
+        return 1;
+    }
+
+    TypingStats stats = {.caseInsensitive = caseInsensitive};
+    fillTypingStats(elapsedTime, streamScoreDistance(&scorer), scorer.textLength, paragraphLength, &stats);
+    if (options->format == OUTPUT_TEXT) {
+        replyPrintf(reply, "Passage: %zu characters, typed: %zu characters\n", paragraphLength, scorer.textLength);
+    }
+    freeStreamScorer(&scorer);
+    // The typed text was streamed through and never held, so there is no alignment to report
+    recordSubmission(state, username, difficultyLevel, &stats, NULL, options, reply);
+    return 0;
+}
@@ -0,0 +1,626 @@
+// Benchmarks for the backend hot paths. Linked against the same backend
+// units as typingtutor.exe and the shared library:
+//
+//   gcc -O2 benchmark.c typing_view.c screen_renderer.c race.c session_server.c backend.c
+//       backend_corpus.c backend_scoring.c backend_leaderboard.c backend_profiles.c scoring.c corpus.c
+//       leaderboard_store.c leaderboard_journal.c keystroke_log.c thread_pool.c file_lock.c profile_store.c
+//       progress_store.c score_sketch.c -o build/benchmark -lm -pthread
+//
+// Every case runs in a forked child so its peak RSS is its own. Results are
+// printed as one JSON object per line, e.g.
+//
+//   {"benchmark":"levenshtein","size":5000,"iterations":120,"ops_per_sec":...,
+//    "items_per_sec":...,"p50_us":...,"p90_us":...,"p99_us":...,"max_us":...,"peak_rss_kb":...}
+//
+// so runs from two releases can be compared line by line.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "backend.h"
+#include "typing_view.h"
+
+#define bench_budget_ns 1000000000ull
+#define bench_max_samples 100000
+#define bench_query_targets 64
+
+typedef struct {
+    const char *name;
+    uint64_t size;
+    void *data;
+    uint64_t iteration;
+} BenchCase;
+
+typedef struct {
+    const char *name;
+    const uint64_t *sizes;
+    int sizeCount;
+    int minIterations;
+    void (*setup)(BenchCase *bench);
+    void (*run)(BenchCase *bench);      // one timed operation
+    void (*teardown)(BenchCase *bench);
+    uint64_t itemsPerOp;                // 0: the case size
+} Benchmark;
+
+static EditScript editScript;
+static int quickMode = 0;
+static int resultFd = STDOUT_FILENO;
+static uint32_t benchRandomState = 12345;
+
+static uint32_t benchRandom(void) {
+    uint32_t x = benchRandomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return benchRandomState = x;
+}
+
+static void *benchAlloc(size_t size) {
+    void *ptr = malloc(size);
+    CHECK_FILE_OP(ptr, "Memory allocation error for benchmark");
+    return ptr;
+}
+
+// ---- Synthetic data ----
+
+static const char *benchWords[] = {
+    "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "typing", "practice",
+    "keyboard", "accuracy", "speed", "paragraph", "measure", "improve", "steady", "rhythm",
+    "Lion", "mouse", "forest", "Hunter", "net", "friends", "afterwards", "trembling",
+};
+
+static char *makeParagraph(size_t length) {
+    char *text = benchAlloc(length + 1);
+    size_t pos = 0;
+    while (pos < length) {
+        const char *word = benchWords[benchRandom() % (sizeof(benchWords) / sizeof(benchWords[0]))];
+        for (size_t i = 0; word[i] && pos < length; i++) text[pos++] = word[i];
+        if (pos < length) text[pos++] = (benchRandom() % 12 == 0) ? '.' : ' ';
+    }
+    text[length] = '\0';
+    return text;
+}
+
+// A plausible attempt at target: about 3% substitutions, drops and insertions
+static char *makeAttempt(const char *target) {
+    size_t length = strlen(target);
+    char *typed = benchAlloc(length * 2 + 1);
+    size_t pos = 0;
+    for (size_t i = 0; i < length; i++) {
+        uint32_t roll = benchRandom() % 100;
+        if (roll == 0) continue;
+        if (roll == 1) typed[pos++] = 'a' + benchRandom() % 26;
+        typed[pos++] = (roll == 2) ? (char)('a' + benchRandom() % 26) : target[i];
+    }
+    typed[pos] = '\0';
+    return typed;
+}
+
+static void writeCorpusFile(const char *path, uint64_t lines) {
+    static const char *sections[] = {"Easy", "Medium", "Hard"};
+    FILE *f = fopen(path, "w");
+    CHECK_FILE_OP(f, "Error creating benchmark corpus");
+    for (int s = 0; s < 3; s++) {
+        fprintf(f, "#%s\n", sections[s]);
+        for (uint64_t i = s; i < lines; i += 3) {
+            char *line = makeParagraph(40 + benchRandom() % 140);
+            fprintf(f, "%s\n", line);
+            free(line);
+        }
+    }
+    fclose(f);
+}
+
+static void writeLeaderboardFile(const char *path, uint64_t entries) {
+    static const char *difficulties[] = {"Easy", "Medium", "Hard"};
+    FILE *f = fopen(path, "w");
+    CHECK_FILE_OP(f, "Error creating benchmark leaderboard");
+    uint64_t users = entries / 4 + 1;
+    for (uint64_t i = 0; i < entries; i++) {
+        double cpm = 60 + (benchRandom() % 60000) / 100.0;
+        fprintf(f, "user%llu %.2f %.2f %.2f %s\n", (unsigned long long)(benchRandom() % users), cpm, cpm / 5,
+                50 + (benchRandom() % 5000) / 100.0, difficulties[benchRandom() % 3]);
+    }
+    fclose(f);
+}
+
+static void removeLeaderboardFiles(void) {
+    remove(LEADERBOARD_SNAPSHOT_PATH);
+    remove(LEADERBOARD_JOURNAL_PATH);
+    remove(LEADERBOARD_LOCK_PATH);
+}
+
+// ---- Scoring ----
+
+typedef struct {
+    char *target;
+    char *typed;
+} ScoringData;
+
+static void setupScoring(BenchCase *bench) {
+    ScoringData *data = benchAlloc(sizeof(ScoringData));
+    data->target = makeParagraph(bench->size);
+    data->typed = makeAttempt(data->target);
+    bench->data = data;
+}
+
+static void runLevenshtein(BenchCase *bench) {
+    ScoringData *data = bench->data;
+    volatile int distance = levenshtein(data->typed, data->target, (int)(bench->iteration & 1));
+    (void)distance;
+}
+
+// A long passage fed to the stream scorer in 64 KiB pieces, as --score-stream reads it
+static void runStreamScore(BenchCase *bench) {
+    ScoringData *data = bench->data;
+    StreamScorer scorer;
+    initStreamScorer(&scorer);
+    beginStreamScore(&scorer, data->target, strlen(data->target), 0);
+    size_t length = strlen(data->typed);
+    for (size_t pos = 0; pos < length; pos += stream_chunk_size) {
+        streamScoreText(&scorer, data->typed + pos, length - pos < stream_chunk_size ? length - pos : stream_chunk_size);
+    }
+    volatile size_t distance = streamScoreDistance(&scorer);
+    (void)distance;
+    freeStreamScorer(&scorer);
+}
+
+// Full edit script for an attempt, as a submission reports it
+static void runAlignEdits(BenchCase *bench) {
+    ScoringData *data = bench->data;
+    volatile size_t distance = alignEdits(&editScript, data->target, strlen(data->target),
+                                          data->typed, strlen(data->typed), (int)(bench->iteration & 1));
+    (void)distance;
+}
+
+static void teardownScoring(BenchCase *bench) {
+    ScoringData *data = bench->data;
+    free(data->target);
+    free(data->typed);
+    free(data);
+}
+
+// ---- Real-time rendering: one frame per keystroke ----
+
+typedef struct {
+    ScreenRenderer screen;
+    char *target;
+    char *typed;
+} RenderData;
+
+static void setupRender(BenchCase *bench) {
+    RenderData *data = benchAlloc(sizeof(RenderData));
+    data->target = makeParagraph(bench->size);
+    data->typed = makeAttempt(data->target);
+    if (strlen(data->typed) > bench->size) data->typed[bench->size] = '\0';
+    // Frames go to /dev/null; the JSON result keeps its own descriptor
+    int devNull = open("/dev/null", O_WRONLY);
+    CHECK_FILE_OP(devNull >= 0, "Error opening /dev/null");
+    dup2(devNull, STDOUT_FILENO);
+    close(devNull);
+    openScreenRenderer(&data->screen);
+    bench->data = data;
+}
+
+static void runRender(BenchCase *bench) {
+    RenderData *data = bench->data;
+    size_t typedLength = strlen(data->typed);
+    size_t pos = typedLength ? bench->iteration % (typedLength + 1) : 0;
+    char saved = data->typed[pos];
+    data->typed[pos] = '\0';
+    displayRealtimeTyping(&data->screen, data->target, data->typed, (int)pos, 0, 1.0 + bench->iteration, NULL);
+    data->typed[pos] = saved;
+}
+
+static void teardownRender(BenchCase *bench) {
+    RenderData *data = bench->data;
+    closeScreenRenderer(&data->screen);
+    free(data->target);
+    free(data->typed);
+    free(data);
+}
+
+// ---- Corpus ----
+
+static void setupCorpusText(BenchCase *bench) {
+    writeCorpusFile("bench_corpus.txt", bench->size);
+}
+
+static void runCorpusLoad(BenchCase *bench) {
+    (void)bench;
+    FILE *file = fopen("bench_corpus.txt", "r");
+    CHECK_FILE_OP(file, "Error opening benchmark corpus");
+    ParagraphCache cache = {0};
+    loadParagraphsForDifficulty(file, &cache, "Medium");
+    fclose(file);
+    freeParagraphCache(&cache);
+}
+
+static void runCorpusCompile(BenchCase *bench) {
+    (void)bench;
+    if (compileCorpus("bench_corpus.txt", "bench_corpus.bin", NULL, NULL) != 0) exit(EXIT_FAILURE);
+}
+
+static void teardownCorpus(BenchCase *bench) {
+    (void)bench;
+    remove("bench_corpus.txt");
+    remove("bench_corpus.bin");
+}
+
+static void setupCorpusLookup(BenchCase *bench) {
+    setupCorpusText(bench);
+    if (compileCorpus("bench_corpus.txt", "bench_corpus.bin", NULL, NULL) != 0) exit(EXIT_FAILURE);
+    CompiledCorpus *corpus = benchAlloc(sizeof(CompiledCorpus));
+    if (openCompiledCorpus(corpus, "bench_corpus.bin") != 0) exit(EXIT_FAILURE);
+    bench->data = corpus;
+}
+
+static void runCorpusLookup(BenchCase *bench) {
+    CompiledCorpus *corpus = bench->data;
+    const CorpusSectionRecord *section = findCorpusSection(corpus, "Medium");
+    uint32_t length;
+    volatile const char *text = getCorpusParagraph(corpus, section->firstEntry + benchRandom() % section->entryCount, &length);
+    (void)text;
+}
+
+// Ten drill paragraphs for two weak n-grams, as --get-drill picks them
+static void runCorpusDrill(BenchCase *bench) {
+    static const char *grams[] = {"qu", "ph", "th", "ing", "ck", "ow", "rh", "ee"};
+    CompiledCorpus *corpus = bench->data;
+    const CorpusSectionRecord *section = findCorpusSection(corpus, "Medium");
+    int gramIds[2] = {corpusGramId(grams[benchRandom() % 8]), corpusGramId(grams[benchRandom() % 8])};
+    CorpusMatch matches[10];
+    volatile size_t found = findGramRichParagraphs(corpus, section, gramIds, 2, matches, 10);
+    (void)found;
+}
+
+static void teardownCorpusLookup(BenchCase *bench) {
+    closeCompiledCorpus(bench->data);
+    free(bench->data);
+    teardownCorpus(bench);
+}
+
+// ---- Leaderboard ----
+
+static void setupLeaderboardFile(BenchCase *bench) {
+    removeLeaderboardFiles();
+    writeLeaderboardFile(LEADERBOARD_SNAPSHOT_PATH, bench->size);
+}
+
+static void runLeaderboardLoad(BenchCase *bench) {
+    (void)bench;
+    BackendState state = {0};
+    refreshLeaderboard(&state);
+    freeBackendState(&state);
+}
+
+static void teardownLeaderboard(BenchCase *bench) {
+    if (bench->data) {
+        freeBackendState(bench->data);
+        free(bench->data);
+    }
+    removeLeaderboardFiles();
+}
+
+static void setupLeaderboardState(BenchCase *bench) {
+    setupLeaderboardFile(bench);
+    BackendState *state = benchAlloc(sizeof(BackendState));
+    memset(state, 0, sizeof(*state));
+    refreshLeaderboard(state);
+    bench->data = state;
+}
+
+static void runLeaderboardRecord(BenchCase *bench) {
+    BackendState *state = bench->data;
+    LeaderboardEntry entry = {0};
+    snprintf(entry.username, sizeof(entry.username), "user%llu",
+             (unsigned long long)(benchRandom() % (bench->size / 4 + 1)));
+    entry.typingSpeed = 60 + (benchRandom() % 60000) / 100.0;
+    entry.wordsPerMinute = entry.typingSpeed / 5;
+    entry.accuracy = 90;
+    strcpy(entry.difficulty, "Medium");
+    recordLeaderboardEntry(&state->leaderboard, &entry);
+}
+
+// Durable submission: journal append, group fsync, view refresh
+static void runLeaderboardUpdate(BenchCase *bench) {
+    BackendState *state = bench->data;
+    UserProfile profile = {0};
+    TypingStats stats = {0};
+    snprintf(profile.username, sizeof(profile.username), "bench%llu", (unsigned long long)bench->iteration);
+    stats.typingSpeed = 60 + (benchRandom() % 60000) / 100.0;
+    stats.wordsPerMinute = stats.typingSpeed / 5;
+    stats.accuracy = 95;
+    updateLeaderboard(state, &profile, &stats, "Medium");
+}
+
+// --get-leaderboard for a user whose rank has to be looked up
+typedef struct {
+    BackendState state;
+    char args[bench_query_targets][4][50];
+    int targetCount;
+} QueryData;
+
+static void setupLeaderboardQuery(BenchCase *bench) {
+    setupLeaderboardFile(bench);
+    QueryData *data = benchAlloc(sizeof(QueryData));
+    memset(data, 0, sizeof(*data));
+    refreshLeaderboard(&data->state);
+
+    size_t count = leaderboardCount(&data->state.leaderboard, "Medium");
+    for (int t = 0; t < bench_query_targets && count > 0; t++) {
+        const LeaderboardNode *node = leaderboardFirst(&data->state.leaderboard, "Medium");
+        for (size_t skip = benchRandom() % count; skip > 0; skip--) node = leaderboardNext(node);
+        snprintf(data->args[t][0], 50, "%s", node->entry.username);
+        snprintf(data->args[t][1], 50, "%.2f", node->entry.typingSpeed);
+        snprintf(data->args[t][2], 50, "%.2f", node->entry.wordsPerMinute);
+        snprintf(data->args[t][3], 50, "%.2f", node->entry.accuracy);
+        data->targetCount++;
+    }
+    bench->data = data;
+}
+
+static void runLeaderboardQuery(BenchCase *bench) {
+    QueryData *data = bench->data;
+    if (data->targetCount == 0) return;
+    char (*target)[50] = data->args[bench->iteration % data->targetCount];
+    char *argv[] = {"typingtutor", "--get-leaderboard", "Medium", target[0], target[1], target[2], target[3]};
+    ReplyBuffer reply = {0};
+    handleGetLeaderboard(&data->state, 7, argv, &textQueryOptions, &reply);
+    freeReplyBuffer(&reply);
+}
+
+static void teardownLeaderboardQuery(BenchCase *bench) {
+    QueryData *data = bench->data;
+    freeBackendState(&data->state);
+    free(data);
+    removeLeaderboardFiles();
+}
+
+// ---- Profiles ----
+
+static void setupProfiles(BenchCase *bench) {
+    remove(PROFILE_STORE_PATH);
+    BackendState *state = benchAlloc(sizeof(BackendState));
+    memset(state, 0, sizeof(*state));
+    ProfileStore *store = getProfileStore(state);
+    if (!store || lockProfileStore(store, 1) != 0) exit(EXIT_FAILURE);
+    for (uint64_t i = 0; i < bench->size; i++) {
+        char name[50];
+        snprintf(name, sizeof(name), "user%llu", (unsigned long long)i);
+        ProfileRecord *record = findProfileRecord(store, name, 1);
+        if (!record) exit(EXIT_FAILURE);
+        record->totalAttempts = 1;
+        record->bestSpeed = record->totalSpeed = 60 + (benchRandom() % 60000) / 100.0;
+        record->bestAccuracy = record->totalAccuracy = 95;
+    }
+    unlockProfileStore(store);
+    bench->data = state;
+}
+
+// One submission's profile write: lock, lookup, in-place update
+static void runProfileUpdate(BenchCase *bench) {
+    UserProfile profile = {0};
+    TypingStats stats = {0};
+    snprintf(profile.username, sizeof(profile.username), "user%llu", (unsigned long long)(benchRandom() % bench->size));
+    stats.typingSpeed = 60 + (benchRandom() % 60000) / 100.0;
+    stats.accuracy = 95;
+    updateUserProfile(bench->data, &profile, &stats);
+}
+
+static void runProfileList(BenchCase *bench) {
+    ReplyBuffer reply = {0};
+    handleListProfiles(bench->data, &textQueryOptions, &reply);
+    freeReplyBuffer(&reply);
+}
+
+static void teardownProfiles(BenchCase *bench) {
+    freeBackendState(bench->data);
+    free(bench->data);
+    remove(PROFILE_STORE_PATH);
+}
+
+// ---- Progress history ----
+
+#define bench_progress_start 1700000000
+
+// size attempts, ten a day, as one heavy user's history
+static void setupProgress(BenchCase *bench) {
+    remove(PROGRESS_STORE_PATH);
+    BackendState *state = benchAlloc(sizeof(BackendState));
+    memset(state, 0, sizeof(*state));
+    ProgressStore *store = getProgressStore(state);
+    if (!store) exit(EXIT_FAILURE);
+    for (uint64_t i = 0; i < bench->size; i++) {
+        ProgressSample sample;
+        memset(&sample, 0, sizeof(sample));
+        sample.timestamp = bench_progress_start + (int64_t)(i * 8640);
+        sample.typingSpeed = 60 + (benchRandom() % 60000) / 100.0f;
+        sample.wordsPerMinute = sample.typingSpeed / 5;
+        sample.accuracy = 95;
+        sample.difficulty = (uint8_t)(i % 3);
+        if (appendProgressSample(store, "benchuser", &sample) != 0) exit(EXIT_FAILURE);
+    }
+    bench->data = state;
+}
+
+// One submission's progress write: lock, find the user, append, fold into rollups
+static void runProgressAppend(BenchCase *bench) {
+    TypingStats stats = {0};
+    stats.typingSpeed = 60 + (benchRandom() % 60000) / 100.0;
+    stats.accuracy = 95;
+    recordProgress(bench->data, "benchuser", "Medium", &stats);
+}
+
+// A month's chart somewhere in the history: every attempt in a 30-day window
+static void runProgressMonth(BenchCase *bench) {
+    int64_t days = (int64_t)(bench->size / 10);
+    int64_t from = bench_progress_start + (int64_t)(benchRandom() % (days > 30 ? days - 30 : 1)) * 86400;
+    ProgressSample *samples;
+    volatile long count = readProgressSamples(getProgressStore(bench->data), "benchuser", from,
+                                              from + 30 * 86400, &samples);
+    (void)count;
+    free(samples);
+}
+
+static void runProgressDaily(BenchCase *bench) {
+    ProgressRollup *rollups;
+    volatile long count = readProgressRollups(getProgressStore(bench->data), "benchuser", PROGRESS_DAILY,
+                                              INT64_MIN, INT64_MAX, &rollups);
+    (void)count;
+    free(rollups);
+}
+
+static void teardownProgress(BenchCase *bench) {
+    freeBackendState(bench->data);
+    free(bench->data);
+    remove(PROGRESS_STORE_PATH);
+}
+
+// ---- Runner ----
+
+static const uint64_t paragraphSizes[] = {50, 500, 5000, 50000};
+static const uint64_t passageSizes[] = {10000, 100000};
+static const uint64_t corpusSizes[] = {10000, 100000, 1000000};
+static const uint64_t leaderboardSizes[] = {10000, 100000, 1000000};
+static const uint64_t profileSizes[] = {1000, 10000, 100000};
+static const uint64_t progressSizes[] = {1000, 10000, 100000};
+
+#define SIZES(array) array, (int)(sizeof(array) / sizeof(array[0]))
+
+static const Benchmark benchmarks[] = {
+    {"levenshtein", SIZES(paragraphSizes), 5, setupScoring, runLevenshtein, teardownScoring, 0},
+    {"stream_score", SIZES(passageSizes), 3, setupScoring, runStreamScore, teardownScoring, 0},
+    {"align_edits", SIZES(paragraphSizes), 5, setupScoring, runAlignEdits, teardownScoring, 0},
+    {"render_frame", SIZES(paragraphSizes), 5, setupRender, runRender, teardownRender, 1},
+    {"corpus_load_text", SIZES(corpusSizes), 3, setupCorpusText, runCorpusLoad, teardownCorpus, 0},
+    {"corpus_compile", SIZES(corpusSizes), 3, setupCorpusText, runCorpusCompile, teardownCorpus, 0},
+    {"corpus_lookup", SIZES(corpusSizes), 5, setupCorpusLookup, runCorpusLookup, teardownCorpusLookup, 1},
+    {"corpus_drill", SIZES(corpusSizes), 5, setupCorpusLookup, runCorpusDrill, teardownCorpusLookup, 1},
+    {"leaderboard_load", SIZES(leaderboardSizes), 3, setupLeaderboardFile, runLeaderboardLoad, teardownLeaderboard, 0},
+    {"leaderboard_record", SIZES(leaderboardSizes), 5, setupLeaderboardState, runLeaderboardRecord, teardownLeaderboard, 1},
+    {"leaderboard_update", SIZES(leaderboardSizes), 5, setupLeaderboardState, runLeaderboardUpdate, teardownLeaderboard, 1},
+    {"leaderboard_query", SIZES(leaderboardSizes), 5, setupLeaderboardQuery, runLeaderboardQuery, teardownLeaderboardQuery, 1},
+    {"profile_update", SIZES(profileSizes), 5, setupProfiles, runProfileUpdate, teardownProfiles, 1},
+    {"profile_list", SIZES(profileSizes), 3, setupProfiles, runProfileList, teardownProfiles, 0},
+    {"progress_append", SIZES(progressSizes), 5, setupProgress, runProgressAppend, teardownProgress, 1},
+    {"progress_month", SIZES(progressSizes), 5, setupProgress, runProgressMonth, teardownProgress, 300},
+    {"progress_daily", SIZES(progressSizes), 5, setupProgress, runProgressDaily, teardownProgress, 0},
+};
+
+static int compareSamples(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentileUs(const uint64_t *sorted, size_t count, double fraction) {
+    size_t index = (size_t)(fraction * (count - 1) + 0.5);
+    return sorted[index] / 1000.0;
+}
+
+// Runs in the forked child
+static void runCase(const Benchmark *benchmark, uint64_t size) {
+    BenchCase bench = {benchmark->name, size, NULL, 0};
+    benchRandomState = (uint32_t)(size * 2654435761u) | 1;
+    if (benchmark->setup) benchmark->setup(&bench);
+
+    uint64_t *samples = benchAlloc(bench_max_samples * sizeof(uint64_t));
+    size_t count = 0;
+    uint64_t total = 0;
+    while (count < bench_max_samples && (count < (size_t)benchmark->minIterations || total < bench_budget_ns)) {
+        bench.iteration = count;
+        uint64_t start = monotonicNanoseconds();
+        benchmark->run(&bench);
+        uint64_t elapsed = monotonicNanoseconds() - start;
+        samples[count++] = elapsed;
+        total += elapsed;
+    }
+
+    if (benchmark->teardown) benchmark->teardown(&bench);
+    qsort(samples, count, sizeof(uint64_t), compareSamples);
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    long peakKb = usage.ru_maxrss;
+#if defined(__APPLE__)
+    peakKb /= 1024;                     // bytes on macOS
+#endif
+    double opsPerSec = count * 1e9 / (double)total;
+    uint64_t itemsPerOp = benchmark->itemsPerOp ? benchmark->itemsPerOp : size;
+    dprintf(resultFd,
+            "{\"benchmark\":\"%s\",\"size\":%llu,\"iterations\":%zu,\"ops_per_sec\":%.2f,\"items_per_sec\":%.0f,"
+            "\"p50_us\":%.2f,\"p90_us\":%.2f,\"p99_us\":%.2f,\"max_us\":%.2f,\"peak_rss_kb\":%ld}\n",
+            benchmark->name, (unsigned long long)size, count, opsPerSec, opsPerSec * itemsPerOp,
+            percentileUs(samples, count, 0.5), percentileUs(samples, count, 0.9),
+            percentileUs(samples, count, 0.99), samples[count - 1] / 1000.0, peakKb);
+    free(samples);
+}
+
+static void printUsage(const char *program) {
+    fprintf(stderr, "Usage: %s [--quick] [benchmark...]\n", program);
+    fprintf(stderr, "  --quick   cap sizes at 5000 characters and 100000 lines/entries\n");
+    fprintf(stderr, "Benchmarks:");
+    for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) fprintf(stderr, " %s", benchmarks[i].name);
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char *argv[]) {
+    const char *selected[sizeof(benchmarks) / sizeof(benchmarks[0])];
+    int selectedCount = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quick") == 0) {
+            quickMode = 1;
+            continue;
+        }
+        size_t j = 0;
+        while (j < sizeof(benchmarks) / sizeof(benchmarks[0]) && strcmp(argv[i], benchmarks[j].name) != 0) j++;
+        if (j == sizeof(benchmarks) / sizeof(benchmarks[0])) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        selected[selectedCount++] = benchmarks[j].name;
+    }
+
+    // Work in a scratch directory so the real leaderboard is never touched
+    char scratch[] = "/tmp/typingtutor-bench.XXXXXX";
+    CHECK_FILE_OP(mkdtemp(scratch), "Error creating benchmark directory");
+    CHECK_FILE_OP(chdir(scratch) == 0, "Error entering benchmark directory");
+    resultFd = dup(STDOUT_FILENO);
+    fflush(stdout);
+
+    int failed = 0;
+    for (size_t b = 0; b < sizeof(benchmarks) / sizeof(benchmarks[0]); b++) {
+        const Benchmark *benchmark = &benchmarks[b];
+        int wanted = selectedCount == 0;
+        for (int i = 0; i < selectedCount; i++) wanted |= strcmp(selected[i], benchmark->name) == 0;
+        if (!wanted) continue;
+
+        for (int s = 0; s < benchmark->sizeCount; s++) {
+            uint64_t size = benchmark->sizes[s];
+            if (quickMode && size > (benchmark->sizes == paragraphSizes ? 5000u : 100000u)) continue;
+            fprintf(stderr, "%s %llu...\n", benchmark->name, (unsigned long long)size);
+
+            pid_t pid = fork();
+            CHECK_FILE_OP(pid >= 0, "Error forking benchmark");
+            if (pid == 0) {
+                runCase(benchmark, size);
+                _exit(0);
+            }
+            int status;
+            waitpid(pid, &status, 0);
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                fprintf(stderr, "%s %llu failed\n", benchmark->name, (unsigned long long)size);
+                failed = 1;
+            }
+        }
+    }
+
+    rmdir(scratch);
+    return failed;
+}
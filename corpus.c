@@ -0,0 +1,679 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+
+#include "corpus.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__WINDOWS__)
+    #include <windows.h>
+    #define CORPUS_WINDOWS 1
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define CORPUS_WINDOWS 0
+#endif
+
+typedef struct {
+    char name[CORPUS_NAME_LENGTH];
+    CorpusEntry *entries;
+    uint64_t count;
+    uint64_t capacity;
+} PendingSection;
+
+// Read one line of any length; returns its length without the line ending,
+// or -1 at end of file.
+static long readLine(FILE *file, char **buf, size_t *capacity) {
+    size_t length = 0;
+    if (*capacity == 0) {
+        *capacity = 256;
+        *buf = malloc(*capacity);
+        if (!*buf) return -1;
+    }
+    while (fgets(*buf + length, (int)(*capacity - length), file)) {
+        length += strlen(*buf + length);
+        if (length > 0 && (*buf)[length - 1] == '\n') break;
+        if (length + 1 < *capacity) break;
+        char *grown = realloc(*buf, *capacity * 2);
+        if (!grown) return -1;
+        *buf = grown;
+        *capacity *= 2;
+    }
+    if (length == 0 && feof(file)) return -1;
+    while (length > 0 && ((*buf)[length - 1] == '\n' || (*buf)[length - 1] == '\r')) {
+        (*buf)[--length] = '\0';
+    }
+    return (long)length;
+}
+
+static PendingSection *findOrAddSection(PendingSection **sections, uint32_t *count, const char *name) {
+    for (uint32_t i = 0; i < *count; i++) {
+        if (strcasecmp((*sections)[i].name, name) == 0) return &(*sections)[i];
+    }
+    PendingSection *grown = realloc(*sections, (*count + 1) * sizeof(PendingSection));
+    if (!grown) return NULL;
+    *sections = grown;
+    PendingSection *section = &grown[(*count)++];
+    memset(section, 0, sizeof(*section));
+    strncpy(section->name, name, CORPUS_NAME_LENGTH - 1);
+    return section;
+}
+
+static int appendEntry(PendingSection *section, uint64_t offset, uint32_t length) {
+    if (section->count == section->capacity) {
+        uint64_t capacity = section->capacity ? section->capacity * 2 : 64;
+        CorpusEntry *grown = realloc(section->entries, capacity * sizeof(CorpusEntry));
+        if (!grown) return -1;
+        section->entries = grown;
+        section->capacity = capacity;
+    }
+    section->entries[section->count++] = (CorpusEntry){offset, length, 0};
+    return 0;
+}
+
+static int letterCode(char c) {
+    int folded = tolower((unsigned char)c);
+    return (folded >= 'a' && folded <= 'z') ? folded - 'a' : -1;
+}
+
+int corpusGramId(const char *gram) {
+    size_t length = strlen(gram);
+    if (length < 2 || length > 3) return -1;
+    int id = 0;
+    for (size_t i = 0; i < length; i++) {
+        int code = letterCode(gram[i]);
+        if (code < 0) return -1;
+        id = id * 26 + code;
+    }
+    return length == 2 ? id : 26 * 26 + id;
+}
+
+// Gram ids at every position of text; ids must hold 2 * length entries
+static size_t collectGrams(const char *text, size_t length, int *ids) {
+    size_t count = 0;
+    for (size_t i = 0; i + 1 < length; i++) {
+        int a = letterCode(text[i]), b = letterCode(text[i + 1]);
+        if (a < 0 || b < 0) continue;
+        ids[count++] = a * 26 + b;
+        int c = i + 2 < length ? letterCode(text[i + 2]) : -1;
+        if (c >= 0) ids[count++] = 26 * 26 + (a * 26 + b) * 26 + c;
+    }
+    return count;
+}
+
+// Shared by the index builder and the query so stored and recomputed
+// densities compare exactly
+static float gramDensity(uint32_t occurrences, uint32_t length) {
+    return length ? (float)occurrences / (float)length : 0.0f;
+}
+
+static uint32_t postingKey(const CorpusPosting *posting) {
+    // Non-negative floats order like their bit patterns; inverted for richest first
+    uint32_t bits;
+    memcpy(&bits, &posting->density, sizeof(bits));
+    return ~bits;
+}
+
+// Stable LSD radix sort on the density, richest first. Postings are filled in
+// paragraph order, so ties stay in paragraph order. scratch holds count items.
+static void sortPostings(CorpusPosting *postings, CorpusPosting *scratch, uint64_t count) {
+    if (count < 32) {
+        for (uint64_t i = 1; i < count; i++) {
+            CorpusPosting item = postings[i];
+            uint64_t j = i;
+            while (j > 0 && postingKey(&postings[j - 1]) > postingKey(&item)) {
+                postings[j] = postings[j - 1];
+                j--;
+            }
+            postings[j] = item;
+        }
+        return;
+    }
+    CorpusPosting *from = postings, *to = scratch;
+    for (int shift = 0; shift < 32; shift += 8) {
+        uint64_t buckets[256] = {0};
+        for (uint64_t i = 0; i < count; i++) buckets[(postingKey(&from[i]) >> shift) & 0xFF]++;
+        if (buckets[(postingKey(&from[0]) >> shift) & 0xFF] == count) continue;
+        uint64_t total = 0;
+        for (int b = 0; b < 256; b++) {
+            uint64_t size = buckets[b];
+            buckets[b] = total;
+            total += size;
+        }
+        for (uint64_t i = 0; i < count; i++) to[buckets[(postingKey(&from[i]) >> shift) & 0xFF]++] = from[i];
+        CorpusPosting *swap = from;
+        from = to;
+        to = swap;
+    }
+    if (from != postings) memcpy(postings, from, count * sizeof(CorpusPosting));
+}
+
+// The distinct gram ids of one paragraph, with how often each occurs added
+// to occurrences (which the caller clears again for just those ids)
+static size_t paragraphGrams(const char *text, uint32_t length, uint32_t *occurrences, int **ids, size_t *capacity) {
+    if ((size_t)length * 2 + 2 > *capacity) {
+        size_t grown = (size_t)length * 2 + 2;
+        int *buffer = realloc(*ids, grown * sizeof(int));
+        if (!buffer) return (size_t)-1;
+        *ids = buffer;
+        *capacity = grown;
+    }
+    size_t count = collectGrams(text, length, *ids), distinct = 0;
+    for (size_t i = 0; i < count; i++) {
+        int id = (*ids)[i];
+        if (occurrences[id]++ == 0) (*ids)[distinct++] = id;
+    }
+    return distinct;
+}
+
+// Write the posting lists section by section and then the gram table. A
+// section's postings are placed with a counting pass, so memory stays at one
+// section's postings however many grams the corpus has.
+static int writeGramIndex(FILE *out, const PendingSection *sections, uint32_t numSections, const char *text,
+                          CorpusHeader *header) {
+    uint64_t *counts = malloc(CORPUS_GRAM_IDS * sizeof(uint64_t));
+    uint64_t *fill = malloc(CORPUS_GRAM_IDS * sizeof(uint64_t));
+    uint32_t *occurrences = calloc(CORPUS_GRAM_IDS, sizeof(uint32_t));
+    CorpusGramRecord *records = NULL;
+    size_t recordCount = 0, recordCapacity = 0;
+    CorpusPosting *postings = NULL, *scratch = NULL;
+    uint64_t scratchCapacity = 0;
+    int *ids = NULL;
+    size_t idCapacity = 0;
+    uint64_t postingBase = 0, firstEntry = 0;
+    int failed = !counts || !fill || !occurrences;
+
+    for (uint32_t s = 0; s < numSections && !failed; s++) {
+        const PendingSection *section = &sections[s];
+        memset(counts, 0, CORPUS_GRAM_IDS * sizeof(uint64_t));
+        for (uint64_t p = 0; p < section->count && !failed; p++) {
+            const CorpusEntry *entry = &section->entries[p];
+            size_t count = paragraphGrams(text + entry->offset, entry->length, occurrences, &ids, &idCapacity);
+            if (count == (size_t)-1) {
+                failed = 1;
+                break;
+            }
+            for (size_t i = 0; i < count; i++) {
+                counts[ids[i]]++;
+                occurrences[ids[i]] = 0;
+            }
+        }
+
+        uint64_t total = 0, longest = 0;
+        size_t present = 0;
+        for (int g = 0; g < CORPUS_GRAM_IDS; g++) {
+            fill[g] = total;
+            total += counts[g];
+            present += counts[g] > 0;
+            if (counts[g] > longest) longest = counts[g];
+        }
+        if (!failed && longest > scratchCapacity) {
+            CorpusPosting *grown = realloc(scratch, longest * sizeof(CorpusPosting));
+            if (grown) scratch = grown;
+            scratchCapacity = grown ? longest : scratchCapacity;
+            failed = !grown;
+        }
+        if (!failed && total > 0) {
+            CorpusPosting *grown = realloc(postings, total * sizeof(CorpusPosting));
+            if (grown) postings = grown;
+            failed = !grown;
+        }
+        if (!failed && recordCount + present > recordCapacity) {
+            recordCapacity = (recordCount + present) * 2;
+            CorpusGramRecord *grown = realloc(records, recordCapacity * sizeof(CorpusGramRecord));
+            if (grown) records = grown;
+            failed = !grown;
+        }
+
+        for (uint64_t p = 0; p < section->count && !failed; p++) {
+            const CorpusEntry *entry = &section->entries[p];
+            size_t count = paragraphGrams(text + entry->offset, entry->length, occurrences, &ids, &idCapacity);
+            if (count == (size_t)-1) {
+                failed = 1;
+                break;
+            }
+            for (size_t i = 0; i < count; i++) {
+                postings[fill[ids[i]]++] = (CorpusPosting){(uint32_t)(firstEntry + p),
+                                                           gramDensity(occurrences[ids[i]], entry->length)};
+                occurrences[ids[i]] = 0;
+            }
+        }
+
+        uint64_t start = 0;
+        for (int g = 0; g < CORPUS_GRAM_IDS && !failed; g++) {
+            if (counts[g] == 0) continue;
+            sortPostings(postings + start, scratch, counts[g]);
+            records[recordCount++] = (CorpusGramRecord){s, (uint32_t)g, postingBase + start, counts[g]};
+            start += counts[g];
+        }
+        if (!failed && total > 0) failed = fwrite(postings, sizeof(CorpusPosting), total, out) != total;
+        postingBase += total;
+        firstEntry += section->count;
+    }
+
+    header->postingCount = postingBase;
+    header->gramTableOffset = header->postingTableOffset + postingBase * sizeof(CorpusPosting);
+    header->gramCount = recordCount;
+    if (!failed && recordCount > 0) failed = fwrite(records, sizeof(CorpusGramRecord), recordCount, out) != recordCount;
+
+    free(counts);
+    free(fill);
+    free(occurrences);
+    free(records);
+    free(postings);
+    free(scratch);
+    free(ids);
+    return failed ? -1 : 0;
+}
+
+// Build paragraphs.bin from the "#Section" formatted text file. The output is
+// written to a temporary file and renamed into place so a running backend
+// never maps a half-written corpus.
+int compileCorpus(const char *textPath, const char *binaryPath, uint64_t *paragraphCount, uint32_t *sectionCount) {
+    FILE *in = fopen(textPath, "r");
+    if (!in) {
+        perror(textPath);
+        return -1;
+    }
+
+    char tempPath[1024];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", binaryPath);
+    FILE *out = fopen(tempPath, "wb");
+    if (!out) {
+        perror(tempPath);
+        fclose(in);
+        return -1;
+    }
+
+    CorpusHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CORPUS_MAGIC, sizeof(CORPUS_MAGIC));
+    header.version = CORPUS_VERSION;
+    header.textOffset = sizeof(CorpusHeader);
+    fwrite(&header, sizeof(header), 1, out);
+
+    PendingSection *sections = NULL;
+    uint32_t numSections = 0;
+    PendingSection *current = NULL;
+    char *line = NULL;
+    size_t lineCapacity = 0;
+    // A copy of the text area for building the n-gram index afterwards
+    char *text = NULL;
+    size_t textCapacity = 0;
+    uint64_t textSize = 0;
+    int failed = 0;
+    long length;
+
+    while (!failed && (length = readLine(in, &line, &lineCapacity)) >= 0) {
+        if (line[0] == '#') {
+            current = findOrAddSection(&sections, &numSections, line + 1);
+            failed = (current == NULL);
+            continue;
+        }
+        if (length == 0 || !current) continue;
+        if (textSize + (uint64_t)length + 1 > textCapacity) {
+            size_t capacity = textCapacity ? textCapacity * 2 : 64 * 1024;
+            while (capacity < textSize + (uint64_t)length + 1) capacity *= 2;
+            char *grown = realloc(text, capacity);
+            if (!grown) {
+                failed = 1;
+                break;
+            }
+            text = grown;
+            textCapacity = capacity;
+        }
+        memcpy(text + textSize, line, (size_t)length + 1);
+        if (fwrite(line, 1, (size_t)length + 1, out) != (size_t)length + 1 ||
+            appendEntry(current, textSize, (uint32_t)length) != 0) {
+            failed = 1;
+            break;
+        }
+        textSize += (uint64_t)length + 1;
+    }
+
+    // Pad the text area so the tables that follow are 8-byte aligned
+    static const char padding[8] = {0};
+    size_t pad = (size_t)((8 - (header.textOffset + textSize) % 8) % 8);
+    if (!failed && pad) failed = fwrite(padding, 1, pad, out) != pad;
+
+    header.textSize = textSize;
+    header.sectionCount = numSections;
+    header.sectionTableOffset = header.textOffset + textSize + pad;
+    header.entryTableOffset = header.sectionTableOffset + (uint64_t)numSections * sizeof(CorpusSectionRecord);
+
+    uint64_t firstEntry = 0;
+    for (uint32_t i = 0; i < numSections && !failed; i++) {
+        CorpusSectionRecord record;
+        memset(&record, 0, sizeof(record));
+        memcpy(record.name, sections[i].name, CORPUS_NAME_LENGTH);
+        record.firstEntry = firstEntry;
+        record.entryCount = sections[i].count;
+        firstEntry += sections[i].count;
+        failed = fwrite(&record, sizeof(record), 1, out) != 1;
+    }
+    for (uint32_t i = 0; i < numSections && !failed; i++) {
+        if (sections[i].count > 0) {
+            failed = fwrite(sections[i].entries, sizeof(CorpusEntry), sections[i].count, out) != sections[i].count;
+        }
+    }
+    header.paragraphCount = firstEntry;
+    header.postingTableOffset = header.entryTableOffset + firstEntry * sizeof(CorpusEntry);
+    if (!failed) failed = writeGramIndex(out, sections, numSections, text, &header) != 0;
+
+    if (!failed) {
+        failed = fseek(out, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, out) != 1;
+    }
+    failed |= ferror(in) != 0;
+    failed |= fclose(out) != 0;
+    fclose(in);
+
+    for (uint32_t i = 0; i < numSections; i++) free(sections[i].entries);
+    free(sections);
+    free(line);
+    free(text);
+
+    if (failed) {
+        fprintf(stderr, "Error: Could not write compiled corpus '%s'\n", binaryPath);
+        remove(tempPath);
+        return -1;
+    }
+#if CORPUS_WINDOWS
+    remove(binaryPath);
+#endif
+    if (rename(tempPath, binaryPath) != 0) {
+        perror(binaryPath);
+        remove(tempPath);
+        return -1;
+    }
+    if (paragraphCount) *paragraphCount = header.paragraphCount;
+    if (sectionCount) *sectionCount = numSections;
+    return 0;
+}
+
+static int mapFile(CompiledCorpus *corpus, const char *path) {
+#if CORPUS_WINDOWS
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return -1;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return -1;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        CloseHandle(file);
+        return -1;
+    }
+    void *base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!base) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return -1;
+    }
+    corpus->fileHandle = file;
+    corpus->mappingHandle = mapping;
+    corpus->base = base;
+    corpus->size = (size_t)size.QuadPart;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return -1;
+    }
+    void *base = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return -1;
+    corpus->base = base;
+    corpus->size = (size_t)info.st_size;
+#endif
+    return 0;
+}
+
+int openCompiledCorpus(CompiledCorpus *corpus, const char *path) {
+    memset(corpus, 0, sizeof(*corpus));
+    if (mapFile(corpus, path) != 0) return -1;
+
+    const CorpusHeader *header = (const CorpusHeader *)corpus->base;
+    uint64_t size = corpus->size;
+    if (size < sizeof(CorpusHeader) ||
+        memcmp(header->magic, CORPUS_MAGIC, sizeof(CORPUS_MAGIC)) != 0 ||
+        header->version != CORPUS_VERSION ||
+        header->textOffset > size || header->textSize > size - header->textOffset ||
+        header->sectionTableOffset > size ||
+        (uint64_t)header->sectionCount * sizeof(CorpusSectionRecord) > size - header->sectionTableOffset ||
+        header->entryTableOffset > size ||
+        header->paragraphCount > (size - header->entryTableOffset) / sizeof(CorpusEntry) ||
+        header->postingTableOffset > size ||
+        header->postingCount > (size - header->postingTableOffset) / sizeof(CorpusPosting) ||
+        header->gramTableOffset > size ||
+        header->gramCount > (size - header->gramTableOffset) / sizeof(CorpusGramRecord)) {
+        fprintf(stderr, "Error: '%s' is not a valid compiled corpus\n", path);
+        closeCompiledCorpus(corpus);
+        return -1;
+    }
+
+    corpus->header = header;
+    corpus->text = (const char *)corpus->base + header->textOffset;
+    corpus->sections = (const CorpusSectionRecord *)(corpus->base + header->sectionTableOffset);
+    corpus->entries = (const CorpusEntry *)(corpus->base + header->entryTableOffset);
+    corpus->postings = (const CorpusPosting *)(corpus->base + header->postingTableOffset);
+    corpus->grams = (const CorpusGramRecord *)(corpus->base + header->gramTableOffset);
+    return 0;
+}
+
+void closeCompiledCorpus(CompiledCorpus *corpus) {
+    if (corpus->base) {
+#if CORPUS_WINDOWS
+        UnmapViewOfFile(corpus->base);
+        CloseHandle(corpus->mappingHandle);
+        CloseHandle(corpus->fileHandle);
+#else
+        munmap((void *)corpus->base, corpus->size);
+#endif
+    }
+    memset(corpus, 0, sizeof(*corpus));
+}
+
+void openEmbeddedCorpus(CompiledCorpus *corpus, const EmbeddedCorpus *tables) {
+    memset(corpus, 0, sizeof(*corpus));
+    corpus->header = tables->header;
+    corpus->text = tables->text;
+    corpus->sections = tables->sections;
+    corpus->entries = tables->entries;
+    corpus->postings = tables->postings;
+    corpus->grams = tables->grams;
+}
+
+const CorpusSectionRecord *findCorpusSection(const CompiledCorpus *corpus, const char *name) {
+    for (uint32_t i = 0; i < corpus->header->sectionCount; i++) {
+        const CorpusSectionRecord *section = &corpus->sections[i];
+        if (strncasecmp(section->name, name, CORPUS_NAME_LENGTH) == 0 &&
+            section->firstEntry <= corpus->header->paragraphCount &&
+            section->entryCount <= corpus->header->paragraphCount - section->firstEntry) {
+            return section;
+        }
+    }
+    return NULL;
+}
+
+// Entries are bounds-checked on access rather than all at open time, so a
+// lookup stays O(1) however large the corpus is.
+const char *getCorpusParagraph(const CompiledCorpus *corpus, uint64_t index, uint32_t *length) {
+    if (index >= corpus->header->paragraphCount) return NULL;
+    const CorpusEntry *entry = &corpus->entries[index];
+    if (entry->offset >= corpus->header->textSize ||
+        entry->length >= corpus->header->textSize - entry->offset ||
+        corpus->text[entry->offset + entry->length] != '\0') {
+        return NULL;
+    }
+    if (length) *length = entry->length;
+    return corpus->text + entry->offset;
+}
+
+static const CorpusGramRecord *findGramRecord(const CompiledCorpus *corpus, uint32_t section, uint32_t gram) {
+    uint64_t low = 0, high = corpus->header->gramCount;
+    while (low < high) {
+        uint64_t mid = low + (high - low) / 2;
+        const CorpusGramRecord *record = &corpus->grams[mid];
+        if (record->section < section || (record->section == section && record->gram < gram)) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == corpus->header->gramCount) return NULL;
+    const CorpusGramRecord *record = &corpus->grams[low];
+    if (record->section != section || record->gram != gram ||
+        record->firstPosting > corpus->header->postingCount ||
+        record->postingCount > corpus->header->postingCount - record->firstPosting) {
+        return NULL;
+    }
+    return record;
+}
+
+// The full score of one paragraph, recomputed from its text
+static double scoreParagraph(const CompiledCorpus *corpus, uint64_t index, const int *gramIds, size_t gramCount) {
+    uint32_t length;
+    const char *text = getCorpusParagraph(corpus, index, &length);
+    if (!text) return -1;
+    uint32_t occurrences[CORPUS_MAX_QUERY_GRAMS] = {0};
+    int ids[2];
+    for (uint32_t i = 0; i + 1 < length; i++) {
+        int a = letterCode(text[i]), b = letterCode(text[i + 1]);
+        if (a < 0 || b < 0) continue;
+        int c = i + 2 < length ? letterCode(text[i + 2]) : -1;
+        ids[0] = a * 26 + b;
+        ids[1] = c >= 0 ? 26 * 26 + ids[0] * 26 + c : -1;
+        for (size_t g = 0; g < gramCount; g++) {
+            occurrences[g] += (gramIds[g] == ids[0]) + (gramIds[g] == ids[1]);
+        }
+    }
+    double score = 0;
+    for (size_t g = 0; g < gramCount; g++) {
+        if (occurrences[g]) score += gramDensity(occurrences[g], length);
+    }
+    return score;
+}
+
+// Open-addressing set of entry indexes already scored
+typedef struct {
+    uint64_t *slots;    // index + 1, 0 = empty
+    size_t capacity;
+    size_t count;
+} SeenSet;
+
+static int markSeen(SeenSet *set, uint64_t index) {
+    if ((set->count + 1) * 2 > set->capacity) {
+        size_t capacity = set->capacity ? set->capacity * 2 : 256;
+        uint64_t *slots = calloc(capacity, sizeof(uint64_t));
+        if (!slots) return -1;
+        for (size_t i = 0; i < set->capacity; i++) {
+            if (!set->slots[i]) continue;
+            size_t slot = (size_t)((set->slots[i] * 0x9E3779B97F4A7C15ull) >> 20) & (capacity - 1);
+            while (slots[slot]) slot = (slot + 1) & (capacity - 1);
+            slots[slot] = set->slots[i];
+        }
+        free(set->slots);
+        set->slots = slots;
+        set->capacity = capacity;
+    }
+    size_t slot = (size_t)(((index + 1) * 0x9E3779B97F4A7C15ull) >> 20) & (set->capacity - 1);
+    while (set->slots[slot]) {
+        if (set->slots[slot] == index + 1) return 0;
+        slot = (slot + 1) & (set->capacity - 1);
+    }
+    set->slots[slot] = index + 1;
+    set->count++;
+    return 1;
+}
+
+size_t findGramRichParagraphs(const CompiledCorpus *corpus, const CorpusSectionRecord *section,
+                              const int *gramIds, size_t gramCount, CorpusMatch *matches, size_t maxMatches) {
+    const CorpusGramRecord *lists[CORPUS_MAX_QUERY_GRAMS];
+    int queryIds[CORPUS_MAX_QUERY_GRAMS];
+    uint64_t cursors[CORPUS_MAX_QUERY_GRAMS];
+    size_t listCount = 0, queryCount = 0, found = 0;
+    uint32_t sectionIndex = (uint32_t)(section - corpus->sections);
+
+    for (size_t g = 0; g < gramCount && queryCount < CORPUS_MAX_QUERY_GRAMS; g++) {
+        if (gramIds[g] < 0 || gramIds[g] >= CORPUS_GRAM_IDS) continue;
+        int duplicate = 0;
+        for (size_t i = 0; i < queryCount; i++) duplicate |= queryIds[i] == gramIds[g];
+        if (duplicate) continue;
+        queryIds[queryCount++] = gramIds[g];
+        const CorpusGramRecord *record = findGramRecord(corpus, sectionIndex, (uint32_t)gramIds[g]);
+        if (record && record->postingCount > 0) {
+            cursors[listCount] = 0;
+            lists[listCount++] = record;
+        }
+    }
+    if (maxMatches == 0) return 0;
+
+    SeenSet seen = {0};
+    int failed = 0;
+    while (!failed) {
+        // No paragraph not yet scored can beat the densities at the cursors
+        double threshold = 0;
+        int active = 0;
+        for (size_t l = 0; l < listCount; l++) {
+            if (cursors[l] == lists[l]->postingCount) continue;
+            threshold += corpus->postings[lists[l]->firstPosting + cursors[l]].density;
+            active = 1;
+        }
+        if (!active || (found == maxMatches && matches[found - 1].score >= threshold)) break;
+
+        for (size_t l = 0; l < listCount; l++) {
+            if (cursors[l] == lists[l]->postingCount) continue;
+            uint64_t index = corpus->postings[lists[l]->firstPosting + cursors[l]++].paragraph;
+            if (index < section->firstEntry || index - section->firstEntry >= section->entryCount) continue;
+            int fresh = markSeen(&seen, index);
+            if (fresh < 0) failed = 1;
+            if (fresh <= 0) continue;
+            double score = scoreParagraph(corpus, index, queryIds, queryCount);
+            if (score < 0 || (found == maxMatches && score <= matches[found - 1].score)) continue;
+            size_t slot = found < maxMatches ? found++ : found - 1;
+            while (slot > 0 && matches[slot - 1].score < score) {
+                matches[slot] = matches[slot - 1];
+                slot--;
+            }
+            matches[slot] = (CorpusMatch){index, score};
+        }
+    }
+    free(seen.slots);
+    return found;
+}
+
+static uint64_t mixBits(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ull;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+// A four-round Feistel network over the smallest even-bit domain holding
+// count, walking the cycle until the value lands inside [0, count). The
+// domain is at most 4 * count, so that takes a few steps on average.
+uint64_t shuffledCorpusIndex(uint64_t seed, uint64_t position, uint64_t count) {
+    if (count <= 1) return 0;
+    int halfBits = 1;
+    while (halfBits < 32 && (1ull << (2 * halfBits)) < count) halfBits++;
+    uint64_t mask = (1ull << halfBits) - 1;
+    uint64_t value = position % count;
+    do {
+        uint64_t left = value >> halfBits, right = value & mask;
+        for (uint64_t round = 0; round < 4; round++) {
+            uint64_t next = left ^ (mixBits(right ^ seed ^ (round << 56)) & mask);
+            left = right;
+            right = next;
+        }
+        value = (left << halfBits) | right;
+    } while (value >= count);
+    return value;
+}
@@ -0,0 +1,116 @@
+#ifndef CORPUS_H
+#define CORPUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Compiled paragraph corpus (paragraphs.bin), produced from paragraphs.txt by
+// `typingtutor --compile-corpus`. Layout, all integers in host byte order:
+//
+//   CorpusHeader | paragraph text | CorpusSectionRecord[] | CorpusEntry[]
+//   | CorpusPosting[] | CorpusGramRecord[]
+//
+// Every paragraph in the text area is NUL-terminated so it can be handed out
+// straight from the mapping. A section's entries are contiguous.
+//
+// The n-gram index maps every letter bigram and trigram (case-folded) of a
+// section to a posting list of the paragraphs containing it, richest first.
+// Gram records are sorted by (section, gram) and found by binary search.
+
+#define CORPUS_MAGIC "TTCORP1"
+#define CORPUS_VERSION 2
+#define CORPUS_NAME_LENGTH 24
+#define CORPUS_GRAM_IDS (26 * 26 + 26 * 26 * 26)
+#define CORPUS_MAX_QUERY_GRAMS 16
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t sectionCount;
+    uint64_t paragraphCount;
+    uint64_t textOffset;
+    uint64_t textSize;
+    uint64_t sectionTableOffset;
+    uint64_t entryTableOffset;
+    uint64_t postingTableOffset;
+    uint64_t postingCount;
+    uint64_t gramTableOffset;
+    uint64_t gramCount;
+} CorpusHeader;
+
+typedef struct {
+    char name[CORPUS_NAME_LENGTH];
+    uint64_t firstEntry;
+    uint64_t entryCount;
+} CorpusSectionRecord;
+
+typedef struct {
+    uint64_t offset;    // relative to the start of the text area
+    uint32_t length;
+    uint32_t reserved;
+} CorpusEntry;
+
+typedef struct {
+    uint32_t section;
+    uint32_t gram;          // corpusGramId()
+    uint64_t firstPosting;
+    uint64_t postingCount;
+} CorpusGramRecord;
+
+typedef struct {
+    uint32_t paragraph;     // entry index
+    float density;          // occurrences per character of the paragraph
+} CorpusPosting;
+
+typedef struct {
+    uint64_t paragraph;     // entry index
+    double score;           // summed density of the query grams
+} CorpusMatch;
+
+typedef struct {
+    const unsigned char *base;
+    size_t size;
+    const CorpusHeader *header;
+    const CorpusSectionRecord *sections;
+    const CorpusEntry *entries;
+    const CorpusPosting *postings;
+    const CorpusGramRecord *grams;
+    const char *text;
+    void *fileHandle;       // Windows file and mapping handles
+    void *mappingHandle;
+} CompiledCorpus;
+
+// The same tables compiled into the binary as C arrays (paragraphs.h, written
+// by embed_corpus), so a corpus is available without touching the filesystem
+typedef struct {
+    const CorpusHeader *header;
+    const char *text;
+    const CorpusSectionRecord *sections;
+    const CorpusEntry *entries;
+    const CorpusPosting *postings;
+    const CorpusGramRecord *grams;
+} EmbeddedCorpus;
+
+int compileCorpus(const char *textPath, const char *binaryPath, uint64_t *paragraphCount, uint32_t *sectionCount);
+int openCompiledCorpus(CompiledCorpus *corpus, const char *path);
+void closeCompiledCorpus(CompiledCorpus *corpus);
+// Point corpus at embedded tables; it owns nothing, and closing it is a no-op
+void openEmbeddedCorpus(CompiledCorpus *corpus, const EmbeddedCorpus *tables);
+const CorpusSectionRecord *findCorpusSection(const CompiledCorpus *corpus, const char *name);
+const char *getCorpusParagraph(const CompiledCorpus *corpus, uint64_t index, uint32_t *length);
+
+// Index of a two- or three-letter gram such as "qu" or "ing", or -1
+int corpusGramId(const char *gram);
+
+// The paragraphs of a section with the highest summed density of the given
+// grams, best first. Walks the posting lists richest-first and stops once no
+// unseen paragraph can beat the current top maxMatches (threshold algorithm),
+// so only a short prefix of each list is read. Returns the number found.
+size_t findGramRichParagraphs(const CompiledCorpus *corpus, const CorpusSectionRecord *section,
+                              const int *gramIds, size_t gramCount, CorpusMatch *matches, size_t maxMatches);
+
+// Position -> index as a seeded bijection on [0, count), so a no-repeat
+// shuffle is just a seed and a position however large the corpus is
+uint64_t shuffledCorpusIndex(uint64_t seed, uint64_t position, uint64_t count);
+
+#endif
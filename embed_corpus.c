@@ -0,0 +1,218 @@
+// Build step that turns the paragraph corpus and leaderboard into C headers,
+// so the backend can serve paragraphs and a seed leaderboard with no files at
+// all (kiosks, read-only media):
+//
+//   gcc embed_corpus.c corpus.c leaderboard_store.c -o build/embed_corpus
+//   ./build/embed_corpus build/paragraphs.txt build/leaderboard.txt paragraphs.h leaderboard.h
+//
+// paragraphs.h holds the compiled corpus tables of corpus.h (text, section
+// table, per-section entry offsets and the n-gram index) as static arrays;
+// leaderboard.h holds the leaderboard entries, fastest first per difficulty.
+// Rebuild the backend afterwards.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "corpus.h"
+#include "leaderboard_store.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__WINDOWS__)
+    #define EMBED_WINDOWS 1
+#else
+    #define EMBED_WINDOWS 0
+#endif
+
+#define max_embed_path 1024
+
+// A C string literal; octal escapes are always three digits so the next
+// character can never extend them
+static void writeCString(FILE *out, const char *text, size_t length) {
+    fputc('"', out);
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (c == '"' || c == '\\' || c == '?') {
+            fprintf(out, "\\%c", c);
+        } else if (c < 0x20 || c >= 0x7F) {
+            fprintf(out, "\\%03o", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+static FILE *openTempHeader(const char *path, char *tempPath, size_t size) {
+    snprintf(tempPath, size, "%s.tmp", path);
+    FILE *out = fopen(tempPath, "w");
+    if (!out) perror(tempPath);
+    return out;
+}
+
+static int finishHeader(FILE *out, const char *tempPath, const char *path) {
+    int failed = ferror(out) != 0;
+    failed |= fclose(out) != 0;
+    if (failed) {
+        fprintf(stderr, "Error: Could not write '%s'\n", tempPath);
+        remove(tempPath);
+        return -1;
+    }
+#if EMBED_WINDOWS
+    remove(path);
+#endif
+    if (rename(tempPath, path) != 0) {
+        perror(path);
+        remove(tempPath);
+        return -1;
+    }
+    return 0;
+}
+
+// C has no empty arrays, so an empty table gets one zeroed placeholder; the
+// counts in the header keep it from ever being read
+static int writeCorpusHeader(const CompiledCorpus *corpus, const char *sourcePath, const char *path) {
+    char tempPath[max_embed_path + 8];
+    FILE *out = openTempHeader(path, tempPath, sizeof(tempPath));
+    if (!out) return -1;
+    const CorpusHeader *header = corpus->header;
+
+    fprintf(out, "// Generated from %s by embed_corpus.c; do not edit.\n", sourcePath);
+    fprintf(out, "// The compiled paragraph corpus, served when neither paragraphs.txt nor\n");
+    fprintf(out, "// paragraphs.bin exists.\n");
+    fprintf(out, "#ifndef EMBEDDED_PARAGRAPHS_H\n#define EMBEDDED_PARAGRAPHS_H\n\n#include \"corpus.h\"\n\n");
+
+    // Every paragraph is its own literal, NUL included, so entry offsets match
+    fprintf(out, "static const char embedded_corpus_text[] =\n");
+    if (header->textSize == 0) fprintf(out, "    \"\"");
+    for (uint64_t offset = 0; offset < header->textSize;) {
+        size_t length = strlen(corpus->text + offset);
+        fprintf(out, "    ");
+        writeCString(out, corpus->text + offset, length);
+        fprintf(out, " \"\\000\"");
+        offset += length + 1;
+        if (offset < header->textSize) fputc('\n', out);
+    }
+    fprintf(out, ";\n\n");
+
+    fprintf(out, "static const CorpusSectionRecord embedded_corpus_sections[] = {\n");
+    for (uint32_t i = 0; i < header->sectionCount; i++) {
+        const CorpusSectionRecord *section = &corpus->sections[i];
+        fprintf(out, "    {");
+        writeCString(out, section->name, strnlen(section->name, CORPUS_NAME_LENGTH));
+        fprintf(out, ", %llu, %llu},\n", (unsigned long long)section->firstEntry,
+                (unsigned long long)section->entryCount);
+    }
+    if (header->sectionCount == 0) fprintf(out, "    {\"\", 0, 0},\n");
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const CorpusEntry embedded_corpus_entries[] = {\n");
+    for (uint64_t i = 0; i < header->paragraphCount; i++) {
+        fprintf(out, "%s{%llu, %u, 0},", i % 4 == 0 ? "    " : " ", (unsigned long long)corpus->entries[i].offset,
+                corpus->entries[i].length);
+        if (i % 4 == 3 || i + 1 == header->paragraphCount) fputc('\n', out);
+    }
+    if (header->paragraphCount == 0) fprintf(out, "    {0, 0, 0},\n");
+    fprintf(out, "};\n\n");
+
+    // Densities in hex so they round-trip bit for bit
+    fprintf(out, "static const CorpusPosting embedded_corpus_postings[] = {\n");
+    for (uint64_t i = 0; i < header->postingCount; i++) {
+        fprintf(out, "%s{%u, %af},", i % 4 == 0 ? "    " : " ", corpus->postings[i].paragraph,
+                (double)corpus->postings[i].density);
+        if (i % 4 == 3 || i + 1 == header->postingCount) fputc('\n', out);
+    }
+    if (header->postingCount == 0) fprintf(out, "    {0, 0.0f},\n");
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const CorpusGramRecord embedded_corpus_grams[] = {\n");
+    for (uint64_t i = 0; i < header->gramCount; i++) {
+        const CorpusGramRecord *gram = &corpus->grams[i];
+        fprintf(out, "%s{%u, %u, %llu, %llu},", i % 4 == 0 ? "    " : " ", gram->section, gram->gram,
+                (unsigned long long)gram->firstPosting, (unsigned long long)gram->postingCount);
+        if (i % 4 == 3 || i + 1 == header->gramCount) fputc('\n', out);
+    }
+    if (header->gramCount == 0) fprintf(out, "    {0, 0, 0, 0},\n");
+    fprintf(out, "};\n\n");
+
+    // Table offsets are meaningless outside a file and stay zero
+    fprintf(out, "static const CorpusHeader embedded_corpus_header = {\n");
+    fprintf(out, "    CORPUS_MAGIC, CORPUS_VERSION, %u, %llu, 0, %llu, 0, 0, 0, %llu, 0, %llu\n};\n\n",
+            header->sectionCount, (unsigned long long)header->paragraphCount,
+            (unsigned long long)header->textSize, (unsigned long long)header->postingCount,
+            (unsigned long long)header->gramCount);
+
+    fprintf(out, "static const EmbeddedCorpus embedded_corpus = {\n");
+    fprintf(out, "    &embedded_corpus_header, embedded_corpus_text, embedded_corpus_sections,\n");
+    fprintf(out, "    embedded_corpus_entries, embedded_corpus_postings, embedded_corpus_grams\n};\n\n");
+    fprintf(out, "#endif\n");
+    return finishHeader(out, tempPath, path);
+}
+
+static int writeLeaderboardHeader(const LeaderboardStore *store, const char *sourcePath, const char *path) {
+    char tempPath[max_embed_path + 8];
+    FILE *out = openTempHeader(path, tempPath, sizeof(tempPath));
+    if (!out) return -1;
+
+    fprintf(out, "// Generated from %s by embed_corpus.c; do not edit.\n", sourcePath);
+    fprintf(out, "// Seed leaderboard, shown when there is no leaderboard.txt and the working\n");
+    fprintf(out, "// directory is read-only.\n");
+    fprintf(out, "#ifndef EMBEDDED_LEADERBOARD_H\n#define EMBEDDED_LEADERBOARD_H\n\n");
+    fprintf(out, "#include \"leaderboard_store.h\"\n\n");
+    fprintf(out, "static const LeaderboardEntry embedded_leaderboard[] = {\n");
+    size_t count = 0;
+    for (int i = 0; i < store->indexCount; i++) {
+        for (const LeaderboardNode *node = leaderboardFirst(store, store->indexes[i].difficulty); node;
+             node = leaderboardNext(node)) {
+            fprintf(out, "    {");
+            writeCString(out, node->entry.username, strlen(node->entry.username));
+            fprintf(out, ", %.2f, %.2f, %.2f, ", node->entry.typingSpeed, node->entry.wordsPerMinute,
+                    node->entry.accuracy);
+            writeCString(out, node->entry.difficulty, strlen(node->entry.difficulty));
+            fprintf(out, "},\n");
+            count++;
+        }
+    }
+    if (count == 0) fprintf(out, "    {\"\", 0, 0, 0, \"\"},\n");
+    fprintf(out, "};\n\nstatic const size_t embedded_leaderboard_count = %zu;\n\n#endif\n", count);
+    return finishHeader(out, tempPath, path);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 5) {
+        fprintf(stderr, "Usage: %s <paragraphs.txt> <leaderboard.txt> <paragraphs.h> <leaderboard.h>\n", argv[0]);
+        return 1;
+    }
+    const char *textPath = argv[1], *leaderboardPath = argv[2];
+    const char *corpusHeaderPath = argv[3], *leaderboardHeaderPath = argv[4];
+    if (strlen(corpusHeaderPath) >= max_embed_path || strlen(leaderboardHeaderPath) >= max_embed_path) {
+        fprintf(stderr, "Error: Output path too long\n");
+        return 1;
+    }
+
+    // Reuse the corpus compiler, then dump its tables
+    char binaryPath[max_embed_path + 8];
+    snprintf(binaryPath, sizeof(binaryPath), "%s.bin", corpusHeaderPath);
+    uint64_t paragraphCount;
+    uint32_t sectionCount;
+    if (compileCorpus(textPath, binaryPath, &paragraphCount, &sectionCount) != 0) return 1;
+    CompiledCorpus corpus;
+    int status = openCompiledCorpus(&corpus, binaryPath) == 0 ? 0 : 1;
+    if (status == 0) {
+        status = writeCorpusHeader(&corpus, textPath, corpusHeaderPath) == 0 ? 0 : 1;
+        closeCompiledCorpus(&corpus);
+    }
+    remove(binaryPath);
+    if (status != 0) return status;
+
+    // A missing leaderboard just embeds an empty one
+    LeaderboardStore store;
+    initLeaderboardStore(&store);
+    replayLeaderboardFile(&store, leaderboardPath, 0);
+    status = writeLeaderboardHeader(&store, leaderboardPath, leaderboardHeaderPath) == 0 ? 0 : 1;
+    freeLeaderboardStore(&store);
+    if (status != 0) return status;
+
+    printf("Embedded %llu paragraphs in %u sections into %s and the leaderboard into %s\n",
+           (unsigned long long)paragraphCount, sectionCount, corpusHeaderPath, leaderboardHeaderPath);
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include <string.h>
+#include <errno.h>
+
+#include "file_lock.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__WINDOWS__)
+    #include <io.h>
+    #include <windows.h>
+    #define FILE_LOCK_WINDOWS 1
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #define FILE_LOCK_WINDOWS 0
+#endif
+
+int lockFileByte(int fd, long byte, int exclusive, int wait) {
+#if FILE_LOCK_WINDOWS
+    OVERLAPPED overlapped;
+    memset(&overlapped, 0, sizeof(overlapped));
+    overlapped.Offset = (DWORD)byte;
+    DWORD flags = (exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0) | (wait ? 0 : LOCKFILE_FAIL_IMMEDIATELY);
+    return LockFileEx((HANDLE)_get_osfhandle(fd), flags, 0, 1, 0, &overlapped) ? 0 : -1;
+#else
+    struct flock lock;
+    memset(&lock, 0, sizeof(lock));
+    lock.l_type = exclusive ? F_WRLCK : F_RDLCK;
+    lock.l_whence = SEEK_SET;
+    lock.l_start = byte;
+    lock.l_len = 1;
+    while (fcntl(fd, wait ? F_SETLKW : F_SETLK, &lock) != 0) {
+        if (!wait || errno != EINTR) return -1;
+    }
+    return 0;
+#endif
+}
+
+void unlockFileByte(int fd, long byte) {
+#if FILE_LOCK_WINDOWS
+    OVERLAPPED overlapped;
+    memset(&overlapped, 0, sizeof(overlapped));
+    overlapped.Offset = (DWORD)byte;
+    UnlockFileEx((HANDLE)_get_osfhandle(fd), 0, 1, 0, &overlapped);
+#else
+    struct flock lock;
+    memset(&lock, 0, sizeof(lock));
+    lock.l_type = F_UNLCK;
+    lock.l_whence = SEEK_SET;
+    lock.l_start = byte;
+    lock.l_len = 1;
+    fcntl(fd, F_SETLK, &lock);
+#endif
+}
@@ -0,0 +1,14 @@
+#ifndef FILE_LOCK_H
+#define FILE_LOCK_H
+
+// Advisory locks on single bytes of an open file, used by every on-disk
+// store: fcntl record locks on POSIX, LockFileEx on Windows. The byte does
+// not have to exist in the file. POSIX locks belong to the process, so they
+// do not keep the threads of one process apart, and closing any descriptor
+// of the file drops all of them.
+
+// 0 once the lock is held. Without wait, -1 at once if someone else holds it.
+int lockFileByte(int fd, long byte, int exclusive, int wait);
+void unlockFileByte(int fd, long byte);
+
+#endif
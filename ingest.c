@@ -0,0 +1,669 @@
+// Corpus ingestion: turns large plain-text dumps (public-domain books and the
+// like) into a graded paragraphs.txt, and optionally a compiled
+// paragraphs.bin, without any hand curation.
+//
+//   gcc -O2 ingest.c corpus.c thread_pool.c -o build/ingest -lm -pthread
+//   ./build/ingest --output build/paragraphs.txt --compile build/paragraphs.bin books/*.txt
+//
+// Input is read in large batches cut into blocks at blank lines. Each block
+// is split into paragraphs and sentences, normalized to typeable ASCII, packed
+// into passages, hashed and measured on its own thread. Passages are then
+// deduplicated by content hash, first occurrence winning, and graded into
+// equal thirds Easy/Medium/Hard by a difficulty score built from character
+// rarity, punctuation density, word length, same-finger bigrams and shifted
+// characters.
+
+#include <ctype.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "corpus.h"
+#include "thread_pool.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__WINDOWS__)
+    #define INGEST_WINDOWS 1
+#else
+    #define INGEST_WINDOWS 0
+#endif
+
+#define ingest_block_bytes (1 << 20)
+#define ingest_batch_blocks 64
+#define ingest_header_scan (64 * 1024)
+#define max_ingest_path 1024
+
+// Stands in for a character with no typeable ASCII form; sentences holding
+// one are dropped
+#define UNTYPEABLE '\x01'
+
+enum {
+    FEATURE_RARITY,         // mean information of the letters, in bits
+    FEATURE_PUNCTUATION,    // punctuation per character
+    FEATURE_WORD_LENGTH,    // mean letters per word
+    FEATURE_SAME_FINGER,    // letter bigrams typed with one finger, per bigram
+    FEATURE_SHIFT,          // capitals and shifted symbols per character
+    FEATURE_COUNT
+};
+
+static const double featureWeights[FEATURE_COUNT] = {1.0, 1.0, 1.5, 1.0, 0.75};
+static const char *gradeNames[3] = {"Easy", "Medium", "Hard"};
+
+// English letter frequencies, percent
+static const double letterFrequency[26] = {
+    8.167, 1.492, 2.782, 4.253, 12.702, 2.228, 2.015, 6.094, 6.966, 0.153, 0.772, 4.025, 2.406,
+    6.749, 7.507, 1.929, 0.095, 5.987, 6.327, 9.056, 2.758, 0.978, 2.360, 0.150, 1.974, 0.074
+};
+
+// QWERTY touch-typing finger per letter, 0 = left pinky ... 7 = right pinky
+static const unsigned char letterFinger[26] = {
+    0, 3, 2, 2, 2, 3, 3, 4, 5, 4, 5, 6, 4, 4, 6, 7, 0, 3, 1, 3, 4, 3, 1, 1, 4, 0
+};
+
+typedef struct {
+    int threads;
+    size_t minLength;
+    size_t maxLength;
+    const char *outputPath;
+    const char *binaryPath;
+} IngestConfig;
+
+typedef struct {
+    uint64_t hash;
+    size_t offset;          // into the owning text buffer
+    uint32_t length;
+    float features[FEATURE_COUNT];
+} Passage;
+
+// One blank-line-aligned slice of a batch and what its worker made of it
+typedef struct {
+    const char *data;
+    size_t size;
+    char *text;             // accepted passages, NUL-separated
+    size_t textLength;
+    size_t textCapacity;
+    Passage *passages;
+    size_t count;
+    size_t capacity;
+    size_t rejected;        // sentences too long, untypeable, or passages too short
+} Block;
+
+typedef struct {
+    Block *blocks;
+    size_t blockCount;
+} Batch;
+
+// Everything kept after deduplication
+typedef struct {
+    char *text;
+    size_t textLength;
+    size_t textCapacity;
+    Passage *passages;
+    size_t count;
+    size_t capacity;
+    uint64_t *hashSlots;    // open addressing, 0 = empty
+    size_t hashCapacity;
+    size_t duplicates;
+    size_t rejected;
+} Corpus;
+
+static IngestConfig config;
+static double letterBits[26];
+
+static void *checkedRealloc(void *ptr, size_t size) {
+    void *grown = realloc(ptr, size);
+    if (!grown) {
+        perror("Memory allocation error for ingestion");
+        exit(EXIT_FAILURE);
+    }
+    return grown;
+}
+
+static void appendText(char **text, size_t *length, size_t *capacity, const char *data, size_t size) {
+    if (*length + size > *capacity) {
+        size_t grown = *capacity ? *capacity * 2 : 64 * 1024;
+        while (grown < *length + size) grown *= 2;
+        *text = checkedRealloc(*text, grown);
+        *capacity = grown;
+    }
+    memcpy(*text + *length, data, size);
+    *length += size;
+}
+
+static int isBlankLineAt(const char *data, size_t size, size_t pos, size_t *lineEnd) {
+    while (pos < size && (data[pos] == ' ' || data[pos] == '\t' || data[pos] == '\r')) pos++;
+    if (pos < size && data[pos] == '\n') {
+        *lineEnd = pos + 1;
+        return 1;
+    }
+    return 0;
+}
+
+// First paragraph boundary at or after from: the end of a blank line
+static size_t findBlockCut(const char *data, size_t size, size_t from) {
+    for (const char *hit = memchr(data + from, '\n', size - from); hit;
+         hit = memchr(hit + 1, '\n', size - (size_t)(hit + 1 - data))) {
+        size_t lineEnd;
+        if (isBlankLineAt(data, size, (size_t)(hit + 1 - data), &lineEnd)) return lineEnd;
+        if (hit + 1 == data + size) break;
+    }
+    return 0;
+}
+
+// ---- Normalization ----
+
+// Append the typeable form of one line, mapping common typographic UTF-8 to
+// ASCII. Whitespace runs collapse to one space.
+static void normalizeLine(const char *line, size_t size, char **out, size_t *length, size_t *capacity) {
+    for (size_t i = 0; i < size; i++) {
+        unsigned char c = (unsigned char)line[i];
+        const char *mapped = NULL;
+        char single[2] = {0, 0};
+        if (c < 0x80) {
+            if (c == '_') continue;                 // _emphasis_ markup in plain-text books
+            single[0] = (c < 0x20 || c == 0x7F) ? ' ' : (char)c;
+            mapped = single;
+        } else {
+            size_t extra = (c >= 0xF0) ? 3 : (c >= 0xE0) ? 2 : (c >= 0xC0) ? 1 : 0;
+            const unsigned char *seq = (const unsigned char *)line + i;
+            if (extra == 1 && i + 1 < size && seq[0] == 0xC2 && seq[1] == 0xA0) {
+                mapped = " ";
+            } else if (extra == 2 && i + 2 < size && seq[0] == 0xE2 && seq[1] == 0x80) {
+                switch (seq[2]) {
+                    case 0x98: case 0x99: case 0xB2: mapped = "'"; break;
+                    case 0x9C: case 0x9D: case 0xB3: mapped = "\""; break;
+                    case 0x90: case 0x91: case 0x92: case 0x93: case 0x94: case 0x95: mapped = "-"; break;
+                    case 0xA6: mapped = "..."; break;
+                    default: break;
+                }
+            }
+            if (!mapped) {
+                single[0] = UNTYPEABLE;
+                mapped = single;
+            }
+            i += (extra < size - i) ? extra : size - i - 1;
+        }
+        for (; *mapped; mapped++) {
+            if (*mapped == ' ' && (*length == 0 || (*out)[*length - 1] == ' ')) continue;
+            appendText(out, length, capacity, mapped, 1);
+        }
+    }
+}
+
+// ---- Measurement ----
+
+static void measurePassage(const char *text, size_t length, float *features) {
+    double bits = 0;
+    size_t letters = 0, punctuation = 0, shifted = 0, words = 0, bigrams = 0, sameFinger = 0;
+    int previous = -1;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (isalpha(c)) {
+            int code = tolower(c) - 'a';
+            bits += letterBits[code];
+            letters++;
+            if (previous < 0) {
+                words++;
+            } else {
+                bigrams++;
+                sameFinger += previous != code && letterFinger[previous] == letterFinger[code];
+            }
+            if (isupper(c)) shifted++;
+            previous = code;
+            continue;
+        }
+        previous = -1;
+        if (ispunct(c)) {
+            punctuation++;
+            if (strchr("~!@#$%^&*()_+{}|:\"<>?", c)) shifted++;
+        }
+    }
+    features[FEATURE_RARITY] = letters ? (float)(bits / (double)letters) : 0;
+    features[FEATURE_PUNCTUATION] = (float)punctuation / (float)length;
+    features[FEATURE_WORD_LENGTH] = words ? (float)letters / (float)words : 0;
+    features[FEATURE_SAME_FINGER] = bigrams ? (float)sameFinger / (float)bigrams : 0;
+    features[FEATURE_SHIFT] = (float)shifted / (float)length;
+}
+
+// FNV-1a over letters and digits only, case-folded, so passages differing
+// only in punctuation, spacing or capitalization count as duplicates
+static uint64_t contentHash(const char *text, size_t length) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (!isalnum(c)) continue;
+        hash ^= (unsigned char)tolower(c);
+        hash *= 1099511628211ull;
+    }
+    return hash ? hash : 1;
+}
+
+// ---- Splitting ----
+
+static int isAbbreviation(const char *text, size_t dot) {
+    static const char *titles[] = {"Mr", "Mrs", "Ms", "Dr", "St", "Jr", "Sr", "Mt", "vs", "etc", "No"};
+    size_t start = dot;
+    while (start > 0 && isalpha((unsigned char)text[start - 1])) start--;
+    size_t length = dot - start;
+    if (length == 1 && isupper((unsigned char)text[start])) return 1;     // initials
+    for (size_t i = 0; i < sizeof(titles) / sizeof(titles[0]); i++) {
+        if (strlen(titles[i]) == length && strncmp(text + start, titles[i], length) == 0) return 1;
+    }
+    return 0;
+}
+
+// End of the sentence starting at from: just past its closing punctuation
+// (and any closing quotes), or the end of the paragraph
+static size_t sentenceEnd(const char *text, size_t length, size_t from) {
+    for (size_t i = from; i < length; i++) {
+        if (text[i] != '.' && text[i] != '!' && text[i] != '?') continue;
+        size_t end = i + 1;
+        while (end < length && strchr("\"')]", text[end])) end++;
+        if (end == length) return end;
+        if (text[end] != ' ' || end + 1 >= length) continue;
+        unsigned char next = (unsigned char)text[end + 1];
+        if ((isupper(next) || next == '"' || next == '\'' || next == '(') && !(text[i] == '.' && isAbbreviation(text, i))) {
+            return end;
+        }
+    }
+    return length;
+}
+
+static void emitPassage(Block *block, const char *text, size_t length) {
+    if (length < config.minLength) {
+        block->rejected++;
+        return;
+    }
+    size_t letters = 0;
+    for (size_t i = 0; i < length; i++) letters += isalpha((unsigned char)text[i]) != 0;
+    // Tables, verse numbering and the like
+    if (letters * 10 < length * 6) {
+        block->rejected++;
+        return;
+    }
+    if (block->count == block->capacity) {
+        block->capacity = block->capacity ? block->capacity * 2 : 256;
+        block->passages = checkedRealloc(block->passages, block->capacity * sizeof(Passage));
+    }
+    Passage *passage = &block->passages[block->count++];
+    passage->hash = contentHash(text, length);
+    passage->offset = block->textLength;
+    passage->length = (uint32_t)length;
+    measurePassage(text, length, passage->features);
+    appendText(&block->text, &block->textLength, &block->textCapacity, text, length);
+    appendText(&block->text, &block->textLength, &block->textCapacity, "", 1);
+}
+
+// Pack whole sentences into passages of at most maxLength characters
+static void splitParagraph(Block *block, const char *text, size_t length) {
+    size_t passageStart = 0, passageEnd = 0;
+    int open = 0;
+    for (size_t start = 0; start < length;) {
+        size_t end = sentenceEnd(text, length, start);
+        int untypeable = memchr(text + start, UNTYPEABLE, end - start) != NULL;
+        if (untypeable || end - start > config.maxLength) {
+            if (open) emitPassage(block, text + passageStart, passageEnd - passageStart);
+            block->rejected++;
+            open = 0;
+        } else if (open && end - passageStart <= config.maxLength) {
+            passageEnd = end;
+        } else {
+            if (open) emitPassage(block, text + passageStart, passageEnd - passageStart);
+            passageStart = start;
+            passageEnd = end;
+            open = 1;
+        }
+        start = end;
+        while (start < length && text[start] == ' ') start++;
+    }
+    if (open) emitPassage(block, text + passageStart, passageEnd - passageStart);
+}
+
+static void processBlock(void *context, size_t index, int worker) {
+    (void)worker;
+    Block *block = &((Batch *)context)->blocks[index];
+    char *paragraph = NULL;
+    size_t paragraphLength = 0, paragraphCapacity = 0;
+    size_t pos = 0;
+    while (pos < block->size) {
+        const char *newline = memchr(block->data + pos, '\n', block->size - pos);
+        size_t lineEnd = newline ? (size_t)(newline - block->data) : block->size;
+        size_t blankEnd;
+        if (isBlankLineAt(block->data, block->size, pos, &blankEnd) || lineEnd == pos) {
+            while (paragraphLength > 0 && paragraph[paragraphLength - 1] == ' ') paragraphLength--;
+            if (paragraphLength > 0) splitParagraph(block, paragraph, paragraphLength);
+            paragraphLength = 0;
+        } else {
+            if (paragraphLength > 0 && paragraph[paragraphLength - 1] != ' ') {
+                appendText(&paragraph, &paragraphLength, &paragraphCapacity, " ", 1);
+            }
+            normalizeLine(block->data + pos, lineEnd - pos, &paragraph, &paragraphLength, &paragraphCapacity);
+        }
+        pos = lineEnd + 1;
+    }
+    while (paragraphLength > 0 && paragraph[paragraphLength - 1] == ' ') paragraphLength--;
+    if (paragraphLength > 0) splitParagraph(block, paragraph, paragraphLength);
+    free(paragraph);
+}
+
+// ---- Merging and grading ----
+
+static int rememberHash(Corpus *corpus, uint64_t hash) {
+    if ((corpus->count + 1) * 2 > corpus->hashCapacity) {
+        size_t capacity = corpus->hashCapacity ? corpus->hashCapacity * 2 : 1 << 16;
+        uint64_t *slots = calloc(capacity, sizeof(uint64_t));
+        if (!slots) {
+            perror("Memory allocation error for ingestion");
+            exit(EXIT_FAILURE);
+        }
+        for (size_t i = 0; i < corpus->hashCapacity; i++) {
+            uint64_t value = corpus->hashSlots[i];
+            if (!value) continue;
+            size_t slot = (size_t)value & (capacity - 1);
+            while (slots[slot]) slot = (slot + 1) & (capacity - 1);
+            slots[slot] = value;
+        }
+        free(corpus->hashSlots);
+        corpus->hashSlots = slots;
+        corpus->hashCapacity = capacity;
+    }
+    size_t slot = (size_t)hash & (corpus->hashCapacity - 1);
+    while (corpus->hashSlots[slot]) {
+        if (corpus->hashSlots[slot] == hash) return 0;
+        slot = (slot + 1) & (corpus->hashCapacity - 1);
+    }
+    corpus->hashSlots[slot] = hash;
+    return 1;
+}
+
+// Blocks are merged in input order, so the first copy of a passage is kept
+static void mergeBatch(Corpus *corpus, Batch *batch) {
+    for (size_t b = 0; b < batch->blockCount; b++) {
+        Block *block = &batch->blocks[b];
+        corpus->rejected += block->rejected;
+        for (size_t i = 0; i < block->count; i++) {
+            Passage passage = block->passages[i];
+            if (!rememberHash(corpus, passage.hash)) {
+                corpus->duplicates++;
+                continue;
+            }
+            const char *text = block->text + passage.offset;
+            passage.offset = corpus->textLength;
+            appendText(&corpus->text, &corpus->textLength, &corpus->textCapacity, text, (size_t)passage.length + 1);
+            if (corpus->count == corpus->capacity) {
+                corpus->capacity = corpus->capacity ? corpus->capacity * 2 : 4096;
+                corpus->passages = checkedRealloc(corpus->passages, corpus->capacity * sizeof(Passage));
+            }
+            corpus->passages[corpus->count++] = passage;
+        }
+        free(block->text);
+        free(block->passages);
+    }
+}
+
+typedef struct {
+    double score;
+    size_t index;
+} RankedPassage;
+
+static int compareRanked(const void *a, const void *b) {
+    const RankedPassage *x = a, *y = b;
+    if (x->score != y->score) return x->score < y->score ? -1 : 1;
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+// Each feature as a z-score over the whole corpus, weighted and summed; the
+// ranking by that score is then cut into thirds so the sections come out the
+// same size
+static unsigned char *gradePassages(const Corpus *corpus) {
+    double mean[FEATURE_COUNT] = {0}, spread[FEATURE_COUNT] = {0};
+    size_t count = corpus->count;
+    for (size_t i = 0; i < count; i++) {
+        for (int f = 0; f < FEATURE_COUNT; f++) mean[f] += corpus->passages[i].features[f];
+    }
+    for (int f = 0; f < FEATURE_COUNT; f++) mean[f] /= (double)count;
+    for (size_t i = 0; i < count; i++) {
+        for (int f = 0; f < FEATURE_COUNT; f++) {
+            double delta = corpus->passages[i].features[f] - mean[f];
+            spread[f] += delta * delta;
+        }
+    }
+    for (int f = 0; f < FEATURE_COUNT; f++) spread[f] = sqrt(spread[f] / (double)count);
+
+    RankedPassage *ranked = malloc(count * sizeof(RankedPassage));
+    unsigned char *grades = malloc(count);
+    if (!ranked || !grades) {
+        perror("Memory allocation error for ingestion");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < count; i++) {
+        double score = 0;
+        for (int f = 0; f < FEATURE_COUNT; f++) {
+            if (spread[f] > 0) score += featureWeights[f] * (corpus->passages[i].features[f] - mean[f]) / spread[f];
+        }
+        ranked[i].score = score;
+        ranked[i].index = i;
+    }
+    qsort(ranked, count, sizeof(RankedPassage), compareRanked);
+    for (size_t rank = 0; rank < count; rank++) {
+        grades[ranked[rank].index] = (unsigned char)((rank * 3) / count);
+    }
+    free(ranked);
+    return grades;
+}
+
+static int writeCorpusText(const Corpus *corpus, const unsigned char *grades, size_t gradeCounts[3]) {
+    char tempPath[max_ingest_path + 8];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", config.outputPath);
+    FILE *out = fopen(tempPath, "w");
+    if (!out) {
+        perror(tempPath);
+        return -1;
+    }
+    int failed = 0;
+    for (int grade = 0; grade < 3; grade++) {
+        gradeCounts[grade] = 0;
+        failed |= fprintf(out, "#%s\n", gradeNames[grade]) < 0;
+        for (size_t i = 0; i < corpus->count && !failed; i++) {
+            if (grades[i] != grade) continue;
+            const Passage *passage = &corpus->passages[i];
+            failed |= fwrite(corpus->text + passage->offset, 1, passage->length, out) != passage->length;
+            failed |= fputc('\n', out) == EOF;
+            gradeCounts[grade]++;
+        }
+    }
+    failed |= fclose(out) != 0;
+    if (failed) {
+        fprintf(stderr, "Error: Could not write '%s'\n", tempPath);
+        remove(tempPath);
+        return -1;
+    }
+#if INGEST_WINDOWS
+    remove(config.outputPath);
+#endif
+    if (rename(tempPath, config.outputPath) != 0) {
+        perror(config.outputPath);
+        remove(tempPath);
+        return -1;
+    }
+    return 0;
+}
+
+// ---- Reading ----
+
+// Project Gutenberg licence boilerplate is not practice material
+static size_t skipBookHeader(const char *data, size_t size) {
+    size_t limit = size < ingest_header_scan ? size : ingest_header_scan;
+    for (size_t pos = 0; pos + 12 < limit; pos++) {
+        if ((pos == 0 || data[pos - 1] == '\n') && strncmp(data + pos, "*** START OF", 12) == 0) {
+            const char *newline = memchr(data + pos, '\n', size - pos);
+            return newline ? (size_t)(newline - data) + 1 : size;
+        }
+    }
+    return 0;
+}
+
+static size_t findBookFooter(const char *data, size_t size) {
+    for (const char *hit = memchr(data, '*', size); hit; hit = memchr(hit + 1, '*', size - (size_t)(hit + 1 - data))) {
+        size_t pos = (size_t)(hit - data);
+        if ((pos == 0 || data[pos - 1] == '\n') && size - pos >= 10 && strncmp(hit, "*** END OF", 10) == 0) return pos;
+        if (pos + 1 >= size) break;
+    }
+    return size;
+}
+
+static void runBatch(Corpus *corpus, const char *data, size_t size, int final, size_t *consumed) {
+    Batch batch = {0};
+    batch.blocks = calloc(ingest_batch_blocks + 1, sizeof(Block));
+    if (!batch.blocks) {
+        perror("Memory allocation error for ingestion");
+        exit(EXIT_FAILURE);
+    }
+    size_t pos = 0;
+    while (pos < size && batch.blockCount <= ingest_batch_blocks) {
+        size_t cut;
+        if (size - pos <= ingest_block_bytes) {
+            cut = final ? size : 0;
+        } else {
+            cut = findBlockCut(data, size, pos + ingest_block_bytes);
+            if (!cut && final) cut = size;
+        }
+        // A paragraph longer than the whole buffer is cut at a line end
+        if (!cut && pos == 0 && batch.blockCount == 0) {
+            const char *newline = memchr(data + size / 2, '\n', size - size / 2);
+            cut = newline ? (size_t)(newline - data) + 1 : size;
+        }
+        if (!cut) break;
+        batch.blocks[batch.blockCount].data = data + pos;
+        batch.blocks[batch.blockCount].size = cut - pos;
+        batch.blockCount++;
+        pos = cut;
+    }
+    parallelFor(batch.blockCount, config.threads, processBlock, &batch);
+    mergeBatch(corpus, &batch);
+    free(batch.blocks);
+    *consumed = pos;
+}
+
+static int ingestFile(Corpus *corpus, const char *path, char *buffer, size_t bufferSize, uint64_t *bytesRead) {
+    FILE *in = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+    if (!in) {
+        perror(path);
+        return -1;
+    }
+    size_t filled = 0;
+    int first = 1, ended = 0;
+    while (!ended) {
+        size_t got = fread(buffer + filled, 1, bufferSize - filled, in);
+        *bytesRead += got;
+        filled += got;
+        ended = got == 0 || feof(in) || ferror(in);
+
+        size_t start = 0;
+        if (first) {
+            start = skipBookHeader(buffer, filled);
+            first = 0;
+        }
+        size_t footer = findBookFooter(buffer + start, filled - start) + start;
+        if (footer < filled) {
+            filled = footer;
+            ended = 1;
+        }
+        size_t consumed;
+        runBatch(corpus, buffer + start, filled - start, ended, &consumed);
+        consumed += start;
+        memmove(buffer, buffer + consumed, filled - consumed);
+        filled -= consumed;
+    }
+    int failed = ferror(in) != 0;
+    if (failed) perror(path);
+    if (in != stdin) fclose(in);
+    return failed ? -1 : 0;
+}
+
+static void printUsage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [options] <text file|-> ...\n"
+            "  --output PATH        graded corpus to write (paragraphs.txt)\n"
+            "  --compile PATH       also compile it into PATH (e.g. paragraphs.bin)\n"
+            "  --threads N          worker threads (one per CPU core)\n"
+            "  --min-length N       shortest passage kept, in characters (40)\n"
+            "  --max-length N       longest passage kept, in characters (200)\n",
+            program);
+}
+
+int main(int argc, char *argv[]) {
+    config = (IngestConfig){hardwareThreadCount(), 40, 200, "paragraphs.txt", NULL};
+    int firstInput = argc;
+    for (int i = 1; i < argc; i++) {
+        int hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--output") == 0 && hasValue) {
+            config.outputPath = argv[++i];
+        } else if (strcmp(argv[i], "--compile") == 0 && hasValue) {
+            config.binaryPath = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && hasValue) {
+            config.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--min-length") == 0 && hasValue) {
+            config.minLength = (size_t)atol(argv[++i]);
+        } else if (strcmp(argv[i], "--max-length") == 0 && hasValue) {
+            config.maxLength = (size_t)atol(argv[++i]);
+        } else if (argv[i][0] == '-' && argv[i][1] == '-') {
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            firstInput = i;
+            break;
+        }
+    }
+    if (firstInput == argc || config.threads < 1 || config.minLength < 1 || config.maxLength < config.minLength ||
+        strlen(config.outputPath) >= max_ingest_path) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    for (int i = 0; i < 26; i++) letterBits[i] = -log2(letterFrequency[i] / 100.0);
+
+    size_t bufferSize = (size_t)ingest_block_bytes * ingest_batch_blocks;
+    char *buffer = malloc(bufferSize);
+    if (!buffer) {
+        perror("Memory allocation error for ingestion");
+        return 1;
+    }
+    Corpus corpus;
+    memset(&corpus, 0, sizeof(corpus));
+    uint64_t bytesRead = 0;
+    clock_t started = clock();
+    time_t wallStarted = time(NULL);
+    int status = 0;
+    for (int i = firstInput; i < argc; i++) {
+        if (ingestFile(&corpus, argv[i], buffer, bufferSize, &bytesRead) != 0) status = 1;
+    }
+    free(buffer);
+    free(corpus.hashSlots);
+
+    if (corpus.count == 0) {
+        fprintf(stderr, "Error: No usable passages found\n");
+        return 1;
+    }
+    unsigned char *grades = gradePassages(&corpus);
+    size_t gradeCounts[3];
+    if (writeCorpusText(&corpus, grades, gradeCounts) != 0) status = 1;
+    free(grades);
+
+    printf("Read %.1f MB; kept %zu passages (%zu Easy, %zu Medium, %zu Hard), dropped %zu duplicates "
+           "and %zu unusable pieces in %lds (%.1fs CPU)\n",
+           bytesRead / 1e6, corpus.count, gradeCounts[0], gradeCounts[1], gradeCounts[2], corpus.duplicates,
+           corpus.rejected, (long)(time(NULL) - wallStarted), (double)(clock() - started) / CLOCKS_PER_SEC);
+    free(corpus.text);
+    free(corpus.passages);
+
+    if (status == 0 && config.binaryPath) {
+        uint64_t paragraphCount;
+        uint32_t sectionCount;
+        if (compileCorpus(config.outputPath, config.binaryPath, &paragraphCount, &sectionCount) != 0) return 1;
+        printf("Compiled %llu paragraphs in %u sections into %s\n",
+               (unsigned long long)paragraphCount, sectionCount, config.binaryPath);
+    }
+    return status;
+}
@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "keystroke_log.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__WINDOWS__)
+    #include <windows.h>
+    #define KEYSTROKE_WINDOWS 1
+#else
+    #define KEYSTROKE_WINDOWS 0
+#endif
+
+// Upper bounds of the interval histogram buckets; the last bucket is open
+const uint32_t keystrokeBucketLimitsMs[KEYSTROKE_HISTOGRAM_BUCKETS - 1] = {
+    50, 100, 150, 200, 300, 400, 600, 800, 1200, 2000
+};
+
+typedef struct {
+    char first;
+    char second;
+    uint64_t intervalNs;
+} BigramSample;
+
+uint64_t monotonicNanoseconds(void) {
+#if KEYSTROKE_WINDOWS
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000000ull +
+           (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000000ull / (uint64_t)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static void growLog(KeystrokeLog *log, size_t capacity) {
+    KeystrokeEvent *grown = realloc(log->events, capacity * sizeof(KeystrokeEvent));
+    if (!grown) {
+        perror("Memory allocation error for keystroke log");
+        exit(EXIT_FAILURE);
+    }
+    log->events = grown;
+    log->capacity = capacity;
+}
+
+void initKeystrokeLog(KeystrokeLog *log, size_t capacity) {
+    memset(log, 0, sizeof(*log));
+    growLog(log, capacity ? capacity : 256);
+}
+
+void freeKeystrokeLog(KeystrokeLog *log) {
+    free(log->events);
+    memset(log, 0, sizeof(*log));
+}
+
+void resetKeystrokeLog(KeystrokeLog *log) {
+    log->count = 0;
+}
+
+void recordKeystroke(KeystrokeLog *log, char key, char expected) {
+    uint64_t now = monotonicNanoseconds();
+    if (log->count == log->capacity) growLog(log, log->capacity * 2);
+    KeystrokeEvent *event = &log->events[log->count++];
+    event->timestampNs = now;
+    event->key = key;
+    event->expected = expected;
+    event->correct = key != KEYSTROKE_BACKSPACE && key == expected;
+}
+
+static int isPrintableKey(char key) {
+    return key >= ' ' && key <= '~';
+}
+
+static int compareIntervals(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int compareBigrams(const void *a, const void *b) {
+    const BigramSample *x = a, *y = b;
+    if (x->first != y->first) return (unsigned char)x->first - (unsigned char)y->first;
+    return (unsigned char)x->second - (unsigned char)y->second;
+}
+
+// Keep the KEYSTROKE_TOP_BIGRAMS slowest bigrams by mean latency, slowest first
+static void offerBigram(KeystrokeSummary *summary, const BigramLatency *bigram) {
+    double mean = (double)bigram->totalNs / bigram->count;
+    int pos = summary->bigramCount;
+    while (pos > 0) {
+        const BigramLatency *other = &summary->slowestBigrams[pos - 1];
+        if ((double)other->totalNs / other->count >= mean) break;
+        pos--;
+    }
+    if (pos >= KEYSTROKE_TOP_BIGRAMS) return;
+    int last = summary->bigramCount < KEYSTROKE_TOP_BIGRAMS ? summary->bigramCount : KEYSTROKE_TOP_BIGRAMS - 1;
+    memmove(&summary->slowestBigrams[pos + 1], &summary->slowestBigrams[pos], (size_t)(last - pos) * sizeof(BigramLatency));
+    summary->slowestBigrams[pos] = *bigram;
+    if (summary->bigramCount < KEYSTROKE_TOP_BIGRAMS) summary->bigramCount++;
+}
+
+void summarizeKeystrokes(const KeystrokeLog *log, KeystrokeSummary *summary) {
+    memset(summary, 0, sizeof(*summary));
+    summary->keystrokes = (uint32_t)log->count;
+    if (log->count == 0) return;
+
+    uint64_t *intervals = malloc(log->count * sizeof(uint64_t));
+    BigramSample *bigrams = malloc(log->count * sizeof(BigramSample));
+    if (!intervals || !bigrams) {
+        perror("Memory allocation error for keystroke summary");
+        exit(EXIT_FAILURE);
+    }
+    size_t intervalCount = 0, bigramCount = 0;
+    uint32_t correctKeys = 0;
+    uint64_t activeNs = 0;
+    summary->burstCount = 1;
+
+    for (size_t i = 0; i < log->count; i++) {
+        const KeystrokeEvent *event = &log->events[i];
+        if (event->key == KEYSTROKE_BACKSPACE) {
+            summary->backspaces++;
+        } else if (!event->correct) {
+            summary->errors++;
+        } else {
+            correctKeys++;
+        }
+        if (i == 0) continue;
+
+        const KeystrokeEvent *previous = &log->events[i - 1];
+        uint64_t interval = event->timestampNs - previous->timestampNs;
+        intervals[intervalCount++] = interval;
+
+        int bucket = 0;
+        while (bucket < KEYSTROKE_HISTOGRAM_BUCKETS - 1 &&
+               interval >= (uint64_t)keystrokeBucketLimitsMs[bucket] * 1000000ull) {
+            bucket++;
+        }
+        summary->intervalHistogram[bucket]++;
+
+        if (interval >= KEYSTROKE_PAUSE_NS) {
+            summary->pauseCount++;
+            summary->pauseNs += interval;
+            summary->burstCount++;
+        } else {
+            activeNs += interval;
+        }
+
+        if (event->correct && isPrintableKey(event->key)) {
+            KeyLatency *key = &summary->keys[event->key - ' '];
+            key->count++;
+            key->totalNs += interval;
+            if (previous->correct && isPrintableKey(previous->key)) {
+                bigrams[bigramCount++] = (BigramSample){previous->key, event->key, interval};
+            }
+        }
+    }
+
+    summary->durationNs = log->events[log->count - 1].timestampNs - log->events[0].timestampNs;
+    summary->meanBurstLength = (double)log->count / summary->burstCount;
+    summary->burstCpm = activeNs ? correctKeys * 60e9 / (double)activeNs : 0;
+
+    if (intervalCount > 0) {
+        qsort(intervals, intervalCount, sizeof(uint64_t), compareIntervals);
+        summary->medianIntervalNs = intervals[intervalCount / 2];
+        summary->p90IntervalNs = intervals[(intervalCount * 9) / 10];
+    }
+
+    qsort(bigrams, bigramCount, sizeof(BigramSample), compareBigrams);
+    for (size_t i = 0; i < bigramCount;) {
+        BigramLatency bigram = {bigrams[i].first, bigrams[i].second, 0, 0};
+        for (; i < bigramCount && bigrams[i].first == bigram.first && bigrams[i].second == bigram.second; i++) {
+            bigram.count++;
+            bigram.totalNs += bigrams[i].intervalNs;
+        }
+        offerBigram(summary, &bigram);
+    }
+
+    free(intervals);
+    free(bigrams);
+}
+
+void addKeystrokeSummary(KeystrokeTotals *totals, const KeystrokeSummary *summary) {
+    totals->attempts++;
+    totals->keystrokes += summary->keystrokes;
+    totals->errors += summary->errors;
+    totals->backspaces += summary->backspaces;
+    totals->durationNs += summary->durationNs;
+    totals->pauseCount += summary->pauseCount;
+    totals->pauseNs += summary->pauseNs;
+    totals->burstCount += summary->burstCount;
+    for (int i = 0; i < KEYSTROKE_HISTOGRAM_BUCKETS; i++) totals->intervalHistogram[i] += summary->intervalHistogram[i];
+    for (int i = 0; i < KEYSTROKE_PRINTABLE_KEYS; i++) {
+        totals->keyCounts[i] += summary->keys[i].count;
+        totals->keyTotalNs[i] += summary->keys[i].totalNs;
+    }
+    totals->lastMedianIntervalNs = summary->medianIntervalNs;
+    totals->lastP90IntervalNs = summary->p90IntervalNs;
+    memset(totals->lastSlowestBigrams, 0, sizeof(totals->lastSlowestBigrams));
+    memcpy(totals->lastSlowestBigrams, summary->slowestBigrams, (size_t)summary->bigramCount * sizeof(BigramLatency));
+    totals->lastBigramCount = summary->bigramCount;
+}
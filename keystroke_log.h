@@ -0,0 +1,96 @@
+#ifndef KEYSTROKE_LOG_H
+#define KEYSTROKE_LOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define KEYSTROKE_HISTOGRAM_BUCKETS 11
+#define KEYSTROKE_PRINTABLE_KEYS 95     // ' ' through '~'
+#define KEYSTROKE_TOP_BIGRAMS 10
+#define KEYSTROKE_PAUSE_NS 1000000000ull
+
+#define KEYSTROKE_BACKSPACE '\b'
+
+typedef struct {
+    uint64_t timestampNs;               // monotonic clock
+    char key;                           // KEYSTROKE_BACKSPACE for a correction
+    char expected;
+    uint8_t correct;
+} KeystrokeEvent;
+
+// Events of the current attempt. Storage is allocated up front and only
+// grows, so recording a key is a clock read and a store.
+typedef struct {
+    KeystrokeEvent *events;
+    size_t count;
+    size_t capacity;
+} KeystrokeLog;
+
+typedef struct {
+    uint32_t count;
+    uint64_t totalNs;
+} KeyLatency;
+
+typedef struct {
+    char first;
+    char second;
+    uint32_t count;
+    uint64_t totalNs;
+} BigramLatency;
+
+// Intervals are measured from the previous keystroke; per-key and per-bigram
+// figures only use correctly typed characters.
+typedef struct {
+    uint32_t keystrokes;
+    uint32_t errors;
+    uint32_t backspaces;
+    uint64_t durationNs;
+    uint64_t medianIntervalNs;
+    uint64_t p90IntervalNs;
+    uint32_t intervalHistogram[KEYSTROKE_HISTOGRAM_BUCKETS];
+    KeyLatency keys[KEYSTROKE_PRINTABLE_KEYS];
+    BigramLatency slowestBigrams[KEYSTROKE_TOP_BIGRAMS];
+    int bigramCount;
+    uint32_t pauseCount;                // intervals of KEYSTROKE_PAUSE_NS or more
+    uint64_t pauseNs;
+    uint32_t burstCount;                // runs of keys between pauses
+    double meanBurstLength;
+    double burstCpm;                    // correct keys per minute, pauses excluded
+} KeystrokeSummary;
+
+// Every summary of a user added up, kept in their profiles.db record, so
+// only fixed-width fields. The slowest bigrams and interval percentiles
+// cannot be summed; they are the latest attempt's.
+typedef struct {
+    uint64_t attempts;
+    uint64_t keystrokes;
+    uint64_t errors;
+    uint64_t backspaces;
+    uint64_t durationNs;
+    uint64_t pauseCount;
+    uint64_t pauseNs;
+    uint64_t burstCount;
+    uint64_t intervalHistogram[KEYSTROKE_HISTOGRAM_BUCKETS];
+    uint64_t keyCounts[KEYSTROKE_PRINTABLE_KEYS];
+    uint64_t keyTotalNs[KEYSTROKE_PRINTABLE_KEYS];
+    uint64_t lastMedianIntervalNs;
+    uint64_t lastP90IntervalNs;
+    BigramLatency lastSlowestBigrams[KEYSTROKE_TOP_BIGRAMS];
+    int32_t lastBigramCount;
+    uint32_t reserved;
+} KeystrokeTotals;
+
+extern const uint32_t keystrokeBucketLimitsMs[KEYSTROKE_HISTOGRAM_BUCKETS - 1];
+
+uint64_t monotonicNanoseconds(void);
+
+void initKeystrokeLog(KeystrokeLog *log, size_t capacity);
+void freeKeystrokeLog(KeystrokeLog *log);
+void resetKeystrokeLog(KeystrokeLog *log);
+void recordKeystroke(KeystrokeLog *log, char key, char expected);
+
+void summarizeKeystrokes(const KeystrokeLog *log, KeystrokeSummary *summary);
+
+void addKeystrokeSummary(KeystrokeTotals *totals, const KeystrokeSummary *summary);
+
+#endif
@@ -0,0 +1,357 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "leaderboard_journal.h"
+#include "file_lock.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__WINDOWS__)
+    #include <io.h>
+    #include <windows.h>
+    #define JOURNAL_WINDOWS 1
+    #define OPEN_FLAGS (_O_RDWR | _O_CREAT | _O_BINARY)
+    #define fsync _commit
+#else
+    #include <unistd.h>
+    #define JOURNAL_WINDOWS 0
+    #define OPEN_FLAGS (O_RDWR | O_CREAT)
+#endif
+
+// Byte ranges of leaderboard.lock used as independent locks
+#define APPEND_LOCK 0
+#define SYNC_LOCK 1
+#define COMPACT_LOCK 2
+// Where the group commit watermark (journal generation, synced length) lives
+#define WATERMARK_OFFSET 16
+
+#define NO_GENERATION UINT64_MAX
+#define JOURNAL_LINE_MAX 160
+
+typedef struct {
+    uint64_t generation;
+    uint64_t foldedGeneration;   // journal generation the snapshot already contains...
+    long foldedLength;           // ...up to this byte offset
+} SnapshotHeader;
+
+const char *leaderboardFilePath(const LeaderboardJournal *journal, const char *name, char path[LEADERBOARD_PATH_MAX]) {
+    snprintf(path, LEADERBOARD_PATH_MAX, "%s%s", journal->directory, name);
+    return path;
+}
+
+static int replaceFile(const LeaderboardJournal *journal, const char *from, const char *to) {
+    char fromPath[LEADERBOARD_PATH_MAX], toPath[LEADERBOARD_PATH_MAX];
+    leaderboardFilePath(journal, from, fromPath);
+    leaderboardFilePath(journal, to, toPath);
+#if JOURNAL_WINDOWS
+    return MoveFileExA(fromPath, toPath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) ? 0 : -1;
+#else
+    if (rename(fromPath, toPath) != 0) return -1;
+    // Make the rename itself durable
+    int dir = open(journal->directory[0] ? journal->directory : ".", O_RDONLY);
+    if (dir >= 0) {
+        fsync(dir);
+        close(dir);
+    }
+    return 0;
+#endif
+}
+
+static int flushFile(FILE *file) {
+    if (fflush(file) != 0) return -1;
+    return fsync(fileno(file));
+}
+
+static void readWatermark(int lockFd, uint64_t *generation, uint64_t *length) {
+    uint64_t values[2] = {NO_GENERATION, 0};
+    if (lseek(lockFd, WATERMARK_OFFSET, SEEK_SET) >= 0) {
+        if (read(lockFd, values, sizeof(values)) != (int)sizeof(values)) {
+            values[0] = NO_GENERATION;
+            values[1] = 0;
+        }
+    }
+    *generation = values[0];
+    *length = values[1];
+}
+
+static void writeWatermark(int lockFd, uint64_t generation, uint64_t length) {
+    uint64_t values[2] = {generation, length};
+    if (lseek(lockFd, WATERMARK_OFFSET, SEEK_SET) >= 0) {
+        if (write(lockFd, values, sizeof(values)) != (int)sizeof(values)) {
+            // Only a hint for group commit; the next committer will fsync itself
+        }
+    }
+}
+
+static void readSnapshotHeader(const LeaderboardJournal *journal, SnapshotHeader *header) {
+    header->generation = 0;
+    header->foldedGeneration = NO_GENERATION;
+    header->foldedLength = 0;
+    char path[LEADERBOARD_PATH_MAX];
+    FILE *file = fopen(leaderboardFilePath(journal, LEADERBOARD_SNAPSHOT_PATH, path), "rb");
+    if (!file) return;
+    char line[128];
+    unsigned long long generation, foldedGeneration;
+    long foldedLength;
+    if (fgets(line, sizeof(line), file) &&
+        sscanf(line, "# snapshot %llu folds %llu %ld", &generation, &foldedGeneration, &foldedLength) == 3) {
+        header->generation = generation;
+        header->foldedGeneration = foldedGeneration;
+        header->foldedLength = foldedLength;
+    }
+    fclose(file);
+}
+
+// Generation of the journal, or NO_GENERATION if there is none yet; *bodyOffset
+// is where its entries start.
+static uint64_t readJournalHeader(const LeaderboardJournal *journal, long *bodyOffset, long *size) {
+    *bodyOffset = 0;
+    *size = 0;
+    char path[LEADERBOARD_PATH_MAX];
+    FILE *file = fopen(leaderboardFilePath(journal, LEADERBOARD_JOURNAL_PATH, path), "rb");
+    if (!file) return NO_GENERATION;
+    char line[128];
+    unsigned long long generation;
+    uint64_t result = NO_GENERATION;
+    if (fgets(line, sizeof(line), file) && sscanf(line, "# journal %llu", &generation) == 1) {
+        result = generation;
+        *bodyOffset = ftell(file);
+    }
+    fseek(file, 0, SEEK_END);
+    *size = ftell(file);
+    fclose(file);
+    return result;
+}
+
+// Where replay of the current journal has to start given the snapshot header
+static long journalReplayStart(const SnapshotHeader *snapshot, uint64_t journalGeneration, long bodyOffset) {
+    if (journalGeneration != NO_GENERATION && journalGeneration == snapshot->foldedGeneration &&
+        snapshot->foldedLength > bodyOffset) {
+        return snapshot->foldedLength;
+    }
+    return bodyOffset;
+}
+
+int openLeaderboardJournal(LeaderboardJournal *journal, const char *directory) {
+    memset(journal, 0, sizeof(*journal));
+    journal->lockFd = -1;
+    if (directory && strlen(directory) >= sizeof(journal->directory)) {
+        fprintf(stderr, "Error: Path too long: %s\n", directory);
+        return -1;
+    }
+    if (directory) strcpy(journal->directory, directory);
+    char path[LEADERBOARD_PATH_MAX];
+    journal->lockFd = open(leaderboardFilePath(journal, LEADERBOARD_LOCK_PATH, path), OPEN_FLAGS, 0644);
+    if (journal->lockFd < 0) {
+        fprintf(stderr, "Error opening %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+void closeLeaderboardJournal(LeaderboardJournal *journal) {
+    if (journal->lockFd >= 0) close(journal->lockFd);
+    journal->lockFd = -1;
+    journal->loaded = 0;
+}
+
+int commitLeaderboardEntry(LeaderboardJournal *journal, const LeaderboardEntry *entry) {
+    return commitLeaderboardEntries(journal, entry, 1);
+}
+
+static int writeAll(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        long n = (long)write(fd, data, (unsigned int)length);
+        if (n <= 0) return -1;
+        data += n;
+        length -= (size_t)n;
+    }
+    return 0;
+}
+
+int commitLeaderboardEntries(LeaderboardJournal *journal, const LeaderboardEntry *entries, size_t count) {
+    if (count == 0) return 0;
+    char *lines = malloc(count * JOURNAL_LINE_MAX);
+    if (!lines) return -1;
+    size_t linesLength = 0;
+    for (size_t i = 0; i < count; i++) {
+        const LeaderboardEntry *entry = &entries[i];
+        int lineLength = snprintf(lines + linesLength, JOURNAL_LINE_MAX, "%s %.2f %.2f %.2f %s\n", entry->username,
+                                  entry->typingSpeed, entry->wordsPerMinute, entry->accuracy, entry->difficulty);
+        if (lineLength < 0 || lineLength >= JOURNAL_LINE_MAX) {
+            free(lines);
+            return -1;
+        }
+        linesLength += (size_t)lineLength;
+    }
+
+    if (lockFileByte(journal->lockFd, APPEND_LOCK, 1, 1) != 0) {
+        free(lines);
+        return -1;
+    }
+    char path[LEADERBOARD_PATH_MAX];
+    int fd = open(leaderboardFilePath(journal, LEADERBOARD_JOURNAL_PATH, path), OPEN_FLAGS, 0644);
+    if (fd < 0) {
+        unlockFileByte(journal->lockFd, APPEND_LOCK);
+        fprintf(stderr, "Error opening %s: %s\n", path, strerror(errno));
+        free(lines);
+        return -1;
+    }
+
+    long bodyOffset, size;
+    uint64_t generation = readJournalHeader(journal, &bodyOffset, &size);
+    int failed = 0;
+    if (generation == NO_GENERATION) {
+        // New journal: it continues from whatever snapshot is on disk
+        SnapshotHeader snapshot;
+        readSnapshotHeader(journal, &snapshot);
+        generation = snapshot.generation;
+    }
+    if (size == 0) {
+        char header[64];
+        int headerLength = snprintf(header, sizeof(header), "# journal %llu\n", (unsigned long long)generation);
+        failed = write(fd, header, headerLength) != headerLength;
+    } else {
+        // Terminate a line left half-written by a crashed process
+        char last = '\n';
+        lseek(fd, size - 1, SEEK_SET);
+        if (read(fd, &last, 1) == 1 && last != '\n') failed = write(fd, "\n", 1) != 1;
+        lseek(fd, 0, SEEK_END);
+    }
+    if (!failed) failed = writeAll(fd, lines, linesLength) != 0;
+    free(lines);
+    uint64_t myEnd = (uint64_t)lseek(fd, 0, SEEK_CUR);
+    unlockFileByte(journal->lockFd, APPEND_LOCK);
+
+    // Group commit: while one process fsyncs, the others queue on the sync
+    // lock and usually find their bytes already covered when they get it.
+    if (!failed && lockFileByte(journal->lockFd, SYNC_LOCK, 1, 1) == 0) {
+        uint64_t syncedGeneration, syncedLength;
+        readWatermark(journal->lockFd, &syncedGeneration, &syncedLength);
+        if (syncedGeneration != generation || syncedLength < myEnd) {
+            uint64_t end = (uint64_t)lseek(fd, 0, SEEK_END);
+            failed = fsync(fd) != 0;
+            if (!failed) writeWatermark(journal->lockFd, generation, end);
+        }
+        unlockFileByte(journal->lockFd, SYNC_LOCK);
+    }
+    close(fd);
+    return failed ? -1 : 0;
+}
+
+// Full reload of snapshot plus journal; the caller holds the append lock
+static void reloadView(LeaderboardJournal *journal, LeaderboardStore *store) {
+    SnapshotHeader snapshot;
+    long bodyOffset, size;
+    char path[LEADERBOARD_PATH_MAX];
+    readSnapshotHeader(journal, &snapshot);
+    uint64_t journalGeneration = readJournalHeader(journal, &bodyOffset, &size);
+
+    freeLeaderboardStore(store);
+    replayLeaderboardFile(store, leaderboardFilePath(journal, LEADERBOARD_SNAPSHOT_PATH, path), 0);
+    journal->snapshotGeneration = snapshot.generation;
+    journal->journalGeneration = journalGeneration;
+    journal->journalOffset = journalReplayStart(&snapshot, journalGeneration, bodyOffset);
+    journal->loaded = 1;
+}
+
+void refreshLeaderboardView(LeaderboardJournal *journal, LeaderboardStore *store) {
+    int locked = lockFileByte(journal->lockFd, APPEND_LOCK, 0, 1) == 0;
+
+    SnapshotHeader snapshot;
+    long bodyOffset, size;
+    readSnapshotHeader(journal, &snapshot);
+    uint64_t journalGeneration = readJournalHeader(journal, &bodyOffset, &size);
+    if (!journal->loaded || snapshot.generation != journal->snapshotGeneration ||
+        journalGeneration != journal->journalGeneration || size < journal->journalOffset) {
+        reloadView(journal, store);
+    }
+    if (size > journal->journalOffset) {
+        char path[LEADERBOARD_PATH_MAX];
+        journal->journalOffset = replayLeaderboardFile(store, leaderboardFilePath(journal, LEADERBOARD_JOURNAL_PATH, path),
+                                                       journal->journalOffset);
+    }
+
+    if (locked) unlockFileByte(journal->lockFd, APPEND_LOCK);
+}
+
+int compactLeaderboardJournal(LeaderboardJournal *journal, long thresholdBytes) {
+    long bodyOffset, size;
+    char path[LEADERBOARD_PATH_MAX];
+    readJournalHeader(journal, &bodyOffset, &size);
+    if (size < thresholdBytes) return 0;
+    if (lockFileByte(journal->lockFd, COMPACT_LOCK, 1, 0) != 0) return 0;
+
+    // Phase 1, shared: read everything committed so far
+    LeaderboardStore store;
+    LeaderboardJournal view;
+    initLeaderboardStore(&store);
+    memset(&view, 0, sizeof(view));
+    view.lockFd = journal->lockFd;
+    strcpy(view.directory, journal->directory);
+    lockFileByte(journal->lockFd, APPEND_LOCK, 0, 1);
+    reloadView(&view, &store);
+    long foldedLength = replayLeaderboardFile(&store, leaderboardFilePath(journal, LEADERBOARD_JOURNAL_PATH, path),
+                                              view.journalOffset);
+    unlockFileByte(journal->lockFd, APPEND_LOCK);
+
+    uint64_t foldedGeneration = view.journalGeneration == NO_GENERATION ? view.snapshotGeneration : view.journalGeneration;
+    uint64_t generation = (foldedGeneration > view.snapshotGeneration ? foldedGeneration : view.snapshotGeneration) + 1;
+
+    // Phase 2, unlocked: write the new snapshot while submitters keep appending
+    int failed = 0;
+    FILE *out = fopen(leaderboardFilePath(journal, LEADERBOARD_SNAPSHOT_PATH ".tmp", path), "wb");
+    if (!out) {
+        failed = 1;
+    } else {
+        failed |= fprintf(out, "# snapshot %llu folds %llu %ld\n", (unsigned long long)generation,
+                          (unsigned long long)foldedGeneration, foldedLength) < 0;
+        failed |= writeLeaderboardSnapshot(&store, out) != 0;
+        failed |= flushFile(out) != 0;
+        failed |= fclose(out) != 0;
+    }
+    freeLeaderboardStore(&store);
+
+    // Phase 3, exclusive: publish the snapshot, then restart the journal with
+    // whatever was appended during phase 2
+    char *tail = NULL;
+    if (!failed && lockFileByte(journal->lockFd, APPEND_LOCK, 1, 1) == 0) {
+        FILE *in = fopen(leaderboardFilePath(journal, LEADERBOARD_JOURNAL_PATH, path), "rb");
+        long tailLength = 0;
+        if (in) {
+            fseek(in, 0, SEEK_END);
+            tailLength = ftell(in) - foldedLength;
+            if (tailLength < 0) tailLength = 0;
+            tail = malloc((size_t)tailLength + 1);
+            fseek(in, foldedLength, SEEK_SET);
+            failed = !tail || fread(tail, 1, (size_t)tailLength, in) != (size_t)tailLength;
+            fclose(in);
+        }
+        if (!failed) failed = replaceFile(journal, LEADERBOARD_SNAPSHOT_PATH ".tmp", LEADERBOARD_SNAPSHOT_PATH) != 0;
+        if (!failed) {
+            out = fopen(leaderboardFilePath(journal, LEADERBOARD_JOURNAL_PATH ".tmp", path), "wb");
+            failed = !out;
+            if (out) {
+                failed |= fprintf(out, "# journal %llu\n", (unsigned long long)generation) < 0;
+                if (tailLength > 0) failed |= fwrite(tail, 1, (size_t)tailLength, out) != (size_t)tailLength;
+                failed |= flushFile(out) != 0;
+                long journalLength = ftell(out);
+                failed |= fclose(out) != 0;
+                if (!failed) failed = replaceFile(journal, LEADERBOARD_JOURNAL_PATH ".tmp", LEADERBOARD_JOURNAL_PATH) != 0;
+                if (!failed && lockFileByte(journal->lockFd, SYNC_LOCK, 1, 1) == 0) {
+                    writeWatermark(journal->lockFd, generation, (uint64_t)journalLength);
+                    unlockFileByte(journal->lockFd, SYNC_LOCK);
+                }
+            }
+        }
+        unlockFileByte(journal->lockFd, APPEND_LOCK);
+    } else {
+        failed = 1;
+    }
+    free(tail);
+    if (failed) remove(leaderboardFilePath(journal, LEADERBOARD_SNAPSHOT_PATH ".tmp", path));
+    unlockFileByte(journal->lockFd, COMPACT_LOCK);
+    return failed ? -1 : 1;
+}
@@ -0,0 +1,56 @@
+#ifndef LEADERBOARD_JOURNAL_H
+#define LEADERBOARD_JOURNAL_H
+
+#include <stdint.h>
+
+#include "leaderboard_store.h"
+
+// Shared on-disk leaderboard, safe for many processes on a shared volume:
+//
+//   leaderboard.txt      sorted snapshot, "# snapshot <gen> folds <jgen> <len>"
+//                        header then one entry per line
+//   leaderboard.journal  "# journal <gen>" header then appended submissions
+//   leaderboard.lock     advisory byte-range locks plus the group commit
+//                        watermark
+//
+// The snapshot header records which journal prefix it already contains, so
+// a crash between replacing the snapshot and replacing the journal never
+// applies an entry twice.
+
+#define LEADERBOARD_SNAPSHOT_PATH "leaderboard.txt"
+#define LEADERBOARD_JOURNAL_PATH "leaderboard.journal"
+#define LEADERBOARD_LOCK_PATH "leaderboard.lock"
+#define LEADERBOARD_PATH_MAX 256
+
+typedef struct {
+    int lockFd;                   // kept open: closing any descriptor drops fcntl locks
+    int loaded;
+    uint64_t snapshotGeneration;  // headers seen by the last refresh
+    uint64_t journalGeneration;
+    long journalOffset;           // journal bytes already replayed
+    char directory[200];          // prefix of the files above, "" or ending in a separator
+} LeaderboardJournal;
+
+// directory prefixes the file names: NULL or "" for the working directory,
+// otherwise ending in a path separator
+int openLeaderboardJournal(LeaderboardJournal *journal, const char *directory);
+// Path of one of the files above (or its ".tmp"), inside the journal's directory
+const char *leaderboardFilePath(const LeaderboardJournal *journal, const char *name, char path[LEADERBOARD_PATH_MAX]);
+void closeLeaderboardJournal(LeaderboardJournal *journal);
+
+// Append one submission and make it durable. Concurrent committers share
+// fsyncs: whoever holds the sync lock flushes everything appended so far.
+int commitLeaderboardEntry(LeaderboardJournal *journal, const LeaderboardEntry *entry);
+// Same for a batch: one locked append and at most one fsync for all of them
+int commitLeaderboardEntries(LeaderboardJournal *journal, const LeaderboardEntry *entries, size_t count);
+
+// Bring store up to date with snapshot + journal, replaying only new journal
+// bytes unless a compaction happened since the last call.
+void refreshLeaderboardView(LeaderboardJournal *journal, LeaderboardStore *store);
+
+// Fold the journal into a new sorted snapshot once it exceeds thresholdBytes.
+// Returns 1 if this call compacted, 0 if not needed or another process is
+// already doing it, -1 on error.
+int compactLeaderboardJournal(LeaderboardJournal *journal, long thresholdBytes);
+
+#endif
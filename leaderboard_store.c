@@ -0,0 +1,268 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "leaderboard_store.h"
+
+static void *checkedAlloc(void *ptr) {
+    if (!ptr) {
+        perror("Memory allocation error for leaderboard");
+        exit(EXIT_FAILURE);
+    }
+    return ptr;
+}
+
+void initLeaderboardStore(LeaderboardStore *store) {
+    memset(store, 0, sizeof(*store));
+    store->randomState = 2463534242u;
+}
+
+void freeLeaderboardStore(LeaderboardStore *store) {
+    for (int i = 0; i < store->indexCount; i++) {
+        LeaderboardNode *node = store->indexes[i].head;
+        while (node) {
+            LeaderboardNode *next = node->next[0].node;
+            free(node);
+            node = next;
+        }
+    }
+    free(store->indexes);
+    free(store->best);
+    initLeaderboardStore(store);
+}
+
+static LeaderboardNode *newNode(int level) {
+    LeaderboardNode *node = checkedAlloc(calloc(1, sizeof(LeaderboardNode) + level * sizeof(LeaderboardLink)));
+    node->level = level;
+    return node;
+}
+
+// Geometric level distribution with p = 1/4
+static int randomLevel(LeaderboardStore *store) {
+    uint32_t x = store->randomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    store->randomState = x;
+    int level = 1;
+    while ((x & 3) == 0 && level < LEADERBOARD_MAX_LEVEL) {
+        level++;
+        x >>= 2;
+    }
+    return level;
+}
+
+static LeaderboardIndex *getIndex(const LeaderboardStore *store, const char *difficulty) {
+    for (int i = 0; i < store->indexCount; i++) {
+        if (strcmp(store->indexes[i].difficulty, difficulty) == 0) return &store->indexes[i];
+    }
+    return NULL;
+}
+
+static LeaderboardIndex *getOrCreateIndex(LeaderboardStore *store, const char *difficulty) {
+    LeaderboardIndex *index = getIndex(store, difficulty);
+    if (index) return index;
+    store->indexes = checkedAlloc(realloc(store->indexes, (store->indexCount + 1) * sizeof(LeaderboardIndex)));
+    index = &store->indexes[store->indexCount++];
+    memset(index, 0, sizeof(*index));
+    strncpy(index->difficulty, difficulty, sizeof(index->difficulty) - 1);
+    index->head = newNode(LEADERBOARD_MAX_LEVEL);
+    index->level = 1;
+    return index;
+}
+
+static int comesBefore(const LeaderboardNode *a, const LeaderboardNode *b) {
+    if (a->entry.typingSpeed != b->entry.typingSpeed) return a->entry.typingSpeed > b->entry.typingSpeed;
+    return a->sequence < b->sequence;
+}
+
+// rank[i] counts the positions passed on the way down to update[i]; the
+// new node's spans are split off its predecessors' at each level
+static void insertNode(LeaderboardIndex *index, LeaderboardNode *node) {
+    LeaderboardNode *update[LEADERBOARD_MAX_LEVEL];
+    size_t rank[LEADERBOARD_MAX_LEVEL];
+    LeaderboardNode *x = index->head;
+    for (int i = index->level - 1; i >= 0; i--) {
+        rank[i] = i == index->level - 1 ? 0 : rank[i + 1];
+        while (x->next[i].node && comesBefore(x->next[i].node, node)) {
+            rank[i] += x->next[i].span;
+            x = x->next[i].node;
+        }
+        update[i] = x;
+    }
+    if (node->level > index->level) {
+        for (int i = index->level; i < node->level; i++) {
+            rank[i] = 0;
+            update[i] = index->head;
+            update[i]->next[i].span = index->count;
+        }
+        index->level = node->level;
+    }
+    for (int i = 0; i < node->level; i++) {
+        node->next[i].node = update[i]->next[i].node;
+        node->next[i].span = update[i]->next[i].span - (rank[0] - rank[i]);
+        update[i]->next[i].node = node;
+        update[i]->next[i].span = rank[0] - rank[i] + 1;
+    }
+    for (int i = node->level; i < index->level; i++) update[i]->next[i].span++;
+    index->count++;
+}
+
+static void removeNode(LeaderboardIndex *index, LeaderboardNode *node) {
+    LeaderboardNode *x = index->head;
+    for (int i = index->level - 1; i >= 0; i--) {
+        while (x->next[i].node && comesBefore(x->next[i].node, node)) x = x->next[i].node;
+        if (i < node->level && x->next[i].node == node) {
+            x->next[i].span += node->next[i].span - 1;
+            x->next[i].node = node->next[i].node;
+        } else {
+            x->next[i].span--;
+        }
+    }
+    while (index->level > 1 && !index->head->next[index->level - 1].node) index->level--;
+    index->count--;
+}
+
+static uint64_t hashKey(const char *username, const char *difficulty) {
+    uint64_t h = 1469598103934665603ull;
+    for (const unsigned char *p = (const unsigned char *)username; *p; p++) h = (h ^ *p) * 1099511628211ull;
+    h = (h ^ 0xff) * 1099511628211ull;
+    for (const unsigned char *p = (const unsigned char *)difficulty; *p; p++) h = (h ^ *p) * 1099511628211ull;
+    return h;
+}
+
+static LeaderboardNode **findBestSlot(LeaderboardStore *store, const char *username, const char *difficulty) {
+    size_t mask = store->bestCapacity - 1;
+    size_t i = (size_t)hashKey(username, difficulty) & mask;
+    while (store->best[i]) {
+        const LeaderboardEntry *e = &store->best[i]->entry;
+        if (strcmp(e->username, username) == 0 && strcmp(e->difficulty, difficulty) == 0) break;
+        i = (i + 1) & mask;
+    }
+    return &store->best[i];
+}
+
+static void growBestTable(LeaderboardStore *store) {
+    LeaderboardNode **old = store->best;
+    size_t oldCapacity = store->bestCapacity;
+    store->bestCapacity = oldCapacity ? oldCapacity * 2 : 64;
+    store->best = checkedAlloc(calloc(store->bestCapacity, sizeof(LeaderboardNode *)));
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (old[i]) *findBestSlot(store, old[i]->entry.username, old[i]->entry.difficulty) = old[i];
+    }
+    free(old);
+}
+
+void recordLeaderboardEntry(LeaderboardStore *store, const LeaderboardEntry *entry) {
+    if ((store->bestCount + 1) * 10 > store->bestCapacity * 7) growBestTable(store);
+
+    LeaderboardIndex *index = getOrCreateIndex(store, entry->difficulty);
+    LeaderboardNode *node = newNode(randomLevel(store));
+    node->entry = *entry;
+    node->entry.username[sizeof(node->entry.username) - 1] = '\0';
+    node->entry.difficulty[sizeof(node->entry.difficulty) - 1] = '\0';
+    node->sequence = store->nextSequence++;
+
+    LeaderboardNode **slot = findBestSlot(store, node->entry.username, node->entry.difficulty);
+    if (*slot && node->entry.typingSpeed > (*slot)->entry.typingSpeed) {
+        removeNode(index, *slot);
+        free(*slot);
+        *slot = node;
+    } else if (!*slot) {
+        *slot = node;
+        store->bestCount++;
+    }
+    insertNode(index, node);
+}
+
+long replayLeaderboardFile(LeaderboardStore *store, const char *path, long offset) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return offset;
+    if (fseek(file, offset, SEEK_SET) != 0) {
+        fclose(file);
+        return offset;
+    }
+
+    char line[256];
+    int skipping = 0;
+    while (fgets(line, sizeof(line), file)) {
+        size_t len = strlen(line);
+        if (len == 0 || line[len - 1] != '\n') {
+            // Over-long line, or a line another process is still writing
+            if (feof(file)) break;
+            skipping = 1;
+            continue;
+        }
+        offset = ftell(file);
+        if (skipping) {
+            skipping = 0;
+            continue;
+        }
+        if (line[0] == '#') continue;
+
+        LeaderboardEntry entry;
+        memset(&entry, 0, sizeof(entry));
+        if (sscanf(line, "%49s %lf %lf %lf %19s", entry.username, &entry.typingSpeed,
+                   &entry.wordsPerMinute, &entry.accuracy, entry.difficulty) == 5) {
+            recordLeaderboardEntry(store, &entry);
+        }
+    }
+    fclose(file);
+    return offset;
+}
+
+// Write every entry, one difficulty at a time, fastest first
+int writeLeaderboardSnapshot(const LeaderboardStore *store, FILE *out) {
+    for (int i = 0; i < store->indexCount; i++) {
+        for (const LeaderboardNode *node = store->indexes[i].head->next[0].node; node; node = node->next[0].node) {
+            if (fprintf(out, "%s %.2f %.2f %.2f %s\n", node->entry.username, node->entry.typingSpeed,
+                        node->entry.wordsPerMinute, node->entry.accuracy, node->entry.difficulty) < 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+const LeaderboardNode *leaderboardFirst(const LeaderboardStore *store, const char *difficulty) {
+    const LeaderboardIndex *index = getIndex(store, difficulty);
+    return index ? index->head->next[0].node : NULL;
+}
+
+const LeaderboardNode *leaderboardNext(const LeaderboardNode *node) {
+    return node->next[0].node;
+}
+
+size_t leaderboardCount(const LeaderboardStore *store, const char *difficulty) {
+    const LeaderboardIndex *index = getIndex(store, difficulty);
+    return index ? index->count : 0;
+}
+
+const LeaderboardNode *leaderboardAt(const LeaderboardStore *store, const char *difficulty, size_t rank) {
+    const LeaderboardIndex *index = getIndex(store, difficulty);
+    if (!index || rank == 0 || rank > index->count) return NULL;
+    const LeaderboardNode *x = index->head;
+    size_t traversed = 0;
+    for (int i = index->level - 1; i >= 0; i--) {
+        while (x->next[i].node && traversed + x->next[i].span <= rank) {
+            traversed += x->next[i].span;
+            x = x->next[i].node;
+        }
+        if (traversed == rank) return x;
+    }
+    return NULL;
+}
+
+size_t leaderboardRank(const LeaderboardStore *store, const char *difficulty, double typingSpeed) {
+    const LeaderboardIndex *index = getIndex(store, difficulty);
+    if (!index) return 1;
+    const LeaderboardNode *x = index->head;
+    size_t faster = 0;
+    for (int i = index->level - 1; i >= 0; i--) {
+        while (x->next[i].node && x->next[i].node->entry.typingSpeed > typingSpeed) {
+            faster += x->next[i].span;
+            x = x->next[i].node;
+        }
+    }
+    return faster + 1;
+}
@@ -0,0 +1,77 @@
+#ifndef LEADERBOARD_STORE_H
+#define LEADERBOARD_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define LEADERBOARD_MAX_LEVEL 24
+
+typedef struct {
+    char username[50];
+    double typingSpeed;
+    double wordsPerMinute;
+    double accuracy;
+    char difficulty[20];
+} LeaderboardEntry;
+
+struct LeaderboardNode;
+
+typedef struct {
+    struct LeaderboardNode *node;
+    size_t span;                        // positions this link advances
+} LeaderboardLink;
+
+// Skip list node; entries of one difficulty are kept fastest first. Each
+// link records how many positions it skips, so ranks are found in O(log n).
+typedef struct LeaderboardNode {
+    LeaderboardEntry entry;
+    uint64_t sequence;                  // arrival order, breaks speed ties
+    int level;
+    LeaderboardLink next[];
+} LeaderboardNode;
+
+typedef struct {
+    char difficulty[20];
+    LeaderboardNode *head;
+    int level;
+    size_t count;
+} LeaderboardIndex;
+
+// All leaderboard entries, one sorted index per difficulty plus a hash from
+// (username, difficulty) to that user's best entry.
+typedef struct {
+    LeaderboardIndex *indexes;
+    int indexCount;
+    LeaderboardNode **best;
+    size_t bestCapacity;
+    size_t bestCount;
+    uint64_t nextSequence;
+    uint32_t randomState;
+} LeaderboardStore;
+
+void initLeaderboardStore(LeaderboardStore *store);
+void freeLeaderboardStore(LeaderboardStore *store);
+
+// Record a submission. A score that beats the user's best for that difficulty
+// replaces it; any other score is kept as a historical entry. O(log n).
+void recordLeaderboardEntry(LeaderboardStore *store, const LeaderboardEntry *entry);
+
+// Replay "username cpm wpm accuracy difficulty" lines from path starting at
+// byte offset; returns the offset just past the last complete line. Lines
+// starting with '#' are headers and are skipped.
+long replayLeaderboardFile(LeaderboardStore *store, const char *path, long offset);
+int writeLeaderboardSnapshot(const LeaderboardStore *store, FILE *out);
+
+// In-order walk of one difficulty: first node, then leaderboardNext() until NULL
+const LeaderboardNode *leaderboardFirst(const LeaderboardStore *store, const char *difficulty);
+const LeaderboardNode *leaderboardNext(const LeaderboardNode *node);
+size_t leaderboardCount(const LeaderboardStore *store, const char *difficulty);
+
+// Order statistics, O(log n). Ranks are 1-based. leaderboardRank() is the
+// rank a score of typingSpeed would get: one more than the entries strictly
+// faster than it.
+const LeaderboardNode *leaderboardAt(const LeaderboardStore *store, const char *difficulty, size_t rank);
+size_t leaderboardRank(const LeaderboardStore *store, const char *difficulty, double typingSpeed);
+
+#endif
@@ -0,0 +1,198 @@
+// libtypingtutor: the backend as a shared library, with the ABI declared in
+// libtypingtutor.h. It links the same backend units as the executable, so
+// the library runs exactly the code paths of typingtutor.exe:
+//
+//   gcc -O2 -shared -fPIC -fvisibility=hidden libtypingtutor.c backend.c backend_corpus.c backend_scoring.c
+//       backend_leaderboard.c backend_profiles.c scoring.c corpus.c leaderboard_store.c leaderboard_journal.c
+//       keystroke_log.c thread_pool.c file_lock.c profile_store.c progress_store.c score_sketch.c
+//       -o build/libtypingtutor.so -lm -pthread
+//
+// (build/libtypingtutor.dylib on macOS; build/libtypingtutor.dll on Windows.)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef TYPINGTUTOR_BUILDING_LIBRARY
+#define TYPINGTUTOR_BUILDING_LIBRARY
+#endif
+#include "backend.h"
+#include "libtypingtutor.h"
+
+struct TypingTutor {
+    BackendState state;
+    ScoreWorkspace workspace;
+    EditScript edits;
+    ReplyBuffer output;             // of the last submit or run
+    ReplyBuffer paragraph;
+};
+
+static const char paragraphPrefix[] = "Random Paragraph:\n";
+
+TYPINGTUTOR_API int typingTutorAbiVersion(void) {
+    return TYPINGTUTOR_ABI_VERSION;
+}
+
+TYPINGTUTOR_API TypingTutor *typingTutorOpen(const char *dataDirectory) {
+    TypingTutor *tutor = calloc(1, sizeof(TypingTutor));
+    if (!tutor) return NULL;
+    if (setDataDirectory(&tutor->state, dataDirectory) != 0) {
+        free(tutor);
+        return NULL;
+    }
+    initScoreWorkspace(&tutor->workspace);
+    initEditScript(&tutor->edits);
+    srand((unsigned int)time(NULL));
+    return tutor;
+}
+
+TYPINGTUTOR_API void typingTutorClose(TypingTutor *tutor) {
+    if (!tutor) return;
+    freeBackendState(&tutor->state);
+    freeScoreWorkspace(&tutor->workspace);
+    freeEditScript(&tutor->edits);
+    freeReplyBuffer(&tutor->output);
+    freeReplyBuffer(&tutor->paragraph);
+    free(tutor);
+}
+
+static void scoreAttempt(TypingTutor *tutor, const char *paragraph, const char *typed, int caseInsensitive,
+                         double elapsedSeconds, TypingStats *attempt, TypingTutorStats *stats) {
+    memset(attempt, 0, sizeof(*attempt));
+    attempt->caseInsensitive = caseInsensitive;
+    computeTypingStats(&tutor->workspace, elapsedSeconds, typed, paragraph, attempt);
+    alignEdits(&tutor->edits, paragraph, strlen(paragraph), typed, strlen(typed), caseInsensitive);
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    stats->cpm = attempt->typingSpeed;
+    stats->wpm = attempt->wordsPerMinute;
+    stats->accuracy = attempt->accuracy;
+    stats->wrongChars = attempt->wrongChars;
+    stats->substitutions = (int32_t)tutor->edits.substitutions;
+    stats->insertions = (int32_t)tutor->edits.insertions;
+    stats->deletions = (int32_t)tutor->edits.deletions;
+    stats->paragraphLength = attempt->paragraphLength;
+}
+
+TYPINGTUTOR_API int typingTutorScore(TypingTutor *tutor, const char *paragraph, const char *typed,
+                                     int caseInsensitive, double elapsedSeconds, TypingTutorStats *stats) {
+    if (!tutor || !paragraph || !typed || !paragraph[0]) return -1;
+    TypingStats attempt;
+    scoreAttempt(tutor, paragraph, typed, caseInsensitive, elapsedSeconds, &attempt, stats);
+    return 0;
+}
+
+TYPINGTUTOR_API const char *typingTutorParagraph(TypingTutor *tutor, const char *difficulty, const char *username) {
+    if (!tutor || !difficulty) return NULL;
+    ReplyBuffer *reply = &tutor->paragraph;
+    reply->length = 0;
+    if (handleGetParagraph(&tutor->state, difficulty, username && username[0] ? username : NULL, &textQueryOptions,
+                           reply) != 0 ||
+        reply->length < sizeof(paragraphPrefix) ||
+        strncmp(reply->data, paragraphPrefix, sizeof(paragraphPrefix) - 1) != 0) {
+        return NULL;
+    }
+    if (reply->data[reply->length - 1] == '\n') reply->data[--reply->length] = '\0';
+    return reply->data + sizeof(paragraphPrefix) - 1;
+}
+
+TYPINGTUTOR_API int typingTutorSubmit(TypingTutor *tutor, const char *username, const char *difficulty,
+                                      int caseInsensitive, double elapsedSeconds, const char *typed,
+                                      const char *paragraph, TypingTutorStats *stats) {
+    if (!tutor || !username || !difficulty || !typed || !paragraph || !paragraph[0]) return -1;
+    tutor->output.length = 0;
+    replyPrintf(&tutor->output, "%s%s\n", paragraphPrefix, paragraph);
+    TypingStats attempt;
+    scoreAttempt(tutor, paragraph, typed, caseInsensitive, elapsedSeconds, &attempt, stats);
+    recordSubmission(&tutor->state, username, difficulty, &attempt, &tutor->edits, &textQueryOptions, &tutor->output);
+    compactLeaderboardIfNeeded(&tutor->state);
+    return 0;
+}
+
+TYPINGTUTOR_API int typingTutorRun(TypingTutor *tutor, int argc, const char *const *argv) {
+    if (!tutor || argc < 0 || argc > max_serve_args) return -1;
+    // dispatchCommand() may reorder these pointers but never writes the strings
+    char *args[max_serve_args + 2];
+    args[0] = "typingtutor";
+    for (int i = 0; i < argc; i++) args[i + 1] = (char *)argv[i];
+    args[argc + 1] = NULL;
+
+    tutor->output.length = 0;
+    int status = dispatchCommand(&tutor->state, argc + 1, args, &tutor->output);
+    compactLeaderboardIfNeeded(&tutor->state);
+    return status;
+}
+
+TYPINGTUTOR_API const char *typingTutorOutput(const TypingTutor *tutor, size_t *length) {
+    if (length) *length = tutor->output.length;
+    return tutor->output.length > 0 ? tutor->output.data : "";
+}
+
+TYPINGTUTOR_API int64_t typingTutorLeaderboard(TypingTutor *tutor, const char *difficulty, uint64_t offset,
+                                               TypingTutorLeaderboardEntry *entries, size_t capacity,
+                                               uint64_t *total) {
+    if (!tutor || !difficulty || (capacity > 0 && !entries) || offset >= SIZE_MAX) return -1;
+    refreshLeaderboard(&tutor->state);
+    const LeaderboardStore *store = &tutor->state.leaderboard;
+    if (total) *total = leaderboardCount(store, difficulty);
+    size_t written = 0;
+    for (const LeaderboardNode *row = leaderboardAt(store, difficulty, (size_t)offset + 1);
+         row && written < capacity; row = leaderboardNext(row), written++) {
+        TypingTutorLeaderboardEntry *entry = &entries[written];
+        memset(entry, 0, sizeof(*entry));
+        entry->rank = offset + written + 1;
+        snprintf(entry->username, sizeof(entry->username), "%s", row->entry.username);
+        entry->cpm = row->entry.typingSpeed;
+        entry->wpm = row->entry.wordsPerMinute;
+        entry->accuracy = row->entry.accuracy;
+    }
+    return (int64_t)written;
+}
+
+TYPINGTUTOR_API uint64_t typingTutorRank(TypingTutor *tutor, const char *difficulty, double cpm, uint64_t *total) {
+    if (!tutor || !difficulty) return 0;
+    refreshLeaderboard(&tutor->state);
+    if (total) *total = leaderboardCount(&tutor->state.leaderboard, difficulty);
+    return leaderboardRank(&tutor->state.leaderboard, difficulty, cpm);
+}
+
+static void copyProfile(TypingTutorProfile *profile, const char *username, double bestSpeed, double bestAccuracy,
+                        double totalSpeed, double totalAccuracy, int64_t attempts) {
+    double runs = attempts > 0 ? (double)attempts : 1;
+    memset(profile, 0, sizeof(*profile));
+    snprintf(profile->username, sizeof(profile->username), "%.*s", (int)sizeof(profile->username) - 1, username);
+    profile->attempts = attempts;
+    profile->bestCpm = bestSpeed;
+    profile->avgCpm = totalSpeed / runs;
+    profile->bestAccuracy = bestAccuracy;
+    profile->avgAccuracy = totalAccuracy / runs;
+}
+
+TYPINGTUTOR_API int typingTutorProfile(TypingTutor *tutor, const char *username, TypingTutorProfile *profile) {
+    if (!tutor || !username || !profile) return -1;
+    UserProfile user = {0};
+    profileName(username, user.username, sizeof(user.username));
+    if (!getProfileStore(&tutor->state)) return -1;
+    readUserProfile(&tutor->state, &user);
+    copyProfile(profile, user.username, user.bestSpeed, user.bestAccuracy, user.totalSpeed, user.totalAccuracy,
+                user.totalAttempts);
+    return user.totalAttempts > 0 ? 0 : 1;
+}
+
+TYPINGTUTOR_API int64_t typingTutorProfiles(TypingTutor *tutor, uint64_t offset, TypingTutorProfile *profiles,
+                                            size_t capacity, uint64_t *total) {
+    if (!tutor || (capacity > 0 && !profiles)) return -1;
+    ProfileStore *store = getProfileStore(&tutor->state);
+    if (!store || lockProfileStore(store, 0) != 0) return -1;
+    size_t count = profileRecordCount(store);
+    if (total) *total = count;
+    size_t written = 0;
+    for (uint64_t i = offset; i < count && written < capacity; i++, written++) {
+        const ProfileRecord *record = profileRecordAt(store, (size_t)i);
+        copyProfile(&profiles[written], record->username, record->bestSpeed, record->bestAccuracy,
+                    record->totalSpeed, record->totalAccuracy, record->totalAttempts);
+    }
+    unlockProfileStore(store);
+    return (int64_t)written;
+}
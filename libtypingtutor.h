@@ -0,0 +1,120 @@
+#ifndef LIBTYPINGTUTOR_H
+#define LIBTYPINGTUTOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// In-process C ABI over the same backend as typingtutor.exe, for the Tk GUI
+// (libtypingtutor.py, ctypes) and the Electron main process (app/native,
+// N-API). Only the functions and structs below are exported. Fields and
+// functions are only ever appended, and TYPINGTUTOR_ABI_VERSION goes up when
+// they are.
+//
+// Version 2 added the leaderboard and profile queries, which fill
+// caller-provided structs instead of formatting text.
+//
+// A handle is not thread-safe: calls on one handle must not overlap. The
+// file locks that keep processes apart are per process, so a process should
+// have at most one handle open on each data directory.
+
+#define TYPINGTUTOR_ABI_VERSION 2
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__WINDOWS__)
+    #ifdef TYPINGTUTOR_BUILDING_LIBRARY
+        #define TYPINGTUTOR_API __declspec(dllexport)
+    #else
+        #define TYPINGTUTOR_API __declspec(dllimport)
+    #endif
+#else
+    #define TYPINGTUTOR_API __attribute__((visibility("default")))
+#endif
+
+typedef struct TypingTutor TypingTutor;
+
+typedef struct {
+    double cpm;
+    double wpm;
+    double accuracy;                // percent
+    int32_t wrongChars;             // edit distance
+    int32_t substitutions;
+    int32_t insertions;             // extra characters typed
+    int32_t deletions;              // target characters missed
+    uint64_t paragraphLength;
+} TypingTutorStats;
+
+typedef struct {
+    uint64_t rank;                  // 1-based, fastest first
+    char username[50];
+    double cpm;
+    double wpm;
+    double accuracy;                // percent
+} TypingTutorLeaderboardEntry;
+
+typedef struct {
+    char username[50];
+    int64_t attempts;
+    double bestCpm;
+    double avgCpm;
+    double bestAccuracy;            // percent
+    double avgAccuracy;
+} TypingTutorProfile;
+
+TYPINGTUTOR_API int typingTutorAbiVersion(void);
+
+// The data files (paragraphs.txt, profiles.db, the leaderboard journal...)
+// are opened inside dataDirectory, or the working directory when it is NULL.
+// The process's working directory is never changed, so handles on different
+// directories can coexist. NULL on error.
+TYPINGTUTOR_API TypingTutor *typingTutorOpen(const char *dataDirectory);
+TYPINGTUTOR_API void typingTutorClose(TypingTutor *tutor);
+
+// Score typed text against a paragraph without recording anything; the
+// numbers every front end and command reports. Returns 0, or -1 on bad
+// arguments.
+TYPINGTUTOR_API int typingTutorScore(TypingTutor *tutor, const char *paragraph, const char *typed,
+                                     int caseInsensitive, double elapsedSeconds, TypingTutorStats *stats);
+
+// The next paragraph for a difficulty, from the user's no-repeat shuffle
+// when username is given. Valid until the next call on the handle; NULL if
+// there is none.
+TYPINGTUTOR_API const char *typingTutorParagraph(TypingTutor *tutor, const char *difficulty, const char *username);
+
+// Score and record an attempt: leaderboard, profile, progress and score
+// distributions, as a submission to the executable does. The report it
+// would print is left in typingTutorOutput().
+TYPINGTUTOR_API int typingTutorSubmit(TypingTutor *tutor, const char *username, const char *difficulty,
+                                      int caseInsensitive, double elapsedSeconds, const char *typed,
+                                      const char *paragraph, TypingTutorStats *stats);
+
+// Run any one-shot command with the arguments that would follow the
+// executable's name (e.g. "--get-leaderboard", "Easy"). Returns the exit
+// status the executable would have; the text is in typingTutorOutput().
+TYPINGTUTOR_API int typingTutorRun(TypingTutor *tutor, int argc, const char *const *argv);
+
+// Output of the last typingTutorSubmit or typingTutorRun, NUL-terminated and
+// valid until the next call on the handle
+TYPINGTUTOR_API const char *typingTutorOutput(const TypingTutor *tutor, size_t *length);
+
+// Up to capacity entries of a difficulty's leaderboard starting at rank
+// offset + 1, fastest first, as --get-leaderboard pages them. Returns how
+// many were written, or -1 on bad arguments; *total (if given) is the size
+// of the board.
+TYPINGTUTOR_API int64_t typingTutorLeaderboard(TypingTutor *tutor, const char *difficulty, uint64_t offset,
+                                               TypingTutorLeaderboardEntry *entries, size_t capacity,
+                                               uint64_t *total);
+
+// The rank a score of cpm would get on a difficulty's leaderboard: one more
+// than the entries strictly faster. 0 on bad arguments.
+TYPINGTUTOR_API uint64_t typingTutorRank(TypingTutor *tutor, const char *difficulty, double cpm, uint64_t *total);
+
+// A user's totals. Returns 0, 1 for a user with no attempts yet (zero
+// totals), or -1 on error.
+TYPINGTUTOR_API int typingTutorProfile(TypingTutor *tutor, const char *username, TypingTutorProfile *profile);
+
+// Up to capacity profiles from position offset, in --list-profiles order.
+// Returns how many were written, or -1 on error; *total (if given) is the
+// number of profiles.
+TYPINGTUTOR_API int64_t typingTutorProfiles(TypingTutor *tutor, uint64_t offset, TypingTutorProfile *profiles,
+                                            size_t capacity, uint64_t *total);
+
+#endif
@@ -0,0 +1,194 @@
+"""ctypes binding for libtypingtutor (see libtypingtutor.h).
+
+Scores, paragraphs and records come from the same C code as typingtutor.exe
+and the desktop app, in this process. open_typing_tutor() raises OSError,
+saying how to build it, when the library is missing or too old.
+"""
+import ctypes
+import json
+import os
+import sys
+
+ABI_VERSION = 2
+BUILD_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "build")
+
+
+class TypingTutorStats(ctypes.Structure):
+    _fields_ = [
+        ("cpm", ctypes.c_double),
+        ("wpm", ctypes.c_double),
+        ("accuracy", ctypes.c_double),
+        ("wrong_chars", ctypes.c_int32),
+        ("substitutions", ctypes.c_int32),
+        ("insertions", ctypes.c_int32),
+        ("deletions", ctypes.c_int32),
+        ("paragraph_length", ctypes.c_uint64),
+    ]
+
+
+class TypingTutorLeaderboardEntry(ctypes.Structure):
+    _fields_ = [
+        ("rank", ctypes.c_uint64),
+        ("_username", ctypes.c_char * 50),
+        ("cpm", ctypes.c_double),
+        ("wpm", ctypes.c_double),
+        ("accuracy", ctypes.c_double),
+    ]
+
+    @property
+    def username(self):
+        return self._username.decode("utf-8", errors="replace")
+
+
+class TypingTutorProfile(ctypes.Structure):
+    _fields_ = [
+        ("_username", ctypes.c_char * 50),
+        ("attempts", ctypes.c_int64),
+        ("best_cpm", ctypes.c_double),
+        ("avg_cpm", ctypes.c_double),
+        ("best_accuracy", ctypes.c_double),
+        ("avg_accuracy", ctypes.c_double),
+    ]
+
+    @property
+    def username(self):
+        return self._username.decode("utf-8", errors="replace")
+
+
+def _library_path():
+    if sys.platform.startswith("win"):
+        name = "libtypingtutor.dll"
+    elif sys.platform == "darwin":
+        name = "libtypingtutor.dylib"
+    else:
+        name = "libtypingtutor.so"
+    return os.path.join(BUILD_DIR, name)
+
+
+def _load():
+    path = _library_path()
+    try:
+        lib = ctypes.CDLL(path)
+    except OSError as error:
+        raise OSError(f"Could not load {path} ({error}). Build it as described in README.md, "
+                      "section 11 (In-Process Backend).") from error
+    lib.typingTutorAbiVersion.restype = ctypes.c_int
+    lib.typingTutorOpen.argtypes = [ctypes.c_char_p]
+    lib.typingTutorOpen.restype = ctypes.c_void_p
+    lib.typingTutorClose.argtypes = [ctypes.c_void_p]
+    lib.typingTutorScore.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int,
+                                     ctypes.c_double, ctypes.POINTER(TypingTutorStats)]
+    lib.typingTutorParagraph.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p]
+    lib.typingTutorParagraph.restype = ctypes.c_char_p
+    lib.typingTutorSubmit.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int,
+                                      ctypes.c_double, ctypes.c_char_p, ctypes.c_char_p,
+                                      ctypes.POINTER(TypingTutorStats)]
+    lib.typingTutorRun.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.POINTER(ctypes.c_char_p)]
+    lib.typingTutorOutput.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_size_t)]
+    lib.typingTutorOutput.restype = ctypes.POINTER(ctypes.c_char)
+    lib.typingTutorLeaderboard.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_uint64,
+                                           ctypes.POINTER(TypingTutorLeaderboardEntry), ctypes.c_size_t,
+                                           ctypes.POINTER(ctypes.c_uint64)]
+    lib.typingTutorLeaderboard.restype = ctypes.c_int64
+    lib.typingTutorRank.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_double, ctypes.POINTER(ctypes.c_uint64)]
+    lib.typingTutorRank.restype = ctypes.c_uint64
+    lib.typingTutorProfile.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(TypingTutorProfile)]
+    lib.typingTutorProfiles.argtypes = [ctypes.c_void_p, ctypes.c_uint64, ctypes.POINTER(TypingTutorProfile),
+                                        ctypes.c_size_t, ctypes.POINTER(ctypes.c_uint64)]
+    lib.typingTutorProfiles.restype = ctypes.c_int64
+    if lib.typingTutorAbiVersion() < ABI_VERSION:
+        raise OSError(f"{path} is older than this binding; rebuild it as described in README.md, section 11.")
+    return lib
+
+
+def _bytes(text):
+    return text.encode("utf-8") if text is not None else None
+
+
+class TypingTutor:
+    """One handle on the backend; not to be shared between threads."""
+
+    def __init__(self, lib, data_directory):
+        self._lib = lib
+        self._handle = lib.typingTutorOpen(_bytes(data_directory))
+        if not self._handle:
+            raise OSError(f"Could not open the typing tutor data in {data_directory}")
+
+    def close(self):
+        if self._handle:
+            self._lib.typingTutorClose(self._handle)
+            self._handle = None
+
+    def score(self, paragraph, typed, case_insensitive=False, elapsed_seconds=0.0):
+        stats = TypingTutorStats()
+        if self._lib.typingTutorScore(self._handle, _bytes(paragraph), _bytes(typed), int(case_insensitive),
+                                      float(elapsed_seconds), ctypes.byref(stats)) != 0:
+            raise ValueError("Cannot score against an empty paragraph")
+        return stats
+
+    def paragraph(self, difficulty, username=None):
+        text = self._lib.typingTutorParagraph(self._handle, _bytes(difficulty), _bytes(username))
+        return text.decode("utf-8") if text is not None else None
+
+    def submit(self, username, difficulty, typed, paragraph, case_insensitive=False, elapsed_seconds=0.0):
+        stats = TypingTutorStats()
+        if self._lib.typingTutorSubmit(self._handle, _bytes(username), _bytes(difficulty), int(case_insensitive),
+                                       float(elapsed_seconds), _bytes(typed), _bytes(paragraph),
+                                       ctypes.byref(stats)) != 0:
+            raise ValueError("Cannot submit an attempt without a user, difficulty and paragraph")
+        return stats, self._output()
+
+    def run(self, *args):
+        """Any one-shot command, e.g. run("--get-leaderboard", "Easy"); returns (status, output)."""
+        argv = (ctypes.c_char_p * len(args))(*[_bytes(arg) for arg in args])
+        status = self._lib.typingTutorRun(self._handle, len(args), argv)
+        return status, self._output()
+
+    def query(self, *args):
+        """A query's --format json records as dicts, e.g. query("--get-leaderboard", "Easy", "--offset", "1000",
+        "--limit", "50"); list queries start with a header record."""
+        status, output = self.run("--format", "json", *args)
+        if status != 0:
+            raise ValueError(output.strip())
+        return [json.loads(line) for line in output.split("\n") if line]
+
+    def leaderboard(self, difficulty, offset=0, limit=10):
+        """(total, entries) for one page of a difficulty's leaderboard, fastest first."""
+        entries = (TypingTutorLeaderboardEntry * limit)()
+        total = ctypes.c_uint64()
+        count = self._lib.typingTutorLeaderboard(self._handle, _bytes(difficulty), offset, entries, limit,
+                                                 ctypes.byref(total))
+        if count < 0:
+            raise ValueError("Cannot read the leaderboard")
+        return total.value, entries[:count]
+
+    def rank(self, difficulty, cpm):
+        """(rank, total): where a score of cpm would place on a difficulty's leaderboard."""
+        total = ctypes.c_uint64()
+        return self._lib.typingTutorRank(self._handle, _bytes(difficulty), float(cpm), ctypes.byref(total)), total.value
+
+    def profile(self, username):
+        """A user's totals; zero for a user with no attempts yet."""
+        profile = TypingTutorProfile()
+        if self._lib.typingTutorProfile(self._handle, _bytes(username), ctypes.byref(profile)) < 0:
+            raise OSError("Could not read the profile store")
+        return profile
+
+    def profiles(self, offset=0, limit=100):
+        """(total, profiles) for one page of --list-profiles."""
+        profiles = (TypingTutorProfile * limit)()
+        total = ctypes.c_uint64()
+        count = self._lib.typingTutorProfiles(self._handle, offset, profiles, limit, ctypes.byref(total))
+        if count < 0:
+            raise OSError("Could not read the profile store")
+        return total.value, profiles[:count]
+
+    def _output(self):
+        length = ctypes.c_size_t()
+        data = self._lib.typingTutorOutput(self._handle, ctypes.byref(length))
+        return ctypes.string_at(data, length.value).decode("utf-8", errors="replace")
+
+
+def open_typing_tutor(data_directory=BUILD_DIR):
+    """The backend on the data files in data_directory. Raises OSError without a usable library."""
+    return TypingTutor(_load(), data_directory)
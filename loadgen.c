@@ -0,0 +1,516 @@
+// Synthetic typist load generator. Each virtual typist repeatedly fetches a
+// paragraph, "types" it at a sampled speed and error rate, submits the
+// attempt and asks for the leaderboard, exactly as the Electron front end
+// does. Requests go to the real backend binary, either through one resident
+// --serve process per typist (what the app does) or one process per call.
+//
+//   gcc -O2 loadgen.c leaderboard_store.c leaderboard_journal.c file_lock.c keystroke_log.c thread_pool.c
+//       -o build/loadgen -lm -pthread
+//   ./build/loadgen --typists 40 --rounds 10 --wpm 45:15 --error-rate 0.04 --think 3000
+//
+// The backend runs in a scratch directory holding a copy of the corpus, so
+// the real leaderboard is never touched. POSIX only.
+
+#define _GNU_SOURCE                     // pipe2() on Linux
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <math.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "keystroke_log.h"
+#include "leaderboard_journal.h"
+#include "leaderboard_store.h"
+#include "thread_pool.h"
+
+extern char **environ;
+
+#define OP_PARAGRAPH 0
+#define OP_SUBMIT 1
+#define OP_LEADERBOARD 2
+#define OP_COUNT 3
+
+#define max_reply_length (16 * 1024 * 1024)
+
+static const char *opNames[OP_COUNT] = {"get_paragraph", "submit", "get_leaderboard"};
+static const char *difficulties[] = {"Easy", "Medium", "Hard"};
+
+typedef struct {
+    int typists;
+    int rounds;
+    double wpmMean;
+    double wpmStddev;
+    double errorRate;
+    double thinkMs;
+    double timeScale;           // multiplies every simulated wait
+    int oneShot;
+    int json;
+    char backend[PATH_MAX];
+    const char *corpus;
+} LoadConfig;
+
+// Best CPM each typist submitted per difficulty, for the consistency check
+typedef struct {
+    double best[3];
+    int submitted[3];
+} TypistResult;
+
+typedef struct {
+    uint64_t *samples[OP_COUNT];
+    size_t count[OP_COUNT];
+    size_t errors[OP_COUNT];
+    TypistResult result;
+    uint32_t randomState;
+} TypistState;
+
+typedef struct {
+    pid_t pid;
+    FILE *requests;
+    FILE *replies;
+} ServeClient;
+
+typedef struct {
+    int status;
+    char *body;
+    size_t length;
+} Reply;
+
+static LoadConfig config;
+static TypistState *typists;
+
+static uint32_t nextRandom(TypistState *typist) {
+    uint32_t x = typist->randomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return typist->randomState = x;
+}
+
+static double uniform(TypistState *typist) {
+    return (nextRandom(typist) + 0.5) / 4294967296.0;
+}
+
+static double normal(TypistState *typist, double mean, double stddev) {
+    double u = uniform(typist), v = uniform(typist);
+    return mean + stddev * sqrt(-2.0 * log(u)) * cos(6.283185307179586 * v);
+}
+
+static void simulateWait(double ms) {
+    ms *= config.timeScale;
+    if (ms <= 0) return;
+    struct timespec ts = {(time_t)(ms / 1000), (long)(fmod(ms, 1000) * 1e6)};
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {}
+}
+
+// ---- Talking to the backend ----
+
+// Typists spawn backends concurrently, so every pipe must be close-on-exec or
+// one typist's backend keeps another typist's pipe open
+static int openPipe(int fds[2]) {
+#if defined(__linux__)
+    return pipe2(fds, O_CLOEXEC);
+#else
+    if (pipe(fds) != 0) return -1;
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return 0;
+#endif
+}
+
+static int startServeClient(ServeClient *client) {
+    int toChild[2], fromChild[2];
+    if (openPipe(toChild) != 0) return -1;
+    if (openPipe(fromChild) != 0) {
+        close(toChild[0]);
+        close(toChild[1]);
+        return -1;
+    }
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, toChild[0], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, fromChild[1], STDOUT_FILENO);
+    char *argv[] = {config.backend, "--serve", NULL};
+    int failed = posix_spawn(&client->pid, config.backend, &actions, NULL, argv, environ) != 0;
+    posix_spawn_file_actions_destroy(&actions);
+    close(toChild[0]);
+    close(fromChild[1]);
+    if (failed) {
+        close(toChild[1]);
+        close(fromChild[0]);
+        return -1;
+    }
+    client->requests = fdopen(toChild[1], "w");
+    client->replies = fdopen(fromChild[0], "r");
+    return client->requests && client->replies ? 0 : -1;
+}
+
+static void stopServeClient(ServeClient *client) {
+    if (client->requests) fclose(client->requests);
+    if (client->replies) fclose(client->replies);
+    if (client->pid > 0) waitpid(client->pid, NULL, 0);
+    memset(client, 0, sizeof(*client));
+}
+
+static int serveRequest(ServeClient *client, int argc, char *argv[], Reply *reply) {
+    size_t length = 0;
+    for (int i = 0; i < argc; i++) length += strlen(argv[i]) + 1;
+    fprintf(client->requests, "%zu\n", length);
+    for (int i = 0; i < argc; i++) fwrite(argv[i], 1, strlen(argv[i]) + 1, client->requests);
+    if (fflush(client->requests) != 0) return -1;
+
+    unsigned long bodyLength;
+    if (fscanf(client->replies, "%d %lu", &reply->status, &bodyLength) != 2 || fgetc(client->replies) != '\n' ||
+        bodyLength > max_reply_length) {
+        return -1;
+    }
+    reply->body = realloc(reply->body, bodyLength + 1);
+    if (!reply->body || fread(reply->body, 1, bodyLength, client->replies) != bodyLength) return -1;
+    reply->body[bodyLength] = '\0';
+    reply->length = bodyLength;
+    return 0;
+}
+
+// One process per call, stdout and stderr captured together
+static int oneShotRequest(int argc, char *argv[], Reply *reply) {
+    int output[2];
+    if (openPipe(output) != 0) return -1;
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, output[1], STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, output[1], STDERR_FILENO);
+    char *args[16];
+    args[0] = config.backend;
+    for (int i = 0; i < argc && i < 14; i++) args[i + 1] = argv[i];
+    args[argc < 14 ? argc + 1 : 15] = NULL;
+    pid_t pid;
+    int failed = posix_spawn(&pid, config.backend, &actions, NULL, args, environ) != 0;
+    posix_spawn_file_actions_destroy(&actions);
+    close(output[1]);
+    if (failed) {
+        close(output[0]);
+        return -1;
+    }
+
+    size_t capacity = 4096;
+    reply->length = 0;
+    reply->body = realloc(reply->body, capacity);
+    ssize_t n;
+    while (reply->body && (n = read(output[0], reply->body + reply->length, capacity - reply->length - 1)) != 0) {
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        reply->length += (size_t)n;
+        if (reply->length + 1 == capacity) reply->body = realloc(reply->body, capacity *= 2);
+    }
+    close(output[0]);
+    int status;
+    if (waitpid(pid, &status, 0) < 0 || !reply->body) return -1;
+    reply->body[reply->length] = '\0';
+    reply->status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    return 0;
+}
+
+static int timedRequest(TypistState *typist, ServeClient *client, int op, int argc, char *argv[], Reply *reply) {
+    uint64_t start = monotonicNanoseconds();
+    int failed = config.oneShot ? oneShotRequest(argc, argv, reply) : serveRequest(client, argc, argv, reply);
+    uint64_t elapsed = monotonicNanoseconds() - start;
+    typist->samples[op][typist->count[op]++] = elapsed;
+    if (failed || reply->status != 0) {
+        typist->errors[op]++;
+        return -1;
+    }
+    return 0;
+}
+
+// ---- Virtual typist ----
+
+static double replyNumber(const char *body, const char *label) {
+    const char *found = strstr(body, label);
+    return found ? atof(found + strlen(label)) : -1;
+}
+
+static void runTypist(void *context, size_t index, int worker) {
+    (void)context;
+    (void)worker;
+    TypistState *typist = &typists[index];
+    ServeClient client = {0};
+    Reply reply = {0};
+    char username[32];
+    snprintf(username, sizeof(username), "loadgen-%zu", index);
+    for (int d = 0; d < 3; d++) typist->result.best[d] = -1;
+
+    if (!config.oneShot && startServeClient(&client) != 0) {
+        fprintf(stderr, "Typist %zu: could not start %s\n", index, config.backend);
+        for (int op = 0; op < OP_COUNT; op++) typist->errors[op] += config.rounds;
+        return;
+    }
+
+    // Everyone typing at the same instant is not what a classroom looks like
+    simulateWait(uniform(typist) * config.thinkMs);
+
+    for (int round = 0; round < config.rounds; round++) {
+        int d = nextRandom(typist) % 3;
+        const char *difficulty = difficulties[d];
+
+        char *paragraphArgs[] = {"--get-paragraph", (char *)difficulty};
+        if (timedRequest(typist, &client, OP_PARAGRAPH, 2, paragraphArgs, &reply) != 0) continue;
+        const char *text = strchr(reply.body, '\n');
+        if (!text) continue;
+        char *paragraph = strdup(text + 1);
+        paragraph[strcspn(paragraph, "\n")] = '\0';
+
+        size_t length = strlen(paragraph);
+        char *typed = malloc(length + 1);
+        for (size_t i = 0; i < length; i++) {
+            typed[i] = uniform(typist) < config.errorRate ? (char)('a' + nextRandom(typist) % 26) : paragraph[i];
+        }
+        typed[length] = '\0';
+        double wpm = normal(typist, config.wpmMean, config.wpmStddev);
+        if (wpm < 5) wpm = 5;
+        double seconds = length / (wpm * 5.0) * 60.0;
+        simulateWait(seconds * 1000);
+
+        char elapsed[32];
+        snprintf(elapsed, sizeof(elapsed), "%.2f", seconds);
+        char *submitArgs[] = {username, (char *)difficulty, "0", elapsed, typed, paragraph};
+        if (timedRequest(typist, &client, OP_SUBMIT, 6, submitArgs, &reply) == 0) {
+            // The reply echoes the paragraph first; only look past it
+            const char *stats = strstr(reply.body, "\nTyping Stats:\n");
+            if (!stats) stats = reply.body;
+            double cpm = replyNumber(stats, "CPM: ");
+            double wpmResult = replyNumber(stats, "WPM: ");
+            double accuracy = replyNumber(stats, "Accuracy: ");
+            if (cpm > typist->result.best[d]) typist->result.best[d] = cpm;
+            typist->result.submitted[d]++;
+
+            char cpmText[32], wpmText[32], accuracyText[32];
+            snprintf(cpmText, sizeof(cpmText), "%.2f", cpm);
+            snprintf(wpmText, sizeof(wpmText), "%.2f", wpmResult);
+            snprintf(accuracyText, sizeof(accuracyText), "%.2f", accuracy);
+            char *leaderboardArgs[] = {"--get-leaderboard", (char *)difficulty, username, cpmText, wpmText, accuracyText};
+            timedRequest(typist, &client, OP_LEADERBOARD, 6, leaderboardArgs, &reply);
+        }
+        free(typed);
+        free(paragraph);
+
+        simulateWait(-log(uniform(typist)) * config.thinkMs);
+    }
+
+    if (!config.oneShot) {
+        char *quitArgs[] = {"--quit"};
+        size_t length = strlen(quitArgs[0]) + 1;
+        fprintf(client.requests, "%zu\n%s%c", length, quitArgs[0], '\0');
+        fflush(client.requests);
+        stopServeClient(&client);
+    }
+    free(reply.body);
+}
+
+// ---- Report ----
+
+static int compareSamples(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentileMs(const uint64_t *sorted, size_t count, double fraction) {
+    return count ? sorted[(size_t)(fraction * (count - 1) + 0.5)] / 1e6 : 0;
+}
+
+// Every typist's best score per difficulty must be on the shared leaderboard
+static void checkConsistency(size_t *checked, size_t *missing, size_t *unexpected) {
+    LeaderboardJournal journal;
+    LeaderboardStore store;
+    initLeaderboardStore(&store);
+    if (openLeaderboardJournal(&journal, NULL) == 0) {
+        refreshLeaderboardView(&journal, &store);
+        closeLeaderboardJournal(&journal);
+    }
+
+    double *found = malloc((size_t)config.typists * 3 * sizeof(double));
+    for (int i = 0; i < config.typists * 3; i++) found[i] = -1;
+    *checked = *missing = *unexpected = 0;
+    for (int d = 0; d < 3; d++) {
+        for (const LeaderboardNode *node = leaderboardFirst(&store, difficulties[d]); node; node = leaderboardNext(node)) {
+            int id;
+            if (sscanf(node->entry.username, "loadgen-%d", &id) != 1 || id < 0 || id >= config.typists) {
+                (*unexpected)++;
+                continue;
+            }
+            double *best = &found[id * 3 + d];
+            if (node->entry.typingSpeed > *best) *best = node->entry.typingSpeed;
+        }
+    }
+    for (int i = 0; i < config.typists; i++) {
+        for (int d = 0; d < 3; d++) {
+            if (typists[i].result.submitted[d] == 0) continue;
+            (*checked)++;
+            if (fabs(found[i * 3 + d] - typists[i].result.best[d]) >= 0.01) (*missing)++;
+        }
+    }
+    free(found);
+    freeLeaderboardStore(&store);
+}
+
+static void report(double wallSeconds) {
+    if (!config.json) {
+        printf("%d typists x %d rounds, %s backend, %.1f s wall time\n", config.typists, config.rounds,
+               config.oneShot ? "one-shot" : "--serve", wallSeconds);
+        printf("%-16s %8s %8s %10s %10s %10s %10s %10s\n", "request", "count", "errors", "req/s",
+               "p50 ms", "p90 ms", "p99 ms", "max ms");
+    }
+    for (int op = 0; op < OP_COUNT; op++) {
+        size_t total = 0, errors = 0;
+        for (int i = 0; i < config.typists; i++) {
+            total += typists[i].count[op];
+            errors += typists[i].errors[op];
+        }
+        uint64_t *all = malloc((total ? total : 1) * sizeof(uint64_t));
+        size_t pos = 0;
+        for (int i = 0; i < config.typists; i++) {
+            memcpy(all + pos, typists[i].samples[op], typists[i].count[op] * sizeof(uint64_t));
+            pos += typists[i].count[op];
+        }
+        qsort(all, total, sizeof(uint64_t), compareSamples);
+        double p50 = percentileMs(all, total, 0.5), p90 = percentileMs(all, total, 0.9);
+        double p99 = percentileMs(all, total, 0.99), max = total ? all[total - 1] / 1e6 : 0;
+        if (config.json) {
+            printf("{\"request\":\"%s\",\"count\":%zu,\"errors\":%zu,\"per_sec\":%.2f,\"p50_ms\":%.3f,"
+                   "\"p90_ms\":%.3f,\"p99_ms\":%.3f,\"max_ms\":%.3f}\n",
+                   opNames[op], total, errors, total / wallSeconds, p50, p90, p99, max);
+        } else {
+            printf("%-16s %8zu %8zu %10.1f %10.2f %10.2f %10.2f %10.2f\n", opNames[op], total, errors,
+                   total / wallSeconds, p50, p90, p99, max);
+        }
+        free(all);
+    }
+
+    size_t checked, missing, unexpected;
+    checkConsistency(&checked, &missing, &unexpected);
+    if (config.json) {
+        printf("{\"leaderboard_checked\":%zu,\"leaderboard_missing\":%zu,\"leaderboard_unexpected\":%zu}\n",
+               checked, missing, unexpected);
+    } else {
+        printf("Leaderboard: %zu best scores checked, %zu missing or wrong, %zu unexpected entries\n",
+               checked, missing, unexpected);
+    }
+}
+
+static void printUsage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --typists N          concurrent virtual typists (10)\n"
+            "  --rounds N           attempts per typist (5)\n"
+            "  --wpm MEAN[:STDDEV]  typing speed distribution (40:10)\n"
+            "  --error-rate P       chance of a wrong character (0.03)\n"
+            "  --think MS           mean pause between attempts, exponential (2000)\n"
+            "  --time-scale F       multiply every simulated wait by F (0.01)\n"
+            "  --one-shot           one backend process per request instead of --serve\n"
+            "  --backend PATH       backend binary (build/typingtutor.exe)\n"
+            "  --corpus PATH        paragraphs file (build/paragraphs.txt)\n"
+            "  --json               JSON lines instead of a table\n",
+            program);
+}
+
+static int copyFile(const char *from, const char *to) {
+    FILE *in = fopen(from, "rb");
+    if (!in) return -1;
+    FILE *out = fopen(to, "wb");
+    if (!out) {
+        fclose(in);
+        return -1;
+    }
+    char buf[65536];
+    size_t n;
+    int failed = 0;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0) failed |= fwrite(buf, 1, n, out) != n;
+    fclose(in);
+    failed |= fclose(out) != 0;
+    return failed ? -1 : 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *backend = "build/typingtutor.exe";
+    config = (LoadConfig){10, 5, 40, 10, 0.03, 2000, 0.01, 0, 0, "", "build/paragraphs.txt"};
+    for (int i = 1; i < argc; i++) {
+        int hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--typists") == 0 && hasValue) {
+            config.typists = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rounds") == 0 && hasValue) {
+            config.rounds = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--wpm") == 0 && hasValue) {
+            char *colon;
+            config.wpmMean = strtod(argv[++i], &colon);
+            if (*colon == ':') config.wpmStddev = atof(colon + 1);
+        } else if (strcmp(argv[i], "--error-rate") == 0 && hasValue) {
+            config.errorRate = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--think") == 0 && hasValue) {
+            config.thinkMs = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--time-scale") == 0 && hasValue) {
+            config.timeScale = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--one-shot") == 0) {
+            config.oneShot = 1;
+        } else if (strcmp(argv[i], "--backend") == 0 && hasValue) {
+            backend = argv[++i];
+        } else if (strcmp(argv[i], "--corpus") == 0 && hasValue) {
+            config.corpus = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0) {
+            config.json = 1;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (config.typists < 1 || config.rounds < 1 || !realpath(backend, config.backend)) {
+        if (config.typists >= 1 && config.rounds >= 1) perror(backend);
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // A typist whose backend died must not take the whole run down
+    signal(SIGPIPE, SIG_IGN);
+
+    char scratch[] = "/tmp/typingtutor-load.XXXXXX";
+    if (!mkdtemp(scratch)) {
+        perror("Error creating scratch directory");
+        return 1;
+    }
+    char corpusCopy[PATH_MAX];
+    snprintf(corpusCopy, sizeof(corpusCopy), "%s/paragraphs.txt", scratch);
+    if (copyFile(config.corpus, corpusCopy) != 0 || chdir(scratch) != 0) {
+        perror(config.corpus);
+        return 1;
+    }
+
+    typists = calloc((size_t)config.typists, sizeof(TypistState));
+    for (int i = 0; i < config.typists; i++) {
+        typists[i].randomState = 2463534242u ^ (uint32_t)(i * 2654435761u);
+        for (int op = 0; op < OP_COUNT; op++) typists[i].samples[op] = malloc((size_t)config.rounds * sizeof(uint64_t));
+    }
+
+    uint64_t start = monotonicNanoseconds();
+    parallelFor((size_t)config.typists, config.typists, runTypist, NULL);
+    double wallSeconds = (monotonicNanoseconds() - start) / 1e9;
+
+    report(wallSeconds);
+    fprintf(stderr, "Backend files left in %s\n", scratch);
+
+    size_t errors = 0;
+    for (int i = 0; i < config.typists; i++) {
+        for (int op = 0; op < OP_COUNT; op++) {
+            errors += typists[i].errors[op];
+            free(typists[i].samples[op]);
+        }
+    }
+    free(typists);
+    return errors ? 1 : 0;
+}
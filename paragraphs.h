@@ -1,12 +1,727 @@
-const char* embedded_paragraphs[] = {
-    "One day after a heavy meal. It was sleeping under a tree.",
-    "After a while, there came a mouse and it started to play on the lion.",
-    "Suddenly the lion got up with anger and looked for those who disturbed its nice sleep.",
-    "Then it saw a small mouse standing trembling with fear.",
-    "The lion jumped on it and started to kill it. The mouse requested the lion to forgive it.",
-    "The lion felt pity and left it. The mouse ran away.",
-    "On another day, the lion was caught in a net by a hunter. The mouse came there and cut the net.",
-    "Thus it escaped. There after, the mouse and the lion became friends.",
-    "They lived happily in the forest afterwards.",
-};
-const int embedded_paragraph_count = sizeof(embedded_paragraphs) / sizeof(embedded_paragraphs[0]);
+// Generated from build/paragraphs.txt by embed_corpus.c; do not edit.
+// The compiled paragraph corpus, served when neither paragraphs.txt nor
+// paragraphs.bin exists.
+#ifndef EMBEDDED_PARAGRAPHS_H
+#define EMBEDDED_PARAGRAPHS_H
+
+#include "corpus.h"
+
+static const char embedded_corpus_text[] =
+    "The cat sat on the mat." "\000"
+    "I like to play games." "\000"
+    "She runs very fast." "\000"
+    "It is a sunny day." "\000"
+    "Dogs bark at night." "\000"
+    "Books are fun to read." "\000"
+    "The sun rises in the east." "\000"
+    "He has a red ball." "\000"
+    "We went to the park." "\000"
+    "Fish swim in water." "\000"
+    "After a while, there came a mouse and it started to play on the lion." "\000"
+    "The lion felt pity and left it. The mouse ran away." "\000"
+    "Suddenly the lion got up with anger and looked for those who disturbed its nice sleep." "\000"
+    "Then it saw a small mouse standing trembling with fear." "\000"
+    "The mouse requested the lion to forgive it." "\000"
+    "They lived happily in the forest afterwards." "\000"
+    "The children played outside until it got dark." "\000"
+    "My sister baked a chocolate cake for my birthday." "\000"
+    "The teacher explained the lesson clearly to the students." "\000"
+    "We watched a movie together last weekend." "\000"
+    "On another day, the lion was caught in a net by a hunter. The mouse came there and cut the net." "\000"
+    "Thus it escaped. There after, the mouse and the lion became friends." "\000"
+    "Despite the heavy rain, the determined marathon runners continued their race through the winding city streets." "\000"
+    "The scientist meticulously recorded every observation, ensuring that no detail was overlooked in the complex experiment." "\000"
+    "As the orchestra played the symphony, the audience sat in awe, captivated by the intricate harmonies and dynamic rhythms." "\000"
+    "The ancient manuscript, written in a language long forgotten, posed a significant challenge to even the most skilled linguists." "\000"
+    "While technological advancements have greatly improved communication, they have also introduced new ethical dilemmas for society to consider." "\000"
+    "The mountain climbers faced numerous obstacles, including treacherous weather and steep cliffs, but their perseverance led them to the summit." "\000";
+
+static const CorpusSectionRecord embedded_corpus_sections[] = {
+    {"Easy", 0, 10},
+    {"Medium", 10, 10},
+    {"Hard", 20, 8},
+};
+
+static const CorpusEntry embedded_corpus_entries[] = {
+    {0, 23, 0}, {24, 21, 0}, {46, 19, 0}, {66, 18, 0},
+    {85, 19, 0}, {105, 22, 0}, {128, 26, 0}, {155, 18, 0},
+    {174, 20, 0}, {195, 19, 0}, {215, 69, 0}, {285, 51, 0},
+    {337, 86, 0}, {424, 55, 0}, {480, 43, 0}, {524, 44, 0},
+    {569, 46, 0}, {616, 49, 0}, {666, 57, 0}, {724, 41, 0},
+    {766, 95, 0}, {862, 68, 0}, {931, 110, 0}, {1042, 120, 0},
+    {1163, 121, 0}, {1285, 127, 0}, {1413, 141, 0}, {1555, 142, 0},
+};
+
+static const CorpusPosting embedded_corpus_postings[] = {
+    {5, 0x1.745d18p-5f}, {7, 0x1.c71c72p-5f}, {1, 0x1.861862p-5f}, {4, 0x1.af286cp-5f},
+    {8, 0x1.99999ap-5f}, {5, 0x1.745d18p-5f}, {7, 0x1.c71c72p-5f}, {2, 0x1.af286cp-5f},
+    {6, 0x1.3b13b2p-5f}, {0, 0x1.0b2164p-3f}, {4, 0x1.af286cp-5f}, {9, 0x1.af286cp-5f},
+    {3, 0x1.c71c72p-5f}, {1, 0x1.861862p-5f}, {7, 0x1.c71c72p-5f}, {4, 0x1.af286cp-5f},
+    {5, 0x1.745d18p-5f}, {0, 0x1.642c86p-5f}, {3, 0x1.c71c72p-5f}, {4, 0x1.af286cp-5f},
+    {5, 0x1.745d18p-5f}, {6, 0x1.3b13b2p-5f}, {7, 0x1.c71c72p-5f}, {8, 0x1.99999ap-5f},
+    {2, 0x1.af286cp-5f}, {9, 0x1.af286cp-5f}, {1, 0x1.861862p-5f}, {6, 0x1.3b13b2p-5f},
+    {2, 0x1.af286cp-5f}, {9, 0x1.af286cp-5f}, {5, 0x1.745d18p-5f}, {1, 0x1.861862p-5f},
+    {4, 0x1.af286cp-5f}, {4, 0x1.af286cp-5f}, {7, 0x1.c71c72p-5f}, {0, 0x1.642c86p-4f},
+    {6, 0x1.3b13b2p-4f}, {7, 0x1.c71c72p-5f}, {2, 0x1.af286cp-5f}, {8, 0x1.99999ap-5f},
+    {4, 0x1.af286cp-5f}, {4, 0x1.af286cp-5f}, {1, 0x1.861862p-5f}, {9, 0x1.af286cp-5f},
+    {9, 0x1.af286cp-5f}, {6, 0x1.3b13b2p-5f}, {3, 0x1.c71c72p-5f}, {9, 0x1.af286cp-5f},
+    {6, 0x1.3b13b2p-5f}, {3, 0x1.c71c72p-5f}, {1, 0x1.861862p-5f}, {5, 0x1.745d18p-5f},
+    {1, 0x1.861862p-5f}, {1, 0x1.861862p-5f}, {7, 0x1.c71c72p-5f}, {0, 0x1.642c86p-5f},
+    {1, 0x1.861862p-5f}, {4, 0x1.af286cp-5f}, {3, 0x1.c71c72p-5f}, {2, 0x1.af286cp-5f},
+    {8, 0x1.99999ap-5f}, {3, 0x1.c71c72p-5f}, {4, 0x1.af286cp-5f}, {5, 0x1.745d18p-5f},
+    {0, 0x1.642c86p-5f}, {5, 0x1.745d18p-5f}, {8, 0x1.99999ap-5f}, {1, 0x1.861862p-5f},
+    {5, 0x1.745d18p-4f}, {7, 0x1.c71c72p-5f}, {6, 0x1.3b13b2p-5f}, {4, 0x1.af286cp-5f},
+    {8, 0x1.99999ap-5f}, {2, 0x1.af286cp-5f}, {2, 0x1.af286cp-5f}, {0, 0x1.642c86p-5f},
+    {6, 0x1.3b13b2p-5f}, {2, 0x1.af286cp-5f}, {9, 0x1.af286cp-5f}, {2, 0x1.af286cp-5f},
+    {6, 0x1.3b13b2p-5f}, {3, 0x1.c71c72p-5f}, {6, 0x1.3b13b2p-5f}, {9, 0x1.af286cp-5f},
+    {9, 0x1.af286cp-5f}, {0, 0x1.642c86p-4f}, {6, 0x1.3b13b2p-4f}, {8, 0x1.99999ap-5f},
+    {8, 0x1.99999ap-5f}, {1, 0x1.861862p-5f}, {5, 0x1.745d18p-5f}, {3, 0x1.c71c72p-5f},
+    {2, 0x1.af286cp-5f}, {5, 0x1.745d18p-5f}, {6, 0x1.3b13b2p-5f}, {2, 0x1.af286cp-5f},
+    {9, 0x1.af286cp-5f}, {8, 0x1.99999ap-4f}, {9, 0x1.af286cp-5f}, {7, 0x1.c71c72p-5f},
+    {1, 0x1.861862p-5f}, {5, 0x1.745d18p-5f}, {4, 0x1.af286cp-5f}, {8, 0x1.99999ap-5f},
+    {2, 0x1.af286cp-5f}, {6, 0x1.3b13b2p-5f}, {9, 0x1.af286cp-5f}, {7, 0x1.c71c72p-5f},
+    {4, 0x1.af286cp-5f}, {5, 0x1.745d18p-5f}, {0, 0x1.642c86p-5f}, {3, 0x1.c71c72p-5f},
+    {4, 0x1.af286cp-5f}, {5, 0x1.745d18p-5f}, {6, 0x1.3b13b2p-5f}, {8, 0x1.99999ap-5f},
+    {2, 0x1.af286cp-5f}, {2, 0x1.af286cp-5f}, {9, 0x1.af286cp-5f}, {5, 0x1.745d18p-5f},
+    {1, 0x1.861862p-5f}, {4, 0x1.af286cp-5f}, {7, 0x1.c71c72p-5f}, {4, 0x1.af286cp-5f},
+    {1, 0x1.861862p-5f}, {6, 0x1.3b13b2p-5f}, {9, 0x1.af286cp-5f}, {1, 0x1.861862p-5f},
+    {1, 0x1.861862p-5f}, {0, 0x1.642c86p-5f}, {1, 0x1.861862p-5f}, {4, 0x1.af286cp-5f},
+    {3, 0x1.c71c72p-5f}, {4, 0x1.af286cp-5f}, {5, 0x1.745d18p-5f}, {5, 0x1.745d18p-5f},
+    {8, 0x1.99999ap-5f}, {1, 0x1.861862p-5f}, {5, 0x1.745d18p-5f}, {7, 0x1.c71c72p-5f},
+    {6, 0x1.3b13b2p-5f}, {2, 0x1.af286cp-5f}, {0, 0x1.642c86p-5f}, {6, 0x1.3b13b2p-5f},
+    {2, 0x1.af286cp-5f}, {3, 0x1.c71c72p-5f}, {6, 0x1.3b13b2p-5f}, {9, 0x1.af286cp-5f},
+    {9, 0x1.af286cp-5f}, {0, 0x1.642c86p-4f}, {6, 0x1.3b13b2p-4f}, {8, 0x1.99999ap-5f},
+    {3, 0x1.c71c72p-5f}, {2, 0x1.af286cp-5f}, {2, 0x1.af286cp-5f}, {9, 0x1.af286cp-5f},
+    {8, 0x1.99999ap-5f}, {9, 0x1.af286cp-5f}, {18, 0x1.1f7048p-6f}, {15, 0x1.745d18p-6f},
+    {10, 0x1.dae608p-7f}, {18, 0x1.1f7048p-6f}, {17, 0x1.4e5e0ap-5f}, {13, 0x1.29e412p-6f},
+    {10, 0x1.dae608p-7f}, {11, 0x1.414142p-5f}, {12, 0x1.7d05f4p-6f}, {13, 0x1.29e412p-6f},
+    {10, 0x1.dae608p-7f}, {15, 0x1.745d18p-6f}, {15, 0x1.745d18p-6f}, {16, 0x1.642c86p-6f},
+    {13, 0x1.29e412p-6f}, {18, 0x1.1f7048p-6f}, {10, 0x1.dae608p-7f}, {19, 0x1.8f9c18p-6f},
+    {19, 0x1.8f9c18p-6f}, {17, 0x1.4e5e0ap-6f}, {11, 0x1.414142p-6f}, {13, 0x1.29e412p-6f},
+    {16, 0x1.642c86p-6f}, {17, 0x1.4e5e0ap-6f}, {11, 0x1.414142p-6f}, {10, 0x1.dae608p-7f},
+    {17, 0x1.4e5e0ap-6f}, {12, 0x1.7d05f4p-7f}, {17, 0x1.4e5e0ap-6f}, {13, 0x1.29e412p-6f},
+    {17, 0x1.4e5e0ap-6f}, {10, 0x1.dae608p-7f}, {12, 0x1.7d05f4p-7f}, {19, 0x1.8f9c18p-6f},
+    {16, 0x1.642c86p-6f}, {17, 0x1.4e5e0ap-6f}, {18, 0x1.1f7048p-6f}, {18, 0x1.1f7048p-6f},
+    {17, 0x1.4e5e0ap-6f}, {16, 0x1.642c86p-6f}, {17, 0x1.4e5e0ap-6f}, {12, 0x1.7d05f4p-7f},
+    {16, 0x1.642c86p-6f}, {18, 0x1.1f7048p-6f}, {12, 0x1.7d05f4p-7f}, {13, 0x1.29e412p-6f},
+    {12, 0x1.7d05f4p-7f}, {16, 0x1.642c86p-6f}, {15, 0x1.745d18p-6f}, {18, 0x1.1f7048p-5f},
+    {13, 0x1.29e412p-6f}, {19, 0x1.8f9c18p-6f}, {12, 0x1.7d05f4p-6f}, {14, 0x1.7d05f4p-6f},
+    {15, 0x1.745d18p-6f}, {16, 0x1.642c86p-6f}, {17, 0x1.4e5e0ap-6f}, {18, 0x1.1f7048p-6f},
+    {10, 0x1.dae608p-7f}, {19, 0x1.8f9c18p-6f}, {12, 0x1.7d05f4p-7f}, {11, 0x1.414142p-6f},
+    {19, 0x1.8f9c18p-6f}, {11, 0x1.414142p-6f}, {13, 0x1.29e412p-6f}, {19, 0x1.8f9c18p-6f},
+    {16, 0x1.642c86p-6f}, {13, 0x1.29e412p-6f}, {18, 0x1.1f7048p-6f}, {12, 0x1.7d05f4p-7f},
+    {12, 0x1.7d05f4p-7f}, {14, 0x1.7d05f4p-6f}, {10, 0x1.dae608p-6f}, {19, 0x1.8f9c18p-6f},
+    {15, 0x1.745d18p-6f}, {17, 0x1.4e5e0ap-6f}, {18, 0x1.1f7048p-6f}, {12, 0x1.7d05f4p-7f},
+    {14, 0x1.7d05f4p-6f}, {15, 0x1.745d18p-6f}, {18, 0x1.1f7048p-6f}, {19, 0x1.8f9c18p-6f},
+    {18, 0x1.1f7048p-6f}, {15, 0x1.745d18p-6f}, {11, 0x1.414142p-6f}, {13, 0x1.29e412p-6f},
+    {14, 0x1.7d05f4p-6f}, {15, 0x1.745d18p-6f}, {17, 0x1.4e5e0ap-6f}, {12, 0x1.7d05f4p-7f},
+    {15, 0x1.745d18p-6f}, {11, 0x1.414142p-6f}, {10, 0x1.dae608p-7f}, {19, 0x1.8f9c18p-6f},
+    {12, 0x1.7d05f4p-7f}, {14, 0x1.7d05f4p-6f}, {16, 0x1.642c86p-6f}, {12, 0x1.7d05f4p-7f},
+    {15, 0x1.745d18p-6f}, {17, 0x1.4e5e0ap-6f}, {18, 0x1.1f7048p-4f}, {19, 0x1.8f9c18p-5f},
+    {14, 0x1.7d05f4p-5f}, {15, 0x1.745d18p-5f}, {11, 0x1.414142p-5f}, {10, 0x1.dae608p-6f},
+    {16, 0x1.642c86p-6f}, {13, 0x1.29e412p-6f}, {12, 0x1.7d05f4p-7f}, {16, 0x1.642c86p-6f},
+    {10, 0x1.dae608p-7f}, {12, 0x1.7d05f4p-6f}, {17, 0x1.4e5e0ap-6f}, {12, 0x1.7d05f4p-7f},
+    {16, 0x1.642c86p-6f}, {19, 0x1.8f9c18p-6f}, {16, 0x1.642c86p-5f}, {15, 0x1.745d18p-6f},
+    {10, 0x1.dae608p-7f}, {13, 0x1.29e412p-5f}, {15, 0x1.745d18p-6f}, {18, 0x1.1f7048p-6f},
+    {14, 0x1.7d05f4p-6f}, {11, 0x1.414142p-6f}, {10, 0x1.dae608p-7f}, {12, 0x1.7d05f4p-7f},
+    {17, 0x1.4e5e0ap-6f}, {17, 0x1.4e5e0ap-6f}, {12, 0x1.7d05f4p-7f}, {11, 0x1.414142p-5f},
+    {13, 0x1.29e412p-5f}, {12, 0x1.7d05f4p-6f}, {14, 0x1.7d05f4p-6f}, {16, 0x1.642c86p-6f},
+    {10, 0x1.dae608p-7f}, {14, 0x1.7d05f4p-6f}, {15, 0x1.745d18p-6f}, {17, 0x1.4e5e0ap-5f},
+    {19, 0x1.8f9c18p-6f}, {12, 0x1.7d05f4p-7f}, {19, 0x1.8f9c18p-6f}, {16, 0x1.642c86p-6f},
+    {17, 0x1.4e5e0ap-6f}, {18, 0x1.1f7048p-6f}, {10, 0x1.dae608p-7f}, {16, 0x1.642c86p-6f},
+    {18, 0x1.1f7048p-5f}, {11, 0x1.414142p-6f}, {10, 0x1.dae608p-7f}, {12, 0x1.7d05f4p-7f},
+    {14, 0x1.7d05f4p-6f}, {15, 0x1.745d18p-6f}, {11, 0x1.414142p-6f}, {13, 0x1.29e412p-6f},
+    {10, 0x1.dae608p-7f}, {12, 0x1.7d05f4p-7f}, {13, 0x1.29e412p-6f}, {12, 0x1.7d05f4p-7f},
+    {11, 0x1.414142p-6f}, {15, 0x1.745d18p-6f}, {18, 0x1.1f7048p-6f}, {12, 0x1.7d05f4p-7f},
+    {13, 0x1.29e412p-6f}, {13, 0x1.29e412p-6f}, {10, 0x1.dae608p-7f}, {19, 0x1.8f9c18p-6f},
+    {14, 0x1.7d05f4p-6f}, {11, 0x1.414142p-6f}, {13, 0x1.29e412p-6f}, {10, 0x1.dae608p-7f},
+    {17, 0x1.4e5e0ap-5f}, {19, 0x1.8f9c18p-6f}, {11, 0x1.414142p-6f}, {13, 0x1.29e412p-6f},
+    {10, 0x1.dae608p-7f}, {12, 0x1.7d05f4p-7f}, {18, 0x1.1f7048p-6f}, {13, 0x1.29e412p-5f},
+    {12, 0x1.7d05f4p-7f}, {12, 0x1.7d05f4p-7f}, {12, 0x1.7d05f4p-7f}, {16, 0x1.642c86p-6f},
+    {18, 0x1.1f7048p-6f}, {17, 0x1.4e5e0ap-6f}, {19, 0x1.8f9c18p-6f}, {12, 0x1.7d05f4p-7f},
+    {17, 0x1.4e5e0ap-6f}, {10, 0x1.dae608p-6f}, {14, 0x1.7d05f4p-6f}, {11, 0x1.414142p-6f},
+    {18, 0x1.1f7048p-6f}, {12, 0x1.7d05f4p-7f}, {12, 0x1.7d05f4p-7f}, {14, 0x1.7d05f4p-6f},
+    {15, 0x1.745d18p-6f}, {17, 0x1.4e5e0ap-6f}, {12, 0x1.7d05f4p-7f}, {12, 0x1.7d05f4p-7f},
+    {16, 0x1.642c86p-6f}, {12, 0x1.7d05f4p-7f}, {14, 0x1.7d05f4p-6f}, {16, 0x1.642c86p-6f},
+    {11, 0x1.414142p-6f}, {13, 0x1.29e412p-6f}, {10, 0x1.dae608p-7f}, {19, 0x1.8f9c18p-6f},
+    {15, 0x1.745d18p-6f}, {11, 0x1.414142p-6f}, {16, 0x1.642c86p-6f}, {18, 0x1.1f7048p-6f},
+    {10, 0x1.dae608p-7f}, {15, 0x1.745d18p-6f}, {14, 0x1.7d05f4p-6f}, {11, 0x1.414142p-6f},
+    {12, 0x1.7d05f4p-7f}, {15, 0x1.745d18p-6f}, {14, 0x1.7d05f4p-6f}, {15, 0x1.745d18p-6f},
+    {16, 0x1.642c86p-6f}, {13, 0x1.29e412p-6f}, {10, 0x1.dae608p-7f}, {14, 0x1.7d05f4p-6f},
+    {16, 0x1.642c86p-6f}, {18, 0x1.1f7048p-6f}, {17, 0x1.4e5e0ap-6f}, {10, 0x1.dae608p-7f},
+    {15, 0x1.745d18p-6f}, {13, 0x1.29e412p-6f}, {14, 0x1.7d05f4p-6f}, {11, 0x1.414142p-6f},
+    {13, 0x1.29e412p-6f}, {10, 0x1.dae608p-7f}, {12, 0x1.7d05f4p-7f}, {16, 0x1.642c86p-6f},
+    {17, 0x1.4e5e0ap-6f}, {12, 0x1.7d05f4p-7f}, {13, 0x1.29e412p-6f}, {18, 0x1.1f7048p-6f},
+    {18, 0x1.1f7048p-6f}, {19, 0x1.8f9c18p-6f}, {14, 0x1.7d05f4p-6f}, {15, 0x1.745d18p-6f},
+    {17, 0x1.4e5e0ap-6f}, {13, 0x1.29e412p-6f}, {18, 0x1.1f7048p-6f}, {10, 0x1.dae608p-7f},
+    {12, 0x1.7d05f4p-7f}, {12, 0x1.7d05f4p-7f}, {13, 0x1.29e412p-6f}, {10, 0x1.dae608p-7f},
+    {19, 0x1.8f9c18p-6f}, {17, 0x1.4e5e0ap-5f}, {10, 0x1.dae608p-6f}, {14, 0x1.7d05f4p-6f},
+    {15, 0x1.745d18p-6f}, {18, 0x1.1f7048p-6f}, {18, 0x1.af286cp-5f}, {14, 0x1.7d05f4p-5f},
+    {15, 0x1.745d18p-5f}, {11, 0x1.414142p-5f}, {13, 0x1.29e412p-5f}, {12, 0x1.1dc478p-5f},
+    {10, 0x1.dae608p-6f}, {19, 0x1.8f9c18p-6f}, {16, 0x1.642c86p-6f}, {17, 0x1.4e5e0ap-6f},
+    {16, 0x1.642c86p-6f}, {19, 0x1.8f9c18p-6f}, {14, 0x1.7d05f4p-6f}, {18, 0x1.1f7048p-6f},
+    {10, 0x1.dae608p-7f}, {13, 0x1.29e412p-6f}, {16, 0x1.642c86p-6f}, {18, 0x1.1f7048p-6f},
+    {12, 0x1.7d05f4p-7f}, {18, 0x1.1f7048p-6f}, {12, 0x1.7d05f4p-7f}, {11, 0x1.414142p-6f},
+    {18, 0x1.1f7048p-6f}, {12, 0x1.7d05f4p-7f}, {14, 0x1.7d05f4p-6f}, {16, 0x1.642c86p-6f},
+    {12, 0x1.7d05f4p-7f}, {12, 0x1.7d05f4p-7f}, {14, 0x1.7d05f4p-6f}, {11, 0x1.414142p-6f},
+    {13, 0x1.29e412p-6f}, {10, 0x1.dae608p-7f}, {16, 0x1.642c86p-6f}, {14, 0x1.7d05f4p-6f},
+    {15, 0x1.745d18p-6f}, {19, 0x1.8f9c18p-6f}, {19, 0x1.8f9c18p-6f}, {15, 0x1.745d18p-6f},
+    {11, 0x1.414142p-6f}, {19, 0x1.8f9c18p-5f}, {10, 0x1.dae608p-7f}, {12, 0x1.7d05f4p-7f},
+    {13, 0x1.29e412p-6f}, {12, 0x1.7d05f4p-7f}, {18, 0x1.1f7048p-6f}, {16, 0x1.642c86p-6f},
+    {18, 0x1.1f7048p-6f}, {15, 0x1.745d18p-6f}, {10, 0x1.dae608p-7f}, {18, 0x1.1f7048p-6f},
+    {17, 0x1.4e5e0ap-5f}, {13, 0x1.29e412p-6f}, {10, 0x1.dae608p-7f}, {11, 0x1.414142p-6f},
+    {13, 0x1.29e412p-6f}, {10, 0x1.dae608p-7f}, {12, 0x1.7d05f4p-7f}, {12, 0x1.7d05f4p-7f},
+    {15, 0x1.745d18p-6f}, {15, 0x1.745d18p-6f}, {16, 0x1.642c86p-6f}, {18, 0x1.1f7048p-6f},
+    {10, 0x1.dae608p-7f}, {19, 0x1.8f9c18p-6f}, {19, 0x1.8f9c18p-6f}, {17, 0x1.4e5e0ap-6f},
+    {11, 0x1.414142p-6f}, {16, 0x1.642c86p-6f}, {17, 0x1.4e5e0ap-6f}, {12, 0x1.7d05f4p-7f},
+    {17, 0x1.4e5e0ap-6f}, {13, 0x1.29e412p-6f}, {17, 0x1.4e5e0ap-6f}, {10, 0x1.dae608p-7f},
+    {19, 0x1.8f9c18p-6f}, {18, 0x1.1f7048p-6f}, {16, 0x1.642c86p-6f}, {17, 0x1.4e5e0ap-6f},
+    {18, 0x1.1f7048p-6f}, {17, 0x1.4e5e0ap-6f}, {16, 0x1.642c86p-6f}, {17, 0x1.4e5e0ap-6f},
+    {12, 0x1.7d05f4p-7f}, {18, 0x1.1f7048p-6f}, {12, 0x1.7d05f4p-7f}, {13, 0x1.29e412p-6f},
+    {12, 0x1.7d05f4p-7f}, {16, 0x1.642c86p-6f}, {18, 0x1.1f7048p-6f}, {13, 0x1.29e412p-6f},
+    {18, 0x1.1f7048p-6f}, {19, 0x1.8f9c18p-6f}, {12, 0x1.7d05f4p-7f}, {11, 0x1.414142p-6f},
+    {19, 0x1.8f9c18p-6f}, {11, 0x1.414142p-6f}, {13, 0x1.29e412p-6f}, {19, 0x1.8f9c18p-6f},
+    {12, 0x1.7d05f4p-7f}, {18, 0x1.1f7048p-6f}, {14, 0x1.7d05f4p-6f}, {10, 0x1.dae608p-7f},
+    {15, 0x1.745d18p-6f}, {18, 0x1.1f7048p-6f}, {14, 0x1.7d05f4p-6f}, {15, 0x1.745d18p-6f},
+    {19, 0x1.8f9c18p-6f}, {18, 0x1.1f7048p-6f}, {13, 0x1.29e412p-6f}, {11, 0x1.414142p-6f},
+    {14, 0x1.7d05f4p-6f}, {15, 0x1.745d18p-6f}, {17, 0x1.4e5e0ap-6f}, {12, 0x1.7d05f4p-7f},
+    {15, 0x1.745d18p-6f}, {10, 0x1.dae608p-7f}, {12, 0x1.7d05f4p-7f}, {19, 0x1.8f9c18p-6f},
+    {14, 0x1.7d05f4p-6f}, {16, 0x1.642c86p-6f}, {12, 0x1.7d05f4p-7f}, {15, 0x1.745d18p-6f},
+    {17, 0x1.4e5e0ap-6f}, {19, 0x1.8f9c18p-6f}, {13, 0x1.29e412p-6f}, {19, 0x1.8f9c18p-6f},
+    {18, 0x1.1f7048p-6f}, {10, 0x1.dae608p-7f}, {15, 0x1.745d18p-6f}, {16, 0x1.642c86p-6f},
+    {10, 0x1.dae608p-7f}, {17, 0x1.4e5e0ap-6f}, {12, 0x1.7d05f4p-7f}, {12, 0x1.7d05f4p-7f},
+    {16, 0x1.642c86p-6f}, {16, 0x1.642c86p-6f}, {10, 0x1.dae608p-7f}, {15, 0x1.745d18p-6f},
+    {18, 0x1.1f7048p-6f}, {13, 0x1.29e412p-5f}, {14, 0x1.7d05f4p-6f}, {11, 0x1.414142p-6f},
+    {10, 0x1.dae608p-7f}, {12, 0x1.7d05f4p-7f}, {17, 0x1.4e5e0ap-6f}, {17, 0x1.4e5e0ap-6f},
+    {12, 0x1.7d05f4p-7f}, {13, 0x1.29e412p-6f}, {12, 0x1.7d05f4p-7f}, {12, 0x1.7d05f4p-7f},
+    {11, 0x1.414142p-6f}, {14, 0x1.7d05f4p-6f}, {15, 0x1.745d18p-6f}, {17, 0x1.4e5e0ap-6f},
+    {12, 0x1.7d05f4p-7f}, {19, 0x1.8f9c18p-6f}, {18, 0x1.1f7048p-6f}, {19, 0x1.8f9c18p-6f},
+    {17, 0x1.4e5e0ap-6f}, {16, 0x1.642c86p-6f}, {10, 0x1.dae608p-7f}, {16, 0x1.642c86p-6f},
+    {18, 0x1.1f7048p-6f}, {12, 0x1.7d05f4p-7f}, {11, 0x1.414142p-6f}, {18, 0x1.1f7048p-6f},
+    {13, 0x1.29e412p-6f}, {14, 0x1.7d05f4p-6f}, {11, 0x1.414142p-6f}, {10, 0x1.dae608p-7f},
+    {12, 0x1.7d05f4p-7f}, {15, 0x1.745d18p-6f}, {12, 0x1.7d05f4p-7f}, {13, 0x1.29e412p-6f},
+    {13, 0x1.29e412p-6f}, {14, 0x1.7d05f4p-6f}, {11, 0x1.414142p-6f}, {13, 0x1.29e412p-6f},
+    {10, 0x1.dae608p-7f}, {19, 0x1.8f9c18p-6f}, {13, 0x1.29e412p-6f}, {18, 0x1.1f7048p-6f},
+    {12, 0x1.7d05f4p-7f}, {12, 0x1.7d05f4p-7f}, {12, 0x1.7d05f4p-7f}, {16, 0x1.642c86p-6f},
+    {18, 0x1.1f7048p-6f}, {17, 0x1.4e5e0ap-6f}, {19, 0x1.8f9c18p-6f}, {12, 0x1.7d05f4p-7f},
+    {17, 0x1.4e5e0ap-6f}, {12, 0x1.7d05f4p-7f}, {15, 0x1.745d18p-6f}, {14, 0x1.7d05f4p-6f},
+    {12, 0x1.7d05f4p-7f}, {14, 0x1.7d05f4p-6f}, {11, 0x1.414142p-6f}, {13, 0x1.29e412p-6f},
+    {10, 0x1.dae608p-7f}, {16, 0x1.642c86p-6f}, {19, 0x1.8f9c18p-6f}, {15, 0x1.745d18p-6f},
+    {11, 0x1.414142p-6f}, {16, 0x1.642c86p-6f}, {18, 0x1.1f7048p-6f}, {10, 0x1.dae608p-7f},
+    {15, 0x1.745d18p-6f}, {14, 0x1.7d05f4p-6f}, {11, 0x1.414142p-6f}, {12, 0x1.7d05f4p-7f},
+    {15, 0x1.745d18p-6f}, {13, 0x1.29e412p-6f}, {16, 0x1.642c86p-6f}, {14, 0x1.7d05f4p-6f},
+    {15, 0x1.745d18p-6f}, {14, 0x1.7d05f4p-6f}, {18, 0x1.1f7048p-6f}, {10, 0x1.dae608p-7f},
+    {17, 0x1.4e5e0ap-6f}, {15, 0x1.745d18p-6f}, {13, 0x1.29e412p-6f}, {16, 0x1.642c86p-6f},
+    {17, 0x1.4e5e0ap-6f}, {12, 0x1.7d05f4p-7f}, {13, 0x1.29e412p-6f}, {18, 0x1.1f7048p-6f},
+    {18, 0x1.1f7048p-6f}, {13, 0x1.29e412p-6f}, {10, 0x1.dae608p-7f}, {14, 0x1.7d05f4p-6f},
+    {17, 0x1.4e5e0ap-6f}, {18, 0x1.1f7048p-6f}, {12, 0x1.7d05f4p-7f}, {12, 0x1.7d05f4p-7f},
+    {13, 0x1.29e412p-6f}, {10, 0x1.dae608p-7f}, {19, 0x1.8f9c18p-6f}, {18, 0x1.1f7048p-6f},
+    {14, 0x1.7d05f4p-6f}, {10, 0x1.dae608p-7f}, {15, 0x1.745d18p-6f}, {17, 0x1.4e5e0ap-6f},
+    {10, 0x1.dae608p-7f}, {17, 0x1.4e5e0ap-6f}, {18, 0x1.af286cp-5f}, {14, 0x1.7d05f4p-5f},
+    {15, 0x1.745d18p-5f}, {11, 0x1.414142p-5f}, {10, 0x1.dae608p-6f}, {19, 0x1.8f9c18p-6f},
+    {16, 0x1.642c86p-6f}, {13, 0x1.29e412p-6f}, {12, 0x1.7d05f4p-7f}, {12, 0x1.7d05f4p-7f},
+    {16, 0x1.642c86p-6f}, {19, 0x1.8f9c18p-6f}, {13, 0x1.29e412p-6f}, {16, 0x1.642c86p-6f},
+    {18, 0x1.1f7048p-6f}, {12, 0x1.7d05f4p-7f}, {12, 0x1.7d05f4p-7f}, {18, 0x1.1f7048p-6f},
+    {14, 0x1.7d05f4p-6f}, {16, 0x1.642c86p-6f}, {12, 0x1.7d05f4p-7f}, {14, 0x1.7d05f4p-6f},
+    {11, 0x1.414142p-6f}, {13, 0x1.29e412p-6f}, {10, 0x1.dae608p-7f}, {16, 0x1.642c86p-6f},
+    {15, 0x1.745d18p-6f}, {19, 0x1.8f9c18p-6f}, {15, 0x1.745d18p-6f}, {19, 0x1.8f9c18p-6f},
+    {11, 0x1.414142p-6f}, {19, 0x1.8f9c18p-6f}, {10, 0x1.dae608p-7f}, {12, 0x1.7d05f4p-7f},
+    {13, 0x1.29e412p-6f}, {12, 0x1.7d05f4p-7f}, {18, 0x1.1f7048p-6f}, {16, 0x1.642c86p-6f},
+    {27, 0x1.5a240ep-6f}, {22, 0x1.29e412p-7f}, {26, 0x1.d0cb58p-8f}, {21, 0x1.e1e1e2p-7f},
+    {25, 0x1.020408p-7f}, {22, 0x1.29e412p-7f}, {23, 0x1.111112p-7f}, {27, 0x1.cd8568p-8f},
+    {26, 0x1.5c9882p-6f}, {25, 0x1.020408p-7f}, {21, 0x1.e1e1e2p-7f}, {20, 0x1.58ed24p-7f},
+    {24, 0x1.0ecf56p-7f}, {25, 0x1.020408p-5f}, {20, 0x1.58ed24p-6f}, {21, 0x1.e1e1e2p-7f},
+    {27, 0x1.cd8568p-7f}, {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f}, {21, 0x1.e1e1e2p-7f},
+    {24, 0x1.0ecf56p-7f}, {22, 0x1.29e412p-7f}, {24, 0x1.0ecf56p-7f}, {20, 0x1.58ed24p-7f},
+    {23, 0x1.111112p-7f}, {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f}, {24, 0x1.963702p-6f},
+    {23, 0x1.111112p-6f}, {26, 0x1.d0cb58p-7f}, {22, 0x1.29e412p-7f}, {27, 0x1.cd8568p-8f},
+    {20, 0x1.58ed24p-7f}, {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-7f}, {22, 0x1.29e412p-7f},
+    {24, 0x1.0ecf56p-7f}, {20, 0x1.58ed24p-7f}, {24, 0x1.0ecf56p-7f}, {21, 0x1.e1e1e2p-7f},
+    {27, 0x1.cd8568p-8f}, {23, 0x1.111112p-7f}, {27, 0x1.cd8568p-8f}, {27, 0x1.cd8568p-8f},
+    {20, 0x1.58ed24p-7f}, {24, 0x1.0ecf56p-7f}, {21, 0x1.e1e1e2p-6f}, {26, 0x1.5c9882p-6f},
+    {20, 0x1.58ed24p-6f}, {24, 0x1.0ecf56p-6f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-7f},
+    {27, 0x1.cd8568p-7f}, {22, 0x1.29e412p-7f}, {24, 0x1.0ecf56p-7f}, {24, 0x1.0ecf56p-7f},
+    {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f}, {22, 0x1.29e412p-7f},
+    {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-6f},
+    {23, 0x1.111112p-6f}, {26, 0x1.d0cb58p-7f}, {22, 0x1.29e412p-7f}, {25, 0x1.020408p-7f},
+    {20, 0x1.58ed24p-7f}, {23, 0x1.111112p-7f}, {20, 0x1.58ed24p-7f}, {22, 0x1.29e412p-6f},
+    {23, 0x1.111112p-6f}, {26, 0x1.d0cb58p-8f}, {22, 0x1.29e412p-7f}, {24, 0x1.0ecf56p-7f},
+    {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f}, {21, 0x1.e1e1e2p-7f}, {26, 0x1.d0cb58p-8f},
+    {26, 0x1.d0cb58p-8f}, {24, 0x1.0ecf56p-7f}, {27, 0x1.cd8568p-7f}, {22, 0x1.29e412p-7f},
+    {26, 0x1.d0cb58p-8f}, {21, 0x1.e1e1e2p-7f}, {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-8f},
+    {22, 0x1.29e412p-6f}, {23, 0x1.111112p-6f}, {24, 0x1.0ecf56p-6f}, {25, 0x1.020408p-6f},
+    {21, 0x1.e1e1e2p-7f}, {26, 0x1.d0cb58p-7f}, {27, 0x1.cd8568p-7f}, {22, 0x1.29e412p-7f},
+    {27, 0x1.cd8568p-8f}, {22, 0x1.29e412p-7f}, {27, 0x1.cd8568p-8f}, {26, 0x1.d0cb58p-7f},
+    {27, 0x1.cd8568p-8f}, {25, 0x1.42850ap-5f}, {23, 0x1.99999ap-6f}, {21, 0x1.e1e1e2p-7f},
+    {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f}, {27, 0x1.5a240ep-5f},
+    {23, 0x1.111112p-5f}, {20, 0x1.02b1dap-5f}, {21, 0x1.e1e1e2p-6f}, {22, 0x1.29e412p-6f},
+    {26, 0x1.d0cb58p-8f}, {24, 0x1.0ecf56p-6f}, {21, 0x1.e1e1e2p-7f}, {22, 0x1.29e412p-7f},
+    {27, 0x1.cd8568p-8f}, {20, 0x1.58ed24p-6f}, {22, 0x1.29e412p-6f}, {23, 0x1.111112p-6f},
+    {26, 0x1.d0cb58p-7f}, {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f}, {27, 0x1.cd8568p-8f},
+    {26, 0x1.d0cb58p-8f}, {23, 0x1.111112p-6f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f},
+    {27, 0x1.cd8568p-8f}, {25, 0x1.020408p-7f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f},
+    {21, 0x1.e1e1e2p-7f}, {27, 0x1.cd8568p-8f}, {21, 0x1.e1e1e2p-7f}, {25, 0x1.020408p-6f},
+    {20, 0x1.58ed24p-7f}, {22, 0x1.29e412p-7f}, {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-7f},
+    {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-6f}, {26, 0x1.d0cb58p-7f},
+    {23, 0x1.111112p-7f}, {24, 0x1.0ecf56p-7f}, {25, 0x1.020408p-7f}, {20, 0x1.af286cp-5f},
+    {22, 0x1.745d18p-5f}, {21, 0x1.69696ap-5f}, {27, 0x1.5a240ep-5f}, {24, 0x1.52832cp-5f},
+    {23, 0x1.111112p-6f}, {25, 0x1.020408p-6f}, {26, 0x1.d0cb58p-8f}, {26, 0x1.d0cb58p-7f},
+    {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f}, {22, 0x1.29e412p-7f}, {24, 0x1.0ecf56p-7f},
+    {22, 0x1.29e412p-7f}, {20, 0x1.58ed24p-7f}, {21, 0x1.e1e1e2p-7f}, {20, 0x1.58ed24p-7f},
+    {24, 0x1.0ecf56p-7f}, {26, 0x1.5c9882p-6f}, {24, 0x1.0ecf56p-6f}, {23, 0x1.111112p-7f},
+    {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f}, {24, 0x1.0ecf56p-6f}, {21, 0x1.e1e1e2p-7f},
+    {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-7f},
+    {27, 0x1.cd8568p-8f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-7f}, {23, 0x1.111112p-7f},
+    {25, 0x1.020408p-7f}, {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f},
+    {22, 0x1.745d18p-5f}, {27, 0x1.5a240ep-6f}, {23, 0x1.111112p-6f}, {24, 0x1.0ecf56p-6f},
+    {25, 0x1.020408p-6f}, {20, 0x1.58ed24p-7f}, {26, 0x1.d0cb58p-8f}, {21, 0x1.e1e1e2p-7f},
+    {20, 0x1.58ed24p-7f}, {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-7f},
+    {22, 0x1.29e412p-7f}, {27, 0x1.cd8568p-8f}, {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f},
+    {22, 0x1.29e412p-6f}, {21, 0x1.e1e1e2p-7f}, {25, 0x1.020408p-7f}, {27, 0x1.cd8568p-8f},
+    {24, 0x1.0ecf56p-7f}, {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f}, {24, 0x1.0ecf56p-7f},
+    {25, 0x1.020408p-7f}, {25, 0x1.020408p-6f}, {26, 0x1.d0cb58p-7f}, {27, 0x1.cd8568p-7f},
+    {23, 0x1.111112p-7f}, {21, 0x1.e1e1e2p-7f}, {27, 0x1.cd8568p-7f}, {20, 0x1.58ed24p-7f},
+    {25, 0x1.020408p-7f}, {25, 0x1.020408p-6f}, {23, 0x1.111112p-6f}, {25, 0x1.020408p-7f},
+    {26, 0x1.d0cb58p-8f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f}, {23, 0x1.111112p-7f},
+    {26, 0x1.d0cb58p-8f}, {22, 0x1.29e412p-7f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f},
+    {27, 0x1.cd8568p-8f}, {23, 0x1.111112p-6f}, {21, 0x1.e1e1e2p-7f}, {20, 0x1.58ed24p-7f},
+    {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f}, {22, 0x1.29e412p-7f}, {24, 0x1.0ecf56p-7f},
+    {27, 0x1.cd8568p-8f}, {26, 0x1.d0cb58p-7f}, {27, 0x1.cd8568p-8f}, {21, 0x1.e1e1e2p-7f},
+    {20, 0x1.58ed24p-7f}, {24, 0x1.0ecf56p-7f}, {25, 0x1.020408p-7f}, {27, 0x1.cd8568p-8f},
+    {23, 0x1.111112p-7f}, {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f}, {24, 0x1.0ecf56p-7f},
+    {26, 0x1.d0cb58p-8f}, {24, 0x1.0ecf56p-7f}, {27, 0x1.cd8568p-7f}, {24, 0x1.0ecf56p-7f},
+    {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f}, {21, 0x1.e1e1e2p-6f}, {20, 0x1.58ed24p-7f},
+    {22, 0x1.29e412p-7f}, {24, 0x1.0ecf56p-7f}, {27, 0x1.cd8568p-8f}, {20, 0x1.58ed24p-6f},
+    {22, 0x1.29e412p-6f}, {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-5f}, {22, 0x1.29e412p-7f},
+    {23, 0x1.111112p-7f}, {27, 0x1.cd8568p-8f}, {24, 0x1.0ecf56p-7f}, {25, 0x1.020408p-7f},
+    {26, 0x1.d0cb58p-8f}, {22, 0x1.29e412p-7f}, {20, 0x1.58ed24p-7f}, {23, 0x1.111112p-7f},
+    {26, 0x1.d0cb58p-8f}, {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-8f}, {23, 0x1.111112p-6f},
+    {25, 0x1.020408p-6f}, {26, 0x1.d0cb58p-7f}, {20, 0x1.58ed24p-7f}, {22, 0x1.29e412p-7f},
+    {24, 0x1.0ecf56p-7f}, {27, 0x1.cd8568p-8f}, {22, 0x1.29e412p-7f}, {25, 0x1.020408p-7f},
+    {27, 0x1.cd8568p-8f}, {24, 0x1.0ecf56p-7f}, {23, 0x1.111112p-7f}, {27, 0x1.cd8568p-8f},
+    {26, 0x1.d0cb58p-8f}, {26, 0x1.d0cb58p-8f}, {26, 0x1.d0cb58p-8f}, {23, 0x1.111112p-7f},
+    {26, 0x1.d0cb58p-8f}, {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-8f}, {20, 0x1.58ed24p-6f},
+    {22, 0x1.29e412p-6f}, {24, 0x1.0ecf56p-6f}, {21, 0x1.e1e1e2p-7f}, {26, 0x1.d0cb58p-7f},
+    {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f}, {23, 0x1.111112p-7f}, {23, 0x1.111112p-7f},
+    {24, 0x1.0ecf56p-7f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-6f},
+    {20, 0x1.58ed24p-7f}, {25, 0x1.020408p-7f}, {27, 0x1.5a240ep-6f}, {21, 0x1.e1e1e2p-7f},
+    {20, 0x1.58ed24p-7f}, {22, 0x1.29e412p-7f}, {23, 0x1.111112p-7f}, {23, 0x1.111112p-7f},
+    {26, 0x1.d0cb58p-8f}, {21, 0x1.e1e1e2p-7f}, {23, 0x1.111112p-7f}, {27, 0x1.cd8568p-8f},
+    {24, 0x1.0ecf56p-7f}, {22, 0x1.29e412p-7f}, {23, 0x1.111112p-7f}, {24, 0x1.0ecf56p-7f},
+    {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f}, {24, 0x1.0ecf56p-7f}, {25, 0x1.020408p-7f},
+    {22, 0x1.bed61cp-6f}, {24, 0x1.0ecf56p-7f}, {27, 0x1.cd8568p-8f}, {24, 0x1.0ecf56p-7f},
+    {23, 0x1.111112p-7f}, {21, 0x1.e1e1e2p-7f}, {20, 0x1.58ed24p-7f}, {22, 0x1.29e412p-7f},
+    {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f}, {25, 0x1.020408p-7f},
+    {24, 0x1.0ecf56p-7f}, {23, 0x1.111112p-6f}, {25, 0x1.020408p-6f}, {21, 0x1.e1e1e2p-7f},
+    {24, 0x1.0ecf56p-7f}, {23, 0x1.111112p-7f}, {22, 0x1.29e412p-7f}, {24, 0x1.0ecf56p-7f},
+    {26, 0x1.d0cb58p-7f}, {27, 0x1.cd8568p-7f}, {22, 0x1.29e412p-7f}, {27, 0x1.cd8568p-7f},
+    {22, 0x1.29e412p-7f}, {22, 0x1.29e412p-7f}, {23, 0x1.111112p-7f}, {23, 0x1.111112p-7f},
+    {24, 0x1.0ecf56p-7f}, {21, 0x1.e1e1e2p-7f}, {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f},
+    {21, 0x1.e1e1e2p-7f}, {20, 0x1.58ed24p-7f}, {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f},
+    {27, 0x1.cd8568p-8f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-7f},
+    {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-7f}, {22, 0x1.29e412p-7f}, {25, 0x1.020408p-6f},
+    {27, 0x1.cd8568p-7f}, {22, 0x1.29e412p-7f}, {23, 0x1.111112p-7f}, {24, 0x1.0ecf56p-7f},
+    {23, 0x1.111112p-7f}, {27, 0x1.cd8568p-8f}, {24, 0x1.0ecf56p-7f}, {27, 0x1.cd8568p-7f},
+    {23, 0x1.111112p-7f}, {22, 0x1.29e412p-6f}, {24, 0x1.0ecf56p-6f}, {25, 0x1.020408p-6f},
+    {21, 0x1.e1e1e2p-7f}, {20, 0x1.58ed24p-7f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f},
+    {21, 0x1.e1e1e2p-5f}, {22, 0x1.bed61cp-5f}, {20, 0x1.af286cp-5f}, {24, 0x1.52832cp-5f},
+    {27, 0x1.207362p-5f}, {23, 0x1.99999ap-6f}, {25, 0x1.020408p-6f}, {26, 0x1.d0cb58p-7f},
+    {23, 0x1.99999ap-6f}, {22, 0x1.29e412p-7f}, {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f},
+    {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f},
+    {24, 0x1.0ecf56p-6f}, {22, 0x1.29e412p-7f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f},
+    {22, 0x1.29e412p-7f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-6f},
+    {22, 0x1.29e412p-7f}, {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f},
+    {24, 0x1.0ecf56p-7f}, {27, 0x1.cd8568p-8f}, {22, 0x1.29e412p-7f}, {20, 0x1.58ed24p-7f},
+    {22, 0x1.29e412p-7f}, {25, 0x1.020408p-7f}, {23, 0x1.111112p-7f}, {27, 0x1.cd8568p-7f},
+    {20, 0x1.58ed24p-7f}, {22, 0x1.29e412p-7f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f},
+    {23, 0x1.111112p-7f}, {21, 0x1.e1e1e2p-6f}, {27, 0x1.cd8568p-7f}, {20, 0x1.58ed24p-7f},
+    {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f}, {20, 0x1.58ed24p-7f}, {27, 0x1.cd8568p-8f},
+    {23, 0x1.111112p-7f}, {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f}, {26, 0x1.5c9882p-6f},
+    {23, 0x1.111112p-6f}, {25, 0x1.020408p-7f}, {27, 0x1.cd8568p-8f}, {22, 0x1.29e412p-7f},
+    {20, 0x1.58ed24p-7f}, {23, 0x1.111112p-7f}, {24, 0x1.0ecf56p-7f}, {27, 0x1.cd8568p-8f},
+    {26, 0x1.d0cb58p-8f}, {22, 0x1.29e412p-7f}, {25, 0x1.020408p-7f}, {23, 0x1.111112p-7f},
+    {24, 0x1.0ecf56p-7f}, {24, 0x1.0ecf56p-7f}, {24, 0x1.0ecf56p-7f}, {24, 0x1.0ecf56p-7f},
+    {22, 0x1.29e412p-7f}, {27, 0x1.cd8568p-8f}, {27, 0x1.cd8568p-8f}, {27, 0x1.cd8568p-8f},
+    {26, 0x1.d0cb58p-8f}, {21, 0x1.e1e1e2p-7f}, {25, 0x1.020408p-7f}, {23, 0x1.111112p-7f},
+    {22, 0x1.29e412p-7f}, {27, 0x1.cd8568p-8f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f},
+    {21, 0x1.e1e1e2p-7f}, {20, 0x1.58ed24p-7f}, {24, 0x1.0ecf56p-7f}, {25, 0x1.020408p-7f},
+    {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f}, {21, 0x1.e1e1e2p-7f}, {20, 0x1.58ed24p-7f},
+    {24, 0x1.0ecf56p-7f}, {27, 0x1.cd8568p-8f}, {25, 0x1.020408p-7f}, {20, 0x1.58ed24p-7f},
+    {25, 0x1.020408p-7f}, {25, 0x1.020408p-7f}, {21, 0x1.e1e1e2p-7f}, {24, 0x1.0ecf56p-7f},
+    {22, 0x1.29e412p-7f}, {24, 0x1.0ecf56p-7f}, {24, 0x1.0ecf56p-6f}, {22, 0x1.29e412p-7f},
+    {27, 0x1.cd8568p-8f}, {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-8f}, {26, 0x1.d0cb58p-8f},
+    {24, 0x1.0ecf56p-7f}, {20, 0x1.58ed24p-7f}, {26, 0x1.d0cb58p-7f}, {22, 0x1.29e412p-7f},
+    {24, 0x1.0ecf56p-7f}, {24, 0x1.0ecf56p-7f}, {21, 0x1.e1e1e2p-7f}, {27, 0x1.cd8568p-8f},
+    {23, 0x1.111112p-7f}, {27, 0x1.cd8568p-8f}, {27, 0x1.cd8568p-8f}, {26, 0x1.d0cb58p-7f},
+    {21, 0x1.e1e1e2p-7f}, {20, 0x1.58ed24p-7f}, {25, 0x1.020408p-7f}, {21, 0x1.e1e1e2p-7f},
+    {24, 0x1.0ecf56p-7f}, {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f}, {20, 0x1.58ed24p-7f},
+    {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f}, {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-7f},
+    {24, 0x1.0ecf56p-7f}, {27, 0x1.cd8568p-8f}, {26, 0x1.d0cb58p-8f}, {23, 0x1.111112p-7f},
+    {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f}, {22, 0x1.29e412p-7f}, {27, 0x1.cd8568p-8f},
+    {27, 0x1.cd8568p-7f}, {27, 0x1.cd8568p-8f}, {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-8f},
+    {22, 0x1.29e412p-7f}, {26, 0x1.d0cb58p-8f}, {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f},
+    {23, 0x1.111112p-7f}, {20, 0x1.58ed24p-7f}, {20, 0x1.58ed24p-7f}, {23, 0x1.111112p-7f},
+    {26, 0x1.d0cb58p-8f}, {22, 0x1.29e412p-7f}, {22, 0x1.29e412p-7f}, {23, 0x1.111112p-7f},
+    {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f}, {22, 0x1.29e412p-7f}, {27, 0x1.cd8568p-8f},
+    {26, 0x1.d0cb58p-8f}, {26, 0x1.d0cb58p-8f}, {24, 0x1.0ecf56p-7f}, {27, 0x1.cd8568p-8f},
+    {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f}, {22, 0x1.29e412p-7f}, {21, 0x1.e1e1e2p-7f},
+    {26, 0x1.d0cb58p-8f}, {23, 0x1.111112p-7f}, {27, 0x1.cd8568p-8f}, {22, 0x1.29e412p-7f},
+    {22, 0x1.29e412p-7f}, {27, 0x1.cd8568p-8f}, {26, 0x1.d0cb58p-8f}, {26, 0x1.d0cb58p-8f},
+    {24, 0x1.0ecf56p-7f}, {21, 0x1.e1e1e2p-7f}, {25, 0x1.020408p-7f}, {23, 0x1.111112p-7f},
+    {23, 0x1.111112p-6f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f},
+    {21, 0x1.e1e1e2p-7f}, {20, 0x1.58ed24p-7f}, {23, 0x1.111112p-7f}, {23, 0x1.111112p-7f},
+    {22, 0x1.29e412p-7f}, {27, 0x1.cd8568p-7f}, {27, 0x1.cd8568p-7f}, {22, 0x1.29e412p-7f},
+    {23, 0x1.111112p-7f}, {23, 0x1.111112p-7f}, {21, 0x1.e1e1e2p-7f}, {22, 0x1.29e412p-7f},
+    {24, 0x1.0ecf56p-7f}, {23, 0x1.111112p-7f}, {22, 0x1.29e412p-7f}, {26, 0x1.d0cb58p-8f},
+    {23, 0x1.111112p-7f}, {22, 0x1.29e412p-7f}, {26, 0x1.d0cb58p-8f}, {23, 0x1.111112p-7f},
+    {25, 0x1.020408p-7f}, {27, 0x1.cd8568p-8f}, {23, 0x1.111112p-7f}, {27, 0x1.cd8568p-8f},
+    {27, 0x1.cd8568p-8f}, {25, 0x1.020408p-7f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f},
+    {21, 0x1.e1e1e2p-7f}, {21, 0x1.e1e1e2p-7f}, {20, 0x1.58ed24p-7f}, {26, 0x1.d0cb58p-8f},
+    {25, 0x1.020408p-7f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-7f},
+    {25, 0x1.020408p-7f}, {25, 0x1.020408p-7f}, {24, 0x1.0ecf56p-7f}, {23, 0x1.111112p-7f},
+    {26, 0x1.d0cb58p-7f}, {22, 0x1.29e412p-7f}, {22, 0x1.29e412p-7f}, {27, 0x1.cd8568p-8f},
+    {27, 0x1.cd8568p-8f}, {20, 0x1.58ed24p-6f}, {21, 0x1.e1e1e2p-7f}, {27, 0x1.cd8568p-7f},
+    {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f}, {26, 0x1.d0cb58p-8f}, {26, 0x1.d0cb58p-8f},
+    {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f}, {22, 0x1.29e412p-7f}, {24, 0x1.0ecf56p-7f},
+    {22, 0x1.29e412p-7f}, {20, 0x1.58ed24p-7f}, {21, 0x1.e1e1e2p-7f}, {24, 0x1.0ecf56p-7f},
+    {26, 0x1.5c9882p-6f}, {24, 0x1.0ecf56p-7f}, {25, 0x1.020408p-7f}, {23, 0x1.111112p-7f},
+    {26, 0x1.d0cb58p-8f}, {21, 0x1.e1e1e2p-7f}, {23, 0x1.111112p-7f}, {24, 0x1.0ecf56p-7f},
+    {25, 0x1.020408p-7f}, {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f},
+    {25, 0x1.020408p-7f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-7f}, {25, 0x1.020408p-7f},
+    {27, 0x1.cd8568p-8f}, {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f},
+    {22, 0x1.29e412p-7f}, {22, 0x1.29e412p-7f}, {22, 0x1.29e412p-7f}, {23, 0x1.111112p-7f},
+    {25, 0x1.020408p-7f}, {27, 0x1.cd8568p-8f}, {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f},
+    {22, 0x1.29e412p-7f}, {21, 0x1.e1e1e2p-7f}, {20, 0x1.58ed24p-7f}, {23, 0x1.111112p-7f},
+    {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-7f}, {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f},
+    {22, 0x1.29e412p-7f}, {25, 0x1.020408p-7f}, {22, 0x1.29e412p-7f}, {24, 0x1.0ecf56p-7f},
+    {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f}, {25, 0x1.020408p-7f}, {24, 0x1.0ecf56p-7f},
+    {25, 0x1.020408p-7f}, {27, 0x1.cd8568p-8f}, {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-7f},
+    {27, 0x1.cd8568p-8f}, {23, 0x1.111112p-7f}, {27, 0x1.cd8568p-8f}, {27, 0x1.cd8568p-8f},
+    {25, 0x1.020408p-7f}, {21, 0x1.e1e1e2p-7f}, {20, 0x1.58ed24p-7f}, {25, 0x1.020408p-6f},
+    {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-7f}, {23, 0x1.111112p-7f}, {23, 0x1.111112p-7f},
+    {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f}, {25, 0x1.020408p-7f}, {22, 0x1.29e412p-7f},
+    {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f}, {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-8f},
+    {27, 0x1.cd8568p-8f}, {23, 0x1.111112p-7f}, {24, 0x1.0ecf56p-7f}, {22, 0x1.29e412p-7f},
+    {27, 0x1.cd8568p-8f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f}, {26, 0x1.d0cb58p-8f},
+    {24, 0x1.0ecf56p-7f}, {25, 0x1.020408p-7f}, {21, 0x1.e1e1e2p-7f}, {20, 0x1.58ed24p-7f},
+    {27, 0x1.cd8568p-8f}, {24, 0x1.0ecf56p-7f}, {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-8f},
+    {26, 0x1.d0cb58p-8f}, {24, 0x1.0ecf56p-7f}, {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f},
+    {27, 0x1.cd8568p-8f}, {25, 0x1.020408p-7f}, {27, 0x1.cd8568p-8f}, {22, 0x1.29e412p-7f},
+    {21, 0x1.e1e1e2p-7f}, {22, 0x1.29e412p-7f}, {22, 0x1.29e412p-7f}, {20, 0x1.58ed24p-6f},
+    {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-7f}, {25, 0x1.020408p-6f}, {26, 0x1.d0cb58p-8f},
+    {24, 0x1.0ecf56p-7f}, {25, 0x1.020408p-7f}, {22, 0x1.29e412p-7f}, {26, 0x1.d0cb58p-8f},
+    {20, 0x1.58ed24p-7f}, {26, 0x1.d0cb58p-8f}, {23, 0x1.111112p-7f}, {27, 0x1.cd8568p-8f},
+    {20, 0x1.58ed24p-7f}, {22, 0x1.29e412p-7f}, {23, 0x1.111112p-7f}, {24, 0x1.0ecf56p-7f},
+    {26, 0x1.d0cb58p-8f}, {26, 0x1.d0cb58p-8f}, {22, 0x1.29e412p-7f}, {27, 0x1.cd8568p-8f},
+    {25, 0x1.020408p-7f}, {23, 0x1.111112p-7f}, {27, 0x1.cd8568p-8f}, {26, 0x1.d0cb58p-8f},
+    {26, 0x1.d0cb58p-8f}, {26, 0x1.d0cb58p-8f}, {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-8f},
+    {26, 0x1.d0cb58p-8f}, {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f}, {24, 0x1.0ecf56p-7f},
+    {26, 0x1.d0cb58p-8f}, {22, 0x1.29e412p-7f}, {24, 0x1.0ecf56p-7f}, {23, 0x1.111112p-7f},
+    {24, 0x1.0ecf56p-7f}, {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f}, {25, 0x1.020408p-7f},
+    {25, 0x1.020408p-7f}, {20, 0x1.58ed24p-7f}, {25, 0x1.020408p-7f}, {22, 0x1.29e412p-7f},
+    {27, 0x1.cd8568p-8f}, {21, 0x1.e1e1e2p-7f}, {27, 0x1.cd8568p-7f}, {20, 0x1.58ed24p-7f},
+    {23, 0x1.111112p-7f}, {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-8f}, {21, 0x1.e1e1e2p-7f},
+    {23, 0x1.111112p-7f}, {27, 0x1.cd8568p-8f}, {24, 0x1.0ecf56p-7f}, {22, 0x1.29e412p-7f},
+    {24, 0x1.0ecf56p-7f}, {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f}, {26, 0x1.d0cb58p-8f},
+    {24, 0x1.0ecf56p-7f}, {22, 0x1.29e412p-7f}, {22, 0x1.29e412p-7f}, {27, 0x1.cd8568p-8f},
+    {22, 0x1.29e412p-7f}, {24, 0x1.0ecf56p-7f}, {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-8f},
+    {27, 0x1.cd8568p-8f}, {23, 0x1.111112p-7f}, {22, 0x1.29e412p-7f}, {25, 0x1.020408p-7f},
+    {24, 0x1.0ecf56p-7f}, {24, 0x1.0ecf56p-7f}, {21, 0x1.e1e1e2p-7f}, {23, 0x1.111112p-7f},
+    {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f}, {25, 0x1.020408p-7f}, {23, 0x1.111112p-7f},
+    {22, 0x1.29e412p-7f}, {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-7f},
+    {22, 0x1.29e412p-7f}, {26, 0x1.d0cb58p-8f}, {27, 0x1.cd8568p-8f}, {22, 0x1.29e412p-7f},
+    {23, 0x1.111112p-7f}, {24, 0x1.0ecf56p-7f}, {21, 0x1.e1e1e2p-7f}, {23, 0x1.111112p-7f},
+    {25, 0x1.020408p-7f}, {25, 0x1.020408p-7f}, {23, 0x1.111112p-7f}, {27, 0x1.cd8568p-8f},
+    {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-7f}, {25, 0x1.020408p-7f}, {23, 0x1.111112p-7f},
+    {26, 0x1.d0cb58p-8f}, {22, 0x1.29e412p-7f}, {27, 0x1.cd8568p-8f}, {27, 0x1.cd8568p-8f},
+    {22, 0x1.29e412p-7f}, {24, 0x1.0ecf56p-7f}, {25, 0x1.020408p-7f}, {27, 0x1.cd8568p-8f},
+    {23, 0x1.111112p-7f}, {24, 0x1.0ecf56p-7f}, {27, 0x1.cd8568p-8f}, {23, 0x1.111112p-7f},
+    {27, 0x1.cd8568p-8f}, {26, 0x1.d0cb58p-8f}, {24, 0x1.0ecf56p-7f}, {27, 0x1.cd8568p-8f},
+    {25, 0x1.020408p-6f}, {21, 0x1.e1e1e2p-7f}, {20, 0x1.58ed24p-7f}, {22, 0x1.29e412p-7f},
+    {23, 0x1.111112p-7f}, {20, 0x1.af286cp-5f}, {21, 0x1.69696ap-5f}, {22, 0x1.29e412p-5f},
+    {27, 0x1.207362p-5f}, {24, 0x1.0ecf56p-5f}, {23, 0x1.111112p-6f}, {25, 0x1.020408p-6f},
+    {26, 0x1.d0cb58p-8f}, {26, 0x1.d0cb58p-8f}, {24, 0x1.0ecf56p-7f}, {22, 0x1.29e412p-7f},
+    {22, 0x1.29e412p-7f}, {21, 0x1.e1e1e2p-7f}, {23, 0x1.111112p-7f}, {22, 0x1.29e412p-7f},
+    {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-8f}, {23, 0x1.111112p-7f}, {24, 0x1.0ecf56p-7f},
+    {26, 0x1.d0cb58p-8f}, {24, 0x1.0ecf56p-7f}, {22, 0x1.29e412p-7f}, {27, 0x1.cd8568p-8f},
+    {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-6f}, {25, 0x1.020408p-7f},
+    {26, 0x1.d0cb58p-8f}, {24, 0x1.0ecf56p-7f}, {27, 0x1.cd8568p-8f}, {22, 0x1.29e412p-7f},
+    {20, 0x1.58ed24p-7f}, {22, 0x1.29e412p-7f}, {25, 0x1.020408p-7f}, {23, 0x1.111112p-7f},
+    {27, 0x1.cd8568p-8f}, {27, 0x1.cd8568p-8f}, {26, 0x1.d0cb58p-8f}, {22, 0x1.29e412p-7f},
+    {20, 0x1.58ed24p-7f}, {27, 0x1.cd8568p-8f}, {23, 0x1.111112p-7f}, {25, 0x1.020408p-7f},
+    {21, 0x1.e1e1e2p-7f}, {20, 0x1.58ed24p-7f}, {23, 0x1.111112p-7f}, {26, 0x1.d0cb58p-8f},
+    {23, 0x1.111112p-7f}, {24, 0x1.0ecf56p-7f}, {26, 0x1.d0cb58p-8f}, {25, 0x1.020408p-7f},
+    {23, 0x1.111112p-6f}, {27, 0x1.cd8568p-8f}, {20, 0x1.58ed24p-7f}, {23, 0x1.111112p-7f},
+    {27, 0x1.cd8568p-8f}, {26, 0x1.d0cb58p-8f}, {22, 0x1.29e412p-7f}, {25, 0x1.020408p-7f},
+    {23, 0x1.111112p-7f}, {24, 0x1.0ecf56p-7f}, {24, 0x1.0ecf56p-7f}, {24, 0x1.0ecf56p-7f},
+    {24, 0x1.0ecf56p-7f},
+};
+
+static const CorpusGramRecord embedded_corpus_grams[] = {
+    {0, 3, 0, 1}, {0, 11, 1, 1}, {0, 12, 2, 1}, {0, 17, 3, 3},
+    {0, 18, 6, 3}, {0, 19, 9, 3}, {0, 24, 12, 2}, {0, 26, 14, 2},
+    {0, 40, 16, 1}, {0, 52, 17, 1}, {0, 78, 18, 1}, {0, 92, 19, 1},
+    {0, 104, 20, 2}, {0, 107, 22, 1}, {0, 117, 23, 1}, {0, 121, 24, 2},
+    {0, 122, 26, 2}, {0, 130, 28, 1}, {0, 138, 29, 1}, {0, 150, 30, 1},
+    {0, 156, 31, 1}, {0, 163, 32, 1}, {0, 174, 33, 1}, {0, 182, 34, 1},
+    {0, 186, 35, 5}, {0, 201, 40, 1}, {0, 214, 41, 1}, {0, 218, 42, 1},
+    {0, 220, 43, 1}, {0, 221, 44, 2}, {0, 226, 46, 3}, {0, 227, 49, 1},
+    {0, 264, 50, 1}, {0, 278, 51, 1}, {0, 286, 52, 1}, {0, 294, 53, 1},
+    {0, 297, 54, 1}, {0, 312, 55, 1}, {0, 316, 56, 1}, {0, 346, 57, 1},
+    {0, 351, 58, 1}, {0, 356, 59, 1}, {0, 357, 60, 1}, {0, 362, 61, 1},
+    {0, 370, 62, 1}, {0, 374, 63, 1}, {0, 377, 64, 1}, {0, 378, 65, 1},
+    {0, 390, 66, 1}, {0, 401, 67, 1}, {0, 446, 68, 2}, {0, 450, 70, 1},
+    {0, 452, 71, 2}, {0, 462, 73, 1}, {0, 466, 74, 1}, {0, 468, 75, 1},
+    {0, 472, 76, 1}, {0, 475, 77, 2}, {0, 487, 79, 2}, {0, 488, 81, 2},
+    {0, 490, 83, 1}, {0, 498, 84, 1}, {0, 501, 85, 3}, {0, 508, 88, 3},
+    {0, 533, 91, 4}, {0, 550, 95, 1}, {0, 572, 96, 1}, {0, 576, 97, 1},
+    {0, 580, 98, 1}, {0, 973, 99, 1}, {0, 992, 100, 1}, {0, 1122, 101, 1},
+    {0, 1128, 102, 2}, {0, 1163, 104, 2}, {0, 1174, 106, 1}, {0, 1363, 107, 1},
+    {0, 1369, 108, 1}, {0, 1730, 109, 1}, {0, 2047, 110, 1}, {0, 2728, 111, 1},
+    {0, 3074, 112, 1}, {0, 3383, 113, 1}, {0, 3398, 114, 1}, {0, 3737, 115, 1},
+    {0, 3846, 116, 1}, {0, 4074, 117, 1}, {0, 4282, 118, 1}, {0, 4589, 119, 1},
+    {0, 4744, 120, 1}, {0, 4933, 121, 1}, {0, 5426, 122, 1}, {0, 6247, 123, 1},
+    {0, 6348, 124, 1}, {0, 6556, 125, 1}, {0, 6559, 126, 1}, {0, 8136, 127, 1},
+    {0, 8330, 128, 1}, {0, 8807, 129, 1}, {0, 8910, 130, 1}, {0, 9678, 131, 1},
+    {0, 9826, 132, 1}, {0, 10314, 133, 1}, {0, 10418, 134, 1}, {0, 10514, 135, 1},
+    {0, 10833, 136, 1}, {0, 11102, 137, 1}, {0, 12272, 138, 1}, {0, 12275, 139, 1},
+    {0, 12394, 140, 1}, {0, 12701, 141, 1}, {0, 12863, 142, 1}, {0, 12966, 143, 1},
+    {0, 13030, 144, 1}, {0, 13377, 145, 2}, {0, 13424, 147, 1}, {0, 13641, 148, 1},
+    {0, 13706, 149, 3}, {0, 14547, 152, 1}, {0, 14552, 153, 1}, {0, 14993, 154, 1},
+    {0, 15567, 155, 1}, {0, 15665, 156, 1}, {0, 15768, 157, 1}, {1, 2, 158, 1},
+    {1, 5, 159, 2}, {1, 8, 161, 1}, {1, 10, 162, 1}, {1, 11, 163, 1},
+    {1, 12, 164, 1}, {1, 13, 165, 4}, {1, 15, 169, 1}, {1, 17, 170, 5},
+    {1, 18, 175, 1}, {1, 19, 176, 2}, {1, 22, 178, 2}, {1, 24, 180, 4},
+    {1, 26, 184, 1}, {1, 30, 185, 1}, {1, 34, 186, 1}, {1, 37, 187, 1},
+    {1, 52, 188, 2}, {1, 56, 190, 1}, {1, 59, 191, 4}, {1, 63, 195, 1},
+    {1, 66, 196, 1}, {1, 78, 197, 2}, {1, 81, 199, 1}, {1, 82, 200, 3},
+    {1, 86, 203, 2}, {1, 95, 205, 1}, {1, 96, 206, 1}, {1, 104, 207, 2},
+    {1, 107, 209, 8}, {1, 108, 217, 2}, {1, 109, 219, 1}, {1, 114, 220, 1},
+    {1, 115, 221, 1}, {1, 116, 222, 1}, {1, 117, 223, 5}, {1, 119, 228, 1},
+    {1, 120, 229, 1}, {1, 121, 230, 6}, {1, 122, 236, 3}, {1, 123, 239, 1},
+    {1, 127, 240, 1}, {1, 128, 241, 1}, {1, 134, 242, 2}, {1, 144, 244, 4},
+    {1, 149, 248, 3}, {1, 160, 251, 2}, {1, 164, 253, 1}, {1, 170, 254, 2},
+    {1, 182, 256, 1}, {1, 185, 257, 1}, {1, 186, 258, 9}, {1, 190, 267, 2},
+    {1, 196, 269, 2}, {1, 210, 271, 1}, {1, 211, 272, 1}, {1, 212, 273, 1},
+    {1, 219, 274, 3}, {1, 221, 277, 3}, {1, 222, 280, 4}, {1, 225, 284, 1},
+    {1, 226, 285, 2}, {1, 227, 287, 6}, {1, 229, 293, 2}, {1, 264, 295, 3},
+    {1, 286, 298, 5}, {1, 289, 303, 1}, {1, 290, 304, 4}, {1, 294, 308, 6},
+    {1, 297, 314, 1}, {1, 300, 315, 1}, {1, 305, 316, 1}, {1, 310, 317, 3},
+    {1, 312, 320, 1}, {1, 313, 321, 1}, {1, 316, 322, 1}, {1, 326, 323, 5},
+    {1, 336, 328, 1}, {1, 341, 329, 5}, {1, 342, 334, 1}, {1, 344, 335, 2},
+    {1, 346, 337, 1}, {1, 349, 338, 1}, {1, 357, 339, 2}, {1, 366, 341, 1},
+    {1, 370, 342, 1}, {1, 374, 343, 1}, {1, 375, 344, 1}, {1, 377, 345, 5},
+    {1, 378, 350, 1}, {1, 381, 351, 4}, {1, 382, 355, 1}, {1, 383, 356, 2},
+    {1, 384, 358, 5}, {1, 385, 363, 1}, {1, 398, 364, 2}, {1, 401, 366, 3},
+    {1, 405, 369, 1}, {1, 436, 370, 1}, {1, 442, 371, 1}, {1, 443, 372, 1},
+    {1, 445, 373, 1}, {1, 446, 374, 5}, {1, 448, 379, 1}, {1, 452, 380, 1},
+    {1, 453, 381, 1}, {1, 461, 382, 2}, {1, 464, 384, 1}, {1, 468, 385, 1},
+    {1, 472, 386, 5}, {1, 476, 391, 2}, {1, 479, 393, 1}, {1, 480, 394, 1},
+    {1, 482, 395, 1}, {1, 486, 396, 1}, {1, 487, 397, 8}, {1, 488, 405, 1},
+    {1, 494, 406, 2}, {1, 496, 408, 1}, {1, 498, 409, 5}, {1, 501, 414, 10},
+    {1, 502, 424, 1}, {1, 508, 425, 4}, {1, 511, 429, 1}, {1, 512, 430, 3},
+    {1, 514, 433, 2}, {1, 518, 435, 1}, {1, 523, 436, 2}, {1, 524, 438, 1},
+    {1, 533, 439, 1}, {1, 535, 440, 1}, {1, 537, 441, 1}, {1, 538, 442, 4},
+    {1, 539, 446, 1}, {1, 550, 447, 2}, {1, 554, 449, 1}, {1, 572, 450, 3},
+    {1, 576, 453, 1}, {1, 579, 454, 2}, {1, 580, 456, 2}, {1, 613, 458, 1},
+    {1, 628, 459, 1}, {1, 735, 460, 1}, {1, 825, 461, 2}, {1, 897, 463, 1},
+    {1, 940, 464, 1}, {1, 973, 465, 1}, {1, 992, 466, 1}, {1, 1017, 467, 4},
+    {1, 1020, 471, 1}, {1, 1081, 472, 1}, {1, 1121, 473, 1}, {1, 1128, 474, 1},
+    {1, 1129, 475, 1}, {1, 1137, 476, 1}, {1, 1163, 477, 1}, {1, 1172, 478, 1},
+    {1, 1174, 479, 1}, {1, 1248, 480, 1}, {1, 1304, 481, 1}, {1, 1362, 482, 1},
+    {1, 1459, 483, 1}, {1, 1577, 484, 1}, {1, 1646, 485, 1}, {1, 2038, 486, 1},
+    {1, 2040, 487, 1}, {1, 2214, 488, 2}, {1, 2218, 490, 1}, {1, 2224, 491, 1},
+    {1, 2318, 492, 1}, {1, 2403, 493, 1}, {1, 2721, 494, 1}, {1, 2728, 495, 1},
+    {1, 2786, 496, 1}, {1, 2821, 497, 2}, {1, 2925, 499, 1}, {1, 2930, 500, 1},
+    {1, 3150, 501, 1}, {1, 3382, 502, 1}, {1, 3397, 503, 2}, {1, 3494, 505, 1},
+    {1, 3499, 506, 1}, {1, 3529, 507, 1}, {1, 3644, 508, 1}, {1, 3685, 509, 1},
+    {1, 3693, 510, 1}, {1, 3721, 511, 1}, {1, 3729, 512, 1}, {1, 3737, 513, 1},
+    {1, 3816, 514, 1}, {1, 3826, 515, 1}, {1, 3844, 516, 1}, {1, 3866, 517, 1},
+    {1, 3867, 518, 2}, {1, 3881, 520, 1}, {1, 3993, 521, 1}, {1, 4160, 522, 1},
+    {1, 4171, 523, 1}, {1, 4437, 524, 4}, {1, 4554, 528, 2}, {1, 4853, 530, 1},
+    {1, 4855, 531, 1}, {1, 4961, 532, 1}, {1, 5115, 533, 2}, {1, 5423, 535, 1},
+    {1, 5486, 536, 1}, {1, 5515, 537, 1}, {1, 5525, 538, 1}, {1, 5529, 539, 3},
+    {1, 5536, 542, 1}, {1, 5627, 543, 2}, {1, 5774, 545, 1}, {1, 5790, 546, 1},
+    {1, 6140, 547, 1}, {1, 6166, 548, 1}, {1, 6373, 549, 1}, {1, 6374, 550, 1},
+    {1, 6394, 551, 1}, {1, 6426, 552, 1}, {1, 6428, 553, 1}, {1, 6461, 554, 4},
+    {1, 6545, 558, 1}, {1, 6571, 559, 2}, {1, 6585, 561, 2}, {1, 6596, 563, 1},
+    {1, 6602, 564, 1}, {1, 6634, 565, 2}, {1, 7543, 567, 2}, {1, 7553, 569, 1},
+    {1, 8120, 570, 1}, {1, 8130, 571, 1}, {1, 8131, 572, 1}, {1, 8136, 573, 2},
+    {1, 8207, 575, 1}, {1, 8216, 576, 1}, {1, 8220, 577, 1}, {1, 8221, 578, 1},
+    {1, 8234, 579, 1}, {1, 8333, 580, 1}, {1, 8334, 581, 4}, {1, 8341, 585, 1},
+    {1, 8490, 586, 1}, {1, 8799, 587, 1}, {1, 8825, 588, 1}, {1, 9172, 589, 4},
+    {1, 9173, 593, 1}, {1, 9550, 594, 1}, {1, 9571, 595, 1}, {1, 9624, 596, 1},
+    {1, 9674, 597, 1}, {1, 9774, 598, 1}, {1, 9966, 599, 1}, {1, 9976, 600, 1},
+    {1, 10206, 601, 1}, {1, 10300, 602, 1}, {1, 10404, 603, 1}, {1, 10426, 604, 1},
+    {1, 10514, 605, 1}, {1, 10586, 606, 1}, {1, 10588, 607, 1}, {1, 10612, 608, 1},
+    {1, 10678, 609, 4}, {1, 10679, 613, 1}, {1, 10694, 614, 1}, {1, 11035, 615, 1},
+    {1, 11043, 616, 1}, {1, 11102, 617, 3}, {1, 11214, 620, 1}, {1, 12016, 621, 1},
+    {1, 12181, 622, 1}, {1, 12198, 623, 1}, {1, 12264, 624, 1}, {1, 12284, 625, 1},
+    {1, 12285, 626, 1}, {1, 12288, 627, 1}, {1, 12290, 628, 1}, {1, 12332, 629, 1},
+    {1, 12478, 630, 1}, {1, 12666, 631, 1}, {1, 12669, 632, 1}, {1, 12740, 633, 1},
+    {1, 12866, 634, 1}, {1, 13055, 635, 1}, {1, 13070, 636, 1}, {1, 13134, 637, 1},
+    {1, 13156, 638, 1}, {1, 13221, 639, 1}, {1, 13326, 640, 1}, {1, 13338, 641, 2},
+    {1, 13342, 643, 2}, {1, 13358, 645, 2}, {1, 13367, 647, 1}, {1, 13533, 648, 1},
+    {1, 13537, 649, 1}, {1, 13579, 650, 1}, {1, 13624, 651, 1}, {1, 13627, 652, 2},
+    {1, 13641, 654, 3}, {1, 13705, 657, 1}, {1, 13706, 658, 9}, {1, 13716, 667, 1},
+    {1, 13739, 668, 1}, {1, 13890, 669, 1}, {1, 13966, 670, 1}, {1, 13996, 671, 1},
+    {1, 14043, 672, 1}, {1, 14057, 673, 1}, {1, 14277, 674, 1}, {1, 14278, 675, 1},
+    {1, 14318, 676, 1}, {1, 14553, 677, 1}, {1, 14639, 678, 1}, {1, 14668, 679, 4},
+    {1, 14708, 683, 1}, {1, 14979, 684, 1}, {1, 15084, 685, 1}, {1, 15565, 686, 1},
+    {1, 15567, 687, 1}, {1, 15572, 688, 1}, {1, 15656, 689, 1}, {1, 15738, 690, 1},
+    {1, 15744, 691, 1}, {1, 15775, 692, 2}, {1, 16625, 694, 1}, {1, 17007, 695, 1},
+    {2, 2, 696, 2}, {2, 3, 698, 1}, {2, 5, 699, 1}, {2, 6, 700, 1},
+    {2, 8, 701, 3}, {2, 11, 704, 2}, {2, 12, 706, 3}, {2, 13, 709, 6},
+    {2, 15, 715, 2}, {2, 17, 717, 2}, {2, 18, 719, 4}, {2, 19, 723, 5},
+    {2, 20, 728, 2}, {2, 21, 730, 2}, {2, 22, 732, 1}, {2, 24, 733, 2},
+    {2, 30, 735, 2}, {2, 44, 737, 2}, {2, 46, 739, 1}, {2, 50, 740, 2},
+    {2, 52, 742, 5}, {2, 56, 747, 4}, {2, 59, 751, 4}, {2, 60, 755, 4},
+    {2, 63, 759, 1}, {2, 66, 760, 3}, {2, 69, 763, 1}, {2, 72, 764, 2},
+    {2, 78, 766, 1}, {2, 82, 767, 3}, {2, 86, 770, 4}, {2, 96, 774, 1},
+    {2, 98, 775, 1}, {2, 99, 776, 1}, {2, 102, 777, 1}, {2, 104, 778, 3},
+    {2, 106, 781, 3}, {2, 107, 784, 7}, {2, 108, 791, 2}, {2, 112, 793, 2},
+    {2, 116, 795, 2}, {2, 117, 797, 5}, {2, 119, 802, 1}, {2, 121, 803, 6},
+    {2, 122, 809, 4}, {2, 123, 813, 4}, {2, 125, 817, 3}, {2, 126, 820, 1},
+    {2, 127, 821, 1}, {2, 128, 822, 1}, {2, 130, 823, 1}, {2, 135, 824, 1},
+    {2, 138, 825, 1}, {2, 144, 826, 2}, {2, 147, 828, 1}, {2, 148, 829, 1},
+    {2, 149, 830, 1}, {2, 160, 831, 1}, {2, 163, 832, 2}, {2, 164, 834, 1},
+    {2, 169, 835, 1}, {2, 170, 836, 1}, {2, 173, 837, 1}, {2, 176, 838, 1},
+    {2, 182, 839, 4}, {2, 186, 843, 8}, {2, 190, 851, 1}, {2, 194, 852, 1},
+    {2, 195, 853, 1}, {2, 196, 854, 2}, {2, 199, 856, 1}, {2, 201, 857, 1},
+    {2, 202, 858, 2}, {2, 206, 860, 1}, {2, 210, 861, 4}, {2, 211, 865, 1},
+    {2, 212, 866, 5}, {2, 213, 871, 2}, {2, 214, 873, 1}, {2, 219, 874, 3},
+    {2, 220, 877, 3}, {2, 221, 880, 7}, {2, 222, 887, 4}, {2, 223, 891, 1},
+    {2, 225, 892, 2}, {2, 226, 894, 2}, {2, 227, 896, 4}, {2, 229, 900, 1},
+    {2, 264, 901, 1}, {2, 268, 902, 1}, {2, 286, 903, 2}, {2, 290, 905, 4},
+    {2, 294, 909, 4}, {2, 297, 913, 1}, {2, 300, 914, 3}, {2, 304, 917, 1},
+    {2, 306, 918, 1}, {2, 310, 919, 2}, {2, 312, 921, 3}, {2, 313, 924, 1},
+    {2, 316, 925, 5}, {2, 320, 930, 3}, {2, 324, 933, 2}, {2, 326, 935, 5},
+    {2, 327, 940, 3}, {2, 330, 943, 1}, {2, 332, 944, 1}, {2, 338, 945, 1},
+    {2, 340, 946, 4}, {2, 341, 950, 5}, {2, 342, 955, 3}, {2, 344, 958, 4},
+    {2, 346, 962, 3}, {2, 351, 965, 1}, {2, 352, 966, 3}, {2, 356, 969, 2},
+    {2, 357, 971, 7}, {2, 358, 978, 3}, {2, 362, 981, 1}, {2, 365, 982, 2},
+    {2, 366, 984, 1}, {2, 367, 985, 1}, {2, 370, 986, 1}, {2, 374, 987, 1},
+    {2, 375, 988, 1}, {2, 376, 989, 2}, {2, 377, 991, 7}, {2, 378, 998, 1},
+    {2, 381, 999, 4}, {2, 382, 1003, 1}, {2, 383, 1004, 2}, {2, 384, 1006, 5},
+    {2, 385, 1011, 2}, {2, 394, 1013, 3}, {2, 397, 1016, 1}, {2, 398, 1017, 1},
+    {2, 401, 1018, 2}, {2, 404, 1020, 1}, {2, 407, 1021, 1}, {2, 409, 1022, 2},
+    {2, 442, 1024, 3}, {2, 444, 1027, 1}, {2, 445, 1028, 1}, {2, 446, 1029, 6},
+    {2, 448, 1035, 1}, {2, 449, 1036, 1}, {2, 450, 1037, 4}, {2, 453, 1041, 1},
+    {2, 454, 1042, 2}, {2, 456, 1044, 3}, {2, 460, 1047, 2}, {2, 462, 1049, 1},
+    {2, 463, 1050, 1}, {2, 466, 1051, 1}, {2, 468, 1052, 1}, {2, 470, 1053, 3},
+    {2, 472, 1056, 5}, {2, 476, 1061, 2}, {2, 478, 1063, 1}, {2, 479, 1064, 1},
+    {2, 482, 1065, 1}, {2, 483, 1066, 1}, {2, 487, 1067, 5}, {2, 488, 1072, 2},
+    {2, 492, 1074, 1}, {2, 494, 1075, 2}, {2, 498, 1077, 7}, {2, 501, 1084, 8},
+    {2, 502, 1092, 4}, {2, 505, 1096, 1}, {2, 508, 1097, 3}, {2, 511, 1100, 4},
+    {2, 512, 1104, 3}, {2, 513, 1107, 1}, {2, 518, 1108, 2}, {2, 520, 1110, 1},
+    {2, 522, 1111, 1}, {2, 523, 1112, 2}, {2, 524, 1114, 1}, {2, 526, 1115, 2},
+    {2, 528, 1117, 1}, {2, 531, 1118, 1}, {2, 532, 1119, 1}, {2, 533, 1120, 4},
+    {2, 537, 1124, 1}, {2, 538, 1125, 5}, {2, 539, 1130, 2}, {2, 546, 1132, 3},
+    {2, 550, 1135, 4}, {2, 570, 1139, 1}, {2, 572, 1140, 2}, {2, 576, 1142, 2},
+    {2, 579, 1144, 1}, {2, 580, 1145, 1}, {2, 589, 1146, 1}, {2, 613, 1147, 1},
+    {2, 628, 1148, 1}, {2, 636, 1149, 1}, {2, 637, 1150, 1}, {2, 643, 1151, 1},
+    {2, 732, 1152, 2}, {2, 735, 1154, 1}, {2, 739, 1155, 1}, {2, 775, 1156, 1},
+    {2, 825, 1157, 1}, {2, 836, 1158, 1}, {2, 895, 1159, 1}, {2, 897, 1160, 2},
+    {2, 973, 1162, 1}, {2, 980, 1163, 1}, {2, 992, 1164, 2}, {2, 996, 1166, 1},
+    {2, 1016, 1167, 3}, {2, 1017, 1170, 4}, {2, 1020, 1174, 1}, {2, 1028, 1175, 1},
+    {2, 1033, 1176, 1}, {2, 1034, 1177, 1}, {2, 1070, 1178, 1}, {2, 1085, 1179, 1},
+    {2, 1118, 1180, 1}, {2, 1130, 1181, 1}, {2, 1174, 1182, 1}, {2, 1177, 1183, 2},
+    {2, 1178, 1185, 2}, {2, 1181, 1187, 1}, {2, 1199, 1188, 1}, {2, 1202, 1189, 1},
+    {2, 1226, 1190, 1}, {2, 1246, 1191, 1}, {2, 1252, 1192, 1}, {2, 1304, 1193, 1},
+    {2, 1458, 1194, 1}, {2, 1473, 1195, 1}, {2, 1824, 1196, 1}, {2, 1839, 1197, 1},
+    {2, 1891, 1198, 1}, {2, 2039, 1199, 1}, {2, 2040, 1200, 2}, {2, 2041, 1202, 1},
+    {2, 2043, 1203, 2}, {2, 2047, 1205, 2}, {2, 2048, 1207, 1}, {2, 2135, 1208, 2},
+    {2, 2144, 1210, 1}, {2, 2210, 1211, 1}, {2, 2214, 1212, 2}, {2, 2223, 1214, 1},
+    {2, 2240, 1215, 3}, {2, 2255, 1218, 1}, {2, 2318, 1219, 1}, {2, 2322, 1220, 1},
+    {2, 2334, 1221, 1}, {2, 2404, 1222, 2}, {2, 2405, 1224, 2}, {2, 2409, 1226, 1},
+    {2, 2478, 1227, 1}, {2, 2559, 1228, 1}, {2, 2567, 1229, 1}, {2, 2728, 1230, 1},
+    {2, 2811, 1231, 1}, {2, 2825, 1232, 1}, {2, 2826, 1233, 1}, {2, 2827, 1234, 2},
+    {2, 2916, 1236, 1}, {2, 2923, 1237, 1}, {2, 2925, 1238, 2}, {2, 3226, 1240, 1},
+    {2, 3250, 1241, 1}, {2, 3341, 1242, 1}, {2, 3382, 1243, 1}, {2, 3399, 1244, 2},
+    {2, 3401, 1246, 1}, {2, 3432, 1247, 1}, {2, 3439, 1248, 1}, {2, 3446, 1249, 1},
+    {2, 3499, 1250, 1}, {2, 3503, 1251, 1}, {2, 3605, 1252, 2}, {2, 3696, 1254, 1},
+    {2, 3704, 1255, 1}, {2, 3720, 1256, 1}, {2, 3721, 1257, 1}, {2, 3724, 1258, 1},
+    {2, 3736, 1259, 1}, {2, 3737, 1260, 3}, {2, 3822, 1263, 1}, {2, 3826, 1264, 2},
+    {2, 3830, 1266, 1}, {2, 3833, 1267, 1}, {2, 3834, 1268, 1}, {2, 3836, 1269, 1},
+    {2, 3840, 1270, 2}, {2, 3843, 1272, 1}, {2, 3846, 1273, 1}, {2, 3850, 1274, 1},
+    {2, 3863, 1275, 1}, {2, 3867, 1276, 1}, {2, 3874, 1277, 1}, {2, 3878, 1278, 1},
+    {2, 3881, 1279, 1}, {2, 3882, 1280, 1}, {2, 3892, 1281, 1}, {2, 3898, 1282, 1},
+    {2, 3930, 1283, 3}, {2, 3993, 1286, 1}, {2, 4058, 1287, 1}, {2, 4204, 1288, 1},
+    {2, 4266, 1289, 1}, {2, 4437, 1290, 2}, {2, 4506, 1292, 1}, {2, 4554, 1293, 1},
+    {2, 4933, 1294, 1}, {2, 4942, 1295, 1}, {2, 5078, 1296, 1}, {2, 5115, 1297, 1},
+    {2, 5178, 1298, 1}, {2, 5252, 1299, 1}, {2, 5260, 1300, 1}, {2, 5419, 1301, 1},
+    {2, 5425, 1302, 1}, {2, 5427, 1303, 1}, {2, 5429, 1304, 1}, {2, 5512, 1305, 1},
+    {2, 5520, 1306, 2}, {2, 5524, 1308, 1}, {2, 5529, 1309, 3}, {2, 5530, 1312, 1},
+    {2, 5536, 1313, 1}, {2, 5618, 1314, 1}, {2, 5627, 1315, 1}, {2, 5738, 1316, 1},
+    {2, 5760, 1317, 1}, {2, 5785, 1318, 2}, {2, 5864, 1320, 1}, {2, 5941, 1321, 1},
+    {2, 5946, 1322, 1}, {2, 6051, 1323, 1}, {2, 6136, 1324, 3}, {2, 6156, 1327, 1},
+    {2, 6166, 1328, 1}, {2, 6201, 1329, 4}, {2, 6206, 1333, 1}, {2, 6207, 1334, 1},
+    {2, 6219, 1335, 1}, {2, 6222, 1336, 1}, {2, 6253, 1337, 1}, {2, 6374, 1338, 1},
+    {2, 6381, 1339, 1}, {2, 6397, 1340, 1}, {2, 6400, 1341, 1}, {2, 6411, 1342, 1},
+    {2, 6424, 1343, 1}, {2, 6425, 1344, 1}, {2, 6426, 1345, 1}, {2, 6428, 1346, 4},
+    {2, 6441, 1350, 2}, {2, 6442, 1352, 1}, {2, 6461, 1353, 4}, {2, 6493, 1357, 1},
+    {2, 6571, 1358, 2}, {2, 6582, 1360, 1}, {2, 6597, 1361, 1}, {2, 6602, 1362, 1},
+    {2, 6630, 1363, 1}, {2, 7543, 1364, 1}, {2, 7655, 1365, 1}, {2, 8125, 1366, 1},
+    {2, 8136, 1367, 1}, {2, 8219, 1368, 2}, {2, 8228, 1370, 1}, {2, 8229, 1371, 1},
+    {2, 8234, 1372, 1}, {2, 8239, 1373, 1}, {2, 8325, 1374, 1}, {2, 8332, 1375, 1},
+    {2, 8333, 1376, 1}, {2, 8334, 1377, 2}, {2, 8402, 1379, 1}, {2, 8482, 1380, 1},
+    {2, 8489, 1381, 1}, {2, 8490, 1382, 1}, {2, 8496, 1383, 1}, {2, 8594, 1384, 1},
+    {2, 8635, 1385, 1}, {2, 8801, 1386, 1}, {2, 8805, 1387, 1}, {2, 8806, 1388, 1},
+    {2, 8818, 1389, 1}, {2, 8905, 1390, 2}, {2, 8909, 1392, 1}, {2, 8911, 1393, 1},
+    {2, 8998, 1394, 1}, {2, 9009, 1395, 1}, {2, 9015, 1396, 1}, {2, 9100, 1397, 1},
+    {2, 9108, 1398, 1}, {2, 9120, 1399, 1}, {2, 9165, 1400, 1}, {2, 9170, 1401, 1},
+    {2, 9172, 1402, 3}, {2, 9185, 1405, 1}, {2, 9189, 1406, 1}, {2, 9195, 1407, 1},
+    {2, 9321, 1408, 1}, {2, 9476, 1409, 1}, {2, 9520, 1410, 3}, {2, 9524, 1413, 1},
+    {2, 9527, 1414, 1}, {2, 9550, 1415, 1}, {2, 9560, 1416, 1}, {2, 9571, 1417, 1},
+    {2, 9585, 1418, 1}, {2, 9587, 1419, 1}, {2, 9590, 1420, 1}, {2, 9624, 1421, 1},
+    {2, 9640, 1422, 1}, {2, 9674, 1423, 1}, {2, 9676, 1424, 1}, {2, 9677, 1425, 1},
+    {2, 9806, 1426, 1}, {2, 9839, 1427, 1}, {2, 9847, 1428, 1}, {2, 9940, 1429, 1},
+    {2, 9952, 1430, 1}, {2, 9958, 1431, 1}, {2, 9962, 1432, 1}, {2, 9966, 1433, 2},
+    {2, 9975, 1435, 2}, {2, 9976, 1437, 1}, {2, 9988, 1438, 1}, {2, 9996, 1439, 1},
+    {2, 10002, 1440, 1}, {2, 10184, 1441, 2}, {2, 10200, 1443, 1}, {2, 10238, 1444, 1},
+    {2, 10304, 1445, 1}, {2, 10404, 1446, 1}, {2, 10440, 1447, 1}, {2, 10464, 1448, 1},
+    {2, 10467, 1449, 1}, {2, 10484, 1450, 1}, {2, 10486, 1451, 1}, {2, 10496, 1452, 1},
+    {2, 10497, 1453, 1}, {2, 10502, 1454, 1}, {2, 10514, 1455, 1}, {2, 10584, 1456, 1},
+    {2, 10585, 1457, 1}, {2, 10588, 1458, 1}, {2, 10612, 1459, 1}, {2, 10627, 1460, 1},
+    {2, 10641, 1461, 1}, {2, 10653, 1462, 1}, {2, 10666, 1463, 1}, {2, 10673, 1464, 1},
+    {2, 10678, 1465, 4}, {2, 10690, 1469, 2}, {2, 10923, 1471, 1}, {2, 10937, 1472, 2},
+    {2, 11012, 1474, 1}, {2, 11043, 1475, 1}, {2, 11102, 1476, 1}, {2, 11106, 1477, 1},
+    {2, 11198, 1478, 1}, {2, 11272, 1479, 1}, {2, 11318, 1480, 1}, {2, 12170, 1481, 1},
+    {2, 12176, 1482, 1}, {2, 12181, 1483, 1}, {2, 12187, 1484, 1}, {2, 12227, 1485, 1},
+    {2, 12250, 1486, 1}, {2, 12272, 1487, 2}, {2, 12274, 1489, 1}, {2, 12276, 1490, 1},
+    {2, 12338, 1491, 1}, {2, 12374, 1492, 1}, {2, 12378, 1493, 1}, {2, 12380, 1494, 1},
+    {2, 12388, 1495, 1}, {2, 12389, 1496, 1}, {2, 12391, 1497, 1}, {2, 12395, 1498, 1},
+    {2, 12468, 1499, 1}, {2, 12488, 1500, 1}, {2, 12494, 1501, 1}, {2, 12535, 1502, 1},
+    {2, 12552, 1503, 2}, {2, 12553, 1505, 1}, {2, 12640, 1506, 1}, {2, 12701, 1507, 1},
+    {2, 12714, 1508, 1}, {2, 12863, 1509, 1}, {2, 12896, 1510, 1}, {2, 12904, 1511, 1},
+    {2, 12913, 1512, 1}, {2, 12951, 1513, 1}, {2, 12965, 1514, 1}, {2, 12969, 1515, 1},
+    {2, 13055, 1516, 1}, {2, 13058, 1517, 1}, {2, 13112, 1518, 1}, {2, 13154, 1519, 1},
+    {2, 13210, 1520, 1}, {2, 13242, 1521, 1}, {2, 13338, 1522, 1}, {2, 13342, 1523, 1},
+    {2, 13355, 1524, 2}, {2, 13356, 1526, 1}, {2, 13376, 1527, 1}, {2, 13381, 1528, 1},
+    {2, 13480, 1529, 1}, {2, 13522, 1530, 1}, {2, 13528, 1531, 2}, {2, 13626, 1533, 1},
+    {2, 13627, 1534, 1}, {2, 13628, 1535, 1}, {2, 13637, 1536, 1}, {2, 13641, 1537, 3},
+    {2, 13702, 1540, 1}, {2, 13706, 1541, 8}, {2, 13710, 1549, 1}, {2, 13714, 1550, 1},
+    {2, 13716, 1551, 1}, {2, 13719, 1552, 1}, {2, 13722, 1553, 1}, {2, 13730, 1554, 1},
+    {2, 13741, 1555, 1}, {2, 13742, 1556, 2}, {2, 13746, 1558, 1}, {2, 13749, 1559, 1},
+    {2, 13830, 1560, 1}, {2, 13962, 1561, 1}, {2, 13966, 1562, 2}, {2, 13970, 1564, 1},
+    {2, 13976, 1565, 1}, {2, 14018, 1566, 1}, {2, 14202, 1567, 1}, {2, 14252, 1568, 1},
+    {2, 14282, 1569, 2}, {2, 14303, 1571, 1}, {2, 14359, 1572, 2}, {2, 14422, 1574, 1},
+    {2, 14496, 1575, 1}, {2, 14512, 1576, 1}, {2, 14520, 1577, 1}, {2, 14542, 1578, 1},
+    {2, 14547, 1579, 1}, {2, 14553, 1580, 2}, {2, 14646, 1582, 1}, {2, 14666, 1583, 1},
+    {2, 14668, 1584, 2}, {2, 14675, 1586, 1}, {2, 14885, 1587, 1}, {2, 14891, 1588, 2},
+    {2, 14979, 1590, 1}, {2, 14989, 1591, 1}, {2, 14993, 1592, 2}, {2, 15566, 1594, 2},
+    {2, 15652, 1596, 1}, {2, 15738, 1597, 1}, {2, 15769, 1598, 1}, {2, 15998, 1599, 1},
+    {2, 16618, 1600, 1}, {2, 17007, 1601, 1}, {2, 17227, 1602, 1}, {2, 17238, 1603, 1},
+    {2, 17401, 1604, 1},
+};
+
+static const CorpusHeader embedded_corpus_header = {
+    CORPUS_MAGIC, CORPUS_VERSION, 3, 28, 0, 1698, 0, 0, 0, 1605, 0, 1017
+};
+
+static const EmbeddedCorpus embedded_corpus = {
+    &embedded_corpus_header, embedded_corpus_text, embedded_corpus_sections,
+    embedded_corpus_entries, embedded_corpus_postings, embedded_corpus_grams
+};
+
+#endif
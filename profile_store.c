@@ -0,0 +1,405 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "profile_store.h"
+#include "file_lock.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__WINDOWS__)
+    #include <io.h>
+    #include <windows.h>
+    #define PROFILE_STORE_WINDOWS 1
+    #define OPEN_FLAGS (_O_RDWR | _O_CREAT | _O_BINARY)
+    #define TEMP_FLAGS (_O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY)
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #define PROFILE_STORE_WINDOWS 0
+    #define OPEN_FLAGS (O_RDWR | O_CREAT)
+    #define TEMP_FLAGS (O_WRONLY | O_CREAT | O_TRUNC)
+
+// fcntl locks belong to the process, so they do not keep this process's own
+// threads apart; every lock is also taken on this mutex
+static pthread_mutex_t threadLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+#define INITIAL_RECORD_CAPACITY 256
+
+// The store lock, byte 0; on POSIX it also takes the thread mutex
+static int lockFile(int fd, int exclusive) {
+#if !PROFILE_STORE_WINDOWS
+    pthread_mutex_lock(&threadLock);
+#endif
+    if (lockFileByte(fd, 0, exclusive, 1) == 0) return 0;
+#if !PROFILE_STORE_WINDOWS
+    pthread_mutex_unlock(&threadLock);
+#endif
+    return -1;
+}
+
+static void unlockFile(int fd) {
+    unlockFileByte(fd, 0);
+#if !PROFILE_STORE_WINDOWS
+    pthread_mutex_unlock(&threadLock);
+#endif
+}
+
+static long long fileSize(int fd) {
+#if PROFILE_STORE_WINDOWS
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx((HANDLE)_get_osfhandle(fd), &size)) return -1;
+    return size.QuadPart;
+#else
+    struct stat info;
+    if (fstat(fd, &info) != 0) return -1;
+    return info.st_size;
+#endif
+}
+
+static void unmapStore(ProfileStore *store) {
+    if (!store->base) return;
+#if PROFILE_STORE_WINDOWS
+    UnmapViewOfFile(store->base);
+    CloseHandle(store->mappingHandle);
+    store->mappingHandle = NULL;
+#else
+    munmap(store->base, store->size);
+#endif
+    store->base = NULL;
+    store->size = 0;
+}
+
+// Map the first size bytes of the file, extending it first if it is shorter
+static int mapStore(ProfileStore *store, size_t size) {
+    unmapStore(store);
+#if PROFILE_STORE_WINDOWS
+    // A mapping larger than the file extends it, even while other processes
+    // still have the shorter view mapped
+    HANDLE mapping = CreateFileMappingA((HANDLE)_get_osfhandle(store->fd), NULL, PAGE_READWRITE,
+                                       (DWORD)((unsigned long long)size >> 32), (DWORD)size, NULL);
+    if (!mapping) return -1;
+    void *base = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+    if (!base) {
+        CloseHandle(mapping);
+        return -1;
+    }
+    store->mappingHandle = mapping;
+#else
+    long long current = fileSize(store->fd);
+    if (current < 0 || ((size_t)current < size && ftruncate(store->fd, (off_t)size) != 0)) return -1;
+    void *base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, store->fd, 0);
+    if (base == MAP_FAILED) return -1;
+#endif
+    store->base = base;
+    store->size = size;
+    return 0;
+}
+
+static size_t storeSize(uint64_t recordCapacity, uint64_t indexCapacity) {
+    return sizeof(ProfileStoreHeader) + recordCapacity * sizeof(ProfileRecord) + indexCapacity * sizeof(uint32_t);
+}
+
+static ProfileStoreHeader *storeHeader(ProfileStore *store) {
+    return (ProfileStoreHeader *)store->base;
+}
+
+static ProfileRecord *storeRecords(ProfileStore *store) {
+    return (ProfileRecord *)(store->base + sizeof(ProfileStoreHeader));
+}
+
+static uint32_t *storeIndex(ProfileStore *store) {
+    return (uint32_t *)(store->base + sizeof(ProfileStoreHeader) +
+                        storeHeader(store)->recordCapacity * sizeof(ProfileRecord));
+}
+
+static int validHeader(ProfileStore *store) {
+    const ProfileStoreHeader *header = storeHeader(store);
+    return store->size >= sizeof(ProfileStoreHeader) &&
+           memcmp(header->magic, PROFILE_STORE_MAGIC, sizeof(PROFILE_STORE_MAGIC)) == 0 &&
+           header->version == PROFILE_STORE_VERSION &&
+           header->recordSize == sizeof(ProfileRecord) &&
+           header->recordCount <= header->recordCapacity &&
+           header->recordCapacity < UINT32_MAX &&
+           header->indexCapacity == header->recordCapacity * 2 &&
+           (header->indexCapacity & (header->indexCapacity - 1)) == 0 &&
+           storeSize(header->recordCapacity, header->indexCapacity) <= store->size;
+}
+
+// FNV-1a
+static uint64_t hashUsername(const char *username) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < PROFILE_NAME_LENGTH && username[i]; i++) {
+        hash ^= (unsigned char)username[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static void buildIndex(ProfileStore *store, uint32_t *index, uint64_t indexCapacity) {
+    const ProfileStoreHeader *header = storeHeader(store);
+    const ProfileRecord *records = storeRecords(store);
+    uint64_t mask = indexCapacity - 1;
+    memset(index, 0, indexCapacity * sizeof(uint32_t));
+    for (uint64_t i = 0; i < header->recordCount; i++) {
+        uint64_t slot = hashUsername(records[i].username) & mask;
+        while (index[slot]) slot = (slot + 1) & mask;
+        index[slot] = (uint32_t)(i + 1);
+    }
+}
+
+static int initializeStore(ProfileStore *store) {
+    if (mapStore(store, storeSize(INITIAL_RECORD_CAPACITY, INITIAL_RECORD_CAPACITY * 2)) != 0) return -1;
+    ProfileStoreHeader *header = storeHeader(store);
+    memset(store->base, 0, store->size);
+    header->version = PROFILE_STORE_VERSION;
+    header->recordSize = sizeof(ProfileRecord);
+    header->recordCapacity = INITIAL_RECORD_CAPACITY;
+    header->indexCapacity = INITIAL_RECORD_CAPACITY * 2;
+    // Written last so a half-initialized file is never taken for a valid one
+    memcpy(header->magic, PROFILE_STORE_MAGIC, sizeof(PROFILE_STORE_MAGIC));
+    return 0;
+}
+
+// Records stay where they are; the old index becomes record space and a new
+// index is built past it. The header switches over only once that is done.
+static int growStore(ProfileStore *store) {
+    ProfileStoreHeader *header = storeHeader(store);
+    uint64_t recordCapacity = header->recordCapacity * 2;
+    uint64_t indexCapacity = header->indexCapacity * 2;
+    if (recordCapacity >= UINT32_MAX) return -1;
+    if (mapStore(store, storeSize(recordCapacity, indexCapacity)) != 0) return -1;
+
+    header = storeHeader(store);
+    buildIndex(store, (uint32_t *)(store->base + sizeof(ProfileStoreHeader) + recordCapacity * sizeof(ProfileRecord)),
+               indexCapacity);
+    header->indexCapacity = indexCapacity;
+    header->recordCapacity = recordCapacity;
+    return 0;
+}
+
+// An earlier version: its records are a prefix of today's, since fields are
+// only ever appended to ProfileRecord
+static int isOlderVersion(ProfileStore *store) {
+    const ProfileStoreHeader *header = storeHeader(store);
+    return store->size >= sizeof(ProfileStoreHeader) &&
+           memcmp(header->magic, PROFILE_STORE_MAGIC, sizeof(PROFILE_STORE_MAGIC)) == 0 &&
+           header->version < PROFILE_STORE_VERSION &&
+           header->recordSize >= PROFILE_NAME_LENGTH && header->recordSize < sizeof(ProfileRecord) &&
+           header->recordCount <= header->recordCapacity &&
+           header->recordCapacity < UINT32_MAX &&
+           header->indexCapacity == header->recordCapacity * 2 &&
+           sizeof(ProfileStoreHeader) + header->recordCount * header->recordSize <= store->size;
+}
+
+// Write the current form of an older store to path.tmp, new fields zeroed.
+// The caller swaps it in, so a crash leaves either the old file or the new one.
+static int writeUpgradedStore(ProfileStore *store, const char *tempPath) {
+    const ProfileStoreHeader *header = storeHeader(store);
+    const unsigned char *oldRecords = store->base + sizeof(ProfileStoreHeader);
+    ProfileStore upgraded = {0};
+    upgraded.size = storeSize(header->recordCapacity, header->indexCapacity);
+    upgraded.base = calloc(1, upgraded.size);
+    if (!upgraded.base) return -1;
+
+    ProfileStoreHeader *newHeader = storeHeader(&upgraded);
+    *newHeader = *header;
+    newHeader->version = PROFILE_STORE_VERSION;
+    newHeader->recordSize = sizeof(ProfileRecord);
+    ProfileRecord *records = storeRecords(&upgraded);
+    for (uint64_t i = 0; i < header->recordCount; i++) {
+        memcpy(&records[i], oldRecords + i * header->recordSize, header->recordSize);
+    }
+    buildIndex(&upgraded, storeIndex(&upgraded), newHeader->indexCapacity);
+
+    int failed = 0;
+    int fd = open(tempPath, TEMP_FLAGS, 0644);
+    if (fd < 0) {
+        failed = 1;
+    } else {
+        for (size_t written = 0; !failed && written < upgraded.size;) {
+            long n = (long)write(fd, upgraded.base + written, (unsigned int)(upgraded.size - written));
+            failed = n <= 0;
+            if (!failed) written += (size_t)n;
+        }
+#if PROFILE_STORE_WINDOWS
+        if (!failed) failed = !FlushFileBuffers((HANDLE)_get_osfhandle(fd));
+#else
+        if (!failed) failed = fsync(fd) != 0;
+#endif
+        failed |= close(fd) != 0;
+        if (failed) remove(tempPath);
+    }
+    free(upgraded.base);
+    return failed ? -1 : 0;
+}
+
+// Swap the upgraded copy in and let go of the old file. Windows cannot
+// replace a file that is still open, so there the lock is dropped first.
+static int replaceUpgradedStore(ProfileStore *store, const char *tempPath, const char *path) {
+    int failed;
+    unmapStore(store);
+#if PROFILE_STORE_WINDOWS
+    unlockFile(store->fd);
+    close(store->fd);
+    failed = !MoveFileExA(tempPath, path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+    failed = rename(tempPath, path) != 0;
+    unlockFile(store->fd);
+    close(store->fd);
+#endif
+    if (failed) remove(tempPath);
+    store->fd = -1;
+    return failed ? -1 : 0;
+}
+
+// Whether another process swapped in an upgraded file while this one waited
+// for the lock on the old one
+static int replacedWhileWaiting(int fd, const char *path) {
+#if PROFILE_STORE_WINDOWS
+    (void)fd;
+    (void)path;
+    return 0;
+#else
+    struct stat opened, current;
+    return fstat(fd, &opened) == 0 && stat(path, &current) == 0 &&
+           (opened.st_ino != current.st_ino || opened.st_dev != current.st_dev);
+#endif
+}
+
+int openProfileStore(ProfileStore *store, const char *path) {
+    size_t directoryLength = strlen(path);
+    while (directoryLength > 0 && path[directoryLength - 1] != '/' && path[directoryLength - 1] != '\\') {
+        directoryLength--;
+    }
+    if (directoryLength >= sizeof(store->directory)) {
+        fprintf(stderr, "Error: Path too long: %s\n", path);
+        return -1;
+    }
+    char tempPath[256];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+    for (int attempt = 0;; attempt++) {
+        memset(store, 0, sizeof(*store));
+        store->fd = open(path, OPEN_FLAGS, 0644);
+        if (store->fd < 0) {
+            perror(path);
+            return -1;
+        }
+        if (lockFile(store->fd, 1) != 0) {
+            perror(path);
+            close(store->fd);
+            return -1;
+        }
+        if (replacedWhileWaiting(store->fd, path) && attempt < 3) {
+            unlockFile(store->fd);
+            close(store->fd);
+            continue;
+        }
+        long long size = fileSize(store->fd);
+        int failed = size < 0;
+        if (!failed && size == 0) {
+            failed = initializeStore(store) != 0;
+        } else if (!failed) {
+            failed = mapStore(store, (size_t)size) != 0;
+            if (!failed && isOlderVersion(store) && attempt < 3) {
+                // Reopen whatever is there now: the upgrade, or another process's
+                if (writeUpgradedStore(store, tempPath) == 0 && replaceUpgradedStore(store, tempPath, path) == 0) {
+                    continue;
+                }
+                if (store->fd >= 0) unlockFile(store->fd);
+                fprintf(stderr, "Error upgrading '%s'\n", path);
+                closeProfileStore(store);
+                return -1;
+            }
+            failed = failed || !validHeader(store);
+            // A crash before the header was finished leaves nothing worth keeping
+            if (failed && store->base && storeHeader(store)->magic[0] == '\0') {
+                failed = initializeStore(store) != 0;
+            }
+        }
+        unlockFile(store->fd);
+        if (failed) {
+            fprintf(stderr, "Error: '%s' is not a valid profile store\n", path);
+            closeProfileStore(store);
+            return -1;
+        }
+        memcpy(store->directory, path, directoryLength);
+        store->directory[directoryLength] = '\0';
+        return 0;
+    }
+}
+
+int syncProfileStore(ProfileStore *store) {
+    if (!store->base) return -1;
+#if PROFILE_STORE_WINDOWS
+    if (!FlushViewOfFile(store->base, store->size)) return -1;
+    return FlushFileBuffers((HANDLE)_get_osfhandle(store->fd)) ? 0 : -1;
+#else
+    return msync(store->base, store->size, MS_SYNC) == 0 ? 0 : -1;
+#endif
+}
+
+void closeProfileStore(ProfileStore *store) {
+    if (store->locked) unlockProfileStore(store);
+    unmapStore(store);
+    if (store->fd > 0) close(store->fd);
+    memset(store, 0, sizeof(*store));
+}
+
+int lockProfileStore(ProfileStore *store, int exclusive) {
+    if (lockFile(store->fd, exclusive) != 0) return -1;
+    // Only growth changes the file size, so a size change means another
+    // process grew the store since this mapping was made
+    long long size = fileSize(store->fd);
+    if (size < 0 || ((size_t)size != store->size && mapStore(store, (size_t)size) != 0) || !validHeader(store)) {
+        unlockFile(store->fd);
+        return -1;
+    }
+    store->locked = exclusive ? 2 : 1;
+    return 0;
+}
+
+void unlockProfileStore(ProfileStore *store) {
+    store->locked = 0;
+    unlockFile(store->fd);
+}
+
+ProfileRecord *findProfileRecord(ProfileStore *store, const char *username, int create) {
+    if (!store->locked || !username[0]) return NULL;
+    ProfileStoreHeader *header = storeHeader(store);
+    ProfileRecord *records = storeRecords(store);
+    uint32_t *index = storeIndex(store);
+    uint64_t mask = header->indexCapacity - 1;
+    uint64_t slot = hashUsername(username) & mask;
+    while (index[slot]) {
+        uint32_t recordNumber = index[slot] - 1;
+        if (recordNumber < header->recordCount &&
+            strncmp(records[recordNumber].username, username, PROFILE_NAME_LENGTH) == 0) {
+            return &records[recordNumber];
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    if (!create || store->locked != 2 || strlen(username) >= PROFILE_NAME_LENGTH) return NULL;
+    if (header->recordCount == header->recordCapacity) {
+        if (growStore(store) != 0) return NULL;
+        return findProfileRecord(store, username, create);
+    }
+    ProfileRecord *record = &records[header->recordCount];
+    memset(record, 0, sizeof(*record));
+    strncpy(record->username, username, PROFILE_NAME_LENGTH - 1);
+    header->recordCount++;
+    index[slot] = (uint32_t)header->recordCount;
+    return record;
+}
+
+size_t profileRecordCount(const ProfileStore *store) {
+    return (size_t)((const ProfileStoreHeader *)store->base)->recordCount;
+}
+
+ProfileRecord *profileRecordAt(ProfileStore *store, size_t index) {
+    return index < profileRecordCount(store) ? &storeRecords(store)[index] : NULL;
+}
@@ -0,0 +1,85 @@
+#ifndef PROFILE_STORE_H
+#define PROFILE_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "keystroke_log.h"
+
+#define PROFILE_STORE_PATH "profiles.db"
+#define PROFILE_STORE_MAGIC "TTPROF1"
+#define PROFILE_STORE_VERSION 3
+#define PROFILE_NAME_LENGTH 56
+#define PROFILE_SECTION_LENGTH 24
+#define PROFILE_SHUFFLE_SECTIONS 10
+
+// profiles.db layout, all memory-mapped:
+//
+//   ProfileStoreHeader
+//   ProfileRecord[recordCapacity]      dense, in creation order
+//   uint32_t index[indexCapacity]      open-addressing hash of usernames,
+//                                      0 = empty, otherwise record number + 1
+//
+// Records never move, so growing the store only appends record space and
+// rebuilds the index behind it. Fields are only ever appended to a record,
+// and an older store (version 1 had no shuffle state, version 2 no keystroke
+// totals) is upgraded when it is opened.
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t recordCapacity;
+    uint64_t recordCount;
+    uint64_t indexCapacity;             // power of two, 2 x recordCapacity
+    uint64_t reserved[3];
+} ProfileStoreHeader;
+
+// Where a user is in their no-repeat pass over one corpus section
+typedef struct {
+    char section[PROFILE_SECTION_LENGTH];   // empty for an unused slot
+    uint64_t count;                         // paragraphs in the section when the pass began
+    uint64_t seed;
+    uint64_t position;
+} ProfileShuffle;
+
+typedef struct {
+    char username[PROFILE_NAME_LENGTH]; // sanitized, NUL-padded
+    double bestSpeed;
+    double bestAccuracy;
+    double totalSpeed;
+    double totalAccuracy;
+    int64_t totalAttempts;
+    ProfileShuffle shuffles[PROFILE_SHUFFLE_SECTIONS]; // most recently used first
+    KeystrokeTotals keystrokes;         // real-time attempts only
+} ProfileRecord;
+
+typedef struct {
+    int fd;
+    void *mappingHandle;                // Windows only
+    unsigned char *base;
+    size_t size;                        // of the current mapping
+    int locked;
+    char directory[200];            // where the legacy per-user files live
+} ProfileStore;
+
+int openProfileStore(ProfileStore *store, const char *path);
+void closeProfileStore(ProfileStore *store);
+// Write dirty pages of the mapping back to the file and wait for the disk
+int syncProfileStore(ProfileStore *store);
+
+// Every access happens under the store lock: shared for reading, exclusive
+// for changes. It also keeps out other threads of this process, which may
+// have opened the store separately. Locking picks up growth done by other
+// processes, so record pointers are only valid until the matching unlock.
+int lockProfileStore(ProfileStore *store, int exclusive);
+void unlockProfileStore(ProfileStore *store);
+
+// Look up a sanitized username. With create set (exclusive lock only) a
+// zeroed record is added when it is missing; that may grow the store and
+// invalidate earlier record pointers. Returns NULL if absent or on error.
+ProfileRecord *findProfileRecord(ProfileStore *store, const char *username, int create);
+
+size_t profileRecordCount(const ProfileStore *store);
+ProfileRecord *profileRecordAt(ProfileStore *store, size_t index);
+
+#endif
@@ -0,0 +1,643 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "progress_store.h"
+#include "file_lock.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__WINDOWS__)
+    #include <io.h>
+    #include <windows.h>
+    #define PROGRESS_STORE_WINDOWS 1
+    #define OPEN_FLAGS (_O_RDWR | _O_CREAT | _O_BINARY)
+    #define READ_FLAGS (_O_RDONLY | _O_BINARY)
+    #define fsync _commit
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+    #define PROGRESS_STORE_WINDOWS 0
+    #define OPEN_FLAGS (O_RDWR | O_CREAT)
+    #define READ_FLAGS O_RDONLY
+
+// fcntl locks belong to the process, so they do not keep this process's own
+// threads apart; every lock is also taken on this mutex
+static pthread_mutex_t threadLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+#define COLUMN_COUNT 6
+#define ROLLUP_READ_BATCH 64
+#define INITIAL_USER_CAPACITY 256
+#define INITIAL_ROLLUP_CAPACITY 16
+#define LEGACY_STORE_MAGIC "TTPROG1"
+
+// The per-user <user>_progress.db of older versions: this header, then
+// segments of a LegacySegmentHeader and the same columns as ours
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t segmentSamples;
+    uint64_t segmentCount;
+    uint64_t sampleCount;
+    uint64_t reserved[4];
+} LegacyFileHeader;
+
+typedef struct {
+    uint32_t count;
+    uint32_t reserved;
+    int64_t minTimestamp;
+    int64_t maxTimestamp;
+} LegacySegmentHeader;
+
+// Column order inside a segment: timestamp, CPM, WPM, accuracy, errors, difficulty
+static const size_t columnWidths[COLUMN_COUNT] = {
+    sizeof(int64_t), sizeof(float), sizeof(float), sizeof(float), sizeof(uint32_t), sizeof(uint8_t)
+};
+
+// The store lock, byte 0; on POSIX it also takes the thread mutex
+static int lockStore(ProgressStore *store, int exclusive) {
+#if !PROGRESS_STORE_WINDOWS
+    pthread_mutex_lock(&threadLock);
+#endif
+    if (lockFileByte(store->fd, 0, exclusive, 1) == 0) return 0;
+#if !PROGRESS_STORE_WINDOWS
+    pthread_mutex_unlock(&threadLock);
+#endif
+    return -1;
+}
+
+static void unlockStore(ProgressStore *store) {
+    unlockFileByte(store->fd, 0);
+#if !PROGRESS_STORE_WINDOWS
+    pthread_mutex_unlock(&threadLock);
+#endif
+}
+
+static long long fileSize(int fd) {
+#if PROGRESS_STORE_WINDOWS
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx((HANDLE)_get_osfhandle(fd), &size)) return -1;
+    return size.QuadPart;
+#else
+    struct stat info;
+    if (fstat(fd, &info) != 0) return -1;
+    return info.st_size;
+#endif
+}
+
+static int readAt(int fd, void *buffer, size_t length, int64_t offset) {
+    if (lseek(fd, (off_t)offset, SEEK_SET) < 0) return -1;
+    unsigned char *cursor = buffer;
+    while (length > 0) {
+        long got = (long)read(fd, cursor, (unsigned)length);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return -1;
+        cursor += got;
+        length -= (size_t)got;
+    }
+    return 0;
+}
+
+static int writeAt(int fd, const void *buffer, size_t length, int64_t offset) {
+    if (lseek(fd, (off_t)offset, SEEK_SET) < 0) return -1;
+    const unsigned char *cursor = buffer;
+    while (length > 0) {
+        long put = (long)write(fd, cursor, (unsigned)length);
+        if (put < 0 && errno == EINTR) continue;
+        if (put <= 0) return -1;
+        cursor += put;
+        length -= (size_t)put;
+    }
+    return 0;
+}
+
+static size_t rowWidth(void) {
+    size_t width = 0;
+    for (int c = 0; c < COLUMN_COUNT; c++) width += columnWidths[c];
+    return width;
+}
+
+static uint64_t segmentSize(void) {
+    return sizeof(ProgressSegmentHeader) + rowWidth() * PROGRESS_SEGMENT_SAMPLES;
+}
+
+// columns is where the segment's first column starts
+static int64_t columnOffset(int64_t columns, int column) {
+    for (int c = 0; c < column; c++) columns += (int64_t)(columnWidths[c] * PROGRESS_SEGMENT_SAMPLES);
+    return columns;
+}
+
+// The first count cells of columns from..COLUMN_COUNT-1 of one segment
+static int readColumns(int fd, int64_t columns, uint32_t count, int from, void *cells[COLUMN_COUNT]) {
+    for (int c = from; c < COLUMN_COUNT; c++) {
+        if (readAt(fd, cells[c], count * columnWidths[c], columnOffset(columns, c)) != 0) return -1;
+    }
+    return 0;
+}
+
+static int readHeader(ProgressStore *store, ProgressFileHeader *header) {
+    if (readAt(store->fd, header, sizeof(*header), 0) != 0) return -1;
+    return memcmp(header->magic, PROGRESS_STORE_MAGIC, sizeof(PROGRESS_STORE_MAGIC)) == 0 &&
+           header->version == PROGRESS_STORE_VERSION &&
+           header->segmentSamples == PROGRESS_SEGMENT_SAMPLES && header->userCapacity > 0 &&
+           (header->userCapacity & (header->userCapacity - 1)) == 0 ? 0 : -1;
+}
+
+static int writeHeader(ProgressStore *store, const ProgressFileHeader *header) {
+    return writeAt(store->fd, header, sizeof(*header), 0);
+}
+
+// Space at the end of the file. The header goes out first, so a crash
+// before the caller links the space in only leaks it.
+static int allocate(ProgressStore *store, ProgressFileHeader *header, uint64_t size, uint64_t *offset) {
+    *offset = header->end;
+    header->end += size;
+    return writeHeader(store, header);
+}
+
+static uint64_t hashUsername(const char *username) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; username[i]; i++) {
+        hash ^= (unsigned char)username[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static int64_t slotOffset(const ProgressFileHeader *header, uint64_t slot) {
+    return (int64_t)(header->userTable + slot * sizeof(ProgressUser));
+}
+
+// The header switches to the new table only once it is complete
+static int growUserTable(ProgressStore *store, ProgressFileHeader *header) {
+    uint64_t capacity = header->userCapacity * 2, mask = capacity - 1, offset;
+    ProgressUser *oldUsers = malloc(header->userCapacity * sizeof(ProgressUser));
+    ProgressUser *users = calloc(capacity, sizeof(ProgressUser));
+    int status = -1;
+    if (oldUsers && users &&
+        readAt(store->fd, oldUsers, header->userCapacity * sizeof(ProgressUser), slotOffset(header, 0)) == 0) {
+        for (uint64_t i = 0; i < header->userCapacity; i++) {
+            if (!oldUsers[i].username[0]) continue;
+            uint64_t slot = hashUsername(oldUsers[i].username) & mask;
+            while (users[slot].username[0]) slot = (slot + 1) & mask;
+            users[slot] = oldUsers[i];
+        }
+        if (allocate(store, header, capacity * sizeof(ProgressUser), &offset) == 0 &&
+            writeAt(store->fd, users, capacity * sizeof(ProgressUser), (int64_t)offset) == 0) {
+            header->userTable = offset;
+            header->userCapacity = capacity;
+            status = writeHeader(store, header);
+        }
+    }
+    free(oldUsers);
+    free(users);
+    return status;
+}
+
+static int saveUser(ProgressStore *store, const ProgressFileHeader *header, int64_t slot, const ProgressUser *user) {
+    if (writeAt(store->fd, user, sizeof(*user), slot) != 0) return -1;
+    return writeHeader(store, header);
+}
+
+// First rollup of the user's array whose period starts at or after periodStart
+static int rollupLowerBound(int fd, const ProgressUser *user, ProgressPeriod period, int64_t periodStart,
+                            uint64_t *position) {
+    uint64_t low = 0, high = user->rollupCount[period];
+    while (low < high) {
+        uint64_t mid = low + (high - low) / 2;
+        int64_t start;
+        if (readAt(fd, &start, sizeof(start), (int64_t)(user->rollups[period] + mid * sizeof(ProgressRollup))) != 0) {
+            return -1;
+        }
+        if (start < periodStart) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    *position = low;
+    return 0;
+}
+
+static void foldSample(ProgressRollup *rollup, const ProgressSample *sample) {
+    rollup->attempts++;
+    rollup->errors += sample->errors;
+    rollup->totalSpeed += sample->typingSpeed;
+    rollup->totalWordsPerMinute += sample->wordsPerMinute;
+    rollup->totalAccuracy += sample->accuracy;
+    if (sample->typingSpeed > rollup->bestSpeed) rollup->bestSpeed = sample->typingSpeed;
+    if (sample->wordsPerMinute > rollup->bestWordsPerMinute) rollup->bestWordsPerMinute = sample->wordsPerMinute;
+    if (sample->accuracy > rollup->bestAccuracy) rollup->bestAccuracy = sample->accuracy;
+}
+
+static int growRollups(ProgressStore *store, ProgressFileHeader *header, ProgressUser *user, ProgressPeriod period) {
+    uint32_t count = user->rollupCount[period];
+    uint32_t capacity = user->rollupCapacity[period] ? user->rollupCapacity[period] * 2 : INITIAL_ROLLUP_CAPACITY;
+    ProgressRollup *rollups = malloc((count ? count : 1) * sizeof(ProgressRollup));
+    uint64_t offset;
+    int status = rollups &&
+                 readAt(store->fd, rollups, count * sizeof(ProgressRollup), (int64_t)user->rollups[period]) == 0 &&
+                 allocate(store, header, capacity * sizeof(ProgressRollup), &offset) == 0 &&
+                 writeAt(store->fd, rollups, count * sizeof(ProgressRollup), (int64_t)offset) == 0 ? 0 : -1;
+    free(rollups);
+    if (status == 0) {
+        user->rollups[period] = offset;
+        user->rollupCapacity[period] = capacity;
+    }
+    return status;
+}
+
+// Attempts nearly always land in the newest period; an older one (clock
+// changes, imported history) is found by binary search or inserted in order
+static int updateRollup(ProgressStore *store, ProgressFileHeader *header, ProgressUser *user,
+                        ProgressPeriod period, const ProgressSample *sample) {
+    int64_t periodStart = progressPeriodStart(sample->timestamp, period);
+    uint64_t count = user->rollupCount[period];
+    uint64_t position = count;
+    ProgressRollup rollup;
+
+    if (count > 0) {
+        int64_t last = (int64_t)(user->rollups[period] + (count - 1) * sizeof(rollup));
+        if (readAt(store->fd, &rollup, sizeof(rollup), last) != 0) return -1;
+        if (rollup.periodStart >= periodStart &&
+            rollupLowerBound(store->fd, user, period, periodStart, &position) != 0) return -1;
+    }
+    if (position < count) {
+        int64_t at = (int64_t)(user->rollups[period] + position * sizeof(rollup));
+        if (readAt(store->fd, &rollup, sizeof(rollup), at) != 0) return -1;
+        if (rollup.periodStart == periodStart) {
+            foldSample(&rollup, sample);
+            return writeAt(store->fd, &rollup, sizeof(rollup), at);
+        }
+    }
+    if (count == user->rollupCapacity[period] && growRollups(store, header, user, period) != 0) return -1;
+    int64_t base = (int64_t)user->rollups[period];
+    for (uint64_t i = count; i > position; i--) {
+        if (readAt(store->fd, &rollup, sizeof(rollup), base + (int64_t)((i - 1) * sizeof(rollup))) != 0 ||
+            writeAt(store->fd, &rollup, sizeof(rollup), base + (int64_t)(i * sizeof(rollup))) != 0) return -1;
+    }
+    memset(&rollup, 0, sizeof(rollup));
+    rollup.periodStart = periodStart;
+    foldSample(&rollup, sample);
+    if (writeAt(store->fd, &rollup, sizeof(rollup), base + (int64_t)(position * sizeof(rollup))) != 0) return -1;
+    user->rollupCount[period]++;
+    return 0;
+}
+
+// The user's slot is written by the caller once the whole batch is in
+static int appendSample(ProgressStore *store, ProgressFileHeader *header, ProgressUser *user,
+                        const ProgressSample *sample) {
+    ProgressSegmentHeader segment;
+    uint64_t offset = user->lastSegment;
+    memset(&segment, 0, sizeof(segment));
+    if (offset != 0 && readAt(store->fd, &segment, sizeof(segment), (int64_t)offset) != 0) return -1;
+    if (offset == 0 || segment.count >= PROGRESS_SEGMENT_SAMPLES) {
+        memset(&segment, 0, sizeof(segment));
+        segment.previous = user->lastSegment;
+        if (allocate(store, header, segmentSize(), &offset) != 0) return -1;
+    }
+
+    // The cells first, then the segment count, then the user's slot: a crash
+    // in between leaves the sample invisible rather than half written
+    const void *cells[COLUMN_COUNT] = {
+        &sample->timestamp, &sample->typingSpeed, &sample->wordsPerMinute,
+        &sample->accuracy, &sample->errors, &sample->difficulty
+    };
+    int64_t columns = (int64_t)(offset + sizeof(segment));
+    for (int c = 0; c < COLUMN_COUNT; c++) {
+        if (writeAt(store->fd, cells[c], columnWidths[c],
+                    columnOffset(columns, c) + (int64_t)(segment.count * columnWidths[c])) != 0) return -1;
+    }
+    if (segment.count == 0 || sample->timestamp < segment.minTimestamp) segment.minTimestamp = sample->timestamp;
+    if (segment.count == 0 || sample->timestamp > segment.maxTimestamp) segment.maxTimestamp = sample->timestamp;
+    segment.count++;
+    if (writeAt(store->fd, &segment, sizeof(segment), (int64_t)offset) != 0) return -1;
+
+    user->lastSegment = offset;
+    user->sampleCount++;
+    header->sampleCount++;
+    if (updateRollup(store, header, user, PROGRESS_DAILY, sample) != 0) return -1;
+    return updateRollup(store, header, user, PROGRESS_WEEKLY, sample);
+}
+
+static void legacyPath(const ProgressStore *store, const char *username, const char *suffix, char *path,
+                       size_t size) {
+    snprintf(path, size, "%s%s_progress%s", store->directory, username, suffix);
+}
+
+static int hasLegacyHistory(const ProgressStore *store, const char *username) {
+    char path[320];
+    struct stat info;
+    legacyPath(store, username, ".db", path, sizeof(path));
+    return stat(path, &info) == 0;
+}
+
+// Replay a new user's <user>_progress.db into their slot and delete the old
+// files; the rollups are rebuilt from the attempts on the way in
+static int importLegacyHistory(ProgressStore *store, ProgressFileHeader *header, int64_t slot, ProgressUser *user) {
+    char path[320];
+    legacyPath(store, user->username, ".db", path, sizeof(path));
+    int fd = open(path, READ_FLAGS);
+    if (fd < 0) return errno == ENOENT ? 0 : -1;
+
+    LegacyFileHeader legacy;
+    int64_t timestamps[PROGRESS_SEGMENT_SAMPLES];
+    float speeds[PROGRESS_SEGMENT_SAMPLES], wordsPerMinute[PROGRESS_SEGMENT_SAMPLES];
+    float accuracies[PROGRESS_SEGMENT_SAMPLES];
+    uint32_t errors[PROGRESS_SEGMENT_SAMPLES];
+    uint8_t difficulties[PROGRESS_SEGMENT_SAMPLES];
+    void *cells[COLUMN_COUNT] = {timestamps, speeds, wordsPerMinute, accuracies, errors, difficulties};
+    int status = readAt(fd, &legacy, sizeof(legacy), 0) == 0 &&
+                 memcmp(legacy.magic, LEGACY_STORE_MAGIC, sizeof(LEGACY_STORE_MAGIC)) == 0 &&
+                 legacy.version == 1 && legacy.segmentSamples == PROGRESS_SEGMENT_SAMPLES ? 0 : -1;
+
+    for (uint64_t s = 0; status == 0 && s < legacy.segmentCount; s++) {
+        LegacySegmentHeader segment;
+        int64_t offset = (int64_t)(sizeof(legacy) +
+                                   s * (sizeof(segment) + rowWidth() * PROGRESS_SEGMENT_SAMPLES));
+        if (readAt(fd, &segment, sizeof(segment), offset) != 0 || segment.count > PROGRESS_SEGMENT_SAMPLES ||
+            readColumns(fd, offset + (int64_t)sizeof(segment), segment.count, 0, cells) != 0) {
+            status = -1;
+            break;
+        }
+        for (uint32_t i = 0; i < segment.count && status == 0; i++) {
+            ProgressSample sample = {timestamps[i], speeds[i], wordsPerMinute[i], accuracies[i], errors[i],
+                                     difficulties[i]};
+            status = appendSample(store, header, user, &sample);
+        }
+    }
+    close(fd);
+    if (status == 0) status = saveUser(store, header, slot, user);
+    if (status != 0) {
+        fprintf(stderr, "Error: Could not import '%s' into the progress store\n", path);
+        return 0;
+    }
+    remove(path);
+    legacyPath(store, user->username, ".daily", path, sizeof(path));
+    remove(path);
+    legacyPath(store, user->username, ".weekly", path, sizeof(path));
+    remove(path);
+    return 0;
+}
+
+// 0 with the user's slot, 1 when there is none and create is unset
+static int findUser(ProgressStore *store, ProgressFileHeader *header, const char *username, int create,
+                    int64_t *slot, ProgressUser *user) {
+    if (!username[0] || strlen(username) >= PROGRESS_NAME_LENGTH) return -1;
+    uint64_t mask = header->userCapacity - 1;
+    uint64_t probe = hashUsername(username) & mask;
+    for (;; probe = (probe + 1) & mask) {
+        if (readAt(store->fd, user, sizeof(*user), slotOffset(header, probe)) != 0) return -1;
+        if (!user->username[0]) break;
+        if (strncmp(user->username, username, PROGRESS_NAME_LENGTH) == 0) {
+            *slot = slotOffset(header, probe);
+            return 0;
+        }
+    }
+    if (!create) return 1;
+
+    if ((header->userCount + 1) * 4 > header->userCapacity * 3) {
+        if (growUserTable(store, header) != 0) return -1;
+        return findUser(store, header, username, create, slot, user);
+    }
+    memset(user, 0, sizeof(*user));
+    strncpy(user->username, username, PROGRESS_NAME_LENGTH - 1);
+    *slot = slotOffset(header, probe);
+    header->userCount++;
+    if (saveUser(store, header, *slot, user) != 0) return -1;
+    return importLegacyHistory(store, header, *slot, user);
+}
+
+int64_t progressPeriodStart(int64_t timestamp, ProgressPeriod period) {
+    time_t when = (time_t)timestamp;
+    struct tm *local = localtime(&when);
+    if (!local) return timestamp;
+    struct tm start = *local;
+    if (period == PROGRESS_WEEKLY) start.tm_mday -= (start.tm_wday + 6) % 7;
+    start.tm_hour = start.tm_min = start.tm_sec = 0;
+    start.tm_isdst = -1;
+    return (int64_t)mktime(&start);
+}
+
+static int initializeStore(ProgressStore *store) {
+    ProgressFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PROGRESS_STORE_MAGIC, sizeof(PROGRESS_STORE_MAGIC));
+    header.version = PROGRESS_STORE_VERSION;
+    header.segmentSamples = PROGRESS_SEGMENT_SAMPLES;
+    header.userCapacity = INITIAL_USER_CAPACITY;
+    header.userTable = sizeof(header);
+    header.end = header.userTable + INITIAL_USER_CAPACITY * sizeof(ProgressUser);
+
+    // Every slot reads as free, so the table is written out in full
+    ProgressUser *users = calloc(INITIAL_USER_CAPACITY, sizeof(ProgressUser));
+    int status = users && writeAt(store->fd, users, INITIAL_USER_CAPACITY * sizeof(ProgressUser),
+                                  (int64_t)header.userTable) == 0 ? writeHeader(store, &header) : -1;
+    free(users);
+    return status;
+}
+
+int openProgressStore(ProgressStore *store, const char *path) {
+    size_t length = strlen(path);
+    while (length > 0 && path[length - 1] != '/' && path[length - 1] != '\\') length--;
+    store->fd = -1;
+    if (length >= sizeof(store->directory)) {
+        fprintf(stderr, "Error: Path too long: %s\n", path);
+        return -1;
+    }
+    memcpy(store->directory, path, length);
+    store->directory[length] = '\0';
+
+    store->fd = open(path, OPEN_FLAGS, 0644);
+    if (store->fd < 0 || lockStore(store, 1) != 0) {
+        perror(path);
+        closeProgressStore(store);
+        return -1;
+    }
+    ProgressFileHeader header;
+    long long size = fileSize(store->fd);
+    int failed = size < 0 || (size == 0 ? initializeStore(store) : readHeader(store, &header)) != 0;
+    unlockStore(store);
+    if (failed) {
+        fprintf(stderr, "Error: '%s' is not a valid progress store\n", path);
+        closeProgressStore(store);
+        return -1;
+    }
+    return 0;
+}
+
+void closeProgressStore(ProgressStore *store) {
+    if (store->fd >= 0) close(store->fd);
+    store->fd = -1;
+}
+
+int appendProgressSample(ProgressStore *store, const char *username, const ProgressSample *sample) {
+    return appendProgressSamples(store, username, sample, 1);
+}
+
+int appendProgressSamples(ProgressStore *store, const char *username, const ProgressSample *samples,
+                          size_t count) {
+    ProgressFileHeader header;
+    ProgressUser user;
+    int64_t slot;
+    if (lockStore(store, 1) != 0) return -1;
+    int status = readHeader(store, &header) == 0 && findUser(store, &header, username, 1, &slot, &user) == 0 ? 0 : -1;
+    for (size_t i = 0; i < count && status == 0; i++) status = appendSample(store, &header, &user, &samples[i]);
+    if (status == 0) status = saveUser(store, &header, slot, &user);
+    unlockStore(store);
+    return status;
+}
+
+int syncProgressStore(ProgressStore *store) {
+    return fsync(store->fd) != 0 ? -1 : 0;
+}
+
+static int growArray(void **items, size_t *capacity, size_t needed, size_t itemSize) {
+    if (needed <= *capacity) return 0;
+    size_t newCapacity = *capacity ? *capacity * 2 : 64;
+    while (newCapacity < needed) newCapacity *= 2;
+    void *grown = realloc(*items, newCapacity * itemSize);
+    if (!grown) return -1;
+    *items = grown;
+    *capacity = newCapacity;
+    return 0;
+}
+
+// Under the shared lock, or the exclusive one when the user's legacy files
+// have to be moved in first. Returns with the lock held only on success.
+static int beginRead(ProgressStore *store, const char *username, ProgressUser *user) {
+    ProgressFileHeader header;
+    int64_t slot;
+    if (lockStore(store, 0) != 0) return -1;
+    int found = readHeader(store, &header) == 0 ? findUser(store, &header, username, 0, &slot, user) : -1;
+    if (found == 1 && hasLegacyHistory(store, username)) {
+        unlockStore(store);
+        if (lockStore(store, 1) != 0) return -1;
+        found = readHeader(store, &header) == 0 ? findUser(store, &header, username, 1, &slot, user) : -1;
+    }
+    if (found != 0) {
+        unlockStore(store);
+        errno = found == 1 ? ENOENT : EIO;
+        return -1;
+    }
+    return 0;
+}
+
+// The chain runs newest first, so the segments are gathered and then read
+// oldest first. Only segments whose time bounds overlap the range are read,
+// and within those only the timestamp column unless something matches.
+static long collectSamples(ProgressStore *store, const ProgressUser *user, int64_t from, int64_t to,
+                           ProgressSample **samples) {
+    uint64_t *segments = NULL;
+    size_t segmentCount = 0, segmentCapacity = 0;
+    for (uint64_t offset = user->lastSegment; offset != 0;) {
+        ProgressSegmentHeader segment;
+        if (growArray((void **)&segments, &segmentCapacity, segmentCount + 1, sizeof(uint64_t)) != 0 ||
+            readAt(store->fd, &segment, sizeof(segment), (int64_t)offset) != 0 || segment.previous >= offset) {
+            free(segments);
+            return -1;
+        }
+        segments[segmentCount++] = offset;
+        offset = segment.previous;
+    }
+
+    int64_t timestamps[PROGRESS_SEGMENT_SAMPLES];
+    float speeds[PROGRESS_SEGMENT_SAMPLES], wordsPerMinute[PROGRESS_SEGMENT_SAMPLES];
+    float accuracies[PROGRESS_SEGMENT_SAMPLES];
+    uint32_t errors[PROGRESS_SEGMENT_SAMPLES];
+    uint8_t difficulties[PROGRESS_SEGMENT_SAMPLES];
+    void *cells[COLUMN_COUNT] = {timestamps, speeds, wordsPerMinute, accuracies, errors, difficulties};
+    size_t count = 0, capacity = 0;
+    long status = 0;
+
+    for (size_t s = segmentCount; s-- > 0 && status == 0;) {
+        ProgressSegmentHeader segment;
+        int64_t columns = (int64_t)(segments[s] + sizeof(segment));
+        if (readAt(store->fd, &segment, sizeof(segment), (int64_t)segments[s]) != 0) {
+            status = -1;
+            break;
+        }
+        if (segment.count == 0 || segment.count > PROGRESS_SEGMENT_SAMPLES ||
+            segment.maxTimestamp < from || segment.minTimestamp >= to) continue;
+
+        if (readAt(store->fd, timestamps, segment.count * sizeof(int64_t), columns) != 0) {
+            status = -1;
+            break;
+        }
+        size_t matches = 0;
+        for (uint32_t i = 0; i < segment.count; i++) {
+            if (timestamps[i] >= from && timestamps[i] < to) matches++;
+        }
+        if (matches == 0) continue;
+        if (readColumns(store->fd, columns, segment.count, 1, cells) != 0 ||
+            growArray((void **)samples, &capacity, count + matches, sizeof(ProgressSample)) != 0) {
+            status = -1;
+            break;
+        }
+        for (uint32_t i = 0; i < segment.count; i++) {
+            if (timestamps[i] < from || timestamps[i] >= to) continue;
+            ProgressSample *sample = &(*samples)[count++];
+            memset(sample, 0, sizeof(*sample));
+            sample->timestamp = timestamps[i];
+            sample->typingSpeed = speeds[i];
+            sample->wordsPerMinute = wordsPerMinute[i];
+            sample->accuracy = accuracies[i];
+            sample->errors = errors[i];
+            sample->difficulty = difficulties[i];
+        }
+    }
+    free(segments);
+    return status == 0 ? (long)count : -1;
+}
+
+long readProgressSamples(ProgressStore *store, const char *username, int64_t from, int64_t to,
+                         ProgressSample **samples) {
+    ProgressUser user;
+    *samples = NULL;
+    if (beginRead(store, username, &user) != 0) return -1;
+    long count = collectSamples(store, &user, from, to, samples);
+    unlockStore(store);
+    if (count < 0) {
+        free(*samples);
+        *samples = NULL;
+    }
+    return count;
+}
+
+static long collectRollups(ProgressStore *store, const ProgressUser *user, ProgressPeriod period, int64_t from,
+                           int64_t to, ProgressRollup **rollups) {
+    uint64_t total = user->rollupCount[period];
+    uint64_t position;
+    if (rollupLowerBound(store->fd, user, period, from, &position) != 0) return -1;
+
+    size_t count = 0, capacity = 0;
+    while (position < total) {
+        size_t batch = total - position < ROLLUP_READ_BATCH ? (size_t)(total - position) : ROLLUP_READ_BATCH;
+        if (growArray((void **)rollups, &capacity, count + batch, sizeof(ProgressRollup)) != 0 ||
+            readAt(store->fd, *rollups + count, batch * sizeof(ProgressRollup),
+                   (int64_t)(user->rollups[period] + position * sizeof(ProgressRollup))) != 0) return -1;
+        for (size_t i = 0; i < batch; i++) {
+            if ((*rollups)[count].periodStart >= to) return (long)count;
+            count++;
+        }
+        position += batch;
+    }
+    return (long)count;
+}
+
+long readProgressRollups(ProgressStore *store, const char *username, ProgressPeriod period,
+                         int64_t from, int64_t to, ProgressRollup **rollups) {
+    ProgressUser user;
+    *rollups = NULL;
+    if (beginRead(store, username, &user) != 0) return -1;
+    long count = collectRollups(store, &user, period, progressPeriodStart(from, period), to, rollups);
+    unlockStore(store);
+    if (count < 0) {
+        free(*rollups);
+        *rollups = NULL;
+    }
+    return count;
+}
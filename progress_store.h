@@ -0,0 +1,123 @@
+#ifndef PROGRESS_STORE_H
+#define PROGRESS_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PROGRESS_STORE_PATH "progress.db"
+#define PROGRESS_STORE_MAGIC "TTPROG2"
+#define PROGRESS_STORE_VERSION 2
+#define PROGRESS_SEGMENT_SAMPLES 256
+#define PROGRESS_NAME_LENGTH 56
+
+// Every user's attempt history in one file:
+//
+//   ProgressFileHeader
+//   user table   open-addressed ProgressUser slots hashed by username, moved
+//                to a table twice the size once three quarters full
+//   segments     PROGRESS_SEGMENT_SAMPLES attempts of one user: a
+//                ProgressSegmentHeader followed by one fixed-width column per
+//                field (timestamps, CPM, WPM, accuracy, errors, difficulty).
+//                A user's segments are chained newest first, so a range
+//                query skips whole segments by their time bounds and reads
+//                only the columns it needs.
+//   rollups      per user, one ProgressRollup array for local calendar days
+//                and one for weeks starting Monday, sorted by start and moved
+//                to an array twice the size when full
+//
+// Segments, tables and arrays are carved from the end of the file. The
+// rollups are kept current on every append, so charting months of history
+// never touches the individual attempts. History that older versions kept
+// in <user>_progress.db/.daily/.weekly is moved in the first time that user
+// is looked up.
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t segmentSamples;
+    uint64_t userCount;
+    uint64_t userCapacity;          // slots in the user table, a power of two
+    uint64_t userTable;             // file offset of the user table
+    uint64_t end;                   // where the next segment, table or array goes
+    uint64_t sampleCount;
+    uint64_t reserved[3];
+} ProgressFileHeader;
+
+typedef struct {
+    char username[PROGRESS_NAME_LENGTH];   // empty for a free slot
+    uint64_t sampleCount;
+    uint64_t lastSegment;           // file offset of the newest segment, 0 before the first
+    uint64_t rollups[2];            // file offsets of the daily and weekly arrays
+    uint32_t rollupCount[2];
+    uint32_t rollupCapacity[2];
+} ProgressUser;
+
+typedef struct {
+    uint32_t count;
+    uint32_t reserved;
+    int64_t minTimestamp;
+    int64_t maxTimestamp;
+    uint64_t previous;              // the user's preceding segment, 0 for the first
+} ProgressSegmentHeader;
+
+enum {
+    PROGRESS_EASY,
+    PROGRESS_MEDIUM,
+    PROGRESS_HARD,
+    PROGRESS_OTHER
+};
+
+typedef struct {
+    int64_t timestamp;              // Unix seconds
+    float typingSpeed;              // CPM
+    float wordsPerMinute;
+    float accuracy;
+    uint32_t errors;
+    uint8_t difficulty;             // PROGRESS_EASY ... PROGRESS_OTHER
+} ProgressSample;
+
+typedef enum {
+    PROGRESS_DAILY,
+    PROGRESS_WEEKLY
+} ProgressPeriod;
+
+typedef struct {
+    int64_t periodStart;            // local midnight starting the day or week
+    uint32_t attempts;
+    uint32_t errors;
+    double totalSpeed;
+    double totalWordsPerMinute;
+    double totalAccuracy;
+    double bestSpeed;
+    double bestWordsPerMinute;
+    double bestAccuracy;
+} ProgressRollup;
+
+typedef struct {
+    int fd;
+    char directory[200];            // where the legacy per-user files live
+} ProgressStore;
+
+// Creates the store if it does not exist yet
+int openProgressStore(ProgressStore *store, const char *path);
+void closeProgressStore(ProgressStore *store);
+
+// Add one attempt and fold it into its day and week, under an exclusive lock
+int appendProgressSample(ProgressStore *store, const char *username, const ProgressSample *sample);
+// Several attempts of one user under one lock, in order
+int appendProgressSamples(ProgressStore *store, const char *username, const ProgressSample *samples,
+                          size_t count);
+// Flush the store to stable storage
+int syncProgressStore(ProgressStore *store);
+
+// Attempts with from <= timestamp < to in the order they were recorded, and
+// rollups whose period starts in [period of from, to). The array is
+// malloc'd and owned by the caller. Return the count, or -1 on error with
+// errno ENOENT when the user has no history.
+long readProgressSamples(ProgressStore *store, const char *username, int64_t from, int64_t to,
+                         ProgressSample **samples);
+long readProgressRollups(ProgressStore *store, const char *username, ProgressPeriod period,
+                         int64_t from, int64_t to, ProgressRollup **rollups);
+
+int64_t progressPeriodStart(int64_t timestamp, ProgressPeriod period);
+
+#endif
@@ -0,0 +1,685 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "race.h"
+#include "session_server.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__WINDOWS__)
+    #include <windows.h>
+    #define RACE_WINDOWS 1
+#else
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <signal.h>
+    #include <sys/socket.h>
+    #include <time.h>
+    #include <unistd.h>
+    #define RACE_WINDOWS 0
+#endif
+
+#define RACE_HEADER_BYTES 3
+#define RACE_SEAT_INPUT_BYTES 512
+#define RACE_DRAIN_MS 1000
+
+enum {
+    RACE_MSG_JOIN = 'J',            // name
+    RACE_MSG_PROGRESS = 'P',        // position, errors
+    RACE_MSG_FINISH = 'F',          // position, errors
+    RACE_MSG_WELCOME = 'W',         // your id
+    RACE_MSG_RACER = 'N',           // id, name
+    RACE_MSG_GO = 'G',              // countdown ms, difficulty length, difficulty, text
+    RACE_MSG_TICK = 'T',            // tick, then per changed racer: id, flags, dpos, derrors[, finish ms]
+    RACE_MSG_END = 'E'
+};
+
+typedef struct {
+    unsigned char data[RACE_BUFFER_BYTES];
+    size_t length;
+} RaceMessage;
+
+// ---- Encoding ----
+
+static void beginMessage(RaceMessage *message, int type) {
+    message->data[0] = (unsigned char)type;
+    message->length = RACE_HEADER_BYTES;
+}
+
+static void putBytes(RaceMessage *message, const void *data, size_t length) {
+    if (message->length + length > sizeof(message->data)) return;
+    memcpy(message->data + message->length, data, length);
+    message->length += length;
+}
+
+static void putVarint(RaceMessage *message, uint64_t value) {
+    unsigned char bytes[10];
+    size_t n = 0;
+    do {
+        bytes[n] = value & 0x7F;
+        value >>= 7;
+        if (value) bytes[n] |= 0x80;
+        n++;
+    } while (value);
+    putBytes(message, bytes, n);
+}
+
+static void putDelta(RaceMessage *message, uint32_t from, uint32_t to) {
+    int64_t delta = (int64_t)to - (int64_t)from;
+    putVarint(message, delta < 0 ? ((uint64_t)(-delta) << 1) - 1 : (uint64_t)delta << 1);
+}
+
+static void endMessage(RaceMessage *message) {
+    size_t payload = message->length - RACE_HEADER_BYTES;
+    message->data[1] = payload & 0xFF;
+    message->data[2] = (payload >> 8) & 0xFF;
+}
+
+static int getVarint(const unsigned char **cursor, const unsigned char *end, uint64_t *value) {
+    *value = 0;
+    for (int shift = 0; *cursor < end && shift < 64; shift += 7) {
+        unsigned char byte = *(*cursor)++;
+        *value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return 0;
+    }
+    return -1;
+}
+
+static int getDelta(const unsigned char **cursor, const unsigned char *end, uint32_t *value) {
+    uint64_t zigzag;
+    if (getVarint(cursor, end, &zigzag) != 0) return -1;
+    int64_t delta = (zigzag & 1) ? -(int64_t)((zigzag + 1) >> 1) : (int64_t)(zigzag >> 1);
+    *value = (uint32_t)((int64_t)*value + delta);
+    return 0;
+}
+
+// Names are shown in other racers' terminals, so only printable ASCII
+static void copyRacerName(char *name, const unsigned char *data, size_t length) {
+    size_t n = 0;
+    for (size_t i = 0; i < length && n < RACE_NAME_LENGTH - 1; i++) {
+        if (data[i] >= 32 && data[i] <= 126) name[n++] = (char)data[i];
+    }
+    name[n] = '\0';
+    if (n == 0) strcpy(name, "racer");
+}
+
+int rankRacers(const RacerState *racers, int count, int *order) {
+    int ranked = 0;
+    for (int i = 0; i < count; i++) {
+        if (!(racers[i].flags & RACER_JOINED)) continue;
+        // Insertion sort: a race has a few dozen racers
+        int j = ranked++;
+        for (; j > 0; j--) {
+            const RacerState *a = &racers[i], *b = &racers[order[j - 1]];
+            int aDone = (a->flags & RACER_FINISHED) != 0, bDone = (b->flags & RACER_FINISHED) != 0;
+            int ahead = aDone != bDone ? aDone
+                        : aDone ? a->finishMs < b->finishMs
+                                : a->position > b->position;
+            if (!ahead) break;
+            order[j] = order[j - 1];
+        }
+        order[j] = i;
+    }
+    return ranked;
+}
+
+#if RACE_WINDOWS
+
+uint64_t raceClockMs(void) {
+    return GetTickCount64();
+}
+
+int runRaceCoordinator(const RaceConfig *config) {
+    (void)config;
+    fprintf(stderr, "Error: Race mode is not supported on Windows\n");
+    return -1;
+}
+
+int connectRaceClient(RaceClient *client, const char *address, const char *name) {
+    (void)name;
+    memset(client, 0, sizeof(*client));
+    client->fd = connectSessionAddress(address);
+    return -1;
+}
+
+int pumpRaceClient(RaceClient *client) {
+    (void)client;
+    return -1;
+}
+
+int waitRaceClient(RaceClient *client, int timeoutMs) {
+    (void)client;
+    (void)timeoutMs;
+    return -1;
+}
+
+int sendRaceProgress(RaceClient *client, uint32_t position, uint32_t errors, int finished) {
+    (void)client;
+    (void)position;
+    (void)errors;
+    (void)finished;
+    return -1;
+}
+
+void closeRaceClient(RaceClient *client) {
+    client->fd = -1;
+}
+
+#else
+
+uint64_t raceClockMs(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;
+}
+
+static int setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags < 0 ? -1 : fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+// Call handle for each whole message at the front of buffer and keep the
+// partial one; -1 if handle rejects one
+static int drainMessages(unsigned char *buffer, size_t *length, void *context,
+                         int (*handle)(void *context, int type, const unsigned char *payload, size_t payloadLength)) {
+    size_t offset = 0;
+    int status = 0;
+    while (*length - offset >= RACE_HEADER_BYTES) {
+        size_t payloadLength = buffer[offset + 1] | (size_t)buffer[offset + 2] << 8;
+        if (*length - offset < RACE_HEADER_BYTES + payloadLength) break;
+        if (handle(context, buffer[offset], buffer + offset + RACE_HEADER_BYTES, payloadLength) != 0) {
+            status = -1;
+            break;
+        }
+        offset += RACE_HEADER_BYTES + payloadLength;
+    }
+    memmove(buffer, buffer + offset, *length - offset);
+    *length -= offset;
+    return status;
+}
+
+// ---- Coordinator ----
+
+typedef struct {
+    int fd;
+    RacerState state;
+    RacerState sent;                // as of the last tick broadcast
+    size_t inputLength;
+    unsigned char input[RACE_SEAT_INPUT_BYTES];
+    size_t outputStart;
+    size_t outputLength;
+    unsigned char output[RACE_BUFFER_BYTES];
+} RaceSeat;
+
+typedef struct {
+    RaceSeat *seats;
+    int seatCount;                  // ids handed out so far; never reused
+    int joined;
+    int racing;
+    uint64_t firstJoin;
+    uint64_t startAt;
+    uint32_t textLength;
+    uint32_t tick;
+} RaceCoordinator;
+
+static volatile sig_atomic_t raceStopping;
+
+static void onRaceStopSignal(int signal) {
+    (void)signal;
+    raceStopping = 1;
+}
+
+static void dropSeat(RaceSeat *seat) {
+    if (seat->fd < 0) return;
+    close(seat->fd);
+    seat->fd = -1;
+    if (seat->state.flags & RACER_JOINED) seat->state.flags |= RACER_LEFT;
+}
+
+static void flushSeat(RaceSeat *seat) {
+    while (seat->fd >= 0 && seat->outputLength > 0) {
+        ssize_t n = write(seat->fd, seat->output + seat->outputStart, seat->outputLength);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+        if (n <= 0) {
+            dropSeat(seat);
+            return;
+        }
+        seat->outputStart += (size_t)n;
+        seat->outputLength -= (size_t)n;
+    }
+    seat->outputStart = 0;
+}
+
+// A racer whose terminal cannot keep up with the ticks is dropped rather
+// than buffered without bound
+static void sendToSeat(RaceSeat *seat, const RaceMessage *message) {
+    if (seat->fd < 0) return;
+    if (seat->outputStart + seat->outputLength + message->length > sizeof(seat->output)) {
+        memmove(seat->output, seat->output + seat->outputStart, seat->outputLength);
+        seat->outputStart = 0;
+    }
+    if (seat->outputLength + message->length > sizeof(seat->output)) {
+        dropSeat(seat);
+        return;
+    }
+    memcpy(seat->output + seat->outputStart + seat->outputLength, message->data, message->length);
+    seat->outputLength += message->length;
+    flushSeat(seat);
+}
+
+static void broadcast(RaceCoordinator *race, const RaceMessage *message, const RaceSeat *except) {
+    for (int i = 0; i < race->seatCount; i++) {
+        RaceSeat *seat = &race->seats[i];
+        if (seat != except && (seat->state.flags & RACER_JOINED)) sendToSeat(seat, message);
+    }
+}
+
+static void encodeRacer(RaceMessage *message, int id, const RacerState *racer) {
+    beginMessage(message, RACE_MSG_RACER);
+    putVarint(message, (uint64_t)id);
+    putBytes(message, racer->name, strlen(racer->name));
+    endMessage(message);
+}
+
+static void joinSeat(RaceCoordinator *race, RaceSeat *seat, const unsigned char *name, size_t length) {
+    int id = (int)(seat - race->seats);
+    copyRacerName(seat->state.name, name, length);
+    seat->state.flags = RACER_JOINED;
+    seat->sent = seat->state;
+    if (race->joined++ == 0) race->firstJoin = raceClockMs();
+
+    RaceMessage message;
+    beginMessage(&message, RACE_MSG_WELCOME);
+    putVarint(&message, (uint64_t)id);
+    endMessage(&message);
+    sendToSeat(seat, &message);
+    for (int i = 0; i < race->seatCount; i++) {
+        // Racers that already left show up through the next tick
+        if (!(race->seats[i].state.flags & RACER_JOINED)) continue;
+        encodeRacer(&message, i, &race->seats[i].state);
+        sendToSeat(seat, &message);
+    }
+    encodeRacer(&message, id, &seat->state);
+    broadcast(race, &message, seat);
+    fprintf(stderr, "%s joined (%d racers)\n", seat->state.name, race->joined);
+}
+
+typedef struct {
+    RaceCoordinator *race;
+    RaceSeat *seat;
+} SeatInput;
+
+static int handleSeatMessage(void *context, int type, const unsigned char *payload, size_t payloadLength) {
+    SeatInput *input = context;
+    RaceCoordinator *race = input->race;
+    RaceSeat *seat = input->seat;
+    RacerState *state = &seat->state;
+
+    if (type == RACE_MSG_JOIN) {
+        if (state->flags & RACER_JOINED) return -1;
+        if (race->racing) return -1;
+        joinSeat(race, seat, payload, payloadLength);
+        return 0;
+    }
+    if (type != RACE_MSG_PROGRESS && type != RACE_MSG_FINISH) return -1;
+    if (!(state->flags & RACER_JOINED)) return -1;
+
+    uint64_t position, errors;
+    const unsigned char *cursor = payload, *end = payload + payloadLength;
+    if (getVarint(&cursor, end, &position) != 0 || getVarint(&cursor, end, &errors) != 0) return -1;
+    // Progress sent during the countdown or after finishing is ignored
+    uint64_t now = raceClockMs();
+    if (!race->racing || now < race->startAt || (state->flags & RACER_FINISHED)) return 0;
+    state->position = position < race->textLength ? (uint32_t)position : race->textLength;
+    state->errors = errors < state->position ? (uint32_t)errors : state->position;
+    if (type == RACE_MSG_FINISH) {
+        state->flags |= RACER_FINISHED;
+        state->finishMs = (uint32_t)(now - race->startAt);
+    }
+    return 0;
+}
+
+static void readSeat(RaceCoordinator *race, RaceSeat *seat) {
+    for (;;) {
+        ssize_t n = read(seat->fd, seat->input + seat->inputLength, sizeof(seat->input) - seat->inputLength);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+        if (n <= 0) {
+            dropSeat(seat);
+            return;
+        }
+        seat->inputLength += (size_t)n;
+        SeatInput input = {race, seat};
+        if (drainMessages(seat->input, &seat->inputLength, &input, handleSeatMessage) != 0 ||
+            seat->inputLength == sizeof(seat->input)) {
+            dropSeat(seat);
+            return;
+        }
+    }
+}
+
+// One message with every racer that moved since the last tick
+static void broadcastTick(RaceCoordinator *race) {
+    RaceMessage message;
+    beginMessage(&message, RACE_MSG_TICK);
+    putVarint(&message, race->tick++);
+    int changed = 0;
+    for (int i = 0; i < race->seatCount; i++) {
+        RacerState *state = &race->seats[i].state, *sent = &race->seats[i].sent;
+        if (!(state->flags & RACER_JOINED)) continue;
+        if (state->position == sent->position && state->errors == sent->errors && state->flags == sent->flags) {
+            continue;
+        }
+        putVarint(&message, (uint64_t)i);
+        putVarint(&message, (uint64_t)state->flags);
+        putDelta(&message, sent->position, state->position);
+        putDelta(&message, sent->errors, state->errors);
+        if ((state->flags & RACER_FINISHED) && !(sent->flags & RACER_FINISHED)) {
+            putVarint(&message, state->finishMs);
+        }
+        *sent = *state;
+        changed++;
+    }
+    if (changed == 0) return;
+    endMessage(&message);
+    broadcast(race, &message, NULL);
+}
+
+static void startRace(RaceCoordinator *race, const RaceConfig *config) {
+    RaceMessage message;
+    beginMessage(&message, RACE_MSG_GO);
+    putVarint(&message, RACE_COUNTDOWN_MS);
+    size_t difficultyLength = strnlen(config->difficulty, RACE_DIFFICULTY_LENGTH - 1);
+    putVarint(&message, difficultyLength);
+    putBytes(&message, config->difficulty, difficultyLength);
+    putBytes(&message, config->text, race->textLength);
+    endMessage(&message);
+    race->racing = 1;
+    race->startAt = raceClockMs() + RACE_COUNTDOWN_MS;
+    broadcast(race, &message, NULL);
+    fprintf(stderr, "Race started with %d racers\n", race->joined);
+}
+
+// Every racer has finished or left
+static int raceOver(const RaceCoordinator *race) {
+    for (int i = 0; i < race->seatCount; i++) {
+        int flags = race->seats[i].state.flags;
+        if ((flags & RACER_JOINED) && !(flags & (RACER_FINISHED | RACER_LEFT))) return 0;
+    }
+    return 1;
+}
+
+static void acceptRacers(RaceCoordinator *race, int listenFd) {
+    for (;;) {
+        int fd = accept(listenFd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        // The lobby closes when the race starts
+        if (race->racing || race->seatCount == RACE_MAX_RACERS || setNonBlocking(fd) != 0) {
+            close(fd);
+            continue;
+        }
+        RaceSeat *seat = &race->seats[race->seatCount++];
+        seat->fd = fd;
+    }
+}
+
+// Give the last tick and the end message a moment to reach slow racers
+static void drainSeats(RaceCoordinator *race) {
+    uint64_t deadline = raceClockMs() + RACE_DRAIN_MS;
+    for (;;) {
+        int pending = 0;
+        for (int i = 0; i < race->seatCount; i++) {
+            flushSeat(&race->seats[i]);
+            if (race->seats[i].fd >= 0 && race->seats[i].outputLength > 0) pending = 1;
+        }
+        uint64_t now = raceClockMs();
+        if (!pending || now >= deadline) return;
+        poll(NULL, 0, 10);
+    }
+}
+
+static void printStandings(const RaceCoordinator *race) {
+    RacerState racers[RACE_MAX_RACERS];
+    int order[RACE_MAX_RACERS];
+    for (int i = 0; i < race->seatCount; i++) racers[i] = race->seats[i].state;
+    int ranked = rankRacers(racers, race->seatCount, order);
+    printf("Race results (%u characters):\n", race->textLength);
+    for (int i = 0; i < ranked; i++) {
+        const RacerState *racer = &racers[order[i]];
+        if (racer->flags & RACER_FINISHED) {
+            printf("%2d. %-*s %7.2fs  %u errors\n", i + 1, RACE_NAME_LENGTH - 1, racer->name,
+                   racer->finishMs / 1000.0, racer->errors);
+        } else {
+            printf("%2d. %-*s %u/%u characters  %u errors%s\n", i + 1, RACE_NAME_LENGTH - 1, racer->name,
+                   racer->position, race->textLength, racer->errors, (racer->flags & RACER_LEFT) ? "  (left)" : "");
+        }
+    }
+    fflush(stdout);
+}
+
+int runRaceCoordinator(const RaceConfig *config) {
+    RaceCoordinator race;
+    memset(&race, 0, sizeof(race));
+    int wanted = config->racers < 1 ? 1 : config->racers > RACE_MAX_RACERS ? RACE_MAX_RACERS : config->racers;
+    size_t textLength = strlen(config->text);
+    race.textLength = (uint32_t)(textLength < RACE_MAX_TEXT ? textLength : RACE_MAX_TEXT - 1);
+
+    int listenFd = openSessionListener(config->address, RACE_MAX_RACERS);
+    if (listenFd < 0) return -1;
+    race.seats = calloc(RACE_MAX_RACERS, sizeof(RaceSeat));
+    if (!race.seats) {
+        perror("Memory allocation error for racers");
+        close(listenFd);
+        return -1;
+    }
+    for (int i = 0; i < RACE_MAX_RACERS; i++) race.seats[i].fd = -1;
+
+    raceStopping = 0;
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onRaceStopSignal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    struct pollfd polls[RACE_MAX_RACERS + 1];
+    int pollSeats[RACE_MAX_RACERS + 1];
+    uint64_t nextTick = raceClockMs() + RACE_TICK_MS;
+    while (!raceStopping) {
+        uint64_t now = raceClockMs();
+        if (!race.racing && race.joined > 0 &&
+            (race.joined >= wanted || now >= race.firstJoin + (uint64_t)config->lobbySeconds * 1000)) {
+            startRace(&race, config);
+        }
+        if (now >= nextTick) {
+            broadcastTick(&race);
+            nextTick = now + RACE_TICK_MS;
+            if (race.racing && raceOver(&race)) break;
+        }
+
+        int count = 0;
+        polls[count].fd = listenFd;
+        polls[count].events = POLLIN;
+        pollSeats[count++] = -1;
+        for (int i = 0; i < race.seatCount; i++) {
+            RaceSeat *seat = &race.seats[i];
+            if (seat->fd < 0) continue;
+            polls[count].fd = seat->fd;
+            polls[count].events = POLLIN | (seat->outputLength > 0 ? POLLOUT : 0);
+            pollSeats[count++] = i;
+        }
+        if (poll(polls, (nfds_t)count, (int)(nextTick - now)) <= 0) continue;
+
+        for (int i = 0; i < count; i++) {
+            if (!polls[i].revents) continue;
+            if (pollSeats[i] < 0) {
+                acceptRacers(&race, listenFd);
+                continue;
+            }
+            RaceSeat *seat = &race.seats[pollSeats[i]];
+            if (polls[i].revents & POLLOUT) flushSeat(seat);
+            if (seat->fd >= 0 && (polls[i].revents & (POLLIN | POLLHUP | POLLERR))) readSeat(&race, seat);
+        }
+    }
+
+    broadcastTick(&race);
+    RaceMessage message;
+    beginMessage(&message, RACE_MSG_END);
+    endMessage(&message);
+    broadcast(&race, &message, NULL);
+    drainSeats(&race);
+    if (race.racing) printStandings(&race);
+
+    for (int i = 0; i < race.seatCount; i++) {
+        if (race.seats[i].fd >= 0) close(race.seats[i].fd);
+    }
+    free(race.seats);
+    close(listenFd);
+    if (strncmp(config->address, "unix:", 5) == 0) unlink(config->address + 5);
+    return 0;
+}
+
+// ---- Racer ----
+
+static int writeAll(int fd, const unsigned char *data, size_t length) {
+    while (length > 0) {
+        ssize_t n = write(fd, data, length);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            struct pollfd writable = {fd, POLLOUT, 0};
+            poll(&writable, 1, 100);
+            continue;
+        }
+        if (n <= 0) return -1;
+        data += n;
+        length -= (size_t)n;
+    }
+    return 0;
+}
+
+static int applyTick(RaceClient *client, const unsigned char *cursor, const unsigned char *end) {
+    uint64_t tick;
+    if (getVarint(&cursor, end, &tick) != 0) return -1;
+    while (cursor < end) {
+        uint64_t id, flags, finishMs;
+        if (getVarint(&cursor, end, &id) != 0 || getVarint(&cursor, end, &flags) != 0 || id >= RACE_MAX_RACERS) {
+            return -1;
+        }
+        RacerState *racer = &client->racers[id];
+        if (getDelta(&cursor, end, &racer->position) != 0 || getDelta(&cursor, end, &racer->errors) != 0) return -1;
+        if ((flags & RACER_FINISHED) && !(racer->flags & RACER_FINISHED)) {
+            if (getVarint(&cursor, end, &finishMs) != 0) return -1;
+            racer->finishMs = (uint32_t)finishMs;
+        }
+        racer->flags = (int)flags;
+        if ((int)id >= client->racerCount) client->racerCount = (int)id + 1;
+    }
+    return 0;
+}
+
+static int handleClientMessage(void *context, int type, const unsigned char *payload, size_t payloadLength) {
+    RaceClient *client = context;
+    const unsigned char *cursor = payload, *end = payload + payloadLength;
+    uint64_t value, length;
+    switch (type) {
+    case RACE_MSG_WELCOME:
+        if (getVarint(&cursor, end, &value) != 0 || value >= RACE_MAX_RACERS) return -1;
+        client->self = (int)value;
+        return 0;
+    case RACE_MSG_RACER:
+        if (getVarint(&cursor, end, &value) != 0 || value >= RACE_MAX_RACERS) return -1;
+        copyRacerName(client->racers[value].name, cursor, (size_t)(end - cursor));
+        client->racers[value].flags |= RACER_JOINED;
+        if ((int)value >= client->racerCount) client->racerCount = (int)value + 1;
+        return 0;
+    case RACE_MSG_GO:
+        if (getVarint(&cursor, end, &value) != 0 || getVarint(&cursor, end, &length) != 0 ||
+            length >= RACE_DIFFICULTY_LENGTH || length > (uint64_t)(end - cursor) ||
+            (size_t)(end - cursor) - length >= RACE_MAX_TEXT) {
+            return -1;
+        }
+        memcpy(client->difficulty, cursor, length);
+        client->difficulty[length] = '\0';
+        cursor += length;
+        memcpy(client->text, cursor, (size_t)(end - cursor));
+        client->text[end - cursor] = '\0';
+        client->startAt = raceClockMs() + value;
+        client->started = 1;
+        return 0;
+    case RACE_MSG_TICK:
+        return applyTick(client, cursor, end);
+    case RACE_MSG_END:
+        client->over = 1;
+        return 0;
+    default:
+        return -1;
+    }
+}
+
+int connectRaceClient(RaceClient *client, const char *address, const char *name) {
+    memset(client, 0, sizeof(*client));
+    client->self = -1;
+    signal(SIGPIPE, SIG_IGN);
+    client->fd = connectSessionAddress(address);
+    if (client->fd < 0) return -1;
+    if (setNonBlocking(client->fd) != 0) {
+        closeRaceClient(client);
+        return -1;
+    }
+    RaceMessage message;
+    beginMessage(&message, RACE_MSG_JOIN);
+    putBytes(&message, name, strnlen(name, RACE_NAME_LENGTH - 1));
+    endMessage(&message);
+    if (writeAll(client->fd, message.data, message.length) != 0) {
+        perror(address);
+        closeRaceClient(client);
+        return -1;
+    }
+    return 0;
+}
+
+int pumpRaceClient(RaceClient *client) {
+    if (client->fd < 0) return -1;
+    for (;;) {
+        ssize_t n = read(client->fd, client->input + client->inputLength, sizeof(client->input) - client->inputLength);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return 0;
+        if (n <= 0) return -1;
+        client->inputLength += (size_t)n;
+        if (drainMessages(client->input, &client->inputLength, client, handleClientMessage) != 0 ||
+            client->inputLength == sizeof(client->input)) {
+            return -1;
+        }
+    }
+}
+
+int waitRaceClient(RaceClient *client, int timeoutMs) {
+    if (client->fd < 0) return -1;
+    struct pollfd readable = {client->fd, POLLIN, 0};
+    if (poll(&readable, 1, timeoutMs) <= 0) return 0;
+    return pumpRaceClient(client);
+}
+
+int sendRaceProgress(RaceClient *client, uint32_t position, uint32_t errors, int finished) {
+    if (client->fd < 0) return -1;
+    if (!finished && position == client->sentPosition && errors == client->sentErrors) return 0;
+    RaceMessage message;
+    beginMessage(&message, finished ? RACE_MSG_FINISH : RACE_MSG_PROGRESS);
+    putVarint(&message, position);
+    putVarint(&message, errors);
+    endMessage(&message);
+    client->sentPosition = position;
+    client->sentErrors = errors;
+    return writeAll(client->fd, message.data, message.length);
+}
+
+void closeRaceClient(RaceClient *client) {
+    if (client->fd >= 0) close(client->fd);
+    client->fd = -1;
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef RACE_H
+#define RACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define RACE_MAX_RACERS 64
+#define RACE_NAME_LENGTH 32
+#define RACE_DIFFICULTY_LENGTH 20
+#define RACE_MAX_TEXT 4096
+#define RACE_TICK_MS 50
+#define RACE_COUNTDOWN_MS 3000
+#define RACE_BUFFER_BYTES 8192
+
+// Local multiplayer races. A coordinator hands every racer the same
+// paragraph; racers send it their position and error count at most once a
+// tick, and every RACE_TICK_MS it broadcasts one tick message holding only
+// the racers that changed since the last tick, as deltas. The tick is encoded
+// once and the same bytes go to every racer, so its size follows how many
+// racers typed during the tick, not how many are connected.
+//
+// Messages are "<type:1><payload length:2, little-endian><payload>"; numbers
+// in payloads are LEB128 varints, and tick deltas are zigzag-encoded.
+
+enum {
+    RACER_JOINED = 1,
+    RACER_FINISHED = 2,
+    RACER_LEFT = 4
+};
+
+typedef struct {
+    char name[RACE_NAME_LENGTH];
+    uint32_t position;
+    uint32_t errors;
+    uint32_t finishMs;              // since the start signal, once finished
+    int flags;
+} RacerState;
+
+typedef struct {
+    int fd;
+    int self;                       // our racer id, -1 until welcomed
+    int racerCount;                 // ids below this are in use
+    RacerState racers[RACE_MAX_RACERS];
+    int started;                    // the paragraph has arrived
+    int over;                       // the coordinator ended the race
+    uint64_t startAt;               // raceClockMs() when typing may begin
+    char difficulty[RACE_DIFFICULTY_LENGTH];
+    char text[RACE_MAX_TEXT];
+    uint32_t sentPosition;
+    uint32_t sentErrors;
+    size_t inputLength;
+    unsigned char input[RACE_BUFFER_BYTES];
+} RaceClient;
+
+typedef struct {
+    const char *address;            // as for --listen
+    int racers;                     // start as soon as this many have joined
+    int lobbySeconds;               // or this long after the first one joined
+    const char *difficulty;
+    const char *text;
+} RaceConfig;
+
+// Milliseconds on a monotonic clock
+uint64_t raceClockMs(void);
+
+// Run one race: lobby, countdown, race, then print the standings. Returns
+// once every racer has finished or left, or on SIGINT/SIGTERM.
+int runRaceCoordinator(const RaceConfig *config);
+
+int connectRaceClient(RaceClient *client, const char *address, const char *name);
+// Apply everything the coordinator has sent so far without blocking; -1 once
+// the connection is gone
+int pumpRaceClient(RaceClient *client);
+// Block up to timeoutMs for the coordinator, then pump
+int waitRaceClient(RaceClient *client, int timeoutMs);
+// Report progress, at most once a tick; unchanged progress is not resent.
+// The coordinator only keeps the latest, so typing between ticks coalesces.
+int sendRaceProgress(RaceClient *client, uint32_t position, uint32_t errors, int finished);
+void closeRaceClient(RaceClient *client);
+
+// Racer ids ordered by standing: finishers by time, then by position
+int rankRacers(const RacerState *racers, int count, int *order);
+
+#endif
@@ -0,0 +1,264 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "score_sketch.h"
+#include "file_lock.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__WINDOWS__)
+    #include <io.h>
+    #include <windows.h>
+    #define SCORE_SKETCH_WINDOWS 1
+    #define OPEN_FLAGS (_O_RDWR | _O_CREAT | _O_BINARY)
+    #define fsync _commit
+#else
+    #include <unistd.h>
+    #define SCORE_SKETCH_WINDOWS 0
+    #define OPEN_FLAGS (O_RDWR | O_CREAT)
+#endif
+
+#define SKETCH_HALF_BUCKETS (SCORE_SKETCH_SUB_BUCKETS / 2)
+#define SKETCH_MAX_UNITS ((1u << 21) - 1)
+
+// ---- Buckets ----
+
+// Values below SCORE_SKETCH_SUB_BUCKETS get a bucket each; above that, a
+// value whose top bit is b shares its bucket with 2^(b - 7) neighbours
+static uint32_t bucketForUnits(uint32_t units) {
+    if (units < SCORE_SKETCH_SUB_BUCKETS) return units;
+    int bit = 0;
+    while ((units >> (bit + 1)) != 0) bit++;
+    int shift = bit - 7;
+    return (uint32_t)shift * SKETCH_HALF_BUCKETS + (units >> shift);
+}
+
+static void bucketRange(uint32_t bucket, double *low, double *width) {
+    if (bucket < SCORE_SKETCH_SUB_BUCKETS) {
+        *low = bucket;
+        *width = 1;
+        return;
+    }
+    uint32_t shift = bucket / SKETCH_HALF_BUCKETS - 1;
+    uint32_t sub = bucket - shift * SKETCH_HALF_BUCKETS;
+    *low = (double)((uint64_t)sub << shift);
+    *width = (double)(1u << shift);
+}
+
+// Sketch units: hundredths of the score, or of 100 - accuracy
+static double toUnits(int metric, double value) {
+    if (metric == SCORE_SKETCH_ACCURACY) value = 100.0 - value;
+    double units = value * SCORE_SKETCH_SCALE;
+    if (!(units > 0)) return 0;
+    return units > SKETCH_MAX_UNITS ? SKETCH_MAX_UNITS : units;
+}
+
+static uint32_t bucketFor(int metric, double value) {
+    return bucketForUnits((uint32_t)toUnits(metric, value));
+}
+
+// Attempts below units, splitting the bucket that holds it evenly
+static double countBelowUnits(const ScoreSketch *sketch, double units) {
+    double below = 0;
+    for (uint32_t b = 0; b < SCORE_SKETCH_BUCKETS; b++) {
+        double low, width;
+        bucketRange(b, &low, &width);
+        if (units >= low + width) {
+            below += sketch->buckets[b];
+            continue;
+        }
+        if (units > low) below += sketch->buckets[b] * (units - low) / width;
+        break;
+    }
+    return below;
+}
+
+static double unitsAtCount(const ScoreSketch *sketch, double target) {
+    double seen = 0, low = 0, width = 0;
+    for (uint32_t b = 0; b < SCORE_SKETCH_BUCKETS; b++) {
+        if (sketch->buckets[b] == 0) continue;
+        bucketRange(b, &low, &width);
+        if (seen + sketch->buckets[b] >= target) return low + width * (target - seen) / sketch->buckets[b];
+        seen += sketch->buckets[b];
+    }
+    return low + width;
+}
+
+void addToScoreSketch(ScoreSketch *sketch, int metric, double value) {
+    uint32_t *bucket = &sketch->buckets[bucketFor(metric, value)];
+    if (*bucket < UINT32_MAX) (*bucket)++;
+    sketch->count++;
+}
+
+void mergeScoreSketch(ScoreSketch *into, const ScoreSketch *from) {
+    for (uint32_t b = 0; b < SCORE_SKETCH_BUCKETS; b++) {
+        uint64_t sum = (uint64_t)into->buckets[b] + from->buckets[b];
+        into->buckets[b] = sum > UINT32_MAX ? UINT32_MAX : (uint32_t)sum;
+    }
+    into->count += from->count;
+}
+
+double scoreSketchShareBelow(const ScoreSketch *sketch, int metric, double value) {
+    if (sketch->count == 0) return 0;
+    double below;
+    if (metric == SCORE_SKETCH_ACCURACY) {
+        // Less accurate means more error, above the value's own hundredth
+        below = (double)sketch->count - countBelowUnits(sketch, floor(toUnits(metric, value)) + 1);
+    } else {
+        below = countBelowUnits(sketch, toUnits(metric, value));
+    }
+    double share = below / (double)sketch->count;
+    return share < 0 ? 0 : share > 1 ? 1 : share;
+}
+
+double scoreSketchQuantile(const ScoreSketch *sketch, int metric, double q) {
+    if (sketch->count == 0) return 0;
+    if (q < 0) q = 0;
+    if (q > 1) q = 1;
+    if (metric == SCORE_SKETCH_ACCURACY) {
+        return 100.0 - unitsAtCount(sketch, (1 - q) * (double)sketch->count) / SCORE_SKETCH_SCALE;
+    }
+    return unitsAtCount(sketch, q * (double)sketch->count) / SCORE_SKETCH_SCALE;
+}
+
+// ---- File ----
+
+static int readAt(int fd, void *buffer, size_t length, int64_t offset) {
+    if (lseek(fd, (off_t)offset, SEEK_SET) < 0) return -1;
+    unsigned char *cursor = buffer;
+    while (length > 0) {
+        long got = (long)read(fd, cursor, (unsigned)length);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return -1;
+        cursor += got;
+        length -= (size_t)got;
+    }
+    return 0;
+}
+
+static int writeAt(int fd, const void *buffer, size_t length, int64_t offset) {
+    if (lseek(fd, (off_t)offset, SEEK_SET) < 0) return -1;
+    const unsigned char *cursor = buffer;
+    while (length > 0) {
+        long put = (long)write(fd, cursor, (unsigned)length);
+        if (put < 0 && errno == EINTR) continue;
+        if (put <= 0) return -1;
+        cursor += put;
+        length -= (size_t)put;
+    }
+    return 0;
+}
+
+static int64_t sketchOffset(int difficulty, int metric) {
+    return (int64_t)(sizeof(ScoreSketchHeader) +
+                     (size_t)(difficulty * SCORE_SKETCH_METRICS + metric) * sizeof(ScoreSketch));
+}
+
+static int64_t bucketOffset(int difficulty, int metric, uint32_t bucket) {
+    return sketchOffset(difficulty, metric) + (int64_t)(offsetof(ScoreSketch, buckets) + bucket * sizeof(uint32_t));
+}
+
+// A new file is the header and zeroed sketches; an existing one has to match
+// this build's bucket layout
+static int prepareStore(ScoreSketchStore *store, const char *path) {
+    ScoreSketchHeader header;
+    if (readAt(store->fd, &header, sizeof(header), 0) == 0) {
+        if (memcmp(header.magic, SCORE_SKETCH_MAGIC, sizeof(SCORE_SKETCH_MAGIC)) == 0 &&
+            header.version == SCORE_SKETCH_VERSION && header.bucketCount == SCORE_SKETCH_BUCKETS &&
+            header.difficulties == SCORE_SKETCH_DIFFICULTIES && header.metrics == SCORE_SKETCH_METRICS) {
+            return 0;
+        }
+        fprintf(stderr, "Error: %s is not a score sketch file for this version\n", path);
+        return -1;
+    }
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SCORE_SKETCH_MAGIC, sizeof(SCORE_SKETCH_MAGIC));
+    header.version = SCORE_SKETCH_VERSION;
+    header.bucketCount = SCORE_SKETCH_BUCKETS;
+    header.difficulties = SCORE_SKETCH_DIFFICULTIES;
+    header.metrics = SCORE_SKETCH_METRICS;
+    ScoreSketch *empty = calloc(1, sizeof(ScoreSketch));
+    if (!empty) return -1;
+    int status = writeAt(store->fd, &header, sizeof(header), 0);
+    for (int d = 0; d < SCORE_SKETCH_DIFFICULTIES && status == 0; d++) {
+        for (int m = 0; m < SCORE_SKETCH_METRICS && status == 0; m++) {
+            status = writeAt(store->fd, empty, sizeof(*empty), sketchOffset(d, m));
+        }
+    }
+    free(empty);
+    return status;
+}
+
+int openScoreSketchStore(ScoreSketchStore *store, const char *path) {
+    store->fd = open(path, OPEN_FLAGS, 0644);
+    if (store->fd < 0) return -1;
+    if (lockFileByte(store->fd, 0, 1, 1) != 0) {
+        closeScoreSketchStore(store);
+        return -1;
+    }
+    int status = prepareStore(store, path);
+    unlockFileByte(store->fd, 0);
+    if (status != 0) closeScoreSketchStore(store);
+    return status;
+}
+
+int syncScoreSketchStore(ScoreSketchStore *store) {
+    return fsync(store->fd) == 0 ? 0 : -1;
+}
+
+void closeScoreSketchStore(ScoreSketchStore *store) {
+    if (store->fd >= 0) close(store->fd);
+    store->fd = -1;
+}
+
+int recordScoreSample(ScoreSketchStore *store, int difficulty, const double values[SCORE_SKETCH_METRICS]) {
+    if (difficulty < 0 || difficulty >= SCORE_SKETCH_DIFFICULTIES || lockFileByte(store->fd, 0, 1, 1) != 0) return -1;
+    int status = 0;
+    for (int m = 0; m < SCORE_SKETCH_METRICS && status == 0; m++) {
+        int64_t offset = bucketOffset(difficulty, m, bucketFor(m, values[m]));
+        uint32_t bucket;
+        uint64_t count;
+        status = readAt(store->fd, &bucket, sizeof(bucket), offset);
+        if (status == 0 && bucket < UINT32_MAX) bucket++;
+        if (status == 0) status = writeAt(store->fd, &bucket, sizeof(bucket), offset);
+        if (status == 0) status = readAt(store->fd, &count, sizeof(count), sketchOffset(difficulty, m));
+        count++;
+        if (status == 0) status = writeAt(store->fd, &count, sizeof(count), sketchOffset(difficulty, m));
+    }
+    unlockFileByte(store->fd, 0);
+    return status;
+}
+
+int mergeScoreSketches(ScoreSketchStore *store, const ScoreSketch sketches[SCORE_SKETCH_DIFFICULTIES][SCORE_SKETCH_METRICS]) {
+    ScoreSketch *stored = malloc(sizeof(ScoreSketch));
+    if (!stored || lockFileByte(store->fd, 0, 1, 1) != 0) {
+        free(stored);
+        return -1;
+    }
+    int status = 0;
+    for (int d = 0; d < SCORE_SKETCH_DIFFICULTIES && status == 0; d++) {
+        for (int m = 0; m < SCORE_SKETCH_METRICS && status == 0; m++) {
+            if (sketches[d][m].count == 0) continue;
+            status = readAt(store->fd, stored, sizeof(*stored), sketchOffset(d, m));
+            if (status != 0) break;
+            mergeScoreSketch(stored, &sketches[d][m]);
+            status = writeAt(store->fd, stored, sizeof(*stored), sketchOffset(d, m));
+        }
+    }
+    unlockFileByte(store->fd, 0);
+    free(stored);
+    return status;
+}
+
+int readScoreSketch(ScoreSketchStore *store, int difficulty, int metric, ScoreSketch *sketch) {
+    if (difficulty < 0 || difficulty >= SCORE_SKETCH_DIFFICULTIES || metric < 0 || metric >= SCORE_SKETCH_METRICS ||
+        lockFileByte(store->fd, 0, 0, 1) != 0) {
+        return -1;
+    }
+    int status = readAt(store->fd, sketch, sizeof(*sketch), sketchOffset(difficulty, metric));
+    unlockFileByte(store->fd, 0);
+    return status;
+}
@@ -0,0 +1,66 @@
+#ifndef SCORE_SKETCH_H
+#define SCORE_SKETCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SCORE_SKETCH_PATH "score_sketches.db"
+#define SCORE_SKETCH_MAGIC "TTSKET1"
+#define SCORE_SKETCH_VERSION 1
+#define SCORE_SKETCH_SCALE 100              // values are bucketed in hundredths
+#define SCORE_SKETCH_SUB_BUCKETS 256        // per power of two: under 0.8% error
+#define SCORE_SKETCH_BUCKETS 1920           // up to 2^21 hundredths
+#define SCORE_SKETCH_DIFFICULTIES 4         // indexed like PROGRESS_EASY ... PROGRESS_OTHER
+
+enum {
+    SCORE_SKETCH_CPM,
+    SCORE_SKETCH_WPM,
+    SCORE_SKETCH_ACCURACY,
+    SCORE_SKETCH_METRICS
+};
+
+// Log-linear histogram in the style of HdrHistogram: exact below 2.56, then
+// SCORE_SKETCH_SUB_BUCKETS / 2 buckets per power of two, so any value is
+// placed within 0.8% in O(1). Sketches merge by adding counts. Accuracy is
+// kept as 100 - accuracy, so the precision goes where accuracies cluster.
+typedef struct {
+    uint64_t count;
+    uint32_t buckets[SCORE_SKETCH_BUCKETS];
+} ScoreSketch;
+
+// score_sketches.db is a ScoreSketchHeader followed by one ScoreSketch per
+// difficulty and metric, difficulty-major; about 90 KB however many
+// attempts it has seen.
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t bucketCount;
+    uint32_t difficulties;
+    uint32_t metrics;
+    uint64_t reserved[2];
+} ScoreSketchHeader;
+
+typedef struct {
+    int fd;
+} ScoreSketchStore;
+
+void addToScoreSketch(ScoreSketch *sketch, int metric, double value);
+void mergeScoreSketch(ScoreSketch *into, const ScoreSketch *from);
+// Share of recorded attempts that scored worse than value (slower, or less
+// accurate), from 0 to 1
+double scoreSketchShareBelow(const ScoreSketch *sketch, int metric, double value);
+// The score at quantile q (0 = worst, 1 = best)
+double scoreSketchQuantile(const ScoreSketch *sketch, int metric, double q);
+
+int openScoreSketchStore(ScoreSketchStore *store, const char *path);
+void closeScoreSketchStore(ScoreSketchStore *store);
+int syncScoreSketchStore(ScoreSketchStore *store);
+
+// One attempt, values indexed by metric; touches one bucket per metric under
+// an exclusive lock
+int recordScoreSample(ScoreSketchStore *store, int difficulty, const double values[SCORE_SKETCH_METRICS]);
+// Fold in sketches built elsewhere (a whole batch), one lock for all of them
+int mergeScoreSketches(ScoreSketchStore *store, const ScoreSketch sketches[SCORE_SKETCH_DIFFICULTIES][SCORE_SKETCH_METRICS]);
+int readScoreSketch(ScoreSketchStore *store, int difficulty, int metric, ScoreSketch *sketch);
+
+#endif
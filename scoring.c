@@ -0,0 +1,465 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scoring.h"
+
+#define WORD_BITS 64
+#define HIGH_BIT ((uint64_t)1 << (WORD_BITS - 1))
+// Patterns at least this long are scored inside a widening diagonal band
+#define BANDED_MIN_LENGTH 2048
+
+void initScoreWorkspace(ScoreWorkspace *ws) {
+    memset(ws, 0, sizeof(*ws));
+}
+
+void freeScoreWorkspace(ScoreWorkspace *ws) {
+    free(ws->peq);
+    free(ws->column);
+    initScoreWorkspace(ws);
+}
+
+static uint64_t *growWords(uint64_t *buf, size_t *capacity, size_t needed) {
+    if (needed <= *capacity) return buf;
+    size_t newCapacity = *capacity ? *capacity : 64;
+    while (newCapacity < needed) newCapacity *= 2;
+    buf = realloc(buf, newCapacity * sizeof(uint64_t));
+    if (!buf) {
+        perror("Memory allocation error for score workspace");
+        exit(EXIT_FAILURE);
+    }
+    *capacity = newCapacity;
+    return buf;
+}
+
+// One 64-row block of one DP column (Hyyro's formulation). hin is the
+// horizontal delta entering the top of the block; the return value is the
+// delta leaving the row selected by outBit.
+static inline int advanceBlock(uint64_t *pv, uint64_t *mv, uint64_t eq, int hin, uint64_t outBit) {
+    uint64_t Pv = *pv;
+    uint64_t Mv = *mv;
+    uint64_t hinNeg = (uint64_t)(hin < 0);
+    uint64_t Xv = eq | Mv;
+    eq |= hinNeg;
+    uint64_t Xh = (((eq & Pv) + Pv) ^ Pv) | eq;
+    uint64_t Ph = Mv | ~(Xh | Pv);
+    uint64_t Mh = Pv & Xh;
+    int hout = ((Ph & outBit) != 0) - ((Mh & outBit) != 0);
+    Ph = (Ph << 1) | (uint64_t)(hin > 0);
+    Mh = (Mh << 1) | hinNeg;
+    *pv = Mh | ~(Xv | Ph);
+    *mv = Ph & Xv;
+    return hout;
+}
+
+// Exact matching: every distinct pattern byte gets its own symbol.
+static size_t buildSymbolsExact(unsigned char symbols[256], const unsigned char *p, size_t m) {
+    size_t count = 1;
+    memset(symbols, 0, 256);
+    for (size_t i = 0; i < m; i++) {
+        if (!symbols[p[i]]) symbols[p[i]] = (unsigned char)count++;
+    }
+    return count;
+}
+
+// Case-insensitive matching: both cases of a letter share one symbol, so the
+// text loop needs no folding at all.
+static size_t buildSymbolsFolded(unsigned char symbols[256], const unsigned char *p, size_t m) {
+    size_t count = 1;
+    memset(symbols, 0, 256);
+    for (size_t i = 0; i < m; i++) {
+        unsigned char c = p[i];
+        if (symbols[c]) continue;
+        symbols[c] = (unsigned char)count;
+        if (c >= 'a' && c <= 'z') symbols[c - 'a' + 'A'] = (unsigned char)count;
+        else if (c >= 'A' && c <= 'Z') symbols[c - 'A' + 'a'] = (unsigned char)count;
+        count++;
+    }
+    return count;
+}
+
+// Patterns up to 64 characters fit in one machine word; the match table lives
+// on the stack.
+static size_t distanceSingleWord(const unsigned char symbols[256], size_t symbolCount,
+                                 const unsigned char *p, size_t m,
+                                 const unsigned char *t, size_t n) {
+    uint64_t peq[256];
+    memset(peq, 0, symbolCount * sizeof(uint64_t));
+    for (size_t i = 0; i < m; i++) peq[symbols[p[i]]] |= (uint64_t)1 << i;
+
+    uint64_t pv = ~(uint64_t)0;
+    uint64_t mv = 0;
+    uint64_t lastBit = (uint64_t)1 << (m - 1);
+    long score = (long)m;
+    for (size_t j = 0; j < n; j++) {
+        score += advanceBlock(&pv, &mv, peq[symbols[t[j]]], 1, lastBit);
+    }
+    return (size_t)score;
+}
+
+// Match masks for a pattern longer than one word, blocks words per symbol,
+// and the column for "no text yet" (every vertical delta +1).
+static void preparePattern(ScoreWorkspace *ws, const unsigned char symbols[256], size_t symbolCount,
+                           const unsigned char *p, size_t m, size_t blocks) {
+    ws->peq = growWords(ws->peq, &ws->peqCapacity, symbolCount * blocks);
+    ws->column = growWords(ws->column, &ws->columnCapacity, 2 * blocks);
+    memset(ws->peq, 0, symbolCount * blocks * sizeof(uint64_t));
+    for (size_t i = 0; i < m; i++) {
+        ws->peq[symbols[p[i]] * blocks + i / WORD_BITS] |= (uint64_t)1 << (i % WORD_BITS);
+    }
+    for (size_t b = 0; b < blocks; b++) {
+        ws->column[b] = ~(uint64_t)0;
+        ws->column[blocks + b] = 0;
+    }
+}
+
+// Advance blocks first..last by one text symbol; returns the delta leaving
+// the row selected by outBit in the last block.
+static inline int advanceColumn(uint64_t *pv, uint64_t *mv, const uint64_t *eq,
+                                size_t first, size_t last, uint64_t outBit) {
+    int carry = 1;
+    for (size_t b = first; b < last; b++) {
+        carry = advanceBlock(&pv[b], &mv[b], eq[b], carry, HIGH_BIT);
+    }
+    return advanceBlock(&pv[last], &mv[last], eq[last], carry, outBit);
+}
+
+static size_t distanceMultiWord(ScoreWorkspace *ws, const unsigned char symbols[256], size_t symbolCount,
+                                const unsigned char *p, size_t m,
+                                const unsigned char *t, size_t n) {
+    size_t blocks = (m + WORD_BITS - 1) / WORD_BITS;
+    preparePattern(ws, symbols, symbolCount, p, m, blocks);
+    uint64_t *pv = ws->column;
+    uint64_t *mv = ws->column + blocks;
+
+    uint64_t lastBit = (uint64_t)1 << ((m - 1) % WORD_BITS);
+    long score = (long)m;
+    for (size_t j = 0; j < n; j++) {
+        score += advanceColumn(pv, mv, ws->peq + symbols[t[j]] * blocks, 0, blocks - 1, lastBit);
+    }
+    return (size_t)score;
+}
+
+// Ukkonen's band: only the blocks that meet rows j-band..j+band are advanced
+// for text position j. Blocks below the band join lazily with every delta +1
+// and blocks above it are left behind with a +1 carry out of them; both only
+// ever overestimate cells outside the band. An optimal path of cost d never
+// leaves the diagonal by more than d, so a result <= band is exact.
+static size_t distanceBanded(ScoreWorkspace *ws, const unsigned char symbols[256], size_t symbolCount,
+                             const unsigned char *p, size_t m,
+                             const unsigned char *t, size_t n, size_t band) {
+    size_t blocks = (m + WORD_BITS - 1) / WORD_BITS;
+    preparePattern(ws, symbols, symbolCount, p, m, blocks);
+    uint64_t *pv = ws->column;
+    uint64_t *mv = ws->column + blocks;
+    uint64_t lastBit = (uint64_t)1 << ((m - 1) % WORD_BITS);
+
+    // score is the value at the bottom row of block last
+    size_t last = (band < m ? band : m - 1) / WORD_BITS;
+    long score = (long)((last + 1) * WORD_BITS < m ? (last + 1) * WORD_BITS : m);
+    for (size_t j = 1; j <= n; j++) {
+        size_t bottom = j + band < m ? j + band : m;
+        for (; last < (bottom - 1) / WORD_BITS; last++) {
+            score += (long)((last + 2) * WORD_BITS < m ? WORD_BITS : m - (last + 1) * WORD_BITS);
+        }
+        size_t first = j > band ? (j - band - 1) / WORD_BITS : 0;
+        if (first > last) first = last;
+        score += advanceColumn(pv, mv, ws->peq + symbols[t[j - 1]] * blocks, first, last,
+                               last == blocks - 1 ? lastBit : HIGH_BIT);
+    }
+    // Rows the band never reached cost one deletion each
+    return (size_t)score + (m - ((last + 1) * WORD_BITS < m ? (last + 1) * WORD_BITS : m));
+}
+
+size_t editDistance(ScoreWorkspace *ws, const char *pattern, size_t patternLen,
+                    const char *text, size_t textLen, int caseInsensitive) {
+    if (patternLen == 0) return textLen;
+    if (textLen == 0) return patternLen;
+
+    const unsigned char *p = (const unsigned char *)pattern;
+    const unsigned char *t = (const unsigned char *)text;
+    unsigned char symbols[256];
+    size_t symbolCount = caseInsensitive ? buildSymbolsFolded(symbols, p, patternLen)
+                                         : buildSymbolsExact(symbols, p, patternLen);
+
+    if (patternLen <= WORD_BITS) {
+        return distanceSingleWord(symbols, symbolCount, p, patternLen, t, textLen);
+    }
+    if (patternLen < BANDED_MIN_LENGTH) {
+        return distanceMultiWord(ws, symbols, symbolCount, p, patternLen, t, textLen);
+    }
+
+    // Long passages: start from a band just wide enough for the length
+    // difference and double it until the result proves itself exact.
+    size_t longer = patternLen > textLen ? patternLen : textLen;
+    size_t band = (patternLen > textLen ? patternLen - textLen : textLen - patternLen) + BANDED_MIN_LENGTH / 8;
+    for (;;) {
+        if (band >= longer) return distanceMultiWord(ws, symbols, symbolCount, p, patternLen, t, textLen);
+        size_t distance = distanceBanded(ws, symbols, symbolCount, p, patternLen, t, textLen, band);
+        if (distance <= band) return distance;
+        band *= 2;
+    }
+}
+
+void initStreamScorer(StreamScorer *scorer) {
+    memset(scorer, 0, sizeof(*scorer));
+    initScoreWorkspace(&scorer->ws);
+}
+
+void freeStreamScorer(StreamScorer *scorer) {
+    freeScoreWorkspace(&scorer->ws);
+    initStreamScorer(scorer);
+}
+
+void beginStreamScore(StreamScorer *scorer, const char *pattern, size_t patternLen, int caseInsensitive) {
+    const unsigned char *p = (const unsigned char *)pattern;
+    size_t symbolCount = caseInsensitive ? buildSymbolsFolded(scorer->symbols, p, patternLen)
+                                         : buildSymbolsExact(scorer->symbols, p, patternLen);
+    scorer->blocks = (patternLen + WORD_BITS - 1) / WORD_BITS;
+    scorer->lastBit = patternLen ? (uint64_t)1 << ((patternLen - 1) % WORD_BITS) : 0;
+    scorer->patternLength = patternLen;
+    scorer->textLength = 0;
+    scorer->score = (long)patternLen;
+    if (scorer->blocks) preparePattern(&scorer->ws, scorer->symbols, symbolCount, p, patternLen, scorer->blocks);
+}
+
+void streamScoreText(StreamScorer *scorer, const char *text, size_t textLen) {
+    const unsigned char *t = (const unsigned char *)text;
+    size_t blocks = scorer->blocks;
+    scorer->textLength += textLen;
+    if (blocks == 0) return;
+    uint64_t *pv = scorer->ws.column;
+    uint64_t *mv = scorer->ws.column + blocks;
+    long score = scorer->score;
+    for (size_t j = 0; j < textLen; j++) {
+        score += advanceColumn(pv, mv, scorer->ws.peq + scorer->symbols[t[j]] * blocks, 0, blocks - 1, scorer->lastBit);
+    }
+    scorer->score = score;
+}
+
+size_t streamScoreDistance(const StreamScorer *scorer) {
+    return scorer->blocks ? (size_t)scorer->score : scorer->textLength;
+}
+
+static void *growBuffer(void *buf, size_t *capacity, size_t needed, size_t elementSize) {
+    if (needed <= *capacity) return buf;
+    size_t newCapacity = *capacity ? *capacity : 64;
+    while (newCapacity < needed) newCapacity *= 2;
+    buf = realloc(buf, newCapacity * elementSize);
+    if (!buf) {
+        perror("Memory allocation error for edit script");
+        exit(EXIT_FAILURE);
+    }
+    *capacity = newCapacity;
+    return buf;
+}
+
+void initEditScript(EditScript *script) {
+    memset(script, 0, sizeof(*script));
+    initScoreWorkspace(&script->ws);
+}
+
+void freeEditScript(EditScript *script) {
+    free(script->ops);
+    free(script->forward);
+    free(script->reverse);
+    free(script->reversed);
+    free(script->cells);
+    freeScoreWorkspace(&script->ws);
+    initEditScript(script);
+}
+
+// Matches buildSymbolsFolded: only ASCII letters fold
+static unsigned char foldCase(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c - 'A' + 'a') : c;
+}
+
+static int sameChar(unsigned char a, unsigned char b, int caseInsensitive) {
+    return caseInsensitive ? foldCase(a) == foldCase(b) : a == b;
+}
+
+static void pushEdit(EditScript *script, char kind, unsigned char expected, unsigned char typed,
+                     size_t targetPos, size_t typedPos) {
+    script->ops = growBuffer(script->ops, &script->capacity, script->count + 1, sizeof(EditOp));
+    EditOp *op = &script->ops[script->count++];
+    op->kind = kind;
+    op->expected = (char)expected;
+    op->typed = (char)typed;
+    op->targetPos = targetPos;
+    op->typedPos = typedPos;
+    if (kind == EDIT_SUBSTITUTE) script->substitutions++;
+    else if (kind == EDIT_INSERT) script->insertions++;
+    else script->deletions++;
+}
+
+// rows[i] = distance between p[0..i) and all of t, for i = 0..m: the last DP
+// column, read off the vertical deltas Myers' algorithm leaves behind.
+static void prefixCosts(ScoreWorkspace *ws, const unsigned char *p, size_t m,
+                        const unsigned char *t, size_t n, int caseInsensitive, long *rows) {
+    rows[0] = (long)n;
+    if (m == 0) return;
+    unsigned char symbols[256];
+    size_t symbolCount = caseInsensitive ? buildSymbolsFolded(symbols, p, m) : buildSymbolsExact(symbols, p, m);
+    size_t blocks = (m + WORD_BITS - 1) / WORD_BITS;
+    preparePattern(ws, symbols, symbolCount, p, m, blocks);
+    uint64_t *pv = ws->column;
+    uint64_t *mv = ws->column + blocks;
+    for (size_t j = 0; j < n; j++) {
+        advanceColumn(pv, mv, ws->peq + symbols[t[j]] * blocks, 0, blocks - 1, HIGH_BIT);
+    }
+    for (size_t i = 1; i <= m; i++) {
+        size_t b = (i - 1) / WORD_BITS, bit = (i - 1) % WORD_BITS;
+        rows[i] = rows[i - 1] + (long)((pv[b] >> bit) & 1) - (long)((mv[b] >> bit) & 1);
+    }
+}
+
+typedef struct {
+    EditScript *script;
+    const unsigned char *p, *t;
+    const unsigned char *rp, *rt;   // both reversed
+    size_t m, n;
+    int caseInsensitive;
+} Alignment;
+
+// Plain DP with traceback, for pieces small enough (or one text character
+// wide) that the full matrix stays cheap
+static void alignSmall(Alignment *a, size_t pa, size_t pb, size_t ta, size_t tb) {
+    EditScript *script = a->script;
+    size_t rows = pb - pa, cols = tb - ta, width = cols + 1;
+    script->cells = growBuffer(script->cells, &script->cellCapacity, (rows + 1) * width, sizeof(uint32_t));
+    uint32_t *d = script->cells;
+    const unsigned char *p = a->p + pa, *t = a->t + ta;
+
+    for (size_t j = 0; j <= cols; j++) d[j] = (uint32_t)j;
+    for (size_t i = 1; i <= rows; i++) {
+        uint32_t *row = d + i * width, *above = row - width;
+        row[0] = (uint32_t)i;
+        for (size_t j = 1; j <= cols; j++) {
+            uint32_t best = above[j - 1] + !sameChar(p[i - 1], t[j - 1], a->caseInsensitive);
+            if (above[j] + 1 < best) best = above[j] + 1;
+            if (row[j - 1] + 1 < best) best = row[j - 1] + 1;
+            row[j] = best;
+        }
+    }
+
+    // Walk back from the corner, then flip this piece into forward order
+    size_t first = script->count, i = rows, j = cols;
+    while (i > 0 || j > 0) {
+        uint32_t here = d[i * width + j];
+        if (i > 0 && j > 0) {
+            int same = sameChar(p[i - 1], t[j - 1], a->caseInsensitive);
+            if (here == d[(i - 1) * width + j - 1] + !same) {
+                if (!same) pushEdit(script, EDIT_SUBSTITUTE, p[i - 1], t[j - 1], pa + i - 1, ta + j - 1);
+                i--, j--;
+                continue;
+            }
+        }
+        if (i > 0 && here == d[(i - 1) * width + j] + 1) {
+            pushEdit(script, EDIT_DELETE, p[i - 1], 0, pa + i - 1, ta + j);
+            i--;
+        } else {
+            pushEdit(script, EDIT_INSERT, 0, t[j - 1], pa + i, ta + j - 1);
+            j--;
+        }
+    }
+    for (size_t lo = first, hi = script->count; lo + 1 < hi; lo++, hi--) {
+        EditOp swap = script->ops[lo];
+        script->ops[lo] = script->ops[hi - 1];
+        script->ops[hi - 1] = swap;
+    }
+}
+
+#define ALIGN_SMALL_CELLS 4096
+
+// Split the typed text in half, find the target row where an optimal path
+// crosses that column (forward costs of the top half plus reverse costs of
+// the bottom half), and solve the two corners on either side of it. cost is
+// the piece's exact distance; a path that cheap never strays further than
+// cost from the diagonal, so each pass only needs the rows it can reach.
+static void alignRange(Alignment *a, size_t pa, size_t pb, size_t ta, size_t tb, size_t cost) {
+    size_t rows = pb - pa, cols = tb - ta;
+    if (cols <= 1 || (rows + 1) * (cols + 1) <= ALIGN_SMALL_CELLS) {
+        alignSmall(a, pa, pb, ta, tb);
+        return;
+    }
+    size_t mid = ta + cols / 2;
+    size_t forwardRows = mid - ta + cost < rows ? mid - ta + cost : rows;
+    size_t reverseRows = tb - mid + cost < rows ? tb - mid + cost : rows;
+    EditScript *script = a->script;
+    prefixCosts(&script->ws, a->p + pa, forwardRows, a->t + ta, mid - ta, a->caseInsensitive, script->forward);
+    prefixCosts(&script->ws, a->rp + (a->m - pb), reverseRows, a->rt + (a->n - tb), tb - mid, a->caseInsensitive,
+                script->reverse);
+
+    size_t split = rows - reverseRows;
+    long best = script->forward[split] + script->reverse[rows - split];
+    for (size_t i = split + 1; i <= forwardRows; i++) {
+        long total = script->forward[i] + script->reverse[rows - i];
+        if (total < best) {
+            best = total;
+            split = i;
+        }
+    }
+    size_t before = (size_t)script->forward[split], after = (size_t)script->reverse[rows - split];
+    alignRange(a, pa, pa + split, ta, mid, before);
+    alignRange(a, pa + split, pb, mid, tb, after);
+}
+
+size_t alignEdits(EditScript *script, const char *pattern, size_t patternLen,
+                  const char *text, size_t textLen, int caseInsensitive) {
+    script->count = script->substitutions = script->insertions = script->deletions = 0;
+    script->forward = growBuffer(script->forward, &script->rowCapacity, patternLen + 1, sizeof(long));
+    script->reverse = realloc(script->reverse, script->rowCapacity * sizeof(long));
+    script->reversed = growBuffer(script->reversed, &script->reversedCapacity, patternLen + textLen + 1, 1);
+    if (!script->reverse) {
+        perror("Memory allocation error for edit script");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < patternLen; i++) script->reversed[i] = (unsigned char)pattern[patternLen - 1 - i];
+    for (size_t j = 0; j < textLen; j++) script->reversed[patternLen + j] = (unsigned char)text[textLen - 1 - j];
+
+    Alignment a = {script, (const unsigned char *)pattern, (const unsigned char *)text,
+                   script->reversed, script->reversed + patternLen, patternLen, textLen, caseInsensitive};
+    alignRange(&a, 0, patternLen, 0, textLen,
+               editDistance(&script->ws, pattern, patternLen, text, textLen, caseInsensitive));
+    return script->count;
+}
+
+static int compareConfusionKeys(const void *a, const void *b) {
+    const Confusion *x = a, *y = b;
+    if (x->expected != y->expected) return (unsigned char)x->expected - (unsigned char)y->expected;
+    return (unsigned char)x->typed - (unsigned char)y->typed;
+}
+
+static int compareConfusionCounts(const void *a, const void *b) {
+    const Confusion *x = a, *y = b;
+    if (x->count != y->count) return x->count < y->count ? 1 : -1;
+    return compareConfusionKeys(a, b);
+}
+
+size_t topConfusions(const EditScript *script, Confusion *out, size_t max) {
+    if (script->substitutions == 0 || max == 0) return 0;
+    Confusion *pairs = malloc(script->substitutions * sizeof(Confusion));
+    if (!pairs) {
+        perror("Memory allocation error for confusion counts");
+        exit(EXIT_FAILURE);
+    }
+    size_t count = 0;
+    for (size_t i = 0; i < script->count; i++) {
+        const EditOp *op = &script->ops[i];
+        if (op->kind == EDIT_SUBSTITUTE) pairs[count++] = (Confusion){op->expected, op->typed, 1};
+    }
+    qsort(pairs, count, sizeof(Confusion), compareConfusionKeys);
+    size_t distinct = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (distinct > 0 && compareConfusionKeys(&pairs[distinct - 1], &pairs[i]) == 0) {
+            pairs[distinct - 1].count++;
+        } else {
+            pairs[distinct++] = pairs[i];
+        }
+    }
+    qsort(pairs, distinct, sizeof(Confusion), compareConfusionCounts);
+    if (distinct > max) distinct = max;
+    memcpy(out, pairs, distinct * sizeof(Confusion));
+    free(pairs);
+    return distinct;
+}
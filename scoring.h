@@ -0,0 +1,96 @@
+#ifndef SCORING_H
+#define SCORING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Reusable scratch space for the bit-parallel edit distance. Buffers only
+// grow, so once a workspace has seen the longest paragraph of a session no
+// further allocation happens.
+typedef struct {
+    uint64_t *peq;        // match masks, symbolCount x blockCount words
+    uint64_t *column;     // vertical +1/-1 delta words, two per block
+    size_t peqCapacity;
+    size_t columnCapacity;
+} ScoreWorkspace;
+
+void initScoreWorkspace(ScoreWorkspace *ws);
+void freeScoreWorkspace(ScoreWorkspace *ws);
+
+// Levenshtein distance between pattern (the target paragraph) and text (what
+// the user typed), using Myers/Hyyro bit-parallel rows of 64 cells.
+size_t editDistance(ScoreWorkspace *ws, const char *pattern, size_t patternLen,
+                    const char *text, size_t textLen, int caseInsensitive);
+
+// The same distance for text that arrives in pieces. Only the match masks
+// and one DP column are kept, about (symbols + 2) x patternLen / 8 bytes, so
+// neither the typed text nor a patternLen x textLen matrix is ever held.
+typedef struct {
+    ScoreWorkspace ws;
+    unsigned char symbols[256];
+    size_t blocks;
+    uint64_t lastBit;
+    size_t patternLength;
+    size_t textLength;
+    long score;
+} StreamScorer;
+
+void initStreamScorer(StreamScorer *scorer);
+void freeStreamScorer(StreamScorer *scorer);
+void beginStreamScore(StreamScorer *scorer, const char *pattern, size_t patternLen, int caseInsensitive);
+void streamScoreText(StreamScorer *scorer, const char *text, size_t textLen);
+// Distance between the pattern and all text fed so far
+size_t streamScoreDistance(const StreamScorer *scorer);
+
+#define EDIT_SUBSTITUTE 'S'     // typed the wrong character
+#define EDIT_INSERT 'I'         // typed a character the target does not have
+#define EDIT_DELETE 'D'         // skipped a target character
+
+typedef struct {
+    char kind;
+    char expected;              // target character, 0 for EDIT_INSERT
+    char typed;                 // typed character, 0 for EDIT_DELETE
+    size_t targetPos;           // for EDIT_INSERT, the target character it precedes
+    size_t typedPos;            // for EDIT_DELETE, where in the typed text it was due
+} EditOp;
+
+// One optimal alignment of typed text against the target, errors only (the
+// characters in between match). The scratch buffers only grow and are
+// reused by the next alignEdits call.
+typedef struct {
+    EditOp *ops;
+    size_t count;
+    size_t capacity;
+    size_t substitutions;
+    size_t insertions;
+    size_t deletions;
+    ScoreWorkspace ws;
+    long *forward;
+    long *reverse;
+    size_t rowCapacity;
+    unsigned char *reversed;
+    size_t reversedCapacity;
+    uint32_t *cells;
+    size_t cellCapacity;
+} EditScript;
+
+typedef struct {
+    char expected;
+    char typed;
+    uint32_t count;
+} Confusion;
+
+void initEditScript(EditScript *script);
+void freeEditScript(EditScript *script);
+
+// Hirschberg's divide and conquer over bit-parallel DP columns: O(m + n)
+// memory and about twice the work of editDistance's unbanded pass. Returns
+// the distance, which is also script->count.
+size_t alignEdits(EditScript *script, const char *pattern, size_t patternLen,
+                  const char *text, size_t textLen, int caseInsensitive);
+
+// The most frequent substitutions (typed 'r' for 't', ...), most frequent
+// first; returns how many were written to out.
+size_t topConfusions(const EditScript *script, Confusion *out, size_t max);
+
+#endif
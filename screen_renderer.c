@@ -0,0 +1,275 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "screen_renderer.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__WINDOWS__)
+    #include <conio.h>
+    #include <io.h>
+    #include <windows.h>
+    #define SCREEN_WINDOWS 1
+#else
+    #include <errno.h>
+    #include <poll.h>
+    #include <sys/ioctl.h>
+    #include <termios.h>
+    #include <unistd.h>
+    #define SCREEN_WINDOWS 0
+#endif
+
+#define SCREEN_DEFAULT_WIDTH 80
+#define SCREEN_DEFAULT_HEIGHT 24
+
+// Reprinting a few unchanged cells is cheaper than a cursor jump
+#define SCREEN_MAX_REPRINT_GAP 4
+
+static const char *styleCodes[SCREEN_STYLE_COUNT] = {
+    "\033[0m",
+    "\033[0;1;37m",
+    "\033[0;1;32m",
+    "\033[0;1;31m",
+    "\033[0;1;33m",
+    "\033[0;41;1;37m",
+    "\033[0;46;30m",
+};
+
+#if !SCREEN_WINDOWS
+static struct termios savedTermios;
+static int termiosSaved = 0;
+#endif
+
+static void querySize(int *width, int *height) {
+    *width = SCREEN_DEFAULT_WIDTH;
+    *height = SCREEN_DEFAULT_HEIGHT;
+#if SCREEN_WINDOWS
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi)) {
+        *width = csbi.srWindow.Right - csbi.srWindow.Left + 1;
+        *height = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
+    }
+#else
+    struct winsize ws;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 0 && ws.ws_row > 0) {
+        *width = ws.ws_col;
+        *height = ws.ws_row;
+    }
+#endif
+}
+
+static void appendBytes(ScreenRenderer *screen, const char *data, size_t length) {
+    if (screen->outLength + length > screen->outCapacity) {
+        size_t capacity = screen->outCapacity ? screen->outCapacity : 4096;
+        while (capacity < screen->outLength + length) capacity *= 2;
+        char *grown = realloc(screen->out, capacity);
+        if (!grown) {
+            perror("Memory allocation error for screen");
+            exit(EXIT_FAILURE);
+        }
+        screen->out = grown;
+        screen->outCapacity = capacity;
+    }
+    memcpy(screen->out + screen->outLength, data, length);
+    screen->outLength += length;
+}
+
+static void appendString(ScreenRenderer *screen, const char *text) {
+    appendBytes(screen, text, strlen(text));
+}
+
+static void appendMoveTo(ScreenRenderer *screen, int row, int col) {
+    char seq[32];
+    int n = snprintf(seq, sizeof(seq), "\033[%d;%dH", row + 1, col + 1);
+    appendBytes(screen, seq, (size_t)n);
+}
+
+static int flushOutput(ScreenRenderer *screen) {
+    size_t sent = 0;
+    while (sent < screen->outLength) {
+#if SCREEN_WINDOWS
+        int n = _write(1, screen->out + sent, (unsigned int)(screen->outLength - sent));
+        if (n <= 0) return -1;
+#else
+        ssize_t n = write(STDOUT_FILENO, screen->out + sent, screen->outLength - sent);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+#endif
+        sent += (size_t)n;
+    }
+    screen->outLength = 0;
+    return 0;
+}
+
+static void resizeBuffers(ScreenRenderer *screen, int width, int height) {
+    size_t cells = (size_t)width * (size_t)height;
+    ScreenCell *front = realloc(screen->front, cells * sizeof(ScreenCell));
+    ScreenCell *back = front ? realloc(screen->back, cells * sizeof(ScreenCell)) : NULL;
+    if (!front || !back) {
+        perror("Memory allocation error for screen");
+        exit(EXIT_FAILURE);
+    }
+    screen->front = front;
+    screen->back = back;
+    screen->width = width;
+    screen->height = height;
+    screen->frontValid = 0;
+}
+
+int openScreenRenderer(ScreenRenderer *screen) {
+    memset(screen, 0, sizeof(*screen));
+    int width, height;
+    querySize(&width, &height);
+    resizeBuffers(screen, width, height);
+
+#if !SCREEN_WINDOWS
+    if (tcgetattr(STDIN_FILENO, &savedTermios) == 0) {
+        struct termios raw = savedTermios;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        termiosSaved = tcsetattr(STDIN_FILENO, TCSANOW, &raw) == 0;
+    }
+#endif
+
+    // Anything queued through stdio must reach the terminal before our writes
+    fflush(stdout);
+    appendString(screen, "\033[?25l");
+    return flushOutput(screen);
+}
+
+void closeScreenRenderer(ScreenRenderer *screen) {
+    appendString(screen, styleCodes[SCREEN_STYLE_PLAIN]);
+    appendMoveTo(screen, screen->usedRows < screen->height ? screen->usedRows : screen->height - 1, 0);
+    appendString(screen, "\033[?25h");
+    flushOutput(screen);
+
+#if !SCREEN_WINDOWS
+    if (termiosSaved) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &savedTermios);
+        termiosSaved = 0;
+    }
+#endif
+    free(screen->front);
+    free(screen->back);
+    free(screen->out);
+    memset(screen, 0, sizeof(*screen));
+}
+
+void beginScreenFrame(ScreenRenderer *screen) {
+    int width, height;
+    querySize(&width, &height);
+    if (width != screen->width || height != screen->height) resizeBuffers(screen, width, height);
+
+    size_t cells = (size_t)screen->width * (size_t)screen->height;
+    for (size_t i = 0; i < cells; i++) screen->back[i] = (ScreenCell){' ', SCREEN_STYLE_PLAIN};
+    screen->cursorRow = 0;
+    screen->cursorCol = 0;
+    screen->usedRows = 0;
+}
+
+void screenPutText(ScreenRenderer *screen, int *row, int *col, const char *text, size_t length, int style) {
+    for (size_t i = 0; i < length; i++) {
+        if (*col >= screen->width) {
+            (*row)++;
+            *col = 0;
+        }
+        if (*row < screen->height) {
+            screen->back[(size_t)*row * screen->width + *col] = (ScreenCell){text[i], (unsigned char)style};
+            if (*row + 1 > screen->usedRows) screen->usedRows = *row + 1;
+        }
+        (*col)++;
+    }
+}
+
+void screenSetCursor(ScreenRenderer *screen, int row, int col) {
+    screen->cursorRow = row;
+    screen->cursorCol = col;
+}
+
+int presentScreen(ScreenRenderer *screen) {
+    int penRow = -1, penCol = -1, penStyle = -1;
+
+    if (!screen->frontValid) {
+        appendString(screen, styleCodes[SCREEN_STYLE_PLAIN]);
+        appendString(screen, "\033[2J");
+        size_t cells = (size_t)screen->width * (size_t)screen->height;
+        for (size_t i = 0; i < cells; i++) screen->front[i] = (ScreenCell){' ', SCREEN_STYLE_PLAIN};
+        penStyle = SCREEN_STYLE_PLAIN;
+        screen->frontValid = 1;
+    }
+
+    for (int row = 0; row < screen->height; row++) {
+        ScreenCell *front = screen->front + (size_t)row * screen->width;
+        const ScreenCell *back = screen->back + (size_t)row * screen->width;
+        for (int col = 0; col < screen->width; col++) {
+            if (front[col].ch == back[col].ch && front[col].style == back[col].style) continue;
+
+            if (penRow == row && penCol < col && col - penCol <= SCREEN_MAX_REPRINT_GAP) {
+                int sameStyle = 1;
+                for (int c = penCol; c < col; c++) sameStyle &= front[c].style == penStyle;
+                if (sameStyle) {
+                    for (int c = penCol; c < col; c++) appendBytes(screen, &front[c].ch, 1);
+                    penCol = col;
+                }
+            }
+            if (penRow != row || penCol != col) appendMoveTo(screen, row, col);
+            if (back[col].style != penStyle) {
+                penStyle = back[col].style;
+                appendString(screen, styleCodes[penStyle]);
+            }
+            appendBytes(screen, &back[col].ch, 1);
+            front[col] = back[col];
+            penRow = row;
+            penCol = col + 1;
+        }
+    }
+
+    if (penRow != screen->cursorRow || penCol != screen->cursorCol) {
+        appendMoveTo(screen, screen->cursorRow, screen->cursorCol);
+    }
+    return flushOutput(screen);
+}
+
+int screenKeyPending(void) {
+#if SCREEN_WINDOWS
+    return _kbhit();
+#else
+    struct pollfd pfd = {STDIN_FILENO, POLLIN, 0};
+    return poll(&pfd, 1, 0) > 0;
+#endif
+}
+
+int readScreenKey(void) {
+#if SCREEN_WINDOWS
+    return _getch();
+#else
+    unsigned char ch;
+    ssize_t n;
+    do {
+        n = read(STDIN_FILENO, &ch, 1);
+    } while (n < 0 && errno == EINTR);
+    return n == 1 ? ch : -1;
+#endif
+}
+
+int waitScreenInput(int fd, int timeoutMs) {
+#if SCREEN_WINDOWS
+    // The console cannot be waited on together with a socket; poll the keyboard
+    (void)fd;
+    for (int waited = 0;; waited += 10) {
+        if (_kbhit()) return SCREEN_INPUT_KEY;
+        if (waited >= timeoutMs) return 0;
+        Sleep(10);
+    }
+#else
+    struct pollfd pfds[2] = {{STDIN_FILENO, POLLIN, 0}, {fd, POLLIN, 0}};
+    int ready = poll(pfds, fd >= 0 ? 2 : 1, timeoutMs);
+    if (ready <= 0) return 0;
+    int result = 0;
+    if (pfds[0].revents) result |= SCREEN_INPUT_KEY;
+    if (fd >= 0 && pfds[1].revents) result |= SCREEN_INPUT_FD;
+    return result;
+#endif
+}
@@ -0,0 +1,61 @@
+#ifndef SCREEN_RENDERER_H
+#define SCREEN_RENDERER_H
+
+#include <stddef.h>
+
+enum {
+    SCREEN_STYLE_PLAIN,
+    SCREEN_STYLE_WHITE,
+    SCREEN_STYLE_GREEN,
+    SCREEN_STYLE_RED,
+    SCREEN_STYLE_YELLOW,
+    SCREEN_STYLE_ERROR_HIGHLIGHT,
+    SCREEN_STYLE_CARET,             // other racers' positions
+    SCREEN_STYLE_COUNT
+};
+
+typedef struct {
+    char ch;
+    unsigned char style;
+} ScreenCell;
+
+// Double-buffered terminal screen. A frame is drawn into the back buffer and
+// presentScreen() writes only the cells that differ from what the terminal
+// already shows, as a single write().
+typedef struct {
+    int width;
+    int height;
+    ScreenCell *front;          // what the terminal currently shows
+    ScreenCell *back;           // frame being drawn
+    int frontValid;             // 0 forces a full repaint
+    int cursorRow;
+    int cursorCol;
+    int usedRows;               // rows drawn in the last frame
+    char *out;
+    size_t outLength;
+    size_t outCapacity;
+} ScreenRenderer;
+
+// Switch the terminal to unbuffered, unechoed input for the whole session
+// and hide the cursor. closeScreenRenderer() restores both and leaves the
+// cursor on the line below the last frame.
+int openScreenRenderer(ScreenRenderer *screen);
+void closeScreenRenderer(ScreenRenderer *screen);
+
+void beginScreenFrame(ScreenRenderer *screen);
+// Draw text at (*row, *col), wrapping at the screen width; the position is
+// advanced past the text. Cells outside the screen are dropped.
+void screenPutText(ScreenRenderer *screen, int *row, int *col, const char *text, size_t length, int style);
+void screenSetCursor(ScreenRenderer *screen, int row, int col);
+int presentScreen(ScreenRenderer *screen);
+
+// Keyboard input while the renderer is open
+int screenKeyPending(void);
+int readScreenKey(void);
+
+// Wait up to timeoutMs for a key or for fd (-1 for none) to become
+// readable; returns SCREEN_INPUT_* bits, 0 on timeout
+enum { SCREEN_INPUT_KEY = 1, SCREEN_INPUT_FD = 2 };
+int waitScreenInput(int fd, int timeoutMs);
+
+#endif
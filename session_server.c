@@ -0,0 +1,589 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "session_server.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__WINDOWS__)
+    #define SESSION_WINDOWS 1
+#else
+    #include <arpa/inet.h>
+    #include <fcntl.h>
+    #include <netinet/in.h>
+    #include <poll.h>
+    #include <pthread.h>
+    #include <signal.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+    #define SESSION_WINDOWS 0
+    #if defined(__linux__)
+        #include <sys/epoll.h>
+        #define SESSION_EPOLL 1
+    #else
+        #define SESSION_EPOLL 0
+    #endif
+#endif
+
+#if SESSION_WINDOWS
+
+int runSessionServer(const SessionServerConfig *config, const SessionHandlers *handlers) {
+    (void)config;
+    (void)handlers;
+    fprintf(stderr, "Error: --listen is not supported on Windows\n");
+    return -1;
+}
+
+void assignSessionShard(Session *session, const char *key) {
+    (void)session;
+    (void)key;
+}
+
+void lockSessionShared(int exclusive) {
+    (void)exclusive;
+}
+
+void unlockSessionShared(void) {
+}
+
+int openSessionListener(const char *address, int backlog) {
+    (void)backlog;
+    fprintf(stderr, "Error: Cannot listen on '%s'; local sockets are not supported on Windows\n", address);
+    return -1;
+}
+
+int connectSessionAddress(const char *address) {
+    fprintf(stderr, "Error: Cannot connect to '%s'; local sockets are not supported on Windows\n", address);
+    return -1;
+}
+
+#else
+
+#define WAKE_SLOT UINT32_MAX
+#define max_session_args 16
+#define max_frame_header 32
+#define session_backlog 256
+#define session_events 64
+
+typedef struct {
+    int index;
+    pthread_t thread;
+    int wakeFds[2];                 // written to after queueing a handoff
+    pthread_mutex_t queueLock;
+    uint32_t *queue;                // slots handed to this worker
+    size_t queueCount;
+#if SESSION_EPOLL
+    int epollFd;
+#else
+    uint32_t *members;              // slots this worker polls
+    size_t memberCount;
+    struct pollfd *polls;
+#endif
+    char frame[SESSION_INPUT_BYTES + 1];
+} SessionWorker;
+
+static Session *slots;
+static uint32_t slotCount;
+static uint32_t *freeSlots;
+static uint32_t freeCount;
+static pthread_mutex_t freeLock = PTHREAD_MUTEX_INITIALIZER;
+static SessionWorker *workers;
+static int workerCount = 1;
+static const SessionHandlers *handlers;
+static pthread_rwlock_t sharedLock = PTHREAD_RWLOCK_INITIALIZER;
+static volatile sig_atomic_t stopping;
+
+static void onStopSignal(int signal) {
+    (void)signal;
+    stopping = 1;
+}
+
+void lockSessionShared(int exclusive) {
+    if (exclusive) {
+        pthread_rwlock_wrlock(&sharedLock);
+    } else {
+        pthread_rwlock_rdlock(&sharedLock);
+    }
+}
+
+void unlockSessionShared(void) {
+    pthread_rwlock_unlock(&sharedLock);
+}
+
+// FNV-1a, so a key always lands on the same worker
+void assignSessionShard(Session *session, const char *key) {
+    uint32_t hash = 2166136261u;
+    for (; *key; key++) {
+        hash ^= (unsigned char)*key;
+        hash *= 16777619u;
+    }
+    session->shard = (int)(hash % (uint32_t)workerCount);
+}
+
+static int setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags < 0 ? -1 : fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+// ---- Slots ----
+
+static Session *claimSlot(void) {
+    pthread_mutex_lock(&freeLock);
+    Session *session = freeCount > 0 ? &slots[freeSlots[--freeCount]] : NULL;
+    pthread_mutex_unlock(&freeLock);
+    return session;
+}
+
+static void releaseSlot(Session *session) {
+    session->fd = -1;
+    pthread_mutex_lock(&freeLock);
+    freeSlots[freeCount++] = session->slot;
+    pthread_mutex_unlock(&freeLock);
+}
+
+// ---- Readiness ----
+
+static void watchSession(SessionWorker *worker, Session *session) {
+#if SESSION_EPOLL
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | (session->outputLength > 0 ? EPOLLOUT : 0);
+    event.data.u32 = session->slot;
+    epoll_ctl(worker->epollFd, EPOLL_CTL_ADD, session->fd, &event);
+#else
+    worker->members[worker->memberCount++] = session->slot;
+#endif
+}
+
+static void unwatchSession(SessionWorker *worker, Session *session) {
+#if SESSION_EPOLL
+    epoll_ctl(worker->epollFd, EPOLL_CTL_DEL, session->fd, NULL);
+#else
+    for (size_t i = 0; i < worker->memberCount; i++) {
+        if (worker->members[i] == session->slot) {
+            worker->members[i] = worker->members[--worker->memberCount];
+            break;
+        }
+    }
+#endif
+}
+
+// Ask for writability only while output is pending
+static void updateInterest(SessionWorker *worker, Session *session) {
+#if SESSION_EPOLL
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | (session->outputLength > 0 ? EPOLLOUT : 0);
+    event.data.u32 = session->slot;
+    epoll_ctl(worker->epollFd, EPOLL_CTL_MOD, session->fd, &event);
+#else
+    (void)worker;
+    (void)session;
+#endif
+}
+
+static void wakeWorker(SessionWorker *worker) {
+    char byte = 1;
+    ssize_t written = write(worker->wakeFds[1], &byte, 1);
+    (void)written;
+}
+
+static void handOff(SessionWorker *worker, uint32_t slot) {
+    pthread_mutex_lock(&worker->queueLock);
+    worker->queue[worker->queueCount++] = slot;
+    pthread_mutex_unlock(&worker->queueLock);
+    wakeWorker(worker);
+}
+
+// ---- Sessions ----
+
+static void closeSession(SessionWorker *worker, Session *session) {
+    unwatchSession(worker, session);
+    if (handlers->closed) handlers->closed(handlers->context, session, worker->index);
+    close(session->fd);
+    releaseSlot(session);
+}
+
+// Only called with the output buffer empty
+static void appendReply(Session *session, int status, const char *data, size_t length) {
+    char header[max_frame_header];
+    int headerLength = snprintf(header, sizeof(header), "%d %lu\n", status, (unsigned long)length);
+    if ((size_t)headerLength + length > SESSION_OUTPUT_BYTES) {
+        static const char tooLarge[] = "Error: Reply too large\n";
+        headerLength = snprintf(header, sizeof(header), "1 %lu\n", (unsigned long)(sizeof(tooLarge) - 1));
+        data = tooLarge;
+        length = sizeof(tooLarge) - 1;
+    }
+    session->outputStart = 0;
+    memcpy(session->output, header, (size_t)headerLength);
+    memcpy(session->output + headerLength, data, length);
+    session->outputLength = (size_t)headerLength + length;
+}
+
+// Returns -1 once the peer is gone
+static int flushOutput(Session *session) {
+    while (session->outputLength > 0) {
+        ssize_t sent = write(session->fd, session->output + session->outputStart, session->outputLength);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+        }
+        session->outputStart += (size_t)sent;
+        session->outputLength -= (size_t)sent;
+    }
+    session->outputStart = 0;
+    return 0;
+}
+
+// Answer every complete frame in the input buffer, one reply in the output
+// buffer at a time. Stops early when the client is not reading (and resumes
+// once it can be written to) or the session has to move to another worker.
+static void processFrames(SessionWorker *worker, Session *session) {
+    while (!session->closing && session->shard == worker->index) {
+        if (session->outputLength > 0 && flushOutput(session) != 0) {
+            session->outputLength = 0;
+            session->closing = 1;
+            break;
+        }
+        if (session->outputLength > 0) break;
+        char *newline = memchr(session->input, '\n', session->inputLength);
+        if (!newline) {
+            if (session->inputLength >= max_frame_header) session->closing = 1;
+            break;
+        }
+        char *end;
+        unsigned long length = strtoul(session->input, &end, 10);
+        size_t headerLength = (size_t)(newline - session->input) + 1;
+        if (end == session->input || (*end != '\n' && *end != '\r') || length > SESSION_INPUT_BYTES - headerLength) {
+            static const char malformed[] = "Error: Malformed request frame\n";
+            appendReply(session, 1, malformed, sizeof(malformed) - 1);
+            session->closing = 1;
+            break;
+        }
+        if (session->inputLength < headerLength + length) break;
+
+        memcpy(worker->frame, session->input + headerLength, length);
+        worker->frame[length] = '\0';
+        size_t consumed = headerLength + length;
+        memmove(session->input, session->input + consumed, session->inputLength - consumed);
+        session->inputLength -= consumed;
+
+        char *args[max_session_args + 1];
+        int argc = 0;
+        args[argc++] = "typingtutor";
+        for (size_t pos = 0; pos < length && argc < max_session_args; pos += strlen(worker->frame + pos) + 1) {
+            args[argc++] = worker->frame + pos;
+        }
+        args[argc] = NULL;
+        if (argc == 2 && strcmp(args[1], "--quit") == 0) {
+            session->closing = 1;
+            break;
+        }
+
+        const char *reply = NULL;
+        size_t replyLength = 0;
+        int status = handlers->handle(handlers->context, session, worker->index, argc, args, &reply, &replyLength);
+        appendReply(session, status, reply, replyLength);
+    }
+}
+
+static void serviceSession(SessionWorker *worker, Session *session, int readable) {
+    while (readable && session->inputLength < SESSION_INPUT_BYTES) {
+        ssize_t got = read(session->fd, session->input + session->inputLength, SESSION_INPUT_BYTES - session->inputLength);
+        if (got < 0 && errno == EINTR) continue;
+        if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (got <= 0) {
+            closeSession(worker, session);
+            return;
+        }
+        session->inputLength += (size_t)got;
+        // Replies go out as frames complete, so a full buffer never stalls
+        processFrames(worker, session);
+    }
+    processFrames(worker, session);
+    // A full buffer that no frame can be taken from will never make progress
+    if (session->inputLength == SESSION_INPUT_BYTES && session->outputLength == 0 &&
+        session->shard == worker->index) {
+        session->closing = 1;
+    }
+
+    if (flushOutput(session) != 0 || (session->closing && session->outputLength == 0)) {
+        closeSession(worker, session);
+        return;
+    }
+    if (session->shard != worker->index && !session->closing) {
+        unwatchSession(worker, session);
+        session->worker = session->shard;
+        handOff(&workers[session->shard], session->slot);
+        return;
+    }
+    updateInterest(worker, session);
+}
+
+static void adoptSessions(SessionWorker *worker) {
+    char drain[64];
+    while (read(worker->wakeFds[0], drain, sizeof(drain)) > 0) {
+    }
+    pthread_mutex_lock(&worker->queueLock);
+    size_t count = worker->queueCount;
+    uint32_t *adopted = malloc((count > 0 ? count : 1) * sizeof(uint32_t));
+    if (adopted) {
+        memcpy(adopted, worker->queue, count * sizeof(uint32_t));
+        worker->queueCount = 0;
+    } else {
+        count = 0;
+    }
+    pthread_mutex_unlock(&worker->queueLock);
+
+    for (size_t i = 0; i < count; i++) {
+        Session *session = &slots[adopted[i]];
+        session->worker = worker->index;
+        watchSession(worker, session);
+        // Requests may already be buffered from before the move
+        serviceSession(worker, session, 0);
+    }
+    free(adopted);
+}
+
+static void *workerMain(void *arg) {
+    SessionWorker *worker = arg;
+    while (!stopping) {
+#if SESSION_EPOLL
+        struct epoll_event events[session_events];
+        int count = epoll_wait(worker->epollFd, events, session_events, 1000);
+        for (int i = 0; i < count && !stopping; i++) {
+            uint32_t slot = events[i].data.u32;
+            if (slot == WAKE_SLOT) {
+                adoptSessions(worker);
+                continue;
+            }
+            Session *session = &slots[slot];
+            // Closed or moved away by an earlier event in this batch
+            if (session->fd < 0 || session->worker != worker->index) continue;
+            serviceSession(worker, session, (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0);
+        }
+#else
+        size_t pollCount = 0;
+        worker->polls[pollCount].fd = worker->wakeFds[0];
+        worker->polls[pollCount++].events = POLLIN;
+        for (size_t i = 0; i < worker->memberCount; i++) {
+            Session *session = &slots[worker->members[i]];
+            worker->polls[pollCount].fd = session->fd;
+            worker->polls[pollCount++].events = POLLIN | (session->outputLength > 0 ? POLLOUT : 0);
+        }
+        // Snapshot of the members, since servicing can close or move them
+        uint32_t *polled = malloc((worker->memberCount + 1) * sizeof(uint32_t));
+        if (!polled) break;
+        memcpy(polled, worker->members, worker->memberCount * sizeof(uint32_t));
+        if (poll(worker->polls, pollCount, 1000) > 0) {
+            for (size_t i = 1; i < pollCount && !stopping; i++) {
+                Session *session = &slots[polled[i - 1]];
+                short revents = worker->polls[i].revents;
+                if (!revents || session->fd != worker->polls[i].fd || session->worker != worker->index) continue;
+                serviceSession(worker, session, (revents & (POLLIN | POLLHUP | POLLERR)) != 0);
+            }
+            if (worker->polls[0].revents) adoptSessions(worker);
+        }
+        free(polled);
+#endif
+    }
+    return NULL;
+}
+
+// ---- Listening ----
+
+// "unix:<path>", "<port>", "127.0.0.1:<port>" or "localhost:<port>".
+// Loopback only: sessions are for clients on this machine.
+static int resolveAddress(const char *address, struct sockaddr_storage *storage, socklen_t *length) {
+    memset(storage, 0, sizeof(*storage));
+    if (strncmp(address, "unix:", 5) == 0) {
+        struct sockaddr_un *local = (struct sockaddr_un *)storage;
+        local->sun_family = AF_UNIX;
+        if (strlen(address + 5) == 0 || strlen(address + 5) >= sizeof(local->sun_path)) {
+            fprintf(stderr, "Error: Invalid socket path '%s'\n", address + 5);
+            return -1;
+        }
+        strcpy(local->sun_path, address + 5);
+        *length = sizeof(*local);
+        return 0;
+    }
+    const char *port = address;
+    if (strncmp(address, "127.0.0.1:", 10) == 0) port = address + 10;
+    if (strncmp(address, "localhost:", 10) == 0) port = address + 10;
+    char *end;
+    long number = strtol(port, &end, 10);
+    if (end == port || *end != '\0' || number < 1 || number > 65535) {
+        fprintf(stderr, "Error: Invalid address '%s'\n", address);
+        return -1;
+    }
+    struct sockaddr_in *loopback = (struct sockaddr_in *)storage;
+    loopback->sin_family = AF_INET;
+    loopback->sin_port = htons((uint16_t)number);
+    loopback->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    *length = sizeof(*loopback);
+    return 0;
+}
+
+int openSessionListener(const char *address, int backlog) {
+    struct sockaddr_storage storage;
+    socklen_t length;
+    if (resolveAddress(address, &storage, &length) != 0) return -1;
+    if (storage.ss_family == AF_UNIX) unlink(((struct sockaddr_un *)&storage)->sun_path);
+    int fd = socket(storage.ss_family, SOCK_STREAM, 0);
+    int reuse = 1;
+    if (fd >= 0 && storage.ss_family == AF_INET) setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (fd < 0 || bind(fd, (struct sockaddr *)&storage, length) != 0 || listen(fd, backlog) != 0 ||
+        setNonBlocking(fd) != 0) {
+        perror(address);
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int connectSessionAddress(const char *address) {
+    struct sockaddr_storage storage;
+    socklen_t length;
+    if (resolveAddress(address, &storage, &length) != 0) return -1;
+    int fd = socket(storage.ss_family, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&storage, length) != 0) {
+        perror(address);
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void acceptSessions(int listenFd, int *nextWorker) {
+    for (;;) {
+        int fd = accept(listenFd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        Session *session = setNonBlocking(fd) == 0 ? claimSlot() : NULL;
+        if (!session) {
+            static const char full[] = "1 22\nError: Server is full\n";
+            ssize_t written = write(fd, full, sizeof(full) - 1);
+            (void)written;
+            close(fd);
+            continue;
+        }
+        session->fd = fd;
+        session->inputLength = session->outputStart = session->outputLength = 0;
+        session->closing = 0;
+        // New sessions are spread round-robin until they name a shard key
+        session->worker = session->shard = *nextWorker;
+        *nextWorker = (*nextWorker + 1) % workerCount;
+        if (handlers->opened) handlers->opened(handlers->context, session);
+        handOff(&workers[session->worker], session->slot);
+    }
+}
+
+static int startWorker(SessionWorker *worker, int index, uint32_t maxSessions) {
+    memset(worker, 0, sizeof(*worker));
+    worker->index = index;
+    worker->queue = malloc(maxSessions * sizeof(uint32_t));
+    if (!worker->queue || pipe(worker->wakeFds) != 0) return -1;
+    setNonBlocking(worker->wakeFds[0]);
+    pthread_mutex_init(&worker->queueLock, NULL);
+#if SESSION_EPOLL
+    worker->epollFd = epoll_create1(0);
+    if (worker->epollFd < 0) return -1;
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u32 = WAKE_SLOT;
+    if (epoll_ctl(worker->epollFd, EPOLL_CTL_ADD, worker->wakeFds[0], &event) != 0) return -1;
+#else
+    worker->members = malloc(maxSessions * sizeof(uint32_t));
+    worker->polls = malloc((maxSessions + 1) * sizeof(struct pollfd));
+    if (!worker->members || !worker->polls) return -1;
+#endif
+    return pthread_create(&worker->thread, NULL, workerMain, worker) == 0 ? 0 : -1;
+}
+
+static void stopWorker(SessionWorker *worker) {
+    close(worker->wakeFds[0]);
+    close(worker->wakeFds[1]);
+#if SESSION_EPOLL
+    close(worker->epollFd);
+#else
+    free(worker->members);
+    free(worker->polls);
+#endif
+    pthread_mutex_destroy(&worker->queueLock);
+    free(worker->queue);
+}
+
+int runSessionServer(const SessionServerConfig *config, const SessionHandlers *sessionHandlers) {
+    handlers = sessionHandlers;
+    workerCount = config->workers > 0 ? config->workers : 1;
+    slotCount = config->maxSessions > 0 ? config->maxSessions : 1;
+
+    int listenFd = openSessionListener(config->address, session_backlog);
+    if (listenFd < 0) return -1;
+
+    slots = calloc(slotCount, sizeof(Session));
+    freeSlots = malloc(slotCount * sizeof(uint32_t));
+    workers = calloc((size_t)workerCount, sizeof(SessionWorker));
+    if (!slots || !freeSlots || !workers) {
+        perror("Memory allocation error for session slots");
+        close(listenFd);
+        return -1;
+    }
+    // Hand out low slots first
+    for (uint32_t i = 0; i < slotCount; i++) {
+        slots[i].fd = -1;
+        slots[i].slot = i;
+        freeSlots[i] = slotCount - 1 - i;
+    }
+    freeCount = slotCount;
+
+    stopping = 0;
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onStopSignal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    int started = 0;
+    for (; started < workerCount; started++) {
+        if (startWorker(&workers[started], started, slotCount) != 0) {
+            perror("Error starting session workers");
+            stopping = 1;
+            break;
+        }
+    }
+
+    int nextWorker = 0;
+    while (!stopping) {
+        struct pollfd listening = {listenFd, POLLIN, 0};
+        if (poll(&listening, 1, 1000) > 0) acceptSessions(listenFd, &nextWorker);
+        if (handlers->tick) handlers->tick(handlers->context);
+    }
+
+    for (int i = 0; i < started; i++) wakeWorker(&workers[i]);
+    for (int i = 0; i < started; i++) pthread_join(workers[i].thread, NULL);
+    for (uint32_t i = 0; i < slotCount; i++) {
+        if (slots[i].fd < 0) continue;
+        if (handlers->closed) handlers->closed(handlers->context, &slots[i], slots[i].worker);
+        close(slots[i].fd);
+        slots[i].fd = -1;
+    }
+    for (int i = 0; i < started; i++) stopWorker(&workers[i]);
+    close(listenFd);
+    if (strncmp(config->address, "unix:", 5) == 0) unlink(config->address + 5);
+
+    free(workers);
+    free(freeSlots);
+    free(slots);
+    workers = NULL;
+    freeSlots = NULL;
+    slots = NULL;
+    return started == workerCount ? 0 : -1;
+}
+
+#endif
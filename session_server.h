@@ -0,0 +1,76 @@
+#ifndef SESSION_SERVER_H
+#define SESSION_SERVER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SESSION_INPUT_BYTES 8192
+#define SESSION_OUTPUT_BYTES 8192
+
+// Event-driven host for many concurrent client sessions in one process.
+//
+// Clients connect over a Unix socket or loopback TCP and speak the --serve
+// framing: a "<length>\n" line and <length> bytes of NUL-separated
+// arguments per request, and a "<status> <length>\n" line and <length> bytes
+// per reply. Each worker thread runs its own epoll loop (poll() where epoll
+// is missing) over the sessions it owns. A session starts on any worker and
+// moves once to the worker its shard key hashes to, so all requests for one
+// user are handled on one thread, in order.
+//
+// Sessions live in a pool of fixed-size slots allocated up front; the slot
+// index stays the same for the life of the connection, so the application
+// can keep its own per-session state in a parallel array.
+typedef struct {
+    int fd;
+    uint32_t slot;
+    int worker;                     // thread that owns it now
+    int shard;                      // thread that should own it
+    int closing;                    // close once the output is flushed
+    size_t inputLength;
+    size_t outputStart;
+    size_t outputLength;
+    char input[SESSION_INPUT_BYTES];
+    char output[SESSION_OUTPUT_BYTES];
+} Session;
+
+typedef struct {
+    // One request: argv[0] is "typingtutor", as for --serve. Point *replyData
+    // at the reply (valid until the next call on this worker) and return the
+    // status. Runs on the session's worker thread.
+    int (*handle)(void *context, Session *session, int worker, int argc, char *argv[],
+                  const char **replyData, size_t *replyLength);
+    // A connection took the slot; reset the application's state for it
+    void (*opened)(void *context, Session *session);
+    // The connection is gone and the slot is about to be reused
+    void (*closed)(void *context, Session *session, int worker);
+    // Called about once a second on the accepting thread
+    void (*tick)(void *context);
+    void *context;
+} SessionHandlers;
+
+typedef struct {
+    const char *address;            // "unix:<path>", "<port>" or "127.0.0.1:<port>"
+    int workers;
+    uint32_t maxSessions;
+} SessionServerConfig;
+
+// Serve until SIGINT/SIGTERM. Returns 0 on a clean shutdown, -1 if the
+// server could not start (or sessions are not supported on this platform).
+int runSessionServer(const SessionServerConfig *config, const SessionHandlers *handlers);
+
+// Route the session to the worker its key hashes to; takes effect once the
+// current request has been answered
+void assignSessionShard(Session *session, const char *key);
+
+// Guards the state all workers share: take it shared to read and exclusive
+// to change
+void lockSessionShared(int exclusive);
+void unlockSessionShared(void);
+
+// Sockets for the same addresses, for other local services (race mode). The
+// listener is non-blocking; the connected socket is blocking. -1 on error,
+// already reported.
+int openSessionListener(const char *address, int backlog);
+int connectSessionAddress(const char *address);
+
+#endif
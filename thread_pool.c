@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "thread_pool.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__WINDOWS__)
+    #include <windows.h>
+    #define POOL_WINDOWS 1
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+    #define POOL_WINDOWS 0
+#endif
+
+typedef struct {
+    size_t count;
+    volatile size_t next;
+    ParallelWork work;
+    void *context;
+} ParallelJob;
+
+typedef struct {
+    ParallelJob *job;
+    int worker;
+} WorkerArgs;
+
+static size_t claimIndex(ParallelJob *job) {
+#if POOL_WINDOWS
+    return (size_t)InterlockedExchangeAdd64((volatile LONG64 *)&job->next, 1);
+#else
+    return __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED);
+#endif
+}
+
+static void drainJob(ParallelJob *job, int worker) {
+    for (size_t index = claimIndex(job); index < job->count; index = claimIndex(job)) {
+        job->work(job->context, index, worker);
+    }
+}
+
+#if POOL_WINDOWS
+static DWORD WINAPI workerMain(LPVOID arg) {
+#else
+static void *workerMain(void *arg) {
+#endif
+    WorkerArgs *args = arg;
+    drainJob(args->job, args->worker);
+    return 0;
+}
+
+int hardwareThreadCount(void) {
+#if POOL_WINDOWS
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+}
+
+void parallelFor(size_t count, int threadCount, ParallelWork work, void *context) {
+    ParallelJob job = {count, 0, work, context};
+    if (threadCount < 1) threadCount = 1;
+    if ((size_t)threadCount > count) threadCount = count > 0 ? (int)count : 1;
+
+    int helpers = threadCount - 1;
+    WorkerArgs *args = helpers ? malloc(helpers * sizeof(WorkerArgs)) : NULL;
+#if POOL_WINDOWS
+    HANDLE *threads = helpers ? malloc(helpers * sizeof(HANDLE)) : NULL;
+#else
+    pthread_t *threads = helpers ? malloc(helpers * sizeof(pthread_t)) : NULL;
+#endif
+    // Without memory for helpers the caller simply does all the work
+    if (helpers && (!args || !threads)) helpers = 0;
+
+    int started = 0;
+    for (int i = 0; i < helpers; i++) {
+        args[i] = (WorkerArgs){&job, i + 1};
+#if POOL_WINDOWS
+        threads[i] = CreateThread(NULL, 0, workerMain, &args[i], 0, NULL);
+        if (!threads[i]) break;
+#else
+        if (pthread_create(&threads[i], NULL, workerMain, &args[i]) != 0) break;
+#endif
+        started++;
+    }
+
+    drainJob(&job, 0);
+
+    for (int i = 0; i < started; i++) {
+#if POOL_WINDOWS
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#else
+        pthread_join(threads[i], NULL);
+#endif
+    }
+    free(args);
+    free(threads);
+}
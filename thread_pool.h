@@ -0,0 +1,18 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stddef.h>
+
+// work(context, index, worker) is called once for every index in [0, count);
+// worker identifies the thread (0 is the caller) so it can use its own
+// scratch space.
+typedef void (*ParallelWork)(void *context, size_t index, int worker);
+
+int hardwareThreadCount(void);
+
+// Run work over count items on threadCount threads, the calling thread
+// included. Items are handed out one at a time, so uneven items still keep
+// every thread busy. Returns once all items are done.
+void parallelFor(size_t count, int threadCount, ParallelWork work, void *context);
+
+#endif
@@ -3,7 +3,9 @@ from tkinter import messagebox
 import random
 import time
 import threading
-import os
+import sys
+
+from libtypingtutor import open_typing_tutor
 
 # Optional: For sound effects (cross-platform)
 try:
@@ -23,23 +25,19 @@ MOTIVATIONAL_MESSAGES = [
     "You're a typing star!"
 ]
 
-# Load paragraphs from file (reuse C version's file if possible)
-PARAGRAPH_FILE = "build/paragraphs.txt"
-
-def load_paragraphs():
-    if not os.path.exists(PARAGRAPH_FILE):
-        return ["The quick brown fox jumps over the lazy dog."]
-    with open(PARAGRAPH_FILE, 'r') as f:
-        return [line.strip() for line in f if line.strip()]
+DIFFICULTIES = ("Easy", "Medium", "Hard")
 
 class TypingTutorGUI:
-    def __init__(self, root):
+    def __init__(self, root, tutor):
         self.root = root
         self.root.title("Typing Tutor - Modern GUI")
         self.root.geometry("900x400")
         self.root.configure(bg="#f0f4f8")
-        self.paragraphs = load_paragraphs()
+        # Paragraphs and scores from the C backend, so the numbers match the
+        # terminal and desktop versions
+        self.tutor = tutor
         self.current_paragraph = ""
+        self.current_difficulty = DIFFICULTIES[0]
         self.start_time = None
         self.timer_running = False
         # Theme state
@@ -322,8 +320,7 @@ class TypingTutorGUI:
             return
         user_input = self.entry.get('1.0', tk.END).strip()
         elapsed = time.time() - self.start_time if self.start_time else 0
-        wpm = len(user_input.split()) / (elapsed / 60) if elapsed > 0 else 0
-        accuracy = sum(1 for a, b in zip(user_input, self.current_paragraph) if a == b) / max(len(self.current_paragraph), 1) * 100
+        wpm, accuracy = self.score(user_input, elapsed)
         self.wpm_label.config(text=f"WPM: {wpm:.1f}")
         self.acc_label.config(text=f"Accuracy: {accuracy:.1f}%")
         self.time_label.config(text=f"Time: {elapsed:.1f}s")
@@ -405,9 +402,27 @@ class TypingTutorGUI:
             else:
                 self.paragraph_label.config(fg="#2d3748")
 
+    def score(self, user_input, elapsed):
+        if not self.current_paragraph or elapsed <= 0:
+            return 0.0, 0.0
+        stats = self.tutor.score(self.current_paragraph, user_input, False, elapsed)
+        return stats.wpm, stats.accuracy
+
+    def board_placing(self, user_input, elapsed):
+        # Where this run would place on the shared leaderboard for its difficulty
+        if not self.current_paragraph or elapsed <= 0:
+            return ""
+        cpm = self.tutor.score(self.current_paragraph, user_input, False, elapsed).cpm
+        rank, total = self.tutor.rank(self.current_difficulty, cpm)
+        return f"#{rank} of {total + 1} on the {self.current_difficulty} leaderboard"
+
     def next_test(self):
         # Pick a new paragraph and limit to 80 chars, split at space if possible
-        new_para = random.choice(self.paragraphs)
+        self.current_difficulty = random.choice(DIFFICULTIES)
+        new_para = self.tutor.paragraph(self.current_difficulty)
+        if not new_para:
+            messagebox.showerror("Typing Tutor", f"There are no {self.current_difficulty} paragraphs in the corpus.")
+            return
         if len(new_para) > 80:
             # Try to split at the last space before 80
             split_idx = new_para.rfind(' ', 0, 80)
@@ -501,11 +516,11 @@ class TypingTutorGUI:
         user_input = self.entry.get('1.0', tk.END).strip()
         elapsed = time.time() - self.start_time if self.start_time else 0
         correct = user_input == self.current_paragraph
-        wpm = len(user_input.split()) / (elapsed / 60) if elapsed > 0 else 0
-        accuracy = sum(1 for a, b in zip(user_input, self.current_paragraph) if a == b) / max(len(self.current_paragraph), 1) * 100
+        wpm, accuracy = self.score(user_input, elapsed)
         if correct:
             msg = random.choice(MOTIVATIONAL_MESSAGES)
-            self.feedback_label.config(text=msg, fg="#38a169")
+            placing = self.board_placing(user_input, elapsed)
+            self.feedback_label.config(text=f"{msg} {placing}" if placing else msg, fg="#38a169")
             self.animate_feedback()
             self.show_motivational_popup(msg)
             self.play_sound("success")
@@ -545,6 +560,7 @@ class TypingTutorGUI:
         # Bind check_result to Return key
         self.root.bind('<Return>', lambda e: self.check_result())
         self.root.mainloop()
+        self.tutor.close()
 
     def start_live_stats_update(self, event=None):
         if not self.timer_running:
@@ -554,5 +570,12 @@ class TypingTutorGUI:
 
 if __name__ == "__main__":
     root = tk.Tk()
-    app = TypingTutorGUI(root)
+    try:
+        tutor = open_typing_tutor()
+    except OSError as error:
+        root.withdraw()
+        messagebox.showerror("Typing Tutor", str(error))
+        root.destroy()
+        sys.exit(str(error))
+    app = TypingTutorGUI(root, tutor)
     app.run()
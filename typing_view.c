@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "typing_view.h"
+
+// Every racer's standing, one row each, under the typing view
+static void displayRaceStandings(ScreenRenderer *screen, int *row, const RaceClient *race) {
+    char line[160];
+    int order[RACE_MAX_RACERS];
+    int ranked = rankRacers(race->racers, race->racerCount, order);
+    size_t textLength = strlen(race->text);
+    int col = 0;
+    screenPutText(screen, row, &col, "Racers:", 7, SCREEN_STYLE_WHITE);
+    for (int i = 0; i < ranked; i++) {
+        const RacerState *racer = &race->racers[order[i]];
+        char bar[21];
+        size_t filled = textLength > 0 ? racer->position * (sizeof(bar) - 1) / textLength : 0;
+        memset(bar, '#', filled);
+        memset(bar + filled, '.', sizeof(bar) - 1 - filled);
+        bar[sizeof(bar) - 1] = '\0';
+        int n = snprintf(line, sizeof(line), "%2d. %-16.16s [%s] %3d%% %3u err", i + 1, racer->name, bar,
+                         textLength > 0 ? (int)(racer->position * 100 / textLength) : 0, racer->errors);
+        if (racer->flags & RACER_FINISHED) {
+            n += snprintf(line + n, sizeof(line) - n, "  %.1fs", racer->finishMs / 1000.0);
+        } else if (racer->flags & RACER_LEFT) {
+            n += snprintf(line + n, sizeof(line) - n, "  left");
+        }
+        if (order[i] == race->self) n += snprintf(line + n, sizeof(line) - n, "  (you)");
+        (*row)++, col = 0;
+        screenPutText(screen, row, &col, line, (size_t)n, order[i] == race->self ? SCREEN_STYLE_YELLOW : SCREEN_STYLE_PLAIN);
+    }
+}
+
+void displayRealtimeTyping(ScreenRenderer *screen, const char* targetText, const char* userInput, int currentPos, int wrongChars, double elapsedTime, const RaceClient *race) {
+    int targetLen = strlen(targetText);
+    int inputLen = strlen(userInput);
+    char line[160];
+    int row = 0, col = 0;
+    // Where the other racers are in the paragraph
+    unsigned char carets[RACE_MAX_TEXT];
+    if (race) {
+        memset(carets, 0, sizeof(carets));
+        for (int i = 0; i < race->racerCount; i++) {
+            const RacerState *racer = &race->racers[i];
+            if (i != race->self && (racer->flags & RACER_JOINED) && !(racer->flags & RACER_LEFT) &&
+                racer->position < sizeof(carets)) {
+                carets[racer->position] = 1;
+            }
+        }
+    }
+    
+    beginScreenFrame(screen);
+    
+    if (race) {
+        screenPutText(screen, &row, &col, "=== Race Mode ===", 17, SCREEN_STYLE_GREEN);
+    } else {
+        screenPutText(screen, &row, &col, "=== Real-Time Typing Mode ===", 29, SCREEN_STYLE_GREEN);
+    }
+    row++, col = 0;
+    screenPutText(screen, &row, &col, "Target Text:", 12, SCREEN_STYLE_WHITE);
+    row++, col = 0;
+    
+    for (int i = 0; i < targetLen; i++) {
+        int style = SCREEN_STYLE_WHITE;
+        if (i < inputLen) {
+            style = userInput[i] == targetText[i] ? SCREEN_STYLE_GREEN : SCREEN_STYLE_ERROR_HIGHLIGHT;
+        } else if (i == currentPos) {
+            style = SCREEN_STYLE_YELLOW;
+        }
+        if (race && i != currentPos && i < (int)sizeof(carets) && carets[i]) style = SCREEN_STYLE_CARET;
+        screenPutText(screen, &row, &col, &targetText[i], 1, style);
+    }
+    
+    row += 2, col = 0;
+    screenPutText(screen, &row, &col, "Your Input:", 11, SCREEN_STYLE_WHITE);
+    row++, col = 0;
+    
+    for (int i = 0; i < inputLen; i++) {
+        int style = (i < targetLen && userInput[i] == targetText[i]) ? SCREEN_STYLE_GREEN : SCREEN_STYLE_RED;
+        screenPutText(screen, &row, &col, &userInput[i], 1, style);
+    }
+    
+    screenPutText(screen, &row, &col, "_", 1, SCREEN_STYLE_YELLOW);
+    screenSetCursor(screen, row, col);
+    
+    row += 2, col = 0;
+    uint64_t now = race ? raceClockMs() : 0;
+    int n;
+    if (race && now < race->startAt) {
+        n = snprintf(line, sizeof(line), "Get ready: the race starts in %d...", (int)((race->startAt - now + 999) / 1000));
+        screenPutText(screen, &row, &col, line, (size_t)n, SCREEN_STYLE_YELLOW);
+    } else {
+        n = snprintf(line, sizeof(line), "Progress: %d/%d characters | Errors: %d | Time: %.1fs",
+                     currentPos, targetLen, wrongChars, elapsedTime);
+        screenPutText(screen, &row, &col, line, (size_t)n, SCREEN_STYLE_WHITE);
+    }
+    
+    if (currentPos > 0) {
+        double currentCPM = (currentPos / elapsedTime) * 60.0;
+        double currentWPM = currentCPM / 5.0;
+        row++, col = 0;
+        n = snprintf(line, sizeof(line), "Current Speed: %.1f CPM (%.1f WPM)", currentCPM, currentWPM);
+        screenPutText(screen, &row, &col, line, (size_t)n, SCREEN_STYLE_PLAIN);
+    }
+    
+    row += 2, col = 0;
+    if (race && currentPos >= targetLen) {
+        screenPutText(screen, &row, &col, "Finished! Waiting for the other racers | Any key=leave", 54, SCREEN_STYLE_YELLOW);
+    } else {
+        screenPutText(screen, &row, &col, "Controls: ESC=quit | Backspace=correct | Any key=type", 53, SCREEN_STYLE_YELLOW);
+    }
+    
+    if (race) {
+        row += 2;
+        displayRaceStandings(screen, &row, race);
+    }
+    
+    presentScreen(screen);
+}
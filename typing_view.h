@@ -0,0 +1,12 @@
+#ifndef TYPING_VIEW_H
+#define TYPING_VIEW_H
+
+#include "race.h"
+#include "screen_renderer.h"
+
+// One frame of the real-time typing view: the target text coloured by what
+// has been typed, the input, speed so far and, with a race, the other
+// racers' carets and standings
+void displayRealtimeTyping(ScreenRenderer *screen, const char* targetText, const char* userInput, int currentPos, int wrongChars, double elapsedTime, const RaceClient *race);
+
+#endif
@@ -6,10 +6,24 @@
 #include <sys/time.h>
 #include <strings.h>
 #include <math.h>
+#include <stdarg.h>
+#include <sys/stat.h>
+#include <limits.h>
+#include <errno.h>
+
+#include "backend.h"
+#include "race.h"
+#include "screen_renderer.h"
+#include "session_server.h"
+#include "thread_pool.h"
+#include "typing_view.h"
+#include "write_behind.h"
 
 #if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__WINDOWS__)
     #include <conio.h>
     #include <windows.h>
+    #include <io.h>
+    #include <fcntl.h>
     #define IS_WINDOWS 1
 #else
     #include <termios.h>
@@ -27,17 +41,9 @@
 #endif
 
 #define max_para_length 200
-#define max_file_line_length 200
-#define max_attempts 10
-#define max_leaderboard_entries 100
-
-#define EASY_SPEED 5
-#define EASY_MEDIUM_SPEED 8
-#define MEDIUM_HARD_SPEED 12
-#define HARD_SPEED 12
-#define HARD_MAX_SPEED 16
-
-#define CHECK_FILE_OP(f, msg) do { if (!(f)) { perror(msg); exit(EXIT_FAILURE); } } while (0)
+#define max_frame_length (16 * 1024 * 1024)
+#define default_max_sessions 1024
+#define max_plausible_cpm 1500
 
 #define ANSI_RESET "\033[0m"
 #define ANSI_RED "\033[1;31m"
@@ -50,226 +56,61 @@
 #define ANSI_CURSOR_HOME "\033[H"
 #define ANSI_CURSOR_UP "\033[A"
 
+// What a --listen session remembers between requests; one per session slot
 typedef struct {
-    char username[50];
-    double bestSpeed;
-    double bestAccuracy;
-    double totalSpeed;
-    double totalAccuracy;
-    int totalAttempts;
-} UserProfile;
+    char username[50];              // empty until --login
+    char difficulty[20];
+    const char *paragraph;          // NULL while no attempt is running
+    size_t paragraphLength;
+    ParagraphArena *arena;          // holding paragraph, or NULL when it is in paragraphs.bin
+    int caseInsensitive;
+    struct timeval started;
+} TypingSession;
 
+// Scratch space of one --listen worker thread
 typedef struct {
-    int easy;
-    int medium;
-    int hard;
-} Difficulty;
+    ScoreWorkspace workspace;
+    EditScript edits;
+    ReplyBuffer reply;
+} SessionWorkspace;
 
 typedef struct {
-    double typingSpeed;   
-    double wordsPerMinute; 
-    double accuracy;
-    int wrongChars;
-    char paragraph[max_para_length];
-    int caseInsensitive;
-} TypingStats;
-
+    BackendState *state;            // leaderboard view and sketches read, under lockSessionShared()
+    CompiledCorpus *corpus;         // fixed for the life of the server; NULL means paragraphs.txt
+    TypingSession *sessions;
+    SessionWorkspace *workspaces;
+    BackendState writerState;       // the stores' own descriptors, used only by the writer thread
+    WriteBehind *writer;
+} SessionHost;
+
+// One attempt of an interactive session; the paragraph is referred to by id
 typedef struct {
-    char username[50];
-    double typingSpeed;   
-    double wordsPerMinute; 
-    double accuracy;
-    char difficulty[20]; 
-} LeaderboardEntry;
+    int paragraphId;
+    TypingStats stats;
+} SessionAttempt;
 
-typedef struct {
-    char **paragraphs;
-    int count;
-} ParagraphCache;
-
-// Function declarations (unchanged)
-void loadParagraphs(FILE *file, ParagraphCache *cache);
-void freeParagraphCache(ParagraphCache *cache);
-char *getRandomParagraph(ParagraphCache *cache);
-void sanitizeUsername(char *username, size_t size);
-void loadUserProfile(UserProfile *profile);
-void updateUserProfile(UserProfile *profile, TypingStats *currentAttempt);
-void printTypingStats(double elapsedTime, const char *input, const char *correctText, Difficulty difficulty, TypingStats *stats);
-void loadLeaderboard(LeaderboardEntry leaderboard[], int *numEntries);
-void saveLeaderboard(LeaderboardEntry leaderboard[], int numEntries);
-void updateLeaderboard(UserProfile *profile, TypingStats *currentAttempt, const char *difficulty);
-void displayLeaderboard(const char *difficulty);
-int min3(int a, int b, int c);
-int levenshtein(const char *s1, const char *s2, int caseInsensitive);
-void toLowerStr(char *dst, const char *src);
+// Function declarations
 void trim_newline(char *str);
 void promptDifficulty(Difficulty *difficulty, char *difficultyLevel);
-void displayPreviousAttempts(TypingStats attempts[], int numAttempts);
-void loadParagraphsForDifficulty(FILE *file, ParagraphCache *cache, const char *difficultyLevel);
+void displayPreviousAttempts(const SessionAttempt *attempts, size_t numAttempts);
 void displayUserSummary(UserProfile *profile);
-void collectUserInput(char *input, size_t inputSize, double *elapsedTime);
+void displayKeystrokeSummary(const KeystrokeSummary *summary);
+void collectUserInput(char **input, size_t *inputCapacity, double *elapsedTime);
 int isValidInput(const char *input);
-void processAttempts(ParagraphCache *cache);
+void processAttempts(ParagraphCache *cache, WriteBehindDurability durability);
 char getRealTimeChar();
 void clearScreen();
 void enableWindowsColorSupport();
 void initializeRealtimeMode();
-void displayRealtimeTyping(const char* targetText, const char* userInput, int currentPos, int wrongChars, double elapsedTime);
-void collectUserInputRealtime(const char* targetText, char *input, size_t inputSize, double *elapsedTime, TypingStats *stats);
+void collectUserInputRealtime(const char* targetText, char *input, size_t inputSize, double *elapsedTime, TypingStats *stats, KeystrokeLog *keystrokes, RaceClient *race);
 int promptTypingMode();
+int runServer(BackendState *state);
+int runSessionHost(int argc, char *argv[]);
 
-// Function implementations (unchanged except for main)
-void loadParagraphs(FILE *file, ParagraphCache *cache) {
-    char line[max_file_line_length];
-    cache->count = 0;
-    cache->paragraphs = NULL;
+// Function implementations
 
-    while (fgets(line, sizeof(line), file) != NULL) {
-        if (line[0] != '\n') cache->count++;
-    }
-
-    cache->paragraphs = malloc(cache->count * sizeof(char *));
-    CHECK_FILE_OP(cache->paragraphs, "Memory allocation error for paragraph cache");
-
-    fseek(file, 0, SEEK_SET);
-    int index = 0;
-    while (fgets(line, sizeof(line), file) != NULL) {
-        if (line[0] != '\n') {
-            size_t len = strlen(line);
-            if (len > 0 && line[len - 1] == '\n') line[len - 1] = '\0';
-            cache->paragraphs[index] = strdup(line);
-            CHECK_FILE_OP(cache->paragraphs[index], "Memory allocation error for paragraph");
-            index++;
-        }
-    }
-}
-
-void save_progress(int wpm, int accuracy) {
-    FILE *file = fopen("progress.txt", "a");
-    if (file) {
-        time_t now = time(0);
-        struct tm *t = localtime(&now);
-        fprintf(file, "%d,%d,%04d-%02d-%02d\n", 
-                wpm, accuracy, 
-                t->tm_year+1900, t->tm_mon+1, t->tm_mday);
-        fclose(file);
-    }
-}
-
-// Load paragraphs for specific difficulty into cache
-void loadParagraphsForDifficulty(FILE *file, ParagraphCache *cache, const char *difficultyLevel)
-{
-    char line[max_file_line_length];
-    int inSection = 0;
-    int count = 0;
-    char marker[16];
-    snprintf(marker, sizeof(marker), "#%s", difficultyLevel);
-
-    while (fgets(line, sizeof(line), file)) {
-        trim_newline(line);
-        if (line[0] == '#') {
-            inSection = (strcasecmp(line, marker) == 0);
-            continue;
-        }
-        if (inSection && strlen(line) > 0 && line[0] != '#') {
-            count++;
-        }
-    }
-
-    if (count == 0) {
-        cache->paragraphs = NULL;
-        cache->count = 0;
-        return;
-    }
-
-    cache->paragraphs = malloc(count * sizeof(char *));
-    cache->count = count;
-
-    fseek(file, 0, SEEK_SET);
-    inSection = 0;
-    int index = 0;
-    while (fgets(line, sizeof(line), file)) {
-        trim_newline(line);
-        if (line[0] == '#') {
-            inSection = (strcasecmp(line, marker) == 0);
-            continue;
-        }
-        if (inSection && strlen(line) > 0 && line[0] != '#') {
-            cache->paragraphs[index++] = strdup(line);
-            if (index >= count) break;
-        }
-    }
-}
-
-void freeParagraphCache(ParagraphCache *cache) {
-    for (int i = 0; i < cache->count; i++) {
-        free(cache->paragraphs[i]);
-        cache->paragraphs[i] = NULL;
-    }
-    free(cache->paragraphs);
-    cache->paragraphs = NULL;
-}
-
-char *getRandomParagraph(ParagraphCache *cache) {
-    if (cache->count == 0) {
-        fprintf(stderr, "Error: No paragraphs available.\n");
-        exit(EXIT_FAILURE);
-    }
-    return cache->paragraphs[rand() % cache->count];
-}
-
-void sanitizeUsername(char *username, size_t size) {
-    for (size_t i = 0; i < strlen(username) && i < size - 1; i++) {
-        if (!isalnum(username[i]) && username[i] != '-' && username[i] != '_') {
-            username[i] = '_';
-        }
-    }
-    username[size - 1] = '\0';
-}
-
-void loadUserProfile(UserProfile *profile) {
-    printf("Enter your username: ");
-    CHECK_FILE_OP(fgets(profile->username, sizeof(profile->username), stdin), "Error reading username");
-    profile->username[strcspn(profile->username, "\n")] = '\0';
-    if (strlen(profile->username) == 0) {
-        strcpy(profile->username, "default");
-    }
-    sanitizeUsername(profile->username, sizeof(profile->username));
-
-    char filename[100];
-    snprintf(filename, sizeof(filename), "%s_profile.txt", profile->username);
-    FILE *f = fopen(filename, "r");
-    if (f && fscanf(f, "%lf %lf %lf %lf %d", &profile->bestSpeed, &profile->bestAccuracy,
-                    &profile->totalSpeed, &profile->totalAccuracy, &profile->totalAttempts) == 5) {
-        fclose(f);
-    } else {
-        if (f) fclose(f);
-        profile->bestSpeed = profile->bestAccuracy = profile->totalSpeed = profile->totalAccuracy = 0;
-        profile->totalAttempts = 0;
-    }
-}
-
-void updateUserProfile(UserProfile *profile, TypingStats *currentAttempt) {
-    if (currentAttempt->typingSpeed > profile->bestSpeed)
-        profile->bestSpeed = currentAttempt->typingSpeed;
-    if (currentAttempt->accuracy > profile->bestAccuracy)
-        profile->bestAccuracy = currentAttempt->accuracy;
-
-    profile->totalSpeed += currentAttempt->typingSpeed;
-    profile->totalAccuracy += currentAttempt->accuracy;
-    profile->totalAttempts++;
-
-    char filename[100];
-    snprintf(filename, sizeof(filename), "%s_profile.txt", profile->username);
-    FILE *f = fopen(filename, "w");
-    if (f) {
-        fprintf(f, "%.2lf %.2lf %.2lf %.2lf %d", profile->bestSpeed, profile->bestAccuracy,
-                profile->totalSpeed, profile->totalAccuracy, profile->totalAttempts);
-        fclose(f);
-    } else {
-        fprintf(stderr, "Error saving user profile to '%s'\n", filename);
-    }
-}
+// Scratch edit script for the terminal mode's per-attempt breakdown
+static EditScript editScript;
 
 void displayUserSummary(UserProfile *profile) {
     printf("\nUser Summary for %s:\n", profile->username);
@@ -284,191 +125,41 @@ void displayUserSummary(UserProfile *profile) {
     printf("--------------------------------------------------------\n");
 }
 
-void printTypingStats(double elapsedTime, const char *input, const char *correctText, Difficulty difficulty, TypingStats *stats) {
-    int dist = levenshtein(correctText, input, stats->caseInsensitive);
-    int len = strlen(correctText);
-    double accuracy = ((double)(len - dist) / len) * 100.0;
-    if (accuracy < 0) accuracy = 0;
-
-    if (elapsedTime < 0.01) elapsedTime = 0.01;
-
-    double cpm = (strlen(input) / elapsedTime) * 60.0;
-    double wpm = cpm / 5.0;
-
-    stats->typingSpeed = cpm;
-    stats->wordsPerMinute = wpm;
-    stats->accuracy = accuracy;
-    stats->wrongChars = dist;
-    strncpy(stats->paragraph, correctText, max_para_length - 1);
-    stats->paragraph[max_para_length - 1] = '\0';
-}
-
-int min3(int a, int b, int c) {
-    if (a <= b && a <= c) return a;
-    else if (b <= c) return b;
-    else return c;
-}
-
-int levenshtein(const char *s1, const char *s2, int caseInsensitive) {
-    int len1 = strlen(s1);
-    int len2 = strlen(s2);
-    int i, j;
-
-    int **dp = malloc((len1 + 1) * sizeof(int *));
-    for (i = 0; i <= len1; i++)
-        dp[i] = malloc((len2 + 1) * sizeof(int));
-
-    for (i = 0; i <= len1; i++) dp[i][0] = i;
-    for (j = 0; j <= len2; j++) dp[0][j] = j;
-
-    for (i = 1; i <= len1; i++) {
-        for (j = 1; j <= len2; j++) {
-            char c1 = s1[i - 1];
-            char c2 = s2[j - 1];
-            if (caseInsensitive) {
-                c1 = tolower(c1);
-                c2 = tolower(c2);
-            }
-            if (c1 == c2)
-                dp[i][j] = dp[i - 1][j - 1];
-            else
-                dp[i][j] = 1 + min3(dp[i - 1][j], dp[i][j - 1], dp[i - 1][j - 1]);
-        }
-    }
-
-    int distance = dp[len1][len2];
-    for (i = 0; i <= len1; i++) free(dp[i]);
-    free(dp);
-
-    return distance;
-}
-
-void loadLeaderboard(LeaderboardEntry leaderboard[], int *numEntries) {
-    FILE *file = fopen("leaderboard.txt", "r");
-    if (!file) {
-        *numEntries = 0;
-        return;
-    }
-
-    *numEntries = 0;
-    while (fscanf(file, "%49s %lf %lf %lf %9s",
-                  leaderboard[*numEntries].username,
-                  &leaderboard[*numEntries].typingSpeed,
-                  &leaderboard[*numEntries].wordsPerMinute,
-                  &leaderboard[*numEntries].accuracy,
-                  leaderboard[*numEntries].difficulty) == 5) {
-        (*numEntries)++;
-        if (*numEntries >= max_leaderboard_entries) break;
-    }
-    fclose(file);
-}
-
-void saveLeaderboard(LeaderboardEntry leaderboard[], int numEntries) {
-    FILE *file = fopen("leaderboard.txt", "w");
-    if (!file) {
-        perror("Error saving leaderboard");
-        return;
-    }
-
-    for (int i = 0; i < numEntries; i++) {
-        fprintf(file, "%s %.2f %.2f %.2f %s\n", leaderboard[i].username,
-                leaderboard[i].typingSpeed, leaderboard[i].wordsPerMinute,
-                leaderboard[i].accuracy, leaderboard[i].difficulty);
-    }
-    fclose(file);
-}
-
-void updateLeaderboard(UserProfile *profile, TypingStats *currentAttempt, const char *difficulty) {
-    LeaderboardEntry leaderboard[max_leaderboard_entries];
-    int numEntries;
-    int replaced = 0;
-    loadLeaderboard(leaderboard, &numEntries);
-
-    LeaderboardEntry newEntry;
-    strncpy(newEntry.username, profile->username, sizeof(newEntry.username) - 1);
-    newEntry.username[sizeof(newEntry.username) - 1] = '\0';
-    newEntry.typingSpeed = currentAttempt->typingSpeed;
-    newEntry.wordsPerMinute = currentAttempt->wordsPerMinute;
-    newEntry.accuracy = currentAttempt->accuracy;
-    strncpy(newEntry.difficulty, difficulty, sizeof(newEntry.difficulty) - 1);
-    newEntry.difficulty[sizeof(newEntry.difficulty) - 1] = '\0';
-
-    for (int i = 0; i < numEntries; i++) {
-        if (strcmp(leaderboard[i].username, newEntry.username) == 0 &&
-            strcmp(leaderboard[i].difficulty, newEntry.difficulty) == 0 &&
-            newEntry.typingSpeed > leaderboard[i].typingSpeed) {
-            leaderboard[i] = newEntry;
-            replaced = 1;
-            break;
-        }
-    }
-
-    if (!replaced) {
-        if (numEntries < max_leaderboard_entries) {
-            leaderboard[numEntries++] = newEntry;
+void displayKeystrokeSummary(const KeystrokeSummary *summary) {
+    if (summary->keystrokes < 2) return;
+    printf("\nKeystroke Timing:\n");
+    printf("--------------------------------------------------------\n");
+    printf("Median Interval: %.0f ms (90th percentile %.0f ms)\n",
+           summary->medianIntervalNs / 1e6, summary->p90IntervalNs / 1e6);
+    printf("Interval Histogram (ms):\n");
+    for (int i = 0; i < KEYSTROKE_HISTOGRAM_BUCKETS; i++) {
+        if (summary->intervalHistogram[i] == 0) continue;
+        if (i < KEYSTROKE_HISTOGRAM_BUCKETS - 1) {
+            printf("  <%5u: %u\n", keystrokeBucketLimitsMs[i], summary->intervalHistogram[i]);
         } else {
-            int worstIndex = -1;
-            double worstScore = 1e9;
-            for (int i = 0; i < numEntries; i++) {
-                if (strcmp(leaderboard[i].difficulty, newEntry.difficulty) == 0 &&
-                    leaderboard[i].typingSpeed < worstScore) {
-                    worstScore = leaderboard[i].typingSpeed;
-                    worstIndex = i;
-                }
-            }
-            if (worstIndex != -1 && newEntry.typingSpeed > leaderboard[worstIndex].typingSpeed) {
-                leaderboard[worstIndex] = newEntry;
-            }
+            printf("  >=%4u: %u\n", keystrokeBucketLimitsMs[i - 1], summary->intervalHistogram[i]);
         }
     }
-
-    for (int i = 0; i < numEntries - 1; i++) {
-        for (int j = i + 1; j < numEntries; j++) {
-            if (strcmp(leaderboard[i].difficulty, leaderboard[j].difficulty) == 0 &&
-                leaderboard[i].typingSpeed < leaderboard[j].typingSpeed) {
-                LeaderboardEntry temp = leaderboard[i];
-                leaderboard[i] = leaderboard[j];
-                leaderboard[j] = temp;
-            }
-        }
-    }
-    saveLeaderboard(leaderboard, numEntries);
-}
-
-void displayLeaderboard(const char *difficulty) {
-    LeaderboardEntry leaderboard[max_leaderboard_entries];
-    int numEntries;
-    loadLeaderboard(leaderboard, &numEntries);
-
-    printf("\nLeaderboard for %s Difficulty:\n", difficulty);
-    printf("-------------------------------------------------------------\n");
-    printf("| Rank | Username       | CPM    | WPM    | Accuracy (%%) |\n");
-    printf("-------------------------------------------------------------\n");
-
-    int rank = 1;
-    int shown = 0;
-    for (int i = 0; i < numEntries && rank <= 10; i++) {
-        if (strcmp(leaderboard[i].difficulty, difficulty) == 0) {
-            printf("| %4d | %-14s | %6.2f | %6.2f | %10.2f |\n",
-                   rank, leaderboard[i].username,
-                   leaderboard[i].typingSpeed, leaderboard[i].wordsPerMinute,
-                   leaderboard[i].accuracy);
-            rank++;
-            shown++;
+    printf("Bursts: %u (%.1f keys each, %.2f CPM while typing) | Pauses: %u (%.1f s)\n",
+           summary->burstCount, summary->meanBurstLength, summary->burstCpm,
+           summary->pauseCount, summary->pauseNs / 1e9);
+    if (summary->bigramCount > 0) {
+        printf("Slowest Bigrams:");
+        for (int i = 0; i < summary->bigramCount && i < 5; i++) {
+            const BigramLatency *bigram = &summary->slowestBigrams[i];
+            printf(" \"%c%c\" %.0f ms", bigram->first, bigram->second, bigram->totalNs / 1e6 / bigram->count);
         }
+        printf("\n");
     }
-    if (shown == 0) {
-        printf("|      No entries for this difficulty level yet          |\n");
-    }
-    printf("-------------------------------------------------------------\n");
+    printf("--------------------------------------------------------\n");
 }
 
-void collectUserInput(char *input, size_t inputSize, double *elapsedTime) {
+void collectUserInput(char **input, size_t *inputCapacity, double *elapsedTime) {
     struct timeval startTime, endTime;
     gettimeofday(&startTime, NULL);
     printf("Your input: \n");
     fflush(stdout);
-    CHECK_FILE_OP(fgets(input, inputSize, stdin), "Error reading input");
+    CHECK_FILE_OP(readTextLine(stdin, input, inputCapacity) >= 0, "Error reading input");
     gettimeofday(&endTime, NULL);
     *elapsedTime = (endTime.tv_sec - startTime.tv_sec) + (endTime.tv_usec - startTime.tv_usec) / 1000000.0;
 }
@@ -512,20 +203,21 @@ void promptDifficulty(Difficulty *difficulty, char *difficultyLevel) {
     }
 }
 
-void displayPreviousAttempts(TypingStats attempts[], int numAttempts) {
+void displayPreviousAttempts(const SessionAttempt *attempts, size_t numAttempts) {
     printf("\nPrevious Attempts:\n");
-    printf("--------------------------------------------------------\n");
-    printf("| Attempt | CPM    | WPM    | Accuracy (%%) | Wrong Chars |\n");
-    printf("--------------------------------------------------------\n");
-    for (int i = 0; i < numAttempts; i++) {
-        printf("| %7d | %6.2f | %6.2f | %11.2f | %11d |\n",
+    printf("--------------------------------------------------------------------\n");
+    printf("| Attempt | Paragraph | CPM    | WPM    | Accuracy (%%) | Wrong Chars |\n");
+    printf("--------------------------------------------------------------------\n");
+    for (size_t i = 0; i < numAttempts; i++) {
+        printf("| %7zu | %9d | %6.2f | %6.2f | %11.2f | %11d |\n",
                i + 1,
-               attempts[i].typingSpeed,
-               attempts[i].wordsPerMinute,
-               attempts[i].accuracy,
-               attempts[i].wrongChars);
+               attempts[i].paragraphId + 1,
+               attempts[i].stats.typingSpeed,
+               attempts[i].stats.wordsPerMinute,
+               attempts[i].stats.accuracy,
+               attempts[i].stats.wrongChars);
     }
-    printf("--------------------------------------------------------\n");
+    printf("--------------------------------------------------------------------\n");
 }
 
 char getRealTimeChar() {
@@ -627,87 +319,79 @@ void initializeRealtimeMode() {
     getRealTimeChar();
 }
 
-void displayRealtimeTyping(const char* targetText, const char* userInput, int currentPos, int wrongChars, double elapsedTime) {
-    int targetLen = strlen(targetText);
-    int inputLen = strlen(userInput);
+// With a race, the coordinator is serviced between keys: other racers'
+// progress is applied as it arrives and ours is sent once a tick
+void collectUserInputRealtime(const char* targetText, char *input, size_t inputSize, double *elapsedTime, TypingStats *stats, KeystrokeLog *keystrokes, RaceClient *race) {
+    struct timeval startTime, currentTime;
     
-    clearScreen();
+    int targetLen = strlen(targetText);
+    int currentPos = 0;
+    int wrongChars = 0;
+    int ch;
     
-    printf(ANSI_GREEN "=== Real-Time Typing Mode ===\n" ANSI_RESET);
-    printf(ANSI_WHITE "Target Text:\n" ANSI_RESET);
+    memset(input, 0, inputSize);
+    *elapsedTime = 0;
     
-    for (int i = 0; i < targetLen; i++) {
-        if (i < inputLen) {
-            if (userInput[i] == targetText[i]) {
-                printf(ANSI_GREEN "%c" ANSI_RESET, targetText[i]);
-            } else {
-                printf(ANSI_BG_RED ANSI_WHITE "%c" ANSI_RESET, targetText[i]);
-            }
-        } else if (i == currentPos) {
-            printf(ANSI_YELLOW "%c" ANSI_RESET, targetText[i]);
-        } else {
-            printf(ANSI_WHITE "%c" ANSI_RESET, targetText[i]);
-        }
+    if (race) {
+        enableWindowsColorSupport();
+        clearScreen();
+    } else {
+        initializeRealtimeMode();
     }
     
-    printf("\n\n" ANSI_WHITE "Your Input:\n" ANSI_RESET);
+    ScreenRenderer screen;
+    openScreenRenderer(&screen);
     
-    for (int i = 0; i < inputLen; i++) {
-        if (i < targetLen) {
-            if (userInput[i] == targetText[i]) {
-                printf(ANSI_GREEN "%c" ANSI_RESET, userInput[i]);
-            } else {
-                printf(ANSI_RED "%c" ANSI_RESET, userInput[i]);
+    // Keys typed during the countdown are dropped
+    while (race && raceClockMs() < race->startAt) {
+        displayRealtimeTyping(&screen, targetText, input, 0, 0, 0.0, race);
+        uint64_t remaining = race->startAt - raceClockMs();
+        int ready = waitScreenInput(race->fd, remaining < RACE_TICK_MS ? (int)remaining : RACE_TICK_MS);
+        if ((ready & SCREEN_INPUT_FD) && pumpRaceClient(race) < 0) closeRaceClient(race);
+        if (ready & SCREEN_INPUT_KEY) {
+            ch = readScreenKey();
+            if (ch == 27 || ch < 0) {
+                closeScreenRenderer(&screen);
+                printf(ANSI_RED "\nRace abandoned.\n" ANSI_RESET);
+                return;
             }
-        } else {
-            printf(ANSI_RED "%c" ANSI_RESET, userInput[i]);
         }
     }
-    
-    printf(ANSI_YELLOW "_" ANSI_RESET);
-    
-    printf("\n\n" ANSI_WHITE "Progress: %d/%d characters | Errors: %d | Time: %.1fs\n" ANSI_RESET, 
-           currentPos, targetLen, wrongChars, elapsedTime);
-    
-    if (currentPos > 0) {
-        double currentCPM = (currentPos / elapsedTime) * 60.0;
-        double currentWPM = currentCPM / 5.0;
-        printf("Current Speed: %.1f CPM (%.1f WPM)\n", currentCPM, currentWPM);
-    }
-    
-    printf("\n" ANSI_YELLOW "Controls: ESC=quit | Backspace=correct | Any key=type" ANSI_RESET "\n");
-    
-    fflush(stdout);
-}
-
-void collectUserInputRealtime(const char* targetText, char *input, size_t inputSize, double *elapsedTime, TypingStats *stats) {
-    struct timeval startTime, currentTime;
     gettimeofday(&startTime, NULL);
-    
-    int targetLen = strlen(targetText);
-    int currentPos = 0;
-    int wrongChars = 0;
-    char ch;
-    
-    memset(input, 0, inputSize);
-    
-    initializeRealtimeMode();
+    uint64_t nextTick = race ? raceClockMs() + RACE_TICK_MS : 0;
     
     while (currentPos < targetLen) {
-        gettimeofday(&currentTime, NULL);
-        *elapsedTime = (currentTime.tv_sec - startTime.tv_sec) + 
-                       (currentTime.tv_usec - startTime.tv_usec) / 1000000.0;
+        // Draw only once every queued key is handled, so a terminal that
+        // falls behind gets one merged frame instead of a backlog of them
+        if (!screenKeyPending()) {
+            gettimeofday(&currentTime, NULL);
+            *elapsedTime = (currentTime.tv_sec - startTime.tv_sec) + 
+                           (currentTime.tv_usec - startTime.tv_usec) / 1000000.0;
+            
+            displayRealtimeTyping(&screen, targetText, input, currentPos, wrongChars, *elapsedTime, race);
+        }
         
-        displayRealtimeTyping(targetText, input, currentPos, wrongChars, *elapsedTime);
+        if (race) {
+            uint64_t now = raceClockMs();
+            if (now >= nextTick) {
+                sendRaceProgress(race, (uint32_t)currentPos, (uint32_t)wrongChars, 0);
+                nextTick = now + RACE_TICK_MS;
+            }
+            int ready = screenKeyPending() ? SCREEN_INPUT_KEY : waitScreenInput(race->fd, (int)(nextTick - now));
+            if ((ready & SCREEN_INPUT_FD) && pumpRaceClient(race) < 0) closeRaceClient(race);
+            if (!(ready & SCREEN_INPUT_KEY)) continue;
+        }
         
-        ch = getRealTimeChar();
+        ch = readScreenKey();
         
-        if (ch == 27) {
+        if (ch == 27 || ch < 0) {
+            closeScreenRenderer(&screen);
             printf(ANSI_RED "\nTest cancelled by user.\n" ANSI_RESET);
             input[0] = '\0';
             return;
         } else if (ch == 8 || ch == 127) {
             if (currentPos > 0) {
+                recordKeystroke(keystrokes, KEYSTROKE_BACKSPACE, targetText[currentPos - 1]);
                 currentPos--;
                 input[currentPos] = '\0';
                 wrongChars = 0;
@@ -718,6 +402,7 @@ void collectUserInputRealtime(const char* targetText, char *input, size_t inputS
                 }
             }
         } else if (ch >= 32 && ch <= 126 && currentPos < (int)(inputSize - 1)) {
+            recordKeystroke(keystrokes, ch, targetText[currentPos]);
             input[currentPos] = ch;
             input[currentPos + 1] = '\0';
             
@@ -738,12 +423,29 @@ void collectUserInputRealtime(const char* targetText, char *input, size_t inputS
     *elapsedTime = (currentTime.tv_sec - startTime.tv_sec) + 
                    (currentTime.tv_usec - startTime.tv_usec) / 1000000.0;
     
-    clearScreen();
-    displayRealtimeTyping(targetText, input, currentPos, wrongChars, *elapsedTime);
+    if (race) {
+        sendRaceProgress(race, (uint32_t)currentPos, (uint32_t)wrongChars, 1);
+        // Keep the standings live until the race is over or we leave
+        while (race->fd >= 0 && !race->over) {
+            displayRealtimeTyping(&screen, targetText, input, currentPos, wrongChars, *elapsedTime, race);
+            int ready = waitScreenInput(race->fd, 1000);
+            if ((ready & SCREEN_INPUT_FD) && pumpRaceClient(race) < 0) closeRaceClient(race);
+            if (ready & SCREEN_INPUT_KEY) {
+                readScreenKey();
+                break;
+            }
+        }
+    }
+    displayRealtimeTyping(&screen, targetText, input, currentPos, wrongChars, *elapsedTime, race);
+    closeScreenRenderer(&screen);
     
-    printf(ANSI_GREEN "\n=== Test Completed! ===\n" ANSI_RESET);
-    printf("Press any key to continue...\n");
-    getRealTimeChar();
+    if (race) {
+        printf(ANSI_GREEN "\n=== Race Completed! ===\n" ANSI_RESET);
+    } else {
+        printf(ANSI_GREEN "\n=== Test Completed! ===\n" ANSI_RESET);
+        printf("Press any key to continue...\n");
+        getRealTimeChar();
+    }
     
     stats->wrongChars = wrongChars;
 }
@@ -764,13 +466,6 @@ int promptTypingMode() {
     return choice;
 }
 
-void toLowerStr(char *dst, const char *src) {
-    while (*src) {
-        *dst++ = tolower((unsigned char)*src++);
-    }
-    *dst = '\0';
-}
-
 void trim_newline(char *str) {
     size_t len = strlen(str);
     while (len > 0 && (str[len - 1] == '\n' || str[len - 1] == '\r')) {
@@ -778,24 +473,39 @@ void trim_newline(char *str) {
     }
 }
 
-void processAttempts(ParagraphCache *cache) {
+void processAttempts(ParagraphCache *cache, WriteBehindDurability durability) {
     printf("Welcome to Typing Tutor!\n");
     UserProfile profile;
-    loadUserProfile(&profile);
-
-    char input[max_para_length];
+    BackendState state = {0};
+    loadUserProfile(&state, &profile);
+
+    // Attempts are saved by a background thread with its own descriptors, so
+    // the next paragraph never waits on the disk. Only the leaderboard view
+    // at the end needs them flushed.
+    BackendState writerState = {0};
+    WriteBehind *writer = startWriteBehind(sizeof(PendingAttempt), max_pending_attempts, durability,
+                                           commitPendingAttempts, &writerState);
+    CHECK_FILE_OP(writer, "Memory allocation error for write-behind queue");
+    PendingAttempt pending;
+
+    char *input = NULL;
+    size_t inputCapacity = 0;
     Difficulty difficulty;
     char difficultyLevel[20];
-    TypingStats attempts[max_attempts];
-    int numAttempts = 0;
+    // Any number of attempts; each is its stats and a paragraph id
+    SessionAttempt *attempts = NULL;
+    size_t numAttempts = 0, attemptCapacity = 0;
     int caseChoice;
     int typingMode;
+    KeystrokeLog keystrokes;
+    initKeystrokeLog(&keystrokes, 4 * max_para_length);
 
     promptDifficulty(&difficulty, difficultyLevel);
     typingMode = promptTypingMode();
 
-    while (numAttempts < max_attempts) {
-        char *currentPara = getRandomParagraph(cache);
+    for (;;) {
+        int paragraphId = shuffledParagraphId(&state, cache, profile.username, "all");
+        const char *currentPara = paragraphText(cache, paragraphId);
         printf("Enable case-insensitive typing? (1-YES, 0-NO): ");
         if (scanf("%d", &caseChoice) != 1 || (caseChoice != 0 && caseChoice != 1)) {
             printf("Invalid input. Please enter 0 or 1.\n");
@@ -810,13 +520,19 @@ void processAttempts(ParagraphCache *cache) {
         TypingStats currentAttempt = {.caseInsensitive = caseChoice};
         
         if (typingMode == 2) {
-            collectUserInputRealtime(currentPara, input, sizeof(input), &elapsedTime, &currentAttempt);
+            if (inputCapacity < strlen(currentPara) + 1) {
+                inputCapacity = strlen(currentPara) + 1;
+                input = realloc(input, inputCapacity);
+                CHECK_FILE_OP(input, "Memory allocation error for input");
+            }
+            resetKeystrokeLog(&keystrokes);
+            collectUserInputRealtime(currentPara, input, inputCapacity, &elapsedTime, &currentAttempt, &keystrokes, NULL);
             if (strlen(input) == 0) {
                 printf("Attempt cancelled. Try again.\n");
                 continue;
             }
         } else {
-            collectUserInput(input, sizeof(input), &elapsedTime);
+            collectUserInput(&input, &inputCapacity, &elapsedTime);
         }
 
         size_t len = strlen(input);
@@ -829,10 +545,19 @@ void processAttempts(ParagraphCache *cache) {
         }
 
         printTypingStats(elapsedTime, input, currentPara, difficulty, &currentAttempt);
-        attempts[numAttempts++] = currentAttempt;
+        if (numAttempts == attemptCapacity) {
+            attemptCapacity = attemptCapacity ? attemptCapacity * 2 : 16;
+            attempts = realloc(attempts, attemptCapacity * sizeof(SessionAttempt));
+            CHECK_FILE_OP(attempts, "Memory allocation error for attempt history");
+        }
+        attempts[numAttempts].paragraphId = paragraphId;
+        attempts[numAttempts++].stats = currentAttempt;
 
-        updateUserProfile(&profile, &currentAttempt);
-        updateLeaderboard(&profile, &currentAttempt, difficultyLevel);
+        recordProfileAttempt(&profile, &currentAttempt);
+        memset(&pending, 0, sizeof(pending));
+        strncpy(pending.username, profile.username, sizeof(pending.username) - 1);
+        strncpy(pending.difficulty, difficultyLevel, sizeof(pending.difficulty) - 1);
+        pending.stats = currentAttempt;
 
         printf("\nTyping Stats for Current Attempt:\n");
         printf("--------------------------------------------------------\n");
@@ -841,8 +566,21 @@ void processAttempts(ParagraphCache *cache) {
         printf("Accuracy: %.2f%%\n", currentAttempt.accuracy);
         printf("Wrong Characters: %d\n", currentAttempt.wrongChars);
         printf("Time taken: %.2f seconds\n", elapsedTime);
+        ReplyBuffer breakdown = {0};
+        alignEdits(&editScript, currentPara, strlen(currentPara), input, strlen(input), caseChoice);
+        formatEditBreakdown(&breakdown, &editScript, 0);
+        fwrite(breakdown.data, 1, breakdown.length, stdout);
+        freeReplyBuffer(&breakdown);
         printf("--------------------------------------------------------\n");
 
+        if (typingMode == 2) {
+            summarizeKeystrokes(&keystrokes, &pending.keystrokes);
+            displayKeystrokeSummary(&pending.keystrokes);
+            pending.hasKeystrokes = 1;
+        }
+        fflush(stdout);
+        queueWriteBehind(writer, &pending);
+
         printf("\nDo you want to continue? (y/n): ");
         char choice[3];
         CHECK_FILE_OP(fgets(choice, sizeof(choice), stdin), "Error reading choice");
@@ -853,187 +591,489 @@ void processAttempts(ParagraphCache *cache) {
             printf("\nWould you like to see the leaderboard for %s difficulty? (y/n): ", difficultyLevel);
             CHECK_FILE_OP(fgets(choice, sizeof(choice), stdin), "Error reading choice");
             if (tolower(choice[0]) == 'y') {
-                displayLeaderboard(difficultyLevel);
+                flushWriteBehind(writer);
+                displayLeaderboard(&state, difficultyLevel);
             }
 
             printf("\nThanks for using Typing Tutor!\n");
             break;
         }
     }
+    stopWriteBehind(writer);
+    freeBackendState(&writerState);
+    free(attempts);
+    free(input);
+    freeKeystrokeLog(&keystrokes);
+    freeBackendState(&state);
 }
 
-int main(int argc, char *argv[]) {
-    srand((unsigned int)time(NULL));
-    ParagraphCache cache = {0};
-
-    if (argc == 3 && strcmp(argv[1], "--get-paragraph") == 0) {
-        const char *difficultyLevel = argv[2];
-        FILE *file = fopen("paragraphs.txt", "r");
-        if (!file) {
-            fprintf(stderr, "Error: Could not open paragraphs.txt\n");
-            return 1;
+// Resident mode for the Electron front end. Each request is a decimal byte
+// count on its own line followed by that many bytes of NUL-terminated
+// arguments (the same arguments the one-shot CLI takes). Each response is
+// "<status> <length>\n" followed by exactly <length> bytes of output.
+int runServer(BackendState *state) {
+#if IS_WINDOWS
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    char header[32];
+    char *payload = NULL;
+    size_t payloadCapacity = 0;
+    ReplyBuffer reply = {0};
+    int status = 0;
+
+    while (fgets(header, sizeof(header), stdin)) {
+        char *end;
+        unsigned long length = strtoul(header, &end, 10);
+        if (end == header || (*end != '\n' && *end != '\r') || length > max_frame_length) {
+            fprintf(stderr, "Error: Malformed request frame\n");
+            status = 1;
+            break;
         }
-        loadParagraphsForDifficulty(file, &cache, difficultyLevel);
-        fclose(file);
-        if (cache.count == 0) {
-            fprintf(stderr, "No paragraphs found for difficulty: %s\n", difficultyLevel);
-            return 1;
+        if (length + 1 > payloadCapacity) {
+            payloadCapacity = length + 1;
+            payload = realloc(payload, payloadCapacity);
+            CHECK_FILE_OP(payload, "Memory allocation error for request frame");
         }
-        char *para = getRandomParagraph(&cache);
-        printf("Random Paragraph:\n%s\n", para);
-        freeParagraphCache(&cache);
-        return 0;
+        if (fread(payload, 1, length, stdin) != length) break;
+        payload[length] = '\0';
+
+        char *args[max_serve_args + 1];
+        int argc = 0;
+        args[argc++] = "typingtutor";
+        for (size_t pos = 0; pos < length && argc < max_serve_args; pos += strlen(payload + pos) + 1) {
+            args[argc++] = payload + pos;
+        }
+        args[argc] = NULL;
+
+        if (argc == 2 && strcmp(args[1], "--quit") == 0) break;
+
+        reply.length = 0;
+        int result = dispatchCommand(state, argc, args, &reply);
+        printf("%d %lu\n", result, (unsigned long)reply.length);
+        if (reply.length > 0) fwrite(reply.data, 1, reply.length, stdout);
+        fflush(stdout);
+        compactLeaderboardIfNeeded(state);
     }
 
-    if (argc >= 2 && strcmp(argv[1], "--get-leaderboard") == 0) {
-        const char *difficulty = (argc >= 3) ? argv[2] : "Easy";
-        const char *currentUser = (argc >= 4) ? argv[3] : NULL;
-        double userCPM = (argc >= 5) ? atof(argv[4]) : -1;
-        double userWPM = (argc >= 6) ? atof(argv[5]) : -1;
-        double userAccuracy = (argc >= 7) ? atof(argv[6]) : -1;
-
-        LeaderboardEntry leaderboard[max_leaderboard_entries];
-        int numEntries;
-        loadLeaderboard(leaderboard, &numEntries);
-
-        printf("\nLeaderboard for %s Difficulty:\n", difficulty);
-        printf("-------------------------------------------------------------\n");
-        printf("| Rank | Username       | CPM    | WPM    | Accuracy (%%) |\n");
-        printf("-------------------------------------------------------------\n");
-
-        int rank = 1;
-        int shown = 0;
-        for (int i = 0; i < numEntries && rank <= 10; i++) {
-            if (strcmp(leaderboard[i].difficulty, difficulty) == 0) {
-                printf("| %4d | %-14s | %6.2f | %6.2f | %10.2f |\n",
-                       rank, leaderboard[i].username,
-                       leaderboard[i].typingSpeed, leaderboard[i].wordsPerMinute,
-                       leaderboard[i].accuracy);
-                rank++;
-                shown++;
-            }
-        }
+    free(payload);
+    freeReplyBuffer(&reply);
+    return status;
+}
 
-        if (shown == 0) {
-            printf("|      No entries for this difficulty level yet          |\n");
+// ---- Multi-session server (--listen) ----
+
+static void openTypingSession(void *context, Session *session) {
+    SessionHost *host = context;
+    memset(&host->sessions[session->slot], 0, sizeof(TypingSession));
+}
+
+// Drop the session's attempt, and its hold on the paragraph text
+static void endSessionAttempt(TypingSession *typing) {
+    if (typing->arena) {
+        lockSessionShared(1);
+        releaseParagraphArena(typing->arena);
+        unlockSessionShared();
+        typing->arena = NULL;
+    }
+    typing->paragraph = NULL;
+    typing->paragraphLength = 0;
+}
+
+static void closeTypingSession(void *context, Session *session, int worker) {
+    SessionHost *host = context;
+    (void)worker;
+    endSessionAttempt(&host->sessions[session->slot]);
+}
+
+// Pick up entries other processes journaled; the writer thread folds the journal
+static void tickTypingSessions(void *context) {
+    SessionHost *host = context;
+    lockSessionShared(1);
+    refreshLeaderboard(host->state);
+    unlockSessionShared();
+}
+
+// Runs on the writer thread: the journal fsync and the profile, progress and
+// sketch updates all happen outside lockSessionShared(), which is only taken
+// to show the new entries in the in-memory leaderboard
+static void commitSessionAttempts(void *context, const void *items, size_t count, WriteBehindDurability durability) {
+    SessionHost *host = context;
+    commitPendingAttempts(&host->writerState, items, count, durability);
+    lockSessionShared(1);
+    refreshLeaderboard(host->state);
+    unlockSessionShared();
+}
+
+// Point the session at the next paragraph. Mapped paragraphs.bin text lives
+// as long as the server; paragraphs.txt text is held by a reference on its
+// arena, so a reload never pulls it out from under a running attempt.
+static int startSessionAttempt(SessionHost *host, TypingSession *typing, const char *difficultyLevel,
+                               ReplyBuffer *reply) {
+    endSessionAttempt(typing);
+    if (host->corpus) {
+        const CorpusSectionRecord *section = findCorpusSection(host->corpus, difficultyLevel);
+        if (section && section->entryCount > 0) {
+            uint64_t offset = nextShuffledIndex(host->state, typing->username, difficultyLevel, section->entryCount);
+            uint32_t length = 0;
+            typing->paragraph = getCorpusParagraph(host->corpus, section->firstEntry + offset, &length);
+            typing->paragraphLength = length;
         }
-        printf("-------------------------------------------------------------\n");
-
-        if (currentUser && userCPM > 0 && userWPM > 0 && userAccuracy > 0) {
-            int userRank = 1;
-            for (int i = 0; i < numEntries; i++) {
-                if (strcmp(leaderboard[i].difficulty, difficulty) == 0) {
-                    if (
-                        strcmp(leaderboard[i].username, currentUser) == 0 &&
-                        fabs(leaderboard[i].typingSpeed - userCPM) < 0.01 &&
-                        fabs(leaderboard[i].wordsPerMinute - userWPM) < 0.01 &&
-                        fabs(leaderboard[i].accuracy - userAccuracy) < 0.01
-                    ) {
-                        if (userRank > 10) {
-                            printf("\nYour Result:\n");
-                            printf("| %4d | %-14s | %6.2f | %6.2f | %10.2f |\n",
-                                   userRank,
-                                   leaderboard[i].username,
-                                   leaderboard[i].typingSpeed,
-                                   leaderboard[i].wordsPerMinute,
-                                   leaderboard[i].accuracy);
-                        }
-                        break;
-                    }
-                    userRank++;
-                }
-            }
+    } else {
+        lockSessionShared(1);
+        ParagraphCache *cache = getCorpusSection(host->state, difficultyLevel);
+        if (cache && cache->count > 0) {
+            int id = shuffledParagraphId(host->state, cache, typing->username, difficultyLevel);
+            typing->paragraph = paragraphText(cache, id);
+            typing->paragraphLength = cache->views[id].length;
+            typing->arena = cache->arena;
+            typing->arena->references++;
         }
-        return 0;
+        unlockSessionShared();
+    }
+    if (!typing->paragraph) {
+        replyPrintf(reply, "No paragraphs found for difficulty: %s\n", difficultyLevel);
+        return 1;
     }
+    snprintf(typing->difficulty, sizeof(typing->difficulty), "%s", difficultyLevel);
+    gettimeofday(&typing->started, NULL);
+    replyPrintf(reply, "Random Paragraph:\n%s\n", typing->paragraph);
+    return 0;
+}
 
-    if (argc == 1) {
-        FILE *file = fopen("paragraphs.txt", "r");
-        if (!file) {
-            file = fopen("paragraphs.txt", "w");
-            CHECK_FILE_OP(file, "Creating paragraphs.txt failed");
-            fprintf(file, "One day after a heavy meal. It was sleeping under a tree.\n");
-            fprintf(file, "After a while, there came a mouse and it started to play on the lion.\n");
-            fprintf(file, "Suddenly the lion got up with anger and looked for those who disturbed its nice sleep.\n");
-            fprintf(file, "Then it saw a small mouse standing trembling with fear.\n");
-            fprintf(file, "The lion jumped on it and started to kill it. The mouse requested the lion to forgive it.\n");
-            fprintf(file, "The lion felt pity and left it. The mouse ran away.\n");
-            fprintf(file, "On another day, the lion was caught in a net by a hunter. The mouse came there and cut the net.\n");
-            fprintf(file, "Thus it escaped. There after, the mouse and the lion became friends.\n");
-            fprintf(file, "They lived happily in the forest afterwards.\n");
-            fclose(file);
-            file = fopen("paragraphs.txt", "r");
-            CHECK_FILE_OP(file, "Error opening paragraphs.txt");
+// Timed on the server from --start, so clients cannot report their own times
+static int finishSessionAttempt(SessionHost *host, TypingSession *typing, SessionWorkspace *scratch,
+                                const char *input, ReplyBuffer *reply) {
+    struct timeval endTime;
+    gettimeofday(&endTime, NULL);
+    double elapsedTime = (endTime.tv_sec - typing->started.tv_sec) +
+                         (endTime.tv_usec - typing->started.tv_usec) / 1000000.0;
+
+    TypingStats stats = {.caseInsensitive = typing->caseInsensitive};
+    computeTypingStats(&scratch->workspace, elapsedTime, input, typing->paragraph, &stats);
+    // Well past the fastest human typists: the text was pasted, not typed
+    if (stats.typingSpeed > max_plausible_cpm) {
+        replyPrintf(reply, "Error: Attempt rejected, %.0f CPM is not plausible; send --start to try again\n",
+                    stats.typingSpeed);
+        endSessionAttempt(typing);
+        return 1;
+    }
+    alignEdits(&scratch->edits, typing->paragraph, typing->paragraphLength, input, strlen(input),
+               typing->caseInsensitive);
+    formatSubmission(reply, typing->difficulty, &stats, &scratch->edits);
+
+    lockSessionShared(1);
+    formatPercentile(host->state, typing->difficulty, &stats, reply);
+    unlockSessionShared();
+
+    PendingAttempt pending;
+    memset(&pending, 0, sizeof(pending));
+    profileName(typing->username, pending.username, sizeof(pending.username));
+    strncpy(pending.difficulty, typing->difficulty, sizeof(pending.difficulty) - 1);
+    pending.stats = stats;
+    queueWriteBehind(host->writer, &pending);
+
+    endSessionAttempt(typing);
+    return 0;
+}
+
+// Session commands:
+//   --login <username>                     binds the session to a user
+//   --start <difficulty> [caseInsensitive] next paragraph; starts the clock
+//   --finish <typedText>                   scores and records the attempt
+//   --get-leaderboard [difficulty]
+static int handleSessionRequest(void *context, Session *session, int worker, int argc, char *argv[],
+                                const char **replyData, size_t *replyLength) {
+    SessionHost *host = context;
+    TypingSession *typing = &host->sessions[session->slot];
+    SessionWorkspace *scratch = &host->workspaces[worker];
+    ReplyBuffer *reply = &scratch->reply;
+    int status = 1;
+    reply->length = 0;
+
+    if (argc == 3 && strcmp(argv[1], "--login") == 0 && strlen(argv[2]) > 0) {
+        snprintf(typing->username, sizeof(typing->username), "%s", argv[2]);
+        endSessionAttempt(typing);
+        char name[50];
+        profileName(typing->username, name, sizeof(name));
+        assignSessionShard(session, name);
+        replyPrintf(reply, "Logged in as %s\n", typing->username);
+        status = 0;
+    } else if (argc >= 2 && argc <= 3 && strcmp(argv[1], "--get-leaderboard") == 0) {
+        lockSessionShared(0);
+        formatLeaderboard(reply, &host->state->leaderboard, argc == 3 ? argv[2] : "Easy", 0,
+                          leaderboard_page_size);
+        unlockSessionShared();
+        status = 0;
+    } else if (typing->username[0] == '\0') {
+        replyPrintf(reply, "Error: Send --login <username> first\n");
+    } else if ((argc == 3 || argc == 4) && strcmp(argv[1], "--start") == 0) {
+        typing->caseInsensitive = argc == 4 ? atoi(argv[3]) != 0 : 0;
+        status = startSessionAttempt(host, typing, argv[2], reply);
+    } else if (argc == 3 && strcmp(argv[1], "--finish") == 0) {
+        if (!typing->paragraph) {
+            replyPrintf(reply, "Error: No attempt in progress; send --start first\n");
+        } else {
+            status = finishSessionAttempt(host, typing, scratch, argv[2], reply);
         }
-        loadParagraphs(file, &cache);
-        fclose(file);
-        processAttempts(&cache);
-        freeParagraphCache(&cache);
-        return 0;
+    } else {
+        replyPrintf(reply, "Usage: --login <username> | --start <difficulty> [caseInsensitive] | "
+                           "--finish <typedText> | --get-leaderboard [difficulty] | --quit\n");
     }
+    *replyData = reply->data;
+    *replyLength = reply->length;
+    return status;
+}
 
-    if (argc < 7) {
-        printf("Usage: %s <username> <difficulty> <caseInsensitive> <elapsedTime> <userInput> <paragraph>\n", argv[0]);
+// argv: --listen <unix:path|port> [--workers N] [--max-sessions N]
+// Hosts many concurrent typing sessions in one process; see session_server.h
+int runSessionHost(int argc, char *argv[]) {
+    SessionServerConfig config = {argv[2], hardwareThreadCount(), default_max_sessions};
+    int i = 3;
+    for (; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--workers") == 0) {
+            config.workers = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--max-sessions") == 0) {
+            config.maxSessions = (uint32_t)strtoul(argv[i + 1], NULL, 10);
+        } else {
+            break;
+        }
+    }
+    if (i != argc || config.workers < 1 || config.maxSessions < 1) {
+        fprintf(stderr, "Usage: %s --listen <unix:path|port> [--workers N] [--max-sessions N]\n", argv[0]);
         return 1;
     }
 
-    const char *username = argv[1];
-    const char *difficultyLevel = argv[2];
-    int caseInsensitive = atoi(argv[3]);
-    double elapsedTime = atof(argv[4]);
-    const char *userInput = argv[5];
-    const char *para = argv[6];
+    BackendState state = {0};
+    SessionHost host = {.state = &state, .corpus = getCompiledCorpus(&state)};
+    host.sessions = calloc(config.maxSessions, sizeof(TypingSession));
+    host.workspaces = calloc((size_t)config.workers, sizeof(SessionWorkspace));
+    CHECK_FILE_OP(host.sessions && host.workspaces, "Memory allocation error for sessions");
+    for (int w = 0; w < config.workers; w++) {
+        initScoreWorkspace(&host.workspaces[w].workspace);
+        initEditScript(&host.workspaces[w].edits);
+    }
+    refreshLeaderboard(&state);
+    // Workers share the profile store for shuffle positions; open it before they start
+    getProfileStore(&state);
+    host.writer = startWriteBehind(sizeof(PendingAttempt), max_pending_attempts, WRITE_BEHIND_BATCH,
+                                   commitSessionAttempts, &host);
+    CHECK_FILE_OP(host.writer, "Memory allocation error for write-behind queue");
+
+    SessionHandlers handlers = {handleSessionRequest, openTypingSession, closeTypingSession, tickTypingSessions,
+                                &host};
+    fprintf(stderr, "Listening on %s with %d workers and %u session slots\n", config.address, config.workers,
+            config.maxSessions);
+    int status = runSessionServer(&config, &handlers) == 0 ? 0 : 1;
+    stopWriteBehind(host.writer);
+    freeBackendState(&host.writerState);
+
+    for (int w = 0; w < config.workers; w++) {
+        freeScoreWorkspace(&host.workspaces[w].workspace);
+        freeEditScript(&host.workspaces[w].edits);
+        freeReplyBuffer(&host.workspaces[w].reply);
+    }
+    free(host.workspaces);
+    free(host.sessions);
+    freeBackendState(&state);
+    return status;
+}
 
-    printf("Random Paragraph:\n%s\n", para);
+// ---- Race mode (--race-host / --race) ----
+
+// argv: --race-host <unix:path|port> [--racers N] [--difficulty D] [--lobby S]
+// Coordinates one race over a random paragraph of the given difficulty
+int runRaceHost(int argc, char *argv[]) {
+    RaceConfig config = {argv[2], 2, 30, "Easy", NULL};
+    int i = 3;
+    for (; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--racers") == 0) {
+            config.racers = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--difficulty") == 0) {
+            config.difficulty = argv[i + 1];
+        } else if (strcmp(argv[i], "--lobby") == 0) {
+            config.lobbySeconds = atoi(argv[i + 1]);
+        } else {
+            break;
+        }
+    }
+    if (i != argc || config.racers < 1 || config.racers > RACE_MAX_RACERS || config.lobbySeconds < 0 ||
+        strlen(config.difficulty) >= RACE_DIFFICULTY_LENGTH) {
+        fprintf(stderr, "Usage: %s --race-host <unix:path|port> [--racers 1-%d] [--difficulty D] [--lobby seconds]\n",
+                argv[0], RACE_MAX_RACERS);
+        return 1;
+    }
 
-    Difficulty difficulty;
-    if (strcmp(difficultyLevel, "Easy") == 0)
-        difficulty = (Difficulty){EASY_SPEED, EASY_MEDIUM_SPEED, MEDIUM_HARD_SPEED};
-    else if (strcmp(difficultyLevel, "Medium") == 0)
-        difficulty = (Difficulty){EASY_MEDIUM_SPEED, MEDIUM_HARD_SPEED, HARD_MAX_SPEED};
-    else
-        difficulty = (Difficulty){MEDIUM_HARD_SPEED, HARD_MAX_SPEED, HARD_SPEED + 4};
-
-    TypingStats stats = {.caseInsensitive = caseInsensitive};
-    char userInputCopy[max_para_length], paraCopy[max_para_length];
-    if (caseInsensitive) {
-        toLowerStr(userInputCopy, userInput);
-        toLowerStr(paraCopy, para);
-        printTypingStats(elapsedTime, userInputCopy, paraCopy, difficulty, &stats);
+    BackendState state = {0};
+    char paragraph[RACE_MAX_TEXT];
+    const char *para = NULL;
+    CompiledCorpus *compiled = getCompiledCorpus(&state);
+    if (compiled) {
+        const CorpusSectionRecord *section = findCorpusSection(compiled, config.difficulty);
+        if (section && section->entryCount > 0) {
+            para = getCorpusParagraph(compiled, section->firstEntry + randomIndex(section->entryCount), NULL);
+        }
     } else {
-        printTypingStats(elapsedTime, userInput, para, difficulty, &stats);
+        ParagraphCache *cache = getCorpusSection(&state, config.difficulty);
+        if (cache && cache->count > 0) para = getRandomParagraph(cache);
+    }
+    if (para) snprintf(paragraph, sizeof(paragraph), "%s", para);
+    freeBackendState(&state);
+    if (!para) {
+        fprintf(stderr, "No paragraphs found for difficulty: %s\n", config.difficulty);
+        return 1;
+    }
+    config.text = paragraph;
+
+    fprintf(stderr, "Race on %s: starting when %d racers have joined or %d s after the first\n", config.address,
+            config.racers, config.lobbySeconds);
+    return runRaceCoordinator(&config) == 0 ? 0 : 1;
+}
+
+// argv: --race <unix:path|port> <username>
+// A finished race is scored and recorded like any real-time attempt
+int runRaceClient(int argc, char *argv[]) {
+    if (argc != 4) {
+        fprintf(stderr, "Usage: %s --race <unix:path|port> <username>\n", argv[0]);
+        return 1;
+    }
+    UserProfile profile = {0};
+    snprintf(profile.username, sizeof(profile.username), "%s", argv[3]);
+    sanitizeUsername(profile.username, sizeof(profile.username));
+
+    RaceClient *race = malloc(sizeof(RaceClient));
+    CHECK_FILE_OP(race, "Memory allocation error for race");
+    if (connectRaceClient(race, argv[2], profile.username) != 0) {
+        free(race);
+        return 1;
+    }
+    printf("Joined the race at %s as %s; waiting for it to start...\n", argv[2], profile.username);
+    fflush(stdout);
+    while (!race->started) {
+        if (waitRaceClient(race, 1000) < 0) {
+            fprintf(stderr, "Error: The race host closed the connection\n");
+            closeRaceClient(race);
+            free(race);
+            return 1;
+        }
     }
 
-    printf("\nTyping Stats:\n");
-    printf("CPM: %.2f\n", stats.typingSpeed);
-    printf("WPM: %.2f\n", stats.wordsPerMinute);
-    printf("Accuracy: %.2f%%\n", stats.accuracy);
-    printf("Wrong Characters: %d\n", stats.wrongChars);
-
-    if (stats.typingSpeed >= difficulty.hard) {
-        printf("Performance: Excellent! You passed the Hard threshold.\n");
-    } else if (stats.typingSpeed >= difficulty.medium) {
-        printf("Performance: Good! You passed the Medium threshold.\n");
-    } else if (stats.typingSpeed >= difficulty.easy) {
-        printf("Performance: Fair! You passed the Easy threshold.\n");
+    size_t capacity = strlen(race->text) + 1;
+    char *input = malloc(capacity);
+    CHECK_FILE_OP(input, "Memory allocation error for input");
+    KeystrokeLog keystrokes;
+    initKeystrokeLog(&keystrokes, 4 * capacity);
+    double elapsedTime;
+    TypingStats currentAttempt = {0};
+    collectUserInputRealtime(race->text, input, capacity, &elapsedTime, &currentAttempt, &keystrokes, race);
+    closeRaceClient(race);
+
+    int status = 1;
+    if (strlen(input) + 1 == capacity) {
+        BackendState state = {0};
+        readUserProfile(&state, &profile);
+        printTypingStats(elapsedTime, input, race->text, difficultyForLevel(race->difficulty), &currentAttempt);
+        updateUserProfile(&state, &profile, &currentAttempt);
+        recordProgress(&state, profile.username, race->difficulty, &currentAttempt);
+        recordScoreSketches(&state, race->difficulty, &currentAttempt);
+        updateLeaderboard(&state, &profile, &currentAttempt, race->difficulty);
+
+        printf("\nTyping Stats for this Race:\n");
+        printf("--------------------------------------------------------\n");
+        printf("Characters Per Minute (CPM): %.2f\n", currentAttempt.typingSpeed);
+        printf("Words Per Minute (WPM): %.2f\n", currentAttempt.wordsPerMinute);
+        printf("Accuracy: %.2f%%\n", currentAttempt.accuracy);
+        printf("Wrong Characters: %d\n", currentAttempt.wrongChars);
+        printf("Time taken: %.2f seconds\n", elapsedTime);
+        printf("--------------------------------------------------------\n");
+        KeystrokeSummary keystrokeSummary;
+        summarizeKeystrokes(&keystrokes, &keystrokeSummary);
+        displayKeystrokeSummary(&keystrokeSummary);
+        saveKeystrokeSummary(&state, profile.username, &keystrokeSummary);
+        compactLeaderboardIfNeeded(&state);
+        freeBackendState(&state);
+        status = 0;
     } else {
-        printf("Performance: Needs Improvement. Try to type faster!\n");
+        printf("Race not finished; nothing was recorded.\n");
     }
 
-    FILE *f = fopen("leaderboard.txt", "a");
-    if (f) {
-        fprintf(f, "%s %.2f %.2f %.2f %s\n", username, stats.typingSpeed, stats.wordsPerMinute, stats.accuracy, difficultyLevel);
-        fclose(f);
+    int order[RACE_MAX_RACERS];
+    int ranked = rankRacers(race->racers, race->racerCount, order);
+    printf("\nStandings:\n");
+    for (int i = 0; i < ranked; i++) {
+        const RacerState *racer = &race->racers[order[i]];
+        if (racer->flags & RACER_FINISHED) {
+            printf("%2d. %s - %.2fs\n", i + 1, racer->name, racer->finishMs / 1000.0);
+        } else {
+            printf("%2d. %s - %u/%zu characters%s\n", i + 1, racer->name, racer->position, capacity - 1,
+                   (racer->flags & RACER_LEFT) ? " (left)" : "");
+        }
     }
+    free(input);
+    freeKeystrokeLog(&keystrokes);
+    free(race);
+    return status;
+}
 
-    UserProfile profile;
-    strncpy(profile.username, username, sizeof(profile.username));
-    profile.bestSpeed = stats.typingSpeed;
-    profile.bestAccuracy = stats.accuracy;
-    profile.totalSpeed = stats.typingSpeed;
-    profile.totalAccuracy = stats.accuracy;
-    profile.totalAttempts = 1;
-    updateLeaderboard(&profile, &stats, difficultyLevel);
+int main(int argc, char *argv[]) {
+    srand((unsigned int)time(NULL));
+    ParagraphCache cache = {0};
 
-    return 0;
-}
\ No newline at end of file
+    if (argc == 2 && strcmp(argv[1], "--serve") == 0) {
+        BackendState state = {0};
+        int status = runServer(&state);
+        freeBackendState(&state);
+        return status;
+    }
+    if (argc >= 3 && strcmp(argv[1], "--listen") == 0) {
+        return runSessionHost(argc, argv);
+    }
+    if (argc >= 3 && strcmp(argv[1], "--race-host") == 0) {
+        return runRaceHost(argc, argv);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--race") == 0) {
+        return runRaceClient(argc, argv);
+    }
+
+    if (argc == 1 || (argc == 3 && strcmp(argv[1], "--durability") == 0)) {
+        WriteBehindDurability durability = WRITE_BEHIND_BATCH;
+        if (argc == 3 && parseWriteBehindDurability(argv[2], &durability) != 0) {
+            fprintf(stderr, "Usage: %s [--durability none|batch|always]\n", argv[0]);
+            return 1;
+        }
+        FILE *file = fopen("paragraphs.txt", "r");
+        if (file) {
+            loadParagraphs(file, &cache);
+            fclose(file);
+        } else {
+            loadEmbeddedParagraphs(&cache);
+        }
+        processAttempts(&cache, durability);
+        freeParagraphCache(&cache);
+        return 0;
+    }
+
+    BackendState state = {0};
+    ReplyBuffer reply = {0};
+    QueryOptions options;
+    int status = parseQueryOptions(&argc, argv, &options, &reply);
+#if IS_WINDOWS
+    if (options.format == OUTPUT_BINARY) _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    // Standard input is only available outside --serve, where it carries frames
+    if (status == 0 && (argc == 2 || (argc == 3 && strcmp(argv[2], "-") == 0)) &&
+        strcmp(argv[1], "--score-batch") == 0) {
+        status = handleScoreBatch(&state, stdin, &reply);
+    } else if (status == 0 && (argc == 7 || (argc == 8 && strcmp(argv[7], "-") == 0)) &&
+               strcmp(argv[1], "--score-stream") == 0) {
+        status = handleScoreStream(&state, argv, stdin, &options, &reply);
+    } else if (status == 0) {
+        status = dispatchQuery(&state, argc, argv, &options, &reply);
+    }
+    if (reply.length > 0) fwrite(reply.data, 1, reply.length, status == 0 ? stdout : stderr);
+    fflush(stdout);
+    compactLeaderboardIfNeeded(&state);
+    freeReplyBuffer(&reply);
+    freeBackendState(&state);
+    return status;
+}
@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "write_behind.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__WINDOWS__)
+    #include <windows.h>
+    #define WRITE_BEHIND_WINDOWS 1
+#else
+    #include <pthread.h>
+    #define WRITE_BEHIND_WINDOWS 0
+#endif
+
+struct WriteBehind {
+    size_t itemSize;
+    size_t capacity;
+    unsigned char *pending;         // queued, not yet taken by the writer
+    unsigned char *writing;         // the batch being committed
+    size_t pendingCount;
+    uint64_t queued;                // items ever queued
+    uint64_t committed;             // of those, items whose commit returned
+    int stopping;
+    int threaded;
+    WriteBehindDurability durability;
+    WriteBehindCommit commit;
+    void *context;
+#if WRITE_BEHIND_WINDOWS
+    CRITICAL_SECTION lock;
+    CONDITION_VARIABLE changed;
+    HANDLE thread;
+#else
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    pthread_t thread;
+#endif
+};
+
+#if WRITE_BEHIND_WINDOWS
+static void lockWriter(WriteBehind *writer) { EnterCriticalSection(&writer->lock); }
+static void unlockWriter(WriteBehind *writer) { LeaveCriticalSection(&writer->lock); }
+static void waitWriter(WriteBehind *writer) { SleepConditionVariableCS(&writer->changed, &writer->lock, INFINITE); }
+static void wakeWriter(WriteBehind *writer) { WakeAllConditionVariable(&writer->changed); }
+#else
+static void lockWriter(WriteBehind *writer) { pthread_mutex_lock(&writer->lock); }
+static void unlockWriter(WriteBehind *writer) { pthread_mutex_unlock(&writer->lock); }
+static void waitWriter(WriteBehind *writer) { pthread_cond_wait(&writer->changed, &writer->lock); }
+static void wakeWriter(WriteBehind *writer) { pthread_cond_broadcast(&writer->changed); }
+#endif
+
+int parseWriteBehindDurability(const char *name, WriteBehindDurability *durability) {
+    if (strcmp(name, "none") == 0) {
+        *durability = WRITE_BEHIND_NONE;
+    } else if (strcmp(name, "batch") == 0) {
+        *durability = WRITE_BEHIND_BATCH;
+    } else if (strcmp(name, "always") == 0) {
+        *durability = WRITE_BEHIND_ALWAYS;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+// Take whatever is pending, commit it with the lock released, repeat; what
+// queues up during a slow commit becomes the next batch
+static void drainWriter(WriteBehind *writer) {
+    lockWriter(writer);
+    for (;;) {
+        while (writer->pendingCount == 0 && !writer->stopping) waitWriter(writer);
+        if (writer->pendingCount == 0) break;
+        size_t take = writer->durability == WRITE_BEHIND_ALWAYS ? 1 : writer->pendingCount;
+        memcpy(writer->writing, writer->pending, take * writer->itemSize);
+        writer->pendingCount -= take;
+        memmove(writer->pending, writer->pending + take * writer->itemSize, writer->pendingCount * writer->itemSize);
+        wakeWriter(writer);
+        unlockWriter(writer);
+
+        writer->commit(writer->context, writer->writing, take, writer->durability);
+
+        lockWriter(writer);
+        writer->committed += take;
+        wakeWriter(writer);
+    }
+    unlockWriter(writer);
+}
+
+#if WRITE_BEHIND_WINDOWS
+static DWORD WINAPI writerMain(LPVOID arg) {
+#else
+static void *writerMain(void *arg) {
+#endif
+    drainWriter(arg);
+    return 0;
+}
+
+WriteBehind *startWriteBehind(size_t itemSize, size_t capacity, WriteBehindDurability durability,
+                              WriteBehindCommit commit, void *context) {
+    WriteBehind *writer = calloc(1, sizeof(WriteBehind));
+    if (!writer) return NULL;
+    writer->itemSize = itemSize;
+    writer->capacity = capacity > 0 ? capacity : 1;
+    writer->durability = durability;
+    writer->commit = commit;
+    writer->context = context;
+    writer->pending = malloc(writer->capacity * itemSize);
+    writer->writing = malloc(writer->capacity * itemSize);
+    if (!writer->pending || !writer->writing) {
+        free(writer->pending);
+        free(writer->writing);
+        free(writer);
+        return NULL;
+    }
+#if WRITE_BEHIND_WINDOWS
+    InitializeCriticalSection(&writer->lock);
+    InitializeConditionVariable(&writer->changed);
+    writer->thread = CreateThread(NULL, 0, writerMain, writer, 0, NULL);
+    writer->threaded = writer->thread != NULL;
+#else
+    pthread_mutex_init(&writer->lock, NULL);
+    pthread_cond_init(&writer->changed, NULL);
+    writer->threaded = pthread_create(&writer->thread, NULL, writerMain, writer) == 0;
+#endif
+    if (!writer->threaded) fprintf(stderr, "Warning: Saving in the foreground; could not start a writer thread\n");
+    return writer;
+}
+
+void queueWriteBehind(WriteBehind *writer, const void *item) {
+    if (!writer->threaded) {
+        writer->commit(writer->context, item, 1, writer->durability);
+        return;
+    }
+    lockWriter(writer);
+    while (writer->pendingCount == writer->capacity) waitWriter(writer);
+    memcpy(writer->pending + writer->pendingCount * writer->itemSize, item, writer->itemSize);
+    writer->pendingCount++;
+    writer->queued++;
+    wakeWriter(writer);
+    unlockWriter(writer);
+}
+
+void flushWriteBehind(WriteBehind *writer) {
+    if (!writer->threaded) return;
+    lockWriter(writer);
+    uint64_t target = writer->queued;
+    while (writer->committed < target) waitWriter(writer);
+    unlockWriter(writer);
+}
+
+void stopWriteBehind(WriteBehind *writer) {
+    if (!writer) return;
+    if (writer->threaded) {
+        lockWriter(writer);
+        writer->stopping = 1;
+        wakeWriter(writer);
+        unlockWriter(writer);
+#if WRITE_BEHIND_WINDOWS
+        WaitForSingleObject(writer->thread, INFINITE);
+        CloseHandle(writer->thread);
+#else
+        pthread_join(writer->thread, NULL);
+#endif
+    }
+#if WRITE_BEHIND_WINDOWS
+    DeleteCriticalSection(&writer->lock);
+#else
+    pthread_cond_destroy(&writer->changed);
+    pthread_mutex_destroy(&writer->lock);
+#endif
+    free(writer->pending);
+    free(writer->writing);
+    free(writer);
+}
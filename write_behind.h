@@ -0,0 +1,34 @@
+#ifndef WRITE_BEHIND_H
+#define WRITE_BEHIND_H
+
+#include <stddef.h>
+
+// How hard a commit tries to reach the disk before it counts as done
+typedef enum {
+    WRITE_BEHIND_NONE,              // write, and leave flushing to the OS
+    WRITE_BEHIND_BATCH,             // one sync per store per batch
+    WRITE_BEHIND_ALWAYS             // every item committed and synced on its own
+} WriteBehindDurability;
+
+// Called on the writer thread with everything queued since the last call,
+// oldest first (one item at a time under WRITE_BEHIND_ALWAYS)
+typedef void (*WriteBehindCommit)(void *context, const void *items, size_t count,
+                                  WriteBehindDurability durability);
+
+// Fixed-size items are copied into a bounded queue and committed by one
+// background thread, so the caller only waits when the queue is full or it
+// asks to flush. Where no thread can be started, items commit inline.
+typedef struct WriteBehind WriteBehind;
+
+// "none", "batch" or "always"; -1 for anything else
+int parseWriteBehindDurability(const char *name, WriteBehindDurability *durability);
+
+WriteBehind *startWriteBehind(size_t itemSize, size_t capacity, WriteBehindDurability durability,
+                              WriteBehindCommit commit, void *context);
+void queueWriteBehind(WriteBehind *writer, const void *item);
+// Wait until everything queued so far has been committed
+void flushWriteBehind(WriteBehind *writer);
+// Flush, stop the thread and free the writer
+void stopWriteBehind(WriteBehind *writer);
+
+#endif